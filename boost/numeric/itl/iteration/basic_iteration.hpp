@@ -111,7 +111,7 @@ class basic_iteration
 
     void set_max_iterations(int m) { max_iter= m; } ///< Set maximal number of iterations
 
-    void restart() { i= 0; } ///< Reset the iteration number
+    void restart() { i= 0; error= 0; is_finished= false; } ///< Reset the iteration number and the termination state
 
     Real resid() const { return resid_; } ///< Last residuum
 
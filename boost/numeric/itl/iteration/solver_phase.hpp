@@ -0,0 +1,72 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_SOLVER_PHASE_INCLUDE
+#define ITL_SOLVER_PHASE_INCLUDE
+
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+namespace itl {
+
+/// Phases of iterative solvers whose times are collected by \ref telemetry_iteration
+namespace phase {
+    enum type { setup, spmv, preconditioner, orthogonalization, vector_update, convergence_check };
+
+    /// Number of phases
+    const int number= 6;
+
+    /// Name of phase \p p
+    inline const char* name(type p)
+    {
+	static const char* names[]= { "setup", "spmv", "preconditioner", "orthogonalization", "vector_update", "convergence_check" };
+	return names[p];
+    }
+}
+
+/// Base class of iteration types that collect telemetry, i.e. that have the methods enter_phase and add_residual
+struct with_telemetry {};
+
+namespace detail {
+
+    template <typename Iteration>
+    inline void telemetry_phase(Iteration&, phase::type, boost::mpl::false_) {}
+
+    template <typename Iteration>
+    inline void telemetry_phase(Iteration& iter, phase::type p, boost::mpl::true_) { iter.enter_phase(p); }
+
+    template <typename Iteration, typename Real>
+    inline void telemetry_residual(Iteration&, const Real&, boost::mpl::false_) {}
+
+    template <typename Iteration, typename Real>
+    inline void telemetry_residual(Iteration& iter, const Real& r, boost::mpl::true_) { iter.add_residual(r); }
+}
+
+/// Attribute the following work of the solver (until the next phase) to phase \p p
+/** Does nothing unless \p iter collects telemetry (see \ref telemetry_iteration). **/
+template <typename Iteration>
+inline void telemetry_phase(Iteration& iter, phase::type p)
+{
+    detail::telemetry_phase(iter, p, boost::is_base_of<with_telemetry, Iteration>());
+}
+
+/// Record the residual (estimate) \p r for solvers that do not check the termination in every iteration
+/** Does nothing unless \p iter collects telemetry (see \ref telemetry_iteration). **/
+template <typename Iteration, typename Real>
+inline void telemetry_residual(Iteration& iter, const Real& r)
+{
+    detail::telemetry_residual(iter, r, boost::is_base_of<with_telemetry, Iteration>());
+}
+
+} // namespace itl
+
+#endif // ITL_SOLVER_PHASE_INCLUDE
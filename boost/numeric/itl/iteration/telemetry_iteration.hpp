@@ -0,0 +1,212 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_TELEMETRY_ITERATION_INCLUDE
+#define ITL_TELEMETRY_ITERATION_INCLUDE
+
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#  error "telemetry_iteration needs C++11."
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <complex>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <utility>
+#include <iostream>
+#include <fstream>
+
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/itl/iteration/basic_iteration.hpp>
+#include <boost/numeric/itl/iteration/solver_phase.hpp>
+
+namespace itl {
+
+/// Residual of one termination check (or estimate) with the time since the start of the solver
+struct residual_entry
+{
+    int    iteration;
+    double time;  ///< Seconds
+    double resid;
+};
+
+/// Telemetry of a solver run: times and counts per phase and the residual history
+class solver_record
+{
+    typedef std::chrono::steady_clock clock;
+  public:
+    solver_record() { clear(); }
+
+    /// Remove all data
+    void clear()
+    {
+	for (int p= 0; p < phase::number; p++)
+	    phase_times[p]= 0.0, phase_counts[p]= 0;
+	residuals.clear();
+	running= false; active= phase::setup; elapsed= 0.0;
+    }
+
+    /// Attribute the time from now on to phase \p p; starts the clock if necessary
+    void enter_phase(phase::type p)
+    {
+	clock::time_point now= clock::now();
+	if (running)
+	    stop_phase(now);
+	running= true; active= p; since= now;
+	phase_counts[p]++;
+    }
+
+    /// Stop the clock, e.g. when the solver is finished
+    void stop()
+    {
+	if (running)
+	    stop_phase(clock::now());
+	running= false;
+    }
+
+    /// Add \p r in \p iteration to the residual history
+    void add_residual(int iteration, double r)
+    {
+	residual_entry e= { iteration, time(), r };
+	residuals.push_back(e);
+    }
+
+    /// Seconds spent in phase \p p
+    double phase_time(phase::type p) const { return phase_times[p] + (running && active == p ? seconds(clock::now()) : 0.0); }
+
+    /// How often phase \p p was entered
+    unsigned long phase_count(phase::type p) const { return phase_counts[p]; }
+
+    /// Seconds in all phases
+    double time() const { return elapsed + (running ? seconds(clock::now()) : 0.0); }
+
+    /// Residual history
+    const std::vector<residual_entry>& residual_history() const { return residuals; }
+
+    /// Write the telemetry as JSON to \p os; iteration count and state are given by the solver
+    void write_json(std::ostream& os, int iterations, int error, bool converged) const
+    {
+	char buffer[128];
+	os << "{\"iterations\":" << iterations << ",\"error\":" << error << ",\"converged\":" << (converged ? "true" : "false");
+	std::snprintf(buffer, sizeof(buffer), ",\"time\":%.9g", time());
+	os << buffer << ",\"phases\":{";
+	for (int p= 0; p < phase::number; p++) {
+	    std::snprintf(buffer, sizeof(buffer), "%s\"%s\":{\"time\":%.9g,\"count\":%lu}", p ? "," : "",
+			  phase::name(phase::type(p)), phase_time(phase::type(p)), phase_counts[p]);
+	    os << buffer;
+	}
+	os << "},\n\"residuals\":[";
+	for (std::size_t i= 0; i < residuals.size(); i++) {
+	    std::snprintf(buffer, sizeof(buffer), "%s[%d,%.9g,%.17g]", i ? (i % 4 ? "," : ",\n") : "",
+			  residuals[i].iteration, residuals[i].time, residuals[i].resid);
+	    os << buffer;
+	}
+	os << "]}\n";
+    }
+
+  private:
+    double seconds(clock::time_point now) const { return std::chrono::duration<double>(now - since).count(); }
+
+    void stop_phase(clock::time_point now)
+    {
+	const double s= seconds(now);
+	phase_times[active]+= s;
+	elapsed+= s;
+	since= now;
+    }
+
+    double                      phase_times[phase::number];
+    unsigned long               phase_counts[phase::number];
+    std::vector<residual_entry> residuals;
+    bool                        running;
+    phase::type                 active;
+    clock::time_point           since;
+    double                      elapsed;
+};
+
+/// Iteration control that records the times of the solver phases and the residual history
+/** Wraps another iteration type \p Base (e.g. cyclic_iteration) and takes the same constructor arguments.
+    The solvers in ITL mark their phases with telemetry_phase; other iteration types ignore this at no cost.
+    The record is shared between copies of the iteration object, e.g. with the inner iterations of restarted GMRES.
+    Each termination check adds the residual to the history. **/
+template <class Real, class Base= basic_iteration<Real> >
+class telemetry_iteration : public Base, public with_telemetry
+{
+    typedef Base super;
+    typedef telemetry_iteration self;
+  public:
+    /// Constructor, with the arguments of Base (at least initial residual and maximal number of iterations)
+    template <typename R0, typename... Args>
+    telemetry_iteration(const R0& r0, int max_iter, Args&&... args)
+      : super(r0, max_iter, std::forward<Args>(args)...), my_record(new solver_record) {}
+
+    bool finished() { return super::finished(); }
+
+    /// Termination check (timed as phase convergence_check) that adds the residual to the history
+    template <typename T>
+    bool finished(const T& r)
+    {
+	my_record->enter_phase(phase::convergence_check);
+	bool ret= super::finished(r);
+	my_record->add_residual(this->iterations(), double(this->resid()));
+	if (ret)
+	    my_record->stop();
+	return ret;
+    }
+
+    template <class T>
+    int terminate(const T& r) { finished(r); return this->error; }
+
+    self& operator++() { super::operator++(); return *this; } ///< Increment counter
+    self& operator+=(int n) { super::operator+=(n); return *this; } ///< Increment counter by n
+
+    /// Attribute the following work to phase \p p (called by the solvers via telemetry_phase)
+    void enter_phase(phase::type p) { my_record->enter_phase(p); }
+
+    /// Add residual estimate \p r of the current iteration to the history (called by the solvers via telemetry_residual)
+    template <typename T>
+    void add_residual(const T& r)
+    {
+	using std::abs;
+	my_record->add_residual(this->iterations(), double(abs(r)));
+    }
+
+    /// The collected telemetry
+    const solver_record& record() const { return *my_record; }
+
+    /// Remove the collected telemetry, e.g. before reusing the iteration object
+    void clear_record() { my_record->clear(); }
+
+    /// Write the telemetry as JSON to \p os
+    void write_json(std::ostream& os) const
+    {
+	my_record->write_json(os, this->iterations(), this->error, this->is_converged());
+    }
+
+    /// Write the telemetry as JSON to the file \p file_name
+    void write_json(const std::string& file_name) const
+    {
+	std::ofstream os(file_name.c_str());
+	MTL_THROW_IF(!os, mtl::io_error(("Cannot create file " + file_name).c_str()));
+	write_json(os);
+    }
+
+  private:
+    std::shared_ptr<solver_record> my_record;
+};
+
+} // namespace itl
+
+#endif // ITL_TELEMETRY_ITERATION_INCLUDE
@@ -17,6 +17,9 @@
 #include <boost/numeric/itl/iteration/basic_iteration.hpp>
 #include <boost/numeric/itl/iteration/cyclic_iteration.hpp>
 #include <boost/numeric/itl/iteration/noisy_iteration.hpp>
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#  include <boost/numeric/itl/iteration/telemetry_iteration.hpp>
+#endif
 
 #include <boost/numeric/itl/krylov/cg.hpp>
 #include <boost/numeric/itl/krylov/cgs.hpp>
@@ -25,6 +28,10 @@
 #include <boost/numeric/itl/krylov/bicgstab_2.hpp>
 #include <boost/numeric/itl/krylov/bicgstab_ell.hpp>
 #include <boost/numeric/itl/krylov/fsm.hpp>
+#include <boost/numeric/itl/krylov/arnoldi.hpp>
+#include <boost/numeric/itl/krylov/lanczos.hpp>
+#include <boost/numeric/itl/krylov/lobpcg.hpp>
+#include <boost/numeric/itl/krylov/shift_invert.hpp>
 #include <boost/numeric/itl/krylov/idr_s.hpp>
 #include <boost/numeric/itl/krylov/gmres.hpp>
 #include <boost/numeric/itl/krylov/tfqmr.hpp>
@@ -0,0 +1,523 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_ARNOLDI_INCLUDE
+#define ITL_ARNOLDI_INCLUDE
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <complex>
+#include <algorithm>
+
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/concept/magnitude.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/multi_vector.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/operation/dot.hpp>
+#include <boost/numeric/mtl/operation/two_norm.hpp>
+#include <boost/numeric/mtl/operation/resource.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/omp_size_type.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+
+namespace itl {
+
+/// Which part of the spectrum is computed by \ref lanczos and \ref arnoldi
+enum eigen_target {
+    largest_magnitude,  ///< Eigenvalues with largest absolute value
+    smallest_magnitude, ///< Eigenvalues with smallest absolute value (use \ref shift_invert for fast convergence)
+    largest_real,       ///< Eigenvalues with largest real part (largest algebraic in the symmetric case)
+    smallest_real       ///< Eigenvalues with smallest real part (smallest algebraic in the symmetric case)
+};
+
+namespace impl {
+
+    /// Orders indices of Ritz values (wr, wi) such that the wanted come first; conjugate pairs stay adjacent
+    template <typename Real>
+    struct eigen_target_less
+    {
+	eigen_target_less(const std::vector<Real>& wr, const std::vector<Real>& wi, eigen_target which)
+	  : wr(wr), wi(wi), which(which) {}
+
+	Real key(std::size_t i) const
+	{
+	    using std::abs;
+	    switch (which) {
+	      case largest_magnitude:  return -std::sqrt(wr[i] * wr[i] + wi[i] * wi[i]);
+	      case smallest_magnitude: return std::sqrt(wr[i] * wr[i] + wi[i] * wi[i]);
+	      case largest_real:       return -wr[i];
+	      default:                 return wr[i];
+	    }
+	}
+
+	bool operator()(std::size_t i, std::size_t j) const
+	{
+	    Real ki= key(i), kj= key(j);
+	    return ki < kj || (ki == kj && wi[i] > wi[j]);
+	}
+
+	const std::vector<Real>& wr, & wi;
+	eigen_target             which;
+    };
+
+    /// Permutation of the Ritz values (wr, wi) with the wanted ones first
+    template <typename Real>
+    std::vector<std::size_t> eigen_target_order(const std::vector<Real>& wr, const std::vector<Real>& wi, eigen_target which)
+    {
+	std::vector<std::size_t> order(wr.size());
+	for (std::size_t i= 0; i < order.size(); i++)
+	    order[i]= i;
+	std::stable_sort(order.begin(), order.end(), eigen_target_less<Real>(wr, wi, which));
+	return order;
+    }
+
+    /// Eigenvalues (wr + i wi) of the leading m x m block of the upper Hessenberg matrix H (Francis double-shift QR)
+    /** H is not modified. Adapted from EISPACK's hqr. **/
+    template <typename Matrix, typename Real>
+    void hessenberg_eigenvalues(const Matrix& H, std::size_t m, std::vector<Real>& wr, std::vector<Real>& wi)
+    {
+	using std::abs; using std::sqrt;
+	const int n= int(m);
+	wr.assign(m, Real(0)); wi.assign(m, Real(0));
+	if (n == 0) return;
+
+	// 1-based copy to stay close to the classical formulation
+	mtl::mat::dense2D<Real> a(n + 1, n + 1);
+	a= Real(0);
+	Real anorm(0);
+	for (int i= 1; i <= n; i++)
+	    for (int j= std::max(i-1, 1); j <= n; j++) {
+		a(i, j)= H(i-1, j-1);
+		anorm+= abs(a(i, j));
+	    }
+
+	int nn= n, l= 1;
+	Real t(0), p(0), q(0), r(0), s, w, x, y, z;
+	while (nn >= 1) {
+	    int its= 0;
+	    do {
+		for (l= nn; l >= 2; l--) {
+		    s= abs(a(l-1, l-1)) + abs(a(l, l));
+		    if (s == Real(0)) s= anorm;
+		    if (abs(a(l, l-1)) + s == s) {
+			a(l, l-1)= Real(0);
+			break;
+		    }
+		}
+		x= a(nn, nn);
+		if (l == nn) {
+		    wr[nn-1]= x + t; wi[nn-1]= Real(0); nn--;
+		} else {
+		    y= a(nn-1, nn-1);
+		    w= a(nn, nn-1) * a(nn-1, nn);
+		    if (l == nn - 1) {
+			p= Real(0.5) * (y - x);
+			q= p * p + w;
+			z= sqrt(abs(q));
+			x+= t;
+			if (q >= Real(0)) {
+			    z= p + (p >= Real(0) ? z : -z);
+			    wr[nn-2]= wr[nn-1]= x + z;
+			    if (z != Real(0)) wr[nn-1]= x - w / z;
+			    wi[nn-2]= wi[nn-1]= Real(0);
+			} else {
+			    wr[nn-2]= wr[nn-1]= x + p;
+			    wi[nn-2]= z; wi[nn-1]= -z;
+			}
+			nn-= 2;
+		    } else {
+			MTL_THROW_IF(its == 60, mtl::runtime_error("Hessenberg QR iteration does not converge"));
+			if (its == 10 || its == 20 || its == 40) { // exceptional shift
+			    t+= x;
+			    for (int i= 1; i <= nn; i++)
+				a(i, i)-= x;
+			    s= abs(a(nn, nn-1)) + abs(a(nn-1, nn-2));
+			    y= x= Real(0.75) * s;
+			    w= Real(-0.4375) * s * s;
+			}
+			++its;
+			int mm;
+			for (mm= nn - 2; mm >= l; mm--) {
+			    z= a(mm, mm);
+			    r= x - z;
+			    s= y - z;
+			    p= (r * s - w) / a(mm+1, mm) + a(mm, mm+1);
+			    q= a(mm+1, mm+1) - z - r - s;
+			    r= a(mm+2, mm+1);
+			    s= abs(p) + abs(q) + abs(r);
+			    p/= s; q/= s; r/= s;
+			    if (mm == l) break;
+			    Real u= abs(a(mm, mm-1)) * (abs(q) + abs(r)),
+				 v= abs(p) * (abs(a(mm-1, mm-1)) + abs(z) + abs(a(mm+1, mm+1)));
+			    if (u + v == v) break;
+			}
+			for (int i= mm + 2; i <= nn; i++) {
+			    a(i, i-2)= Real(0);
+			    if (i != mm + 2) a(i, i-3)= Real(0);
+			}
+			for (int k= mm; k <= nn - 1; k++) {
+			    if (k != mm) {
+				p= a(k, k-1);
+				q= a(k+1, k-1);
+				r= k != nn - 1 ? a(k+2, k-1) : Real(0);
+				if ((x= abs(p) + abs(q) + abs(r)) != Real(0)) {
+				    p/= x; q/= x; r/= x;
+				}
+			    }
+			    s= sqrt(p * p + q * q + r * r);
+			    if (p < Real(0)) s= -s;
+			    if (s != Real(0)) {
+				if (k == mm) {
+				    if (l != mm)
+					a(k, k-1)= -a(k, k-1);
+				} else
+				    a(k, k-1)= -s * x;
+				p+= s;
+				x= p / s; y= q / s; z= r / s;
+				q/= p; r/= p;
+				for (int j= k; j <= nn; j++) {
+				    p= a(k, j) + q * a(k+1, j);
+				    if (k != nn - 1) {
+					p+= r * a(k+2, j);
+					a(k+2, j)-= p * z;
+				    }
+				    a(k+1, j)-= p * y;
+				    a(k, j)-= p * x;
+				}
+				int mmin= nn < k + 3 ? nn : k + 3;
+				for (int i= l; i <= mmin; i++) {
+				    p= x * a(i, k) + y * a(i, k+1);
+				    if (k != nn - 1) {
+					p+= z * a(i, k+2);
+					a(i, k+2)-= p * r;
+				    }
+				    a(i, k+1)-= p * q;
+				    a(i, k)-= p;
+				}
+			    }
+			}
+		    }
+		}
+	    } while (l < nn - 1);
+	}
+    }
+
+    /// sqrt(a^2 + b^2) without destructive over- or underflow (std::hypot is not available before C++11)
+    template <typename Real>
+    inline Real arnoldi_hypot(Real a, Real b)
+    {
+	using std::abs; using std::sqrt;
+	a= abs(a); b= abs(b);
+	if (a < b)
+	    std::swap(a, b);
+	if (a == Real(0))
+	    return Real(0);
+	Real r= b / a;
+	return a * sqrt(Real(1) + r * r);
+    }
+
+    /// Implicitly shifted QR step with real shift \p mu on the upper Hessenberg m x m matrix H; Q accumulates the rotations
+    template <typename Matrix, typename Real>
+    void hessenberg_single_shift(Matrix& H, Matrix& Q, std::size_t m, Real mu)
+    {
+	using std::abs; using std::sqrt;
+	for (std::size_t k= 0; k + 1 < m; k++) {
+	    Real x= k == 0 ? H(0, 0) - mu : H(k, k-1), y= k == 0 ? H(1, 0) : H(k+1, k-1),
+		 rr= arnoldi_hypot(x, y), c(1), s(0);
+	    if (rr != Real(0))
+		c= x / rr, s= y / rr;
+	    for (std::size_t j= k == 0 ? 0 : k - 1; j < m; j++) {
+		Real a= H(k, j), b= H(k+1, j);
+		H(k, j)= c * a + s * b; H(k+1, j)= c * b - s * a;
+	    }
+	    for (std::size_t i= 0, iend= std::min(k + 3, m); i < iend; i++) {
+		Real a= H(i, k), b= H(i, k+1);
+		H(i, k)= c * a + s * b; H(i, k+1)= c * b - s * a;
+	    }
+	    for (std::size_t i= 0; i < m; i++) {
+		Real a= Q(i, k), b= Q(i, k+1);
+		Q(i, k)= c * a + s * b; Q(i, k+1)= c * b - s * a;
+	    }
+	    if (k > 0)
+		H(k+1, k-1)= Real(0);
+	}
+    }
+
+    /// Implicit double-shift (Francis) QR step with shifts mu and conj(mu) where s = 2 Re(mu) and t = |mu|^2
+    template <typename Matrix, typename Real>
+    void hessenberg_double_shift(Matrix& H, Matrix& Q, std::size_t m, Real s, Real t)
+    {
+	using std::abs; using std::sqrt;
+	Real x= H(0, 0) * H(0, 0) + H(0, 1) * H(1, 0) - s * H(0, 0) + t,
+	     y= H(1, 0) * (H(0, 0) + H(1, 1) - s),
+	     z= m > 2 ? H(1, 0) * H(2, 1) : Real(0);
+
+	for (std::size_t k= 0; k + 1 < m; k++) {
+	    const std::size_t r= std::min(std::size_t(3), m - k);
+	    Real v[3]= {x, y, r == 3 ? z : Real(0)}, sc= abs(v[0]) + abs(v[1]) + abs(v[2]);
+	    if (sc != Real(0)) {
+		v[0]/= sc; v[1]/= sc; v[2]/= sc;   // scaled against under- and overflow
+		Real nrm= sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]), alpha= v[0] > Real(0) ? -nrm : nrm;
+		v[0]-= alpha;
+		Real beta= Real(2) / (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+		for (std::size_t j= k == 0 ? 0 : k - 1; j < m; j++) {
+		    Real d(0);
+		    for (std::size_t l= 0; l < r; l++) d+= v[l] * H(k+l, j);
+		    d*= beta;
+		    for (std::size_t l= 0; l < r; l++) H(k+l, j)-= d * v[l];
+		}
+		for (std::size_t i= 0, iend= std::min(k + 4, m); i < iend; i++) {
+		    Real d(0);
+		    for (std::size_t l= 0; l < r; l++) d+= H(i, k+l) * v[l];
+		    d*= beta;
+		    for (std::size_t l= 0; l < r; l++) H(i, k+l)-= d * v[l];
+		}
+		for (std::size_t i= 0; i < m; i++) {
+		    Real d(0);
+		    for (std::size_t l= 0; l < r; l++) d+= Q(i, k+l) * v[l];
+		    d*= beta;
+		    for (std::size_t l= 0; l < r; l++) Q(i, k+l)-= d * v[l];
+		}
+	    }
+	    if (k + 2 < m) {
+		x= H(k+1, k); y= H(k+2, k); z= k + 3 < m ? H(k+3, k) : Real(0);
+	    }
+	}
+	for (std::size_t j= 0; j < m; j++)   // remove round-off below the sub-diagonal
+	    for (std::size_t i= j + 2; i < m; i++)
+		H(i, j)= Real(0);
+    }
+
+    /// Deterministic pseudo-random vector for restarting after a breakdown
+    template <typename Vector>
+    void arnoldi_random(Vector& v, std::size_t seed)
+    {
+	typedef typename mtl::Collection<Vector>::value_type value_type;
+	unsigned long state= 2463534242ul + 7919ul * seed;
+	for (std::size_t i= 0; i < size(v); i++) {
+	    state= (1103515245ul * state + 12345ul) % 2147483648ul;
+	    v[i]= value_type(double(state) / 2147483648.0 - 0.5);
+	}
+    }
+
+    /// Orthogonalize w against the first j+1 columns of V by modified Gram-Schmidt with one re-orthogonalization
+    /** The coefficients are added to column j of H if \p store is set. **/
+    template <typename MultiVector, typename Vector, typename Matrix>
+    void arnoldi_orthogonalize(const MultiVector& V, std::size_t j, Vector& w, Matrix& H, bool store)
+    {
+	using mtl::dot;
+	for (int pass= 0; pass < 2; pass++)
+	    for (std::size_t i= 0; i <= j; i++) {
+		typename mtl::Collection<Vector>::value_type c= dot(V.vector(i), w);
+		w-= c * V.vector(i);
+		if (store)
+		    H(i, j)+= c;
+	    }
+    }
+
+    /// Extend the Arnoldi factorization A V_k = V_k H_k + f e_k^T to m columns
+    template <typename LinearOperator, typename MultiVector, typename Vector, typename Matrix>
+    void arnoldi_expand(const LinearOperator& A, MultiVector& V, Vector& f, Matrix& H, std::size_t k, std::size_t m)
+    {
+	typedef typename mtl::Collection<Vector>::value_type             value_type;
+	typedef typename mtl::Magnitude<value_type>::type                real;
+	const real eps= std::numeric_limits<real>::epsilon();
+
+	for (std::size_t j= k; j < m; j++) {
+	    for (std::size_t i= 0; i < m; i++)
+		H(i, j)= value_type(0);
+	    if (j > 0) {
+		real beta= two_norm(f), hnorm(0);
+		for (std::size_t i= 0; i < j; i++)
+		    hnorm+= std::abs(H(i, j-1)) * std::abs(H(i, j-1));
+		if (beta <= eps * std::sqrt(hnorm)) { // invariant subspace found: continue with a new direction
+		    arnoldi_random(f, j);
+		    arnoldi_orthogonalize(V, j-1, f, H, false);
+		    H(j, j-1)= value_type(0);
+		    V.vector(j)= f / two_norm(f);
+		} else {
+		    H(j, j-1)= beta;
+		    V.vector(j)= f / beta;
+		}
+	    }
+	    f= A * V.vector(j);
+	    arnoldi_orthogonalize(V, j, f, H, true);
+	}
+    }
+
+    /// Apply the accumulated m x m transformation Q to V: V(:, 0:k+1)= V(:, 0:m) * Q(:, 0:k+1)
+    template <typename MultiVector, typename Matrix>
+    void arnoldi_transform_basis(MultiVector& V, const Matrix& Q, std::size_t k, std::size_t m)
+    {
+	typedef typename mtl::Collection<Matrix>::value_type             value_type;
+	typedef typename mtl::traits::omp_size_type<std::size_t>::type   size_type;
+	const size_type n= size_type(num_rows(V.vector(0))), kk= size_type(k + 1 < m ? k + 1 : m);
+
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+#     endif
+	{
+	    std::vector<value_type> tmp(kk);
+#         ifdef MTL_WITH_OPENMP
+#           pragma omp for
+#         endif
+	    for (size_type i= 0; i < n; i++) {
+		for (size_type j= 0; j < kk; j++) {
+		    value_type s(0);
+		    for (std::size_t l= 0; l < m; l++)
+			s+= V.vector(l)[i] * Q(l, j);
+		    tmp[j]= s;
+		}
+		for (size_type j= 0; j < kk; j++)
+		    V.vector(j)[i]= tmp[j];
+	    }
+	}
+    }
+
+    /// Compress the m-step factorization to k steps; the shifts are the eigenvalues with indices order[k:m]
+    template <typename MultiVector, typename Vector, typename Matrix, typename Real>
+    void arnoldi_restart(MultiVector& V, Vector& f, Matrix& H, std::size_t k, std::size_t m,
+			 const std::vector<Real>& wr, const std::vector<Real>& wi, const std::vector<std::size_t>& order)
+    {
+	if (k == m) // all Ritz values kept, nothing to compress
+	    return;
+	Matrix Q(m, m);
+	Q= Real(1);
+	for (std::size_t i= k; i < m; i++) {
+	    std::size_t o= order[i];
+	    if (wi[o] == Real(0))
+		hessenberg_single_shift(H, Q, m, wr[o]);
+	    else if (wi[o] > Real(0))
+		hessenberg_double_shift(H, Q, m, Real(2) * wr[o], wr[o] * wr[o] + wi[o] * wi[o]);
+	}
+
+	Real beta_k= H(k, k-1), sigma= Q(m-1, k-1);
+	arnoldi_transform_basis(V, Q, k, m);
+	f= beta_k * V.vector(k) + sigma * f;
+	for (std::size_t j= 0; j < k; j++)
+	    for (std::size_t i= k; i < m; i++)
+		H(i, j)= Real(0);
+    }
+
+    /// Number of Ritz values kept on restart: nev, or nev + 1 when nev would split a complex conjugate pair
+    /** The basis has at least nev + 2 vectors (see \ref arnoldi) unless it spans the whole space;
+	only then nev + 1 can be m, all values are kept and the factorization is already invariant. **/
+    template <typename Real>
+    std::size_t arnoldi_kept(std::size_t nev, std::size_t m, const std::vector<Real>& wi, const std::vector<std::size_t>& order)
+    {
+	std::size_t k= nev;
+	if (k < m && wi[order[k-1]] != Real(0) && wi[order[k-1]] == -wi[order[k]])
+	    k++;
+	return k;
+    }
+
+    /// Setup of the basis and the check of sizes common to \ref lanczos and \ref arnoldi
+    template <typename MultiVector, typename Vector>
+    std::size_t arnoldi_setup(MultiVector& V, Vector& f, const Vector& v0, std::size_t nev, std::size_t ncv)
+    {
+	const std::size_t n= size(v0);
+	std::size_t m= ncv == 0 ? std::max(2 * nev + 1, std::size_t(20)) : ncv;
+	if (m > n) m= n;
+	MTL_THROW_IF(nev == 0 || nev >= m, mtl::range_error("Number of eigenvalues must be positive and less than the basis size"));
+	MTL_THROW_IF(two_norm(v0) == 0, mtl::domain_error("Start vector must not be zero"));
+
+	Vector tmp(resource(v0));
+	V.change_dim(n, m);
+	f.change_dim(n);
+	tmp= v0 / two_norm(v0);
+	V.vector(0)= tmp;
+	return m;
+    }
+
+} // namespace impl
+
+/// Implicitly restarted Arnoldi method for \p nev eigenvalues of the (real) linear operator A
+/** The eigenvalues are returned in the complex vector \p lambda (ordered from the most wanted on)
+    and an orthonormal basis of the corresponding invariant subspace in the \p nk columns of \p Q with
+    A * Q = Q * H + r e_nk^T where H is the nk x nk upper Hessenberg matrix. nk is nev or nev + 1
+    if a complex conjugate pair would otherwise be split.
+    \p v0 is the start vector, \p ncv the basis size (by default max(2 nev + 1, 20), at least nev + 2
+    so that a conjugate pair can be completed, at most the dimension of A).
+    The basis is kept in a multi_vector so that the memory is O(n ncv).
+    Each restart applies the unwanted Ritz values as exact shifts (real or complex conjugate double shifts).
+    The iteration counts the restarts and is finished when |r| is below the tolerance relative to the
+    largest modulus of the wanted eigenvalues. A can be any linear operator including \ref shift_invert. **/
+template <typename LinearOperator, typename Vector, typename VectorLambda, typename Matrix, typename Iteration>
+int arnoldi(const LinearOperator& A, const Vector& v0, std::size_t nev, VectorLambda& lambda,
+	    mtl::mat::multi_vector<Vector>& Q, Matrix& H, Iteration& iter,
+	    eigen_target which= largest_magnitude, std::size_t ncv= 0)
+{
+    mtl::vampir_trace<7012> tracer;
+    using std::abs; using std::sqrt;
+    typedef typename mtl::Collection<Vector>::value_type         value_type;
+    typedef typename mtl::Magnitude<value_type>::type            real;
+    typedef typename mtl::Collection<VectorLambda>::value_type   lambda_type;
+
+    mtl::mat::multi_vector<Vector> V;
+    Vector                         f(resource(v0));
+    const std::size_t              m= impl::arnoldi_setup(V, f, v0, nev, ncv == 0 ? 0 : std::max(ncv, nev + 2));
+    mtl::mat::dense2D<real>        Hm(m, m);
+    std::vector<real>              wr, wi;
+    std::vector<std::size_t>       order;
+    std::size_t                    k= nev;
+    const real                     eps23= std::pow(std::numeric_limits<real>::epsilon(), real(2) / real(3));
+
+    Hm= real(0);
+    impl::arnoldi_expand(A, V, f, Hm, 0, m);
+    for (;;) {
+	impl::hessenberg_eigenvalues(Hm, m, wr, wi);
+	order= impl::eigen_target_order(wr, wi, which);
+	k= impl::arnoldi_kept(nev, m, wi, order);
+	impl::arnoldi_restart(V, f, Hm, k, m, wr, wi, order);
+
+	real scale= eps23;
+	for (std::size_t i= 0; i < k; i++)
+	    scale= std::max(scale, sqrt(wr[order[i]] * wr[order[i]] + wi[order[i]] * wi[order[i]]));
+	if (iter.finished(real(two_norm(f) / scale)))
+	    break;
+	++iter;
+	impl::arnoldi_expand(A, V, f, Hm, k, m);
+    }
+
+    impl::hessenberg_eigenvalues(Hm, k, wr, wi);
+    order= impl::eigen_target_order(wr, wi, which);
+    lambda.change_dim(nev);
+    for (std::size_t i= 0; i < nev; i++)
+	lambda[i]= lambda_type(std::complex<real>(wr[order[i]], wi[order[i]]));
+
+    Q.change_dim(size(v0), k);
+    for (std::size_t j= 0; j < k; j++)
+	Q.vector(j)= V.vector(j);
+    H.change_dim(k, k);
+    for (std::size_t i= 0; i < k; i++)
+	for (std::size_t j= 0; j < k; j++)
+	    H(i, j)= Hm(i, j);
+    return iter;
+}
+
+/// Implicitly restarted Arnoldi method for \p nev eigenvalues of the (real) linear operator A without the invariant subspace
+/** For details see the version with invariant subspace. **/
+template <typename LinearOperator, typename Vector, typename VectorLambda, typename Iteration>
+int arnoldi(const LinearOperator& A, const Vector& v0, std::size_t nev, VectorLambda& lambda,
+	    Iteration& iter, eigen_target which= largest_magnitude, std::size_t ncv= 0)
+{
+    typedef typename mtl::Magnitude<typename mtl::Collection<Vector>::value_type>::type real;
+    mtl::mat::multi_vector<Vector> Q;
+    mtl::mat::dense2D<real>        H(0, 0);
+    return arnoldi(A, v0, nev, lambda, Q, H, iter, which, ncv);
+}
+
+} // namespace itl
+
+#endif // ITL_ARNOLDI_INCLUDE
@@ -16,6 +16,7 @@
 #include <complex>
 #include <boost/numeric/itl/itl_fwd.hpp>
 #include <boost/numeric/itl/krylov/base_solver.hpp>
+#include <boost/numeric/itl/iteration/solver_phase.hpp>
 
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/operation/conj.hpp>
@@ -35,16 +36,20 @@ int bicg(const LinearOperator &A, Vector &x, const Vector &b,
     using mtl::conj;
     typedef typename mtl::Collection<Vector>::value_type Scalar;
     Scalar     rho_1(0), rho_2(0), alpha(0), beta(0);
+    telemetry_phase(iter, phase::setup);
     Vector     r(b - A * x), z(resource(x)), p(resource(x)), q(resource(x)),
  	       r_tilde(r), z_tilde(resource(x)), p_tilde(resource(x)), q_tilde(resource(x));
 
     while ( ! iter.finished(r)) {
 	++iter;
+	telemetry_phase(iter, phase::preconditioner);
 	z= solve(M, r);
 	z_tilde= adjoint_solve(M, r_tilde);
+	telemetry_phase(iter, phase::orthogonalization);
 	rho_1= dot(z_tilde, z);
 
 	if (rho_1 == 0.) return iter.fail(2, "bicg breakdown");
+	telemetry_phase(iter, phase::vector_update);
 	if (iter.first()) {
 	    p= z;
 	    p_tilde= z_tilde;
@@ -54,10 +59,13 @@ int bicg(const LinearOperator &A, Vector &x, const Vector &b,
 	    p_tilde= z_tilde + conj(beta) * p_tilde;
 	}
 
+	telemetry_phase(iter, phase::spmv);
 	q= A * p;
 	q_tilde= adjoint(A) * p_tilde;
+	telemetry_phase(iter, phase::orthogonalization);
 	alpha= rho_1 / dot(p_tilde, q);
 
+	telemetry_phase(iter, phase::vector_update);
 	x+= alpha * p;
 	r-= alpha * q;
 	r_tilde-= conj(alpha) * q_tilde;
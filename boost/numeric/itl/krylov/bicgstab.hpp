@@ -16,10 +16,12 @@
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
 #include <boost/numeric/mtl/operation/resource.hpp>
+#include <boost/numeric/mtl/operation/lazy.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 #include <boost/numeric/itl/utility/exception.hpp>
 #include <boost/numeric/itl/krylov/base_solver.hpp>
+#include <boost/numeric/itl/iteration/solver_phase.hpp>
 
 namespace itl {
 
@@ -32,19 +34,23 @@ int bicgstab(const LinearOperator& A, HilbertSpaceX& x, const HilbertSpaceB& b,
   typedef typename mtl::Collection<HilbertSpaceX>::value_type Scalar;
   typedef HilbertSpaceX                                       Vector;
   mtl::vampir_trace<7004> tracer;
+  using mtl::lazy;
 
-  Scalar     rho_1(0), rho_2(0), alpha(0), beta(0), gamma, omega(0);
+  Scalar     rho_1(0), rho_2(0), alpha(0), beta(0), gamma, omega(0), ts, tt;
   Vector     p(resource(x)), phat(resource(x)), s(resource(x)), shat(resource(x)), 
              t(resource(x)), v(resource(x)), r(resource(x)), rtilde(resource(x));
 
+  telemetry_phase(iter, phase::setup);
   r = b - A * x;
   rtilde = r;
 
   while (! iter.finished(r)) {
     ++iter;
+    telemetry_phase(iter, phase::orthogonalization);
     rho_1 = dot(rtilde, r);
     MTL_THROW_IF(rho_1 == 0.0, unexpected_orthogonality());
 
+    telemetry_phase(iter, phase::vector_update);
     if (iter.first())
       p = r;
     else {
@@ -52,12 +58,14 @@ int bicgstab(const LinearOperator& A, HilbertSpaceX& x, const HilbertSpaceB& b,
       beta = (rho_1 / rho_2) * (alpha / omega);
       p = r + beta * (p - omega * v);
     }
+    telemetry_phase(iter, phase::preconditioner);
     phat = solve(M, p);
-    v = A * phat;
-
-    gamma = dot(rtilde, v);
+    // v = A * phat; gamma = dot(rtilde, v);
+    telemetry_phase(iter, phase::spmv);
+    (lazy(v)= A * phat) || (lazy(gamma)= lazy_dot(rtilde, v));
     MTL_THROW_IF(gamma == 0.0, unexpected_orthogonality());
 
+    telemetry_phase(iter, phase::vector_update);
     alpha = rho_1 / gamma;
     s = r - alpha * v;
     
@@ -65,12 +73,15 @@ int bicgstab(const LinearOperator& A, HilbertSpaceX& x, const HilbertSpaceB& b,
       x += alpha * phat;
       break;
     }
+    telemetry_phase(iter, phase::preconditioner);
     shat = solve(M, s);
-    t = A * shat;
-    omega = dot(t, s) / dot(t, t);
+    // t = A * shat; omega = dot(t, s) / dot(t, t);
+    telemetry_phase(iter, phase::spmv);
+    (lazy(t)= A * shat) || (lazy(ts)= lazy_dot(t, s)) || (lazy(tt)= lazy_unary_dot(t));
+    omega = ts / tt;
 
-    x += omega * shat + alpha * phat;
-    r = s - omega * t;
+    telemetry_phase(iter, phase::vector_update);
+    (lazy(x)+= omega * shat + alpha * phat) || (lazy(r)= s - omega * t);
 
     rho_2 = rho_1;    
   }
@@ -23,6 +23,7 @@
 #include <boost/numeric/itl/pc/identity.hpp>
 #include <boost/numeric/itl/pc/is_identity.hpp>
 #include <boost/numeric/itl/krylov/base_solver.hpp>
+#include <boost/numeric/itl/iteration/solver_phase.hpp>
 
 #include <boost/numeric/mtl/operation/dot.hpp>
 #include <boost/numeric/mtl/operation/unary_dot.hpp>
@@ -49,19 +50,23 @@ int cg(const LinearOperator& A, HilbertSpaceX& x, const HilbertSpaceB& b,
     Scalar rho(0), rho_1(0), alpha(0), alpha_1(0);
     Vector p(resource(x)), q(resource(x)), r(resource(x)), z(resource(x));
   
+    telemetry_phase(iter, phase::setup);
     r = b - A*x;
     rho = dot(r, r);
     while (! iter.finished(Real(sqrt(abs(rho))))) {
 	++iter;
+	telemetry_phase(iter, phase::vector_update);
 	if (iter.first())
 	    p = r;
 	else 
 	    p = r + (rho / rho_1) * p;	   
 
 	// q = A * p; alpha = rho / dot(p, q);
+	telemetry_phase(iter, phase::spmv);
 	(lazy(q)= A * p) || (lazy(alpha_1)= lazy_dot(p, q));
 	alpha= rho / alpha_1;
 	
+	telemetry_phase(iter, phase::vector_update);
 	x += alpha * p;
 	rho_1 = rho;
 	(lazy(r) -= alpha * q) || (lazy(rho) = lazy_unary_dot(r));
@@ -89,20 +94,25 @@ int cg(const LinearOperator& A, HilbertSpaceX& x, const HilbertSpaceB& b,
     Scalar rho(0), rho_1(0), rr, alpha(0), alpha_1;
     Vector p(resource(x)), q(resource(x)), r(resource(x)), z(resource(x));
   
+    telemetry_phase(iter, phase::setup);
     r = b - A*x;
     rr = dot(r, r);
     while (! iter.finished(Real(sqrt(abs(rr))))) {
 	++iter;
+	telemetry_phase(iter, phase::preconditioner);
 	(lazy(z)= solve(L, r)) || (lazy(rho)= lazy_dot(r, z));
 
+	telemetry_phase(iter, phase::vector_update);
 	if (iter.first())
 	    p = z;
 	else 
 	    p = z + (rho / rho_1) * p;
 	
+	telemetry_phase(iter, phase::spmv);
 	(lazy(q)= A * p) || (lazy(alpha_1)= lazy_dot(p, q));
 	alpha= rho / alpha_1;
       
+	telemetry_phase(iter, phase::vector_update);
 	x += alpha * p;
 	rho_1 = rho;
 	(lazy(r) -= alpha * q) || (lazy(rr) = lazy_unary_dot(r));
@@ -19,6 +19,7 @@
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 #include <boost/numeric/itl/krylov/base_solver.hpp>
+#include <boost/numeric/itl/iteration/solver_phase.hpp>
 
 namespace itl {
 
@@ -31,15 +32,18 @@ int cgs(const LinearOperator &A, Vector &x, const Vector &b,
     mtl::vampir_trace<7007> tracer;
     typedef typename mtl::Collection<Vector>::value_type Scalar;
     Scalar     rho_1(0), rho_2(0), alpha(0), beta(0);
+    telemetry_phase(iter, phase::setup);
     Vector     p(resource(x)), phat(resource(x)), q(resource(x)), qhat(resource(x)), vhat(resource(x)),
 	       u(resource(x)), uhat(resource(x)), r(b - A * x), rtilde= r;
 
     while (! iter.finished(r)) {
 	++iter;
+	telemetry_phase(iter, phase::orthogonalization);
 	rho_1= dot(rtilde, r);
 
 	if (rho_1 == 0.) iter.fail(2, "cgs breakdown");
 
+	telemetry_phase(iter, phase::vector_update);
 	if (iter.first())
 	    p= u= r;
 	else {
@@ -48,15 +52,24 @@ int cgs(const LinearOperator &A, Vector &x, const Vector &b,
 	    p= u + beta * (q + beta * p);
 	}
 
-        vhat= A * Vector(solve(M, p));
+	telemetry_phase(iter, phase::preconditioner);
+	phat= solve(M, p);
+	telemetry_phase(iter, phase::spmv);
+        vhat= A * phat;
+	telemetry_phase(iter, phase::orthogonalization);
 	alpha = rho_1 / dot(rtilde, vhat);
+	telemetry_phase(iter, phase::vector_update);
 	q= u - alpha * vhat;
 
 	u+= q;
+	telemetry_phase(iter, phase::preconditioner);
 	uhat= solve(M, u);
 	
+	telemetry_phase(iter, phase::vector_update);
 	x+= alpha * uhat;
+	telemetry_phase(iter, phase::spmv);
 	qhat= A * uhat;
+	telemetry_phase(iter, phase::vector_update);
 	r-= alpha * qhat;
 
 	rho_2= rho_1;
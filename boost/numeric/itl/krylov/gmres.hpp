@@ -27,6 +27,7 @@
 #include <boost/numeric/mtl/utility/irange.hpp>
 
 #include <boost/numeric/itl/krylov/base_solver.hpp>
+#include <boost/numeric/itl/iteration/solver_phase.hpp>
 #include <boost/numeric/itl/pc/identity.hpp>
 
 namespace itl {
@@ -47,6 +48,7 @@ int gmres_full(const Matrix &A, Vector &x, const Vector &b,
     const Scalar                zero= math::zero(Scalar());
     Scalar                      rho, nu, hr;
     Size                        k, kmax(std::min(size(x), Size(iter.max_iterations() - iter.iterations())));
+    telemetry_phase(iter, phase::setup);
     Vector                      r0(b - A *x), r(solve(L,r0)), va(resource(x)), va0(resource(x)), va00(resource(x));
     mtl::mat::multi_vector<Vector>   V(Vector(resource(x), zero), kmax+1); 
     mtl::dense_vector<Scalar>   s(kmax+1, zero), c(kmax+1, zero), g(kmax+1, zero), y(kmax, zero);  // replicated in distributed solvers 
@@ -61,8 +63,13 @@ int gmres_full(const Matrix &A, Vector &x, const Vector &b,
 
     // GMRES iteration
     for (k= 0; k < kmax ; ++k, ++iter) {
-        va0= A * Vector(solve(R, V.vector(k)));
+	telemetry_phase(iter, phase::preconditioner);
+	va00= solve(R, V.vector(k));
+	telemetry_phase(iter, phase::spmv);
+        va0= A * va00;
+	telemetry_phase(iter, phase::preconditioner);
         V.vector(k+1)= va= solve(L,va0);
+	telemetry_phase(iter, phase::orthogonalization);
 	// orth(V, V[k+1], false); 
         // modified Gram Schmidt method
         for (Size j= 0; j < k+1; j++) {
@@ -81,6 +88,7 @@ int gmres_full(const Matrix &A, Vector &x, const Vector &b,
             V.vector(k+1)*= 1. / H[k+1][k];
 
         // k Given's rotations
+	telemetry_phase(iter, phase::vector_update);
 	for(Size i= 0; i < k; i++)
 	    mtl::mat::givens<mtl::mat::dense2D<Scalar> >(H, H[i][k-1], H[i+1][k-1]).trafo(i);
 	
@@ -93,12 +101,14 @@ int gmres_full(const Matrix &A, Vector &x, const Vector &b,
  	    mtl::vec::givens<mtl::vec::dense_vector<Scalar> >(g, c[k], s[k]).trafo(k);
         }
 	rho= abs(g[k+1]);
+	telemetry_residual(iter, rho);
     }
     
     //reduce k, to get regular matrix
     while (k > 0 && abs(g[k-1])<= iter.atol()) k--;
 
     // iteration is finished -> compute x: solve H*y=g as far as rank of H allows
+    telemetry_phase(iter, phase::vector_update);
     irange                  range(k);
     for (; !range.empty(); --range) {
 	try {
@@ -114,6 +124,7 @@ int gmres_full(const Matrix &A, Vector &x, const Vector &b,
         return iter.fail(2, "GMRES did not find any direction to correct x");
     x+= Vector(solve(R, Vector(V.vector(range)*y[range])));
     
+    telemetry_phase(iter, phase::spmv);
     r= b - A*x;
     return iter.terminate(r);
 }
@@ -0,0 +1,140 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_LANCZOS_INCLUDE
+#define ITL_LANCZOS_INCLUDE
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/concept/magnitude.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/multi_vector.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/operation/two_norm.hpp>
+#include <boost/numeric/mtl/operation/resource.hpp>
+#include <boost/numeric/mtl/operation/eigenvalue_symmetric.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/itl/krylov/arnoldi.hpp>
+
+namespace itl {
+
+namespace impl {
+
+    /// Eigenpairs of the leading k x k block of the tridiagonal Lanczos matrix T (symmetrized from its lower part)
+    template <typename Matrix, typename Real>
+    void lanczos_ritz(const Matrix& T, std::size_t k, std::vector<Real>& theta, Matrix& S)
+    {
+	Matrix                                                   Tk(k, k);
+	mtl::vec::dense_vector<Real, mtl::vec::parameters<> >    l(k);
+	Tk= Real(0);
+	for (std::size_t i= 0; i < k; i++) {
+	    Tk(i, i)= T(i, i);
+	    if (i + 1 < k)
+		Tk(i+1, i)= Tk(i, i+1)= T(i+1, i);
+	}
+	mtl::mat::eigen_symmetric(Tk, l, S);
+	theta.resize(k);
+	for (std::size_t i= 0; i < k; i++)
+	    theta[i]= l[i];
+    }
+
+    /// Keep the Lanczos matrix exactly symmetric tridiagonal after shifts
+    template <typename Matrix>
+    void lanczos_clean(Matrix& T, std::size_t m)
+    {
+	typedef typename mtl::Collection<Matrix>::value_type value_type;
+	for (std::size_t j= 0; j < m; j++)
+	    for (std::size_t i= 0; i < m; i++)
+		if (i > j + 1 || j > i + 1)
+		    T(i, j)= value_type(0);
+		else if (j == i + 1)
+		    T(i, j)= T(j, i);
+    }
+
+} // namespace impl
+
+/// Implicitly restarted Lanczos method for \p nev eigenpairs of the symmetric (real) linear operator A
+/** The eigenvalues are returned in \p lambda (ordered from the most wanted on) and the eigenvectors
+    in the columns of the multi_vector \p X.
+    \p v0 is the start vector, \p ncv the basis size (by default max(2 nev + 1, 20)).
+    The basis is kept in a multi_vector and fully re-orthogonalized so that the memory is O(n ncv)
+    and no spurious copies of eigenvalues appear.
+    Each restart applies the unwanted Ritz values as exact shifts to the tridiagonal matrix.
+    The iteration counts the restarts and is finished when all wanted Ritz pairs (theta, x)
+    satisfy |A x - theta x| <= tol * |theta|. A can be any linear operator including \ref shift_invert. **/
+template <typename LinearOperator, typename Vector, typename VectorLambda, typename Iteration>
+int lanczos(const LinearOperator& A, const Vector& v0, std::size_t nev, VectorLambda& lambda,
+	    mtl::mat::multi_vector<Vector>& X, Iteration& iter,
+	    eigen_target which= largest_magnitude, std::size_t ncv= 0)
+{
+    mtl::vampir_trace<7011> tracer;
+    using std::abs;
+    typedef typename mtl::Collection<Vector>::value_type         value_type;
+    typedef typename mtl::Magnitude<value_type>::type            real;
+
+    mtl::mat::multi_vector<Vector> V;
+    Vector                         f(resource(v0));
+    const std::size_t              m= impl::arnoldi_setup(V, f, v0, nev, ncv);
+    mtl::mat::dense2D<real>        T(m, m), S(0, 0);
+    std::vector<real>              theta, zero(m, real(0));
+    std::vector<std::size_t>       order;
+    const real                     eps23= std::pow(std::numeric_limits<real>::epsilon(), real(2) / real(3));
+
+    T= real(0);
+    impl::arnoldi_expand(A, V, f, T, 0, m);
+    for (;;) {
+	impl::lanczos_ritz(T, m, theta, S);
+	order= impl::eigen_target_order(theta, zero, which);
+	impl::arnoldi_restart(V, f, T, nev, m, theta, zero, order);
+	impl::lanczos_clean(T, m);
+
+	// Ritz estimates |f| |e_k^T s_i| on the compressed factorization
+	impl::lanczos_ritz(T, nev, theta, S);
+	real beta= two_norm(f), resid(0);
+	for (std::size_t i= 0; i < nev; i++)
+	    resid= std::max(resid, beta * abs(S(nev-1, i)) / std::max(abs(theta[i]), eps23));
+	if (iter.finished(resid))
+	    break;
+	++iter;
+	impl::arnoldi_expand(A, V, f, T, nev, m);
+    }
+
+    order= impl::eigen_target_order(theta, std::vector<real>(nev, real(0)), which);
+    lambda.change_dim(nev);
+    X.change_dim(size(v0), nev);
+    for (std::size_t i= 0; i < nev; i++) {
+	std::size_t o= order[i];
+	lambda[i]= theta[o];
+	X.vector(i)= S(0, o) * V.vector(0);
+	for (std::size_t l= 1; l < nev; l++)
+	    X.vector(i)+= S(l, o) * V.vector(l);
+    }
+    return iter;
+}
+
+/// Implicitly restarted Lanczos method for \p nev eigenvalues of the symmetric (real) linear operator A
+/** For details see the version with eigenvectors. **/
+template <typename LinearOperator, typename Vector, typename VectorLambda, typename Iteration>
+int lanczos(const LinearOperator& A, const Vector& v0, std::size_t nev, VectorLambda& lambda,
+	    Iteration& iter, eigen_target which= largest_magnitude, std::size_t ncv= 0)
+{
+    mtl::mat::multi_vector<Vector> X;
+    return lanczos(A, v0, nev, lambda, X, iter, which, ncv);
+}
+
+} // namespace itl
+
+#endif // ITL_LANCZOS_INCLUDE
@@ -0,0 +1,337 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_LOBPCG_INCLUDE
+#define ITL_LOBPCG_INCLUDE
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/concept/magnitude.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/compressed2D.hpp>
+#include <boost/numeric/mtl/matrix/multi_vector.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/operation/dot.hpp>
+#include <boost/numeric/mtl/operation/resource.hpp>
+#include <boost/numeric/mtl/operation/eigenvalue_symmetric.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/omp_size_type.hpp>
+#include <boost/numeric/mtl/utility/tag.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/itl/pc/identity.hpp>
+
+namespace itl {
+
+namespace impl {
+
+    /// Stands for the identity as mass matrix in the standard eigenvalue problem
+    struct lobpcg_identity {};
+
+    /// Y(:, j)= A * X(:, j) for j in [first, last), generic: one product per column
+    template <typename LinearOperator, typename MultiVector>
+    void lobpcg_mult(const LinearOperator& A, const MultiVector& X, MultiVector& Y, std::size_t first, std::size_t last)
+    {
+	for (std::size_t j= first; j < last; j++)
+	    Y.vector(j)= A * X.vector(j);
+    }
+
+    template <typename MultiVector>
+    void lobpcg_mult(const lobpcg_identity&, const MultiVector& X, MultiVector& Y, std::size_t first, std::size_t last)
+    {
+	for (std::size_t j= first; j < last; j++)
+	    Y.vector(j)= X.vector(j);
+    }
+
+    /// Sparse matrix times block of vectors for row-major CRS: each row of A is traversed once for all columns
+    template <typename Value, typename Parameters, typename MultiVector>
+    void lobpcg_mult(const mtl::mat::compressed2D<Value, Parameters>& A, const MultiVector& X, MultiVector& Y,
+		     std::size_t first, std::size_t last, boost::mpl::true_)
+    {
+	typedef typename mtl::Collection<MultiVector>::value_type                                             value_type;
+	typedef typename mtl::traits::omp_size_type<typename mtl::Collection<mtl::mat::compressed2D<Value, Parameters> >::size_type>::type size_type;
+	const std::size_t           nb= last - first;
+	std::vector<const value_type*> x(nb);
+	std::vector<value_type*>    y(nb);
+	for (std::size_t j= 0; j < nb; j++) {
+	    x[j]= &X.vector(first + j)[0];
+	    y[j]= &Y.vector(first + j)[0];
+	}
+	const size_type nr= size_type(num_rows(A));
+
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+#     endif
+	{
+	    std::vector<value_type> tmp(nb);
+#         ifdef MTL_WITH_OPENMP
+#           pragma omp for
+#         endif
+	    for (size_type i= 0; i < nr; i++) {
+		std::fill(tmp.begin(), tmp.end(), value_type(0));
+		for (size_type k= A.ref_major()[i], kend= A.ref_major()[i+1]; k < kend; k++) {
+		    const value_type a= A.data[k];
+		    const size_type  c= A.ref_minor()[k];
+		    for (std::size_t j= 0; j < nb; j++)
+			tmp[j]+= a * x[j][c];
+		}
+		for (std::size_t j= 0; j < nb; j++)
+		    y[j][i]= tmp[j];
+	    }
+	}
+    }
+
+    template <typename Value, typename Parameters, typename MultiVector>
+    void lobpcg_mult(const mtl::mat::compressed2D<Value, Parameters>& A, const MultiVector& X, MultiVector& Y,
+		     std::size_t first, std::size_t last, boost::mpl::false_)
+    {
+	for (std::size_t j= first; j < last; j++)
+	    Y.vector(j)= A * X.vector(j);
+    }
+
+    template <typename Value, typename Parameters, typename MultiVector>
+    void lobpcg_mult(const mtl::mat::compressed2D<Value, Parameters>& A, const MultiVector& X, MultiVector& Y,
+		     std::size_t first, std::size_t last)
+    {
+	mtl::vampir_trace<3075> tracer;
+	lobpcg_mult(A, X, Y, first, last,
+		    boost::mpl::bool_<boost::is_same<typename Parameters::orientation, mtl::tag::row_major>::value>());
+    }
+
+    /// G(i, j)= dot(X(:, i), Y(:, j)) for i, j in [0, r), symmetrized
+    template <typename MultiVector, typename Matrix>
+    void lobpcg_gram(const MultiVector& X, const MultiVector& Y, std::size_t r, Matrix& G)
+    {
+	using mtl::dot;
+	for (std::size_t i= 0; i < r; i++)
+	    for (std::size_t j= i; j < r; j++) {
+		typename mtl::Collection<Matrix>::value_type gij= dot(X.vector(i), Y.vector(j)),
+		                                             gji= dot(X.vector(j), Y.vector(i));
+		G(i, j)= G(j, i)= (gij + gji) / 2;
+	    }
+    }
+
+    /// Rayleigh-Ritz on span(S(:, 0:r)): smallest k Ritz values in theta and coefficients in C (r x k)
+    /** The Gram matrix of the mass matrix is diagonalized and directions with relative weight below
+	\p drop are removed, i.e. linear dependencies in the basis are tolerated.
+	Returns false if less than k independent directions remain. **/
+    template <typename Matrix, typename Vector, typename Real>
+    bool lobpcg_rayleigh_ritz(const Matrix& GA, const Matrix& GB, std::size_t k, Vector& theta, Matrix& C, Real drop)
+    {
+	using std::sqrt;
+	const std::size_t r= num_rows(GA);
+	Matrix U(r, r), Y(0, 0);
+	Vector d(r), mu(0);
+	mtl::mat::eigen_symmetric(GB, d, U);
+
+	std::size_t first= 0;
+	while (first < r && d[first] <= drop * d[r-1])
+	    first++;
+	const std::size_t q= r - first;
+	if (q < k)
+	    return false;
+
+	Matrix Z(r, q), T(r, q), H(q, q);
+	for (std::size_t i= 0; i < r; i++)
+	    for (std::size_t j= 0; j < q; j++)
+		Z(i, j)= U(i, first + j) / sqrt(d[first + j]);
+	T= GA * Z;
+	H= trans(Z) * T;
+	for (std::size_t i= 0; i < q; i++)
+	    for (std::size_t j= 0; j < i; j++)
+		H(i, j)= H(j, i)= (H(i, j) + H(j, i)) / 2;
+	mtl::mat::eigen_symmetric(H, mu, Y);
+
+	theta.change_dim(k);
+	C.change_dim(r, k);
+	for (std::size_t j= 0; j < k; j++) {
+	    theta[j]= mu[j];
+	    for (std::size_t i= 0; i < r; i++) {
+		Real s(0);
+		for (std::size_t l= 0; l < q; l++)
+		    s+= Z(i, l) * Y(l, j);
+		C(i, j)= s;
+	    }
+	}
+	return true;
+    }
+
+    /// Replace the blocks [0, k) by S(:, 0:r) * C and [2k, 3k) by S(:, k:r) * C(k:r, :), row by row in place
+    template <typename MultiVector, typename Matrix>
+    void lobpcg_update(MultiVector& S, const Matrix& C, std::size_t k, std::size_t r)
+    {
+	typedef typename mtl::Collection<MultiVector>::value_type        value_type;
+	typedef typename mtl::traits::omp_size_type<std::size_t>::type   size_type;
+	const size_type n= size_type(num_rows(S.vector(0)));
+	std::vector<value_type*> s(r > k ? 3 * k : k);
+	for (std::size_t j= 0; j < s.size(); j++)
+	    s[j]= &S.vector(j)[0];
+	value_type** sp= &s[0];
+
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+#     endif
+	{
+	    std::vector<value_type> row(r), p(k);
+#         ifdef MTL_WITH_OPENMP
+#           pragma omp for
+#         endif
+	    for (size_type i= 0; i < n; i++) {
+		for (std::size_t l= 0; l < r; l++)
+		    row[l]= sp[l][i];
+		for (std::size_t j= 0; j < k; j++) {
+		    value_type x(0), y(0);
+		    for (std::size_t l= 0; l < k; l++)
+			x+= row[l] * C(l, j);
+		    for (std::size_t l= k; l < r; l++)
+			y+= row[l] * C(l, j);
+		    sp[j][i]= x + y;
+		    p[j]= y;
+		}
+		if (r > k)
+		    for (std::size_t j= 0; j < k; j++)
+			sp[2 * k + j][i]= p[j];
+	    }
+	}
+    }
+
+    /// Scale column j of S, AS and BS such that it has unit B-norm; returns false if the norm vanishes
+    template <typename MultiVector>
+    bool lobpcg_normalize(MultiVector& S, MultiVector& AS, MultiVector& BS, std::size_t j)
+    {
+	using std::sqrt; using std::abs; using mtl::dot;
+	typedef typename mtl::Magnitude<typename mtl::Collection<MultiVector>::value_type>::type real;
+	real nrm= sqrt(abs(dot(S.vector(j), BS.vector(j))));
+	if (nrm == real(0))
+	    return false;
+	S.vector(j)/= nrm; AS.vector(j)/= nrm; BS.vector(j)/= nrm;
+	return true;
+    }
+
+    template <typename LinearOperatorA, typename LinearOperatorB, typename Vector, typename VectorLambda,
+	      typename Preconditioner, typename Iteration>
+    int lobpcg(const LinearOperatorA& A, const LinearOperatorB& B, mtl::mat::multi_vector<Vector>& X,
+	       VectorLambda& lambda, const Preconditioner& P, Iteration& iter)
+    {
+	mtl::vampir_trace<7013> tracer;
+	using std::abs; using std::sqrt;
+	typedef typename mtl::Collection<Vector>::value_type           value_type;
+	typedef typename mtl::Magnitude<value_type>::type              real;
+	typedef mtl::mat::dense2D<real>                                matrix_type;
+	typedef mtl::vec::dense_vector<real, mtl::vec::parameters<> >  vector_type;
+
+	const std::size_t n= num_rows(X), k= num_cols(X);
+	MTL_THROW_IF(k == 0 || 3 * k > n, mtl::range_error("Block size must be positive and at most a third of the dimension"));
+
+	const real        drop= 1000 * std::numeric_limits<real>::epsilon();
+	mtl::mat::multi_vector<Vector> S(X.vector(0), 3 * k), AS(X.vector(0), 3 * k), BS(X.vector(0), 3 * k);
+	matrix_type       GA(k, k), GB(k, k), C(0, 0);
+	vector_type       theta(k);
+
+	// Rayleigh-Ritz on the start block
+	for (std::size_t j= 0; j < k; j++)
+	    S.vector(j)= X.vector(j);
+	lobpcg_mult(A, S, AS, 0, k);
+	lobpcg_mult(B, S, BS, 0, k);
+	lobpcg_gram(S, AS, k, GA);
+	lobpcg_gram(S, BS, k, GB);
+	MTL_THROW_IF(!lobpcg_rayleigh_ritz(GA, GB, k, theta, C, drop), mtl::range_error("Start vectors are linearly dependent"));
+	lobpcg_update(S, C, k, k); lobpcg_update(AS, C, k, k); lobpcg_update(BS, C, k, k);
+
+	bool with_p= false;
+	for (;;) {
+	    // residuals in the W block
+	    real resid(0);
+	    for (std::size_t j= 0; j < k; j++) {
+		Vector& r= AS.vector(k + j);
+		r= AS.vector(j) - theta[j] * BS.vector(j);
+		resid= std::max(resid, real(two_norm(r) / std::max(abs(theta[j]), std::numeric_limits<real>::min())));
+	    }
+	    if (iter.finished(resid))
+		break;
+	    ++iter;
+
+	    // preconditioned residuals
+	    for (std::size_t j= 0; j < k; j++)
+		S.vector(k + j)= solve(P, AS.vector(k + j));
+	    lobpcg_mult(A, S, AS, k, 2 * k);
+	    lobpcg_mult(B, S, BS, k, 2 * k);
+
+	    std::size_t r= with_p ? 3 * k : 2 * k;
+	    for (std::size_t j= k; j < r; j++)
+		lobpcg_normalize(S, AS, BS, j);
+	    GA.change_dim(r, r); GB.change_dim(r, r);
+	    lobpcg_gram(S, AS, r, GA);
+	    lobpcg_gram(S, BS, r, GB);
+	    if (!lobpcg_rayleigh_ritz(GA, GB, k, theta, C, drop)) {
+		MTL_THROW_IF(!with_p, mtl::range_error("Search space is exhausted"));
+		r= 2 * k;                      // restart without search directions
+		GA.change_dim(r, r); GB.change_dim(r, r);
+		lobpcg_gram(S, AS, r, GA);
+		lobpcg_gram(S, BS, r, GB);
+		if (!lobpcg_rayleigh_ritz(GA, GB, k, theta, C, drop))
+		    return iter.fail(2, "Search space is exhausted");
+	    }
+	    lobpcg_update(S, C, k, r); lobpcg_update(AS, C, k, r); lobpcg_update(BS, C, k, r);
+	    with_p= true;
+	}
+
+	lambda.change_dim(k);
+	for (std::size_t j= 0; j < k; j++) {
+	    lambda[j]= theta[j];
+	    X.vector(j)= S.vector(j);
+	}
+	return iter;
+    }
+
+} // namespace impl
+
+/// Locally optimal block preconditioned conjugate gradient method for the generalized eigenvalue problem A x = lambda B x
+/** Computes the num_cols(X) smallest eigenvalues of the symmetric matrix A and the symmetric positive definite B.
+    The columns of the multi_vector \p X contain the start vectors on entry and the B-orthonormal eigenvectors on exit;
+    the eigenvalues are returned in ascending order in \p lambda.
+    \p P is an itl preconditioner (e.g. pc::ic_0, pc::ilu_0 of A or of A - sigma B) applied to the residuals.
+    All vectors of the search space [X, W, P] are processed in blocks: compressed2D matrices are multiplied with
+    all columns in one sweep over the matrix and the Rayleigh-Ritz problem of size 3 num_cols(X) is solved with
+    mat::eigen_symmetric. The iteration is finished when max_j |A x_j - lambda_j B x_j| / |lambda_j| is below
+    its tolerance. **/
+template <typename LinearOperatorA, typename LinearOperatorB, typename Vector, typename VectorLambda,
+	  typename Preconditioner, typename Iteration>
+int lobpcg(const LinearOperatorA& A, const LinearOperatorB& B, mtl::mat::multi_vector<Vector>& X,
+	   VectorLambda& lambda, const Preconditioner& P, Iteration& iter)
+{
+    return impl::lobpcg(A, B, X, lambda, P, iter);
+}
+
+/// Locally optimal block preconditioned conjugate gradient method for the eigenvalue problem A x = lambda x
+/** For details see the generalized version. **/
+template <typename LinearOperator, typename Vector, typename VectorLambda, typename Preconditioner, typename Iteration>
+int lobpcg(const LinearOperator& A, mtl::mat::multi_vector<Vector>& X, VectorLambda& lambda,
+	   const Preconditioner& P, Iteration& iter)
+{
+    return impl::lobpcg(A, impl::lobpcg_identity(), X, lambda, P, iter);
+}
+
+/// Locally optimal block conjugate gradient method without preconditioner for the eigenvalue problem A x = lambda x
+template <typename LinearOperator, typename Vector, typename VectorLambda, typename Iteration>
+int lobpcg(const LinearOperator& A, mtl::mat::multi_vector<Vector>& X, VectorLambda& lambda, Iteration& iter)
+{
+    return impl::lobpcg(A, impl::lobpcg_identity(), X, lambda, pc::identity<LinearOperator>(A), iter);
+}
+
+} // namespace itl
+
+#endif // ITL_LOBPCG_INCLUDE
@@ -0,0 +1,99 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_SHIFT_INVERT_INCLUDE
+#define ITL_SHIFT_INVERT_INCLUDE
+
+#include <cstddef>
+
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/utility/ashape.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/operation/resource.hpp>
+#include <boost/numeric/mtl/vector/mat_cvec_multiplier.hpp>
+
+namespace itl {
+
+/// Matrix-free linear operator (A - sigma I)^{-1} for computing eigenvalues close to \p sigma with \ref lanczos or \ref arnoldi
+/** The inverse is applied by \p solver which must be set up for A - sigma I and provide
+    solver(x, b) like \ref cg_solver or \ref gmres_solver.
+    An eigenvalue theta of the operator corresponds to the eigenvalue sigma + 1 / theta of A
+    (see member function eigenvalue), thus the eigenvalues of A closest to sigma are found with target largest_magnitude. **/
+template <typename Solver, typename Value= double>
+class shift_invert
+{
+  public:
+    typedef Value    value_type;
+
+    /// Constructor with solver for A - sigma I, the dimension \p n of A and the shift
+    shift_invert(Solver& solver, std::size_t n, Value sigma) : solver(&solver), n(n), my_sigma(sigma) {}
+
+    /// Member function that realizes the multiplication, i.e. the solution with (A - sigma I)
+    template <typename VectorIn, typename VectorOut, typename Assign>
+    void mult(const VectorIn& v, VectorOut& w, Assign) const
+    {
+	MTL_DEBUG_THROW_IF(size(v) != n || size(w) != n, mtl::incompatible_size());
+	VectorOut x(resource(w));
+	x= 0;
+	(*solver)(x, v);
+	for (std::size_t i= 0; i < n; i++)
+	    Assign::apply(w[i], x[i]);
+    }
+
+    /// Multiplication is procastinated until we know where the product goes
+    template <typename VectorIn>
+    mtl::vec::mat_cvec_multiplier<shift_invert, VectorIn> operator*(const VectorIn& v) const
+    {	return mtl::vec::mat_cvec_multiplier<shift_invert, VectorIn>(*this, v);    }
+
+    /// The shift
+    Value sigma() const { return my_sigma; }
+
+    /// Eigenvalue of A corresponding to the eigenvalue \p theta of the operator
+    template <typename T>
+    T eigenvalue(const T& theta) const { return T(my_sigma) + T(1) / theta; }
+
+    std::size_t dim() const { return n; } ///< Dimension of the operator
+
+  private:
+    Solver*      solver;
+    std::size_t  n;
+    Value        my_sigma;
+};
+
+template <typename Solver, typename Value>
+inline std::size_t size(const shift_invert<Solver, Value>& A) { return A.dim() * A.dim(); } ///< Matrix size
+
+template <typename Solver, typename Value>
+inline std::size_t num_rows(const shift_invert<Solver, Value>& A) { return A.dim(); } ///< Number of rows
+
+template <typename Solver, typename Value>
+inline std::size_t num_cols(const shift_invert<Solver, Value>& A) { return A.dim(); } ///< Number of columns
+
+} // namespace itl
+
+namespace mtl {
+
+    template <typename Solver, typename Value>
+    struct Collection<itl::shift_invert<Solver, Value> >
+    {
+	typedef Value          value_type;
+	typedef std::size_t    size_type;
+    };
+
+    namespace ashape {
+	template <typename Solver, typename Value>
+	struct ashape_aux<itl::shift_invert<Solver, Value> >
+	{	typedef nonscal type;    };
+    }
+}
+
+#endif // ITL_SHIFT_INVERT_INCLUDE
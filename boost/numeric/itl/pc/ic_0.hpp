@@ -32,6 +32,7 @@
 #include <boost/numeric/mtl/matrix/transposed_view.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 #include <boost/numeric/itl/pc/solver.hpp>
+#include <boost/numeric/itl/pc/index_evaluator.hpp>
 
 
 namespace itl { namespace pc {
@@ -70,7 +71,7 @@ class ic_0
     const VectorOut& solve_lower(const VectorIn& x, VectorOut&) const
     {
 	static VectorOut y0;
-	y0.change_resource(resource(x));
+	impl::change_resource(y0, x);
 	lower_solver(x, y0);
 	return y0;
     }
@@ -25,6 +25,7 @@
 #include <boost/numeric/mtl/vector/dense_vector.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 #include <boost/numeric/itl/pc/solver.hpp>
+#include <boost/numeric/itl/pc/index_evaluator.hpp>
 
 namespace itl { namespace pc {
 
@@ -74,7 +75,7 @@ class ilu
     const VectorOut& solve_lower(const VectorIn& x, VectorOut&) const
     {
 	static VectorOut y0;
-	y0.change_resource(resource(x));
+	impl::change_resource(y0, x);
 	lower_solver(x, y0);
 	return y0;
     }
@@ -109,7 +110,7 @@ class ilu
 	y.checked_change_resource(x);
 	// y= unit_upper_trisolve(adjoint(L), inverse_lower_trisolve(adjoint(U), x));
 	static VectorOut y0;
-	y0.change_resource(resource(x));
+	impl::change_resource(y0, x);
 	adjoint_lower_solver(x, y0);
 	adjoint_upper_solver(y0, y);
     }
@@ -0,0 +1,44 @@
+// Software License for MTL
+// 
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+// 
+// This file is part of the Matrix Template Library
+// 
+// See also license.mtl.txt in the distribution.
+
+#ifndef ITL_PC_INDEX_EVALUATOR_INCLUDE
+#define ITL_PC_INDEX_EVALUATOR_INCLUDE
+
+#include <boost/numeric/mtl/utility/index_evaluator.hpp>
+#include <boost/numeric/mtl/operation/assign_mode.hpp>
+#include <boost/numeric/itl/itl_fwd.hpp>
+
+namespace itl { namespace pc {
+
+    template <typename VectorOut, typename Solver> struct ic_0_evaluator;
+
+}} // namespace itl::pc
+
+namespace mtl { namespace traits {
+
+/// Adjoint solves of IC(0) are evaluated backward in fused expressions
+template <typename VectorOut, typename Matrix, typename Value, typename VectorIn>
+struct index_evaluator<lazy_assign<VectorOut, itl::pc::solver<itl::pc::ic_0<Matrix, Value>, VectorIn, true>, assign::assign_sum> >
+{
+    typedef itl::pc::ic_0_evaluator<VectorOut, itl::pc::solver<itl::pc::ic_0<Matrix, Value>, VectorIn, true> > type;
+};
+
+/// ILU uses the evaluator of IC(0) since both do the same at the upper triangle
+template <typename VectorOut, typename Matrix, typename Factorizer, typename Value, typename VectorIn>
+struct index_evaluator<lazy_assign<VectorOut, itl::pc::solver<itl::pc::ilu<Matrix, Factorizer, Value>, VectorIn, true>, assign::assign_sum> >
+{
+    typedef itl::pc::ic_0_evaluator<VectorOut, itl::pc::solver<itl::pc::ilu<Matrix, Factorizer, Value>, VectorIn, true> > type;
+};
+
+}} // namespace mtl::traits
+
+#endif // ITL_PC_INDEX_EVALUATOR_INCLUDE
@@ -14,11 +14,29 @@
 #define ITL_PC_SOLVER_INCLUDE
 
 #include <boost/mpl/bool.hpp>
+#include <boost/numeric/mtl/utility/is_what.hpp>
 #include <boost/numeric/mtl/vector/assigner.hpp>
+#include <boost/numeric/mtl/operation/resource.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 namespace itl { namespace pc {
 
+namespace impl {
+
+    template <typename VectorOut, typename VectorIn>
+    inline void change_resource(VectorOut& y, const VectorIn& x, boost::mpl::false_)
+    {	y.change_resource(resource(x));    }
+
+    template <typename MatrixOut, typename MatrixIn>
+    inline void change_resource(MatrixOut& Y, const MatrixIn& X, boost::mpl::true_)
+    {	Y.change_dim(num_rows(X), num_cols(X));    }
+
+    /// Adapt temporary \p y to the resource of \p x, which is a vector or a matrix with one right-hand side per column
+    template <typename VectorOut, typename VectorIn>
+    inline void change_resource(VectorOut& y, const VectorIn& x)
+    {	change_resource(y, x, mtl::traits::is_matrix<VectorOut>());    }
+}
+
 /// Helper class for delayed (i.e. copy-free) evaluation of preconditioners
 template <typename PC, typename Vector, bool adjoint= false>
 struct solver
@@ -90,6 +90,31 @@ namespace mtl {
 
     }
 
+    namespace vec {
+
+#     ifdef MTL_REDUCTION_BLOCK_SIZE
+	const std::size_t reduction_block_size= MTL_REDUCTION_BLOCK_SIZE;
+#     else
+	/// Number of entries that are reduced sequentially in each block of a deterministic reduction
+	/** Used if MTL_DETERMINISTIC_REDUCTION is defined and in reductions with accumulation policies.
+	    The results depend on this block size but not on the number of threads. Should be a multiple of 64 to not disturb the unrolling.
+	    Can be reset with a macro definition or corresponding compiler flag,
+	    e.g. {-D|/D}MTL_REDUCTION_BLOCK_SIZE=1024 **/
+	const std::size_t reduction_block_size= 4096;
+#     endif
+
+#     ifdef MTL_FUSED_OMP_MIN_SIZE
+	const std::size_t fused_omp_min_size= MTL_FUSED_OMP_MIN_SIZE;
+#     else
+	/// Minimal vector size for which fused statements are evaluated in an OpenMP parallel region
+	/** Smaller vectors are evaluated serially because starting the threads would cost more than the loop.
+	    Can be reset with a macro definition or corresponding compiler flag,
+	    e.g. {-D|/D}MTL_FUSED_OMP_MIN_SIZE=1024 **/
+	const std::size_t fused_omp_min_size= 4096;
+#     endif
+
+    }
+
 
 
 } // namespace mtl
@@ -19,6 +19,7 @@
 #include <boost/numeric/mtl/mtl_fwd.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/assert.hpp>
+#include <boost/numeric/mtl/utility/allocation.hpp>
 #include <boost/numeric/mtl/matrix/dimension.hpp>
 #include <boost/numeric/mtl/detail/index.hpp>
 #include <boost/numeric/mtl/operation/clone.hpp>
@@ -28,19 +29,6 @@
 namespace mtl { namespace detail {
 using std::size_t;
   
-// Macro MTL_ENABLE_ALIGNMENT is by default not set
-
-// Minimal size of memory allocation using alignment
-#ifndef MTL_ALIGNMENT_LIMIT
-#  define MTL_ALIGNMENT_LIMIT 1024
-#endif
-
-// Alignment in memory
-#ifndef MTL_ALIGNMENT
-#  define MTL_ALIGNMENT 128
-#endif
-
-
 // Size helper for static size
 template <unsigned Size>
 struct size_helper
@@ -92,78 +80,11 @@ struct size_helper<0>
 };
 
 
-// Encapsulate behavior of alignment
-
-# ifdef MTL_ENABLE_ALIGNMENT
-
-    template <typename Value>
-    struct alignment_helper
-    {
-	typedef alignment_helper self;
-
-	alignment_helper() : malloc_address(0) {}
-
-	Value* alligned_alloc(std::size_t size)
-	{
-	    if (size == 0)
-		return 0;
-
-	    bool        align= size * sizeof(value_type) >= MTL_ALIGNMENT_LIMIT;
-	    std::size_t bytes= size * sizeof(value_type);
-	    
-	    if (align)
-		bytes+= MTL_ALIGNMENT - 1;
-
-	    char* p= malloc_address= new char[bytes];
-	    if (align)
-		while ((long int)(p) % MTL_ALIGNMENT) p++;
-		// p+= MTL_ALIGNMENT - (long int)(p) % MTL_ALIGNMENT;
-
-	    return reinterpret_cast<value_type*>(p);
-	}
-
-	void aligned_delete(bool is_own, Value*& data)
-	{
-	    if (is_own && malloc_address) delete[] malloc_address;
-	    data= 0;
-	}
-
-	friend void swap(self& x, self& y) 
-	{
-	    using std::swap
-	    swap(x.malloc_address, y.malloc_address);
-	}
-
-      private:	    
-	char*                                     malloc_address;
-    };
-
-# else
-
-    template <typename Value>
-    struct alignment_helper
-    {
-	typedef alignment_helper self;
-
-	Value* alligned_alloc(std::size_t size)	{  return size > 0 ? new Value[size] : (Value*)(0); }
-
-	void aligned_delete(bool is_own, Value*& data)
-	{
-	    if (is_own && data != 0) // std::cout << "Delete " << data << '\n', 
-		delete[] data, data= 0;
-	}
-
-	friend void swap(self&, self&) {}
-    };
-
-# endif
-
-
-template <typename Value, bool OnStack, unsigned Size> // for data on stack
+template <typename Value, bool OnStack, unsigned Size, typename Allocator> // for data on stack
 struct memory_crtp
-//    : public contiguous_memory_block<Value, OnStack, Size>
+//    : public contiguous_memory_block<Value, OnStack, Size, Allocator>
 {
-    typedef contiguous_memory_block<Value, OnStack, Size> base;
+    typedef contiguous_memory_block<Value, OnStack, Size, Allocator> base;
 
     static bool const                         on_stack= OnStack;
     
@@ -206,18 +127,17 @@ struct memory_crtp
     
 };
 
-// OnStack == false -> data on heap 
-template <typename Value, bool OnStack, unsigned Size>
+// OnStack == false -> data on heap, allocated with policy Allocator (see allocation.hpp)
+template <typename Value, bool OnStack, unsigned Size, typename Allocator>
 struct contiguous_memory_block
     : public size_helper<Size>,
-      public alignment_helper<Value>,
-      public memory_crtp<Value, OnStack, Size>
+      public memory_crtp<Value, OnStack, Size, Allocator>
 {
     typedef Value                             value_type;
     typedef contiguous_memory_block           self;
     typedef size_helper<Size>                 size_base;
-    typedef alignment_helper<Value>           alignment_base;
-    typedef memory_crtp<Value, OnStack, Size> crtp_base;
+    typedef memory_crtp<Value, OnStack, Size, Allocator> crtp_base;
+    typedef Allocator                         allocator_type;
 
     /// Category of memory, determines behaviour
     enum c_t {own,         //< My own memory: allocate and free it
@@ -231,12 +151,16 @@ struct contiguous_memory_block
     {
 	category= own;
 	this->set_size(size);
-	data= this->alligned_alloc(this->used_memory());
+	const std::size_t padded= allocation::padded_size<Allocator, Value>(size);
+	data= allocation::create<Allocator, Value>(padded);
+	for (std::size_t i= size; i < padded; i++)
+	    data[i]= Value();
     }
 
     void delete_it()
     {
-	this->aligned_delete(category == own, data);
+	if (category == own)
+	    allocation::destroy<Allocator>(data, allocation::padded_size<Allocator, Value>(this->used_memory())), data= 0;
     }
 
     template <typename Other>
@@ -316,8 +240,8 @@ struct contiguous_memory_block
     }
 
     // Other types must be copied always
-    template<typename Value2, bool OnStack2, unsigned Size2>
-    explicit contiguous_memory_block(const contiguous_memory_block<Value2, OnStack2, Size2>& other)
+    template<typename Value2, bool OnStack2, unsigned Size2, typename Allocator2>
+    explicit contiguous_memory_block(const contiguous_memory_block<Value2, OnStack2, Size2, Allocator2>& other)
     {
 	// std::cout << "Copy constructor (different type).\n";
 	copy_construction(other);
@@ -362,8 +286,8 @@ protected:
     }
 
 public:
-    template<typename Value2, bool OnStack2, unsigned Size2>
-    self& operator=(const contiguous_memory_block<Value2, OnStack2, Size2>& other)
+    template<typename Value2, bool OnStack2, unsigned Size2, typename Allocator2>
+    self& operator=(const contiguous_memory_block<Value2, OnStack2, Size2, Allocator2>& other)
     {
 	// std::cout << "Assignment from different array type -> Copy.\n";
 	copy_assignment(other);
@@ -373,6 +297,12 @@ public:
 
     void set_view() { category= view; }
 
+    /// Number of entries including the zero padding of the allocation policy (only for own memory)
+    std::size_t padded_memory() const
+    {
+	return category == own ? allocation::padded_size<Allocator, Value>(this->used_memory()) : this->used_memory();
+    }
+
     void realloc(std::size_t size)
     {
 	if (Size == 0) {
@@ -401,7 +331,6 @@ public:
 	swap(x.category, y.category);
 	std::swap(x.data, y.data);
 	swap(static_cast<size_base&>(x), static_cast<size_base&>(y));
-	swap(static_cast<alignment_base&>(x), static_cast<alignment_base&>(y));
     }	
 
 protected:
@@ -410,11 +339,10 @@ public:
     Value                                     *data;
 };
 
-// OnStack == true 
-template <typename Value, unsigned Size>
-struct contiguous_memory_block<Value, true, Size>
-    : public alignment_helper<Value>,
-      public memory_crtp<Value, true, Size>
+// OnStack == true (Allocator is ignored)
+template <typename Value, unsigned Size, typename Allocator>
+struct contiguous_memory_block<Value, true, Size, Allocator>
+    : public memory_crtp<Value, true, Size, Allocator>
 {
     typedef Value                             value_type;
     typedef contiguous_memory_block           self;
@@ -440,8 +368,8 @@ struct contiguous_memory_block<Value, true, Size>
     }
 
 
-    template<typename Value2, bool OnStack2, unsigned Size2>
-    explicit contiguous_memory_block(const contiguous_memory_block<Value2, OnStack2, Size2>& other)
+    template<typename Value2, bool OnStack2, unsigned Size2, typename Allocator2>
+    explicit contiguous_memory_block(const contiguous_memory_block<Value2, OnStack2, Size2, Allocator2>& other)
     {
 	// std::cout << "Copied in copy constructor (different type).\n";	
 	MTL_CRASH_IF(Size != other.used_memory(), "Incompatible size!");
@@ -463,8 +391,8 @@ protected:
     }
 
 public:
-    template<typename Value2, bool OnStack2, unsigned Size2>
-    self& operator=(const contiguous_memory_block<Value2, OnStack2, Size2>& other)
+    template<typename Value2, bool OnStack2, unsigned Size2, typename Allocator2>
+    self& operator=(const contiguous_memory_block<Value2, OnStack2, Size2, Allocator2>& other)
     {
 	// std::cout << "Assignment from different type.\n";
 	MTL_CRASH_IF(Size != other.used_memory(), "Incompatible size!");
@@ -484,6 +412,8 @@ public:
 	return Size;
     }
 
+    std::size_t padded_memory() const { return Size; }
+
   protected:
     enum c_t {own};
     static const c_t category= own;
@@ -493,8 +423,8 @@ public:
 }} // namespace mtl::detail
 
 namespace mtl {
-    template <typename Value, bool OnStack, unsigned Size>
-    struct is_clonable< detail::contiguous_memory_block<Value, OnStack, Size> > : boost::mpl::bool_<!OnStack> {};
+    template <typename Value, bool OnStack, unsigned Size, typename Allocator>
+    struct is_clonable< detail::contiguous_memory_block<Value, OnStack, Size, Allocator> > : boost::mpl::bool_<!OnStack> {};
 }
 
 #endif // MTL_CONTIGUOUS_MEMORY_BLOCK_INCLUDE
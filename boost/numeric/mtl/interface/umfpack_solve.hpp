@@ -136,7 +136,8 @@ namespace mtl { namespace mat {
 	    typedef typename matrix_type::size_type           size_type;
 	    typedef typename index<size_type>::type           index_type;
 
-	    static const bool copy_indices= sizeof(index_type) != sizeof(size_type),
+	    static const bool copy_indices= sizeof(index_type) != sizeof(size_type)
+		                            || sizeof(index_type) != sizeof(typename matrix_type::minor_index_type),
 		              long_indices= use_long<size_type>::value;
 	    typedef boost::mpl::bool_<long_indices>           blong;
 	    typedef boost::mpl::true_                         true_;
@@ -379,7 +380,8 @@ namespace mtl { namespace mat {
 	    typedef typename matrix_type::size_type           size_type;
 	    typedef typename index<size_type>::type           index_type;
 
-	    static const bool copy_indices= sizeof(index_type) != sizeof(size_type),
+	    static const bool copy_indices= sizeof(index_type) != sizeof(size_type)
+		                            || sizeof(index_type) != sizeof(typename matrix_type::minor_index_type),
 		              long_indices= use_long<size_type>::value;
 
 	    typedef boost::mpl::bool_<long_indices>           blong;
@@ -16,8 +16,15 @@
 #ifdef MTL_HAS_VPT
   #include <vt_user.h> 
   #include <boost/mpl/bool.hpp>
+#elif defined(MTL_WITH_TRACE)
+  #include <boost/numeric/mtl/interface/vpt_trace.hpp>
+  #include <boost/mpl/bool.hpp>
 #endif 
 
+#ifdef MTL_WITH_ROOFLINE
+  #include <boost/numeric/mtl/interface/vpt_roofline.hpp>
+#endif
+
 #include <math.h> 
 #include <string>
 
@@ -26,12 +33,12 @@ namespace mtl {
 /// Namespace for Vampir Trace interface
 namespace vpt {
 
-#ifdef MTL_HAS_VPT
-
 #ifndef MTL_VPT_LEVEL
 #  define MTL_VPT_LEVEL 2
 #endif 
 
+#ifdef MTL_HAS_VPT
+
 /// Class for Vampir Trace
 template <int N>
 class vampir_trace
@@ -66,6 +73,32 @@ class vampir_trace
     static std::string name;
 };
 
+#elif defined(MTL_WITH_TRACE)
+
+/// Class for the built-in tracing (see vpt_trace.hpp)
+template <int N>
+class vampir_trace
+{
+    typedef boost::mpl::bool_<(MTL_VPT_LEVEL * 1000 < N)> to_print;
+  public:
+    /// Default constructor defines the start point of a trace
+    vampir_trace() { entry(to_print());  }
+
+    void entry(boost::mpl::false_) {}
+    void entry(boost::mpl::true_) { record_trace_event(N, true); }
+    
+    /// Destructor defines the end point of a trace
+    ~vampir_trace() { end(to_print());  }
+
+    void end(boost::mpl::false_) {}
+    void end(boost::mpl::true_) { record_trace_event(N, false); }
+    
+    /// Function to check whether this event is traced with the current setting
+    bool is_traced() { return to_print::value; }
+
+  private:
+    static std::string name; // not used, names are taken from vpt_names.hpp or set_trace_event_name
+};
 
 #else
 
@@ -82,12 +115,43 @@ class vampir_trace
 };
 #endif
 
-    // names defined in vpt.cpp !!!
+    // names defined in vpt_names.hpp !!!
+
+#ifdef MTL_WITH_ROOFLINE
+
+/// Class for the roofline instrumentation of kernel N (see vpt_roofline.hpp)
+/** Measures the time from construction to destruction for a kernel with \p flops operations and \p bytes of memory traffic. **/
+template <int N>
+class roofline
+{
+  public:
+    roofline(double flops, double bytes) : flops(flops), bytes(bytes), start(roofline_clock()) {}
+    ~roofline() { record_roofline(N, flops, bytes, roofline_clock() - start); }
+
+  private:
+    roofline(const roofline&);
+    roofline& operator=(const roofline&);
+
+    double        flops, bytes;
+    std::uint64_t start;
+};
+
+#else
+
+// Dummy when the roofline instrumentation is not enabled
+template <int N>
+class roofline
+{
+  public:
+    roofline(double, double) {}
+};
+#endif
 
 } // namespace vpt
 
 /// Import of vpt::vampir_trace
 using vpt::vampir_trace;
+using vpt::roofline;
 
 } // namespace mtl
 
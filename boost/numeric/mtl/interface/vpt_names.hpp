@@ -0,0 +1,461 @@
+// Software License for MTL
+// 
+// Copyright (c) 2007 The Trustees of Indiana University. 
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com. 
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+// 
+// This file is part of the Matrix Template Library
+// 
+// See also license.mtl.txt in the distribution.
+
+// Names of the trace events for Vampir Trace and the built-in tracing.
+// No include guard: the file is included with a definition of MTL_VPT_NAME(Id, Name).
+
+// Categories:
+// Utilities + very small functions:  0000
+// Static size operations:            1000
+// Vector operations:                 2000
+// Matrix Vector & single matrix:     3000
+// Matrix matrix operations:          4000
+// Factorizations, preconditioners:   5000
+// Fused operations:                  6000
+// Iterative solvers:                 7000
+// Multigrid:                         8000
+
+
+// Utilities:                        < 1000
+MTL_VPT_NAME(1, "copysign")
+MTL_VPT_NAME(2, "Elem_raw_copy")
+MTL_VPT_NAME(3, "Get_real_part")
+MTL_VPT_NAME(4, "Info_contruct_vector")
+MTL_VPT_NAME(5, "right_scale_inplace")
+MTL_VPT_NAME(6, "sign_real_part_of_complex")
+MTL_VPT_NAME(7, "unrolling_expresion")
+MTL_VPT_NAME(8, "")
+MTL_VPT_NAME(9, "")
+MTL_VPT_NAME(10, "squared_abs_magnitudes")
+MTL_VPT_NAME(11, "squared_abs_complex")
+MTL_VPT_NAME(12, "squared_abs_magnitudes_template")
+MTL_VPT_NAME(13, "update_store")
+MTL_VPT_NAME(14, "update_plus")
+MTL_VPT_NAME(15, "update_minus")
+MTL_VPT_NAME(16, "update_times")
+MTL_VPT_NAME(17, "update_adapter")
+MTL_VPT_NAME(18, "")
+MTL_VPT_NAME(19, "")
+MTL_VPT_NAME(20, "update_proxy_<<")
+MTL_VPT_NAME(21, "update_proxy_=")
+MTL_VPT_NAME(22, "update_proxy_+=")
+MTL_VPT_NAME(23, "sfunctor::plus")
+MTL_VPT_NAME(24, "sfunctor::minus")
+MTL_VPT_NAME(25, "sfunctor::times")
+MTL_VPT_NAME(26, "sfunctor::divide")
+MTL_VPT_NAME(27, "sfunctor::assign")
+MTL_VPT_NAME(28, "sfunctor::plus_assign")
+MTL_VPT_NAME(29, "sfunctor::minus_assign")
+MTL_VPT_NAME(30, "sfunctor::times_assign")
+MTL_VPT_NAME(31, "sfunctor::divide_assign")
+MTL_VPT_NAME(32, "sfunctor::identity")
+MTL_VPT_NAME(33, "sfunctor::abs")
+MTL_VPT_NAME(34, "sfunctor::sqrt")
+MTL_VPT_NAME(35, "sfunctor::square")
+MTL_VPT_NAME(36, "sfunctor::negate")
+MTL_VPT_NAME(37, "sfunctor::compose")
+MTL_VPT_NAME(38, "sfunctor::compose_first")
+MTL_VPT_NAME(39, "sfunctor::compose_second")
+MTL_VPT_NAME(40, "sfunctor::compose_both")
+MTL_VPT_NAME(41, "sfunctor::compose_binary")
+MTL_VPT_NAME(42, "")
+MTL_VPT_NAME(43, "")
+MTL_VPT_NAME(44, "")
+MTL_VPT_NAME(45, "")
+
+// Fine-grained vector operations
+MTL_VPT_NAME(236, "Vector_swapped_row")
+
+
+// Static size operations:           1000
+MTL_VPT_NAME(1001, "stat_vec_expr")
+MTL_VPT_NAME(1002, "fsize_dmat_dmat_mult")
+MTL_VPT_NAME(1003, "vector_size_static")
+MTL_VPT_NAME(1004, "static_dispatch") // ?? row_in_matrix.hpp:74
+MTL_VPT_NAME(1005, "copy_blocks_forward")
+MTL_VPT_NAME(1006, "copy_blocks_backward")
+MTL_VPT_NAME(1007, "Static_Size")
+MTL_VPT_NAME(1008, "fsize_mat_vect_mult")
+MTL_VPT_NAME(1009, "")
+MTL_VPT_NAME(1010, "")
+MTL_VPT_NAME(1011, "")
+MTL_VPT_NAME(1012, "")
+MTL_VPT_NAME(1013, "")
+MTL_VPT_NAME(1014, "")
+MTL_VPT_NAME(1015, "")
+MTL_VPT_NAME(1016, "")
+MTL_VPT_NAME(1017, "")
+MTL_VPT_NAME(1018, "")
+MTL_VPT_NAME(1019, "")
+MTL_VPT_NAME(1020, "")
+
+
+
+
+
+// Vector operations:                2000
+MTL_VPT_NAME(2001, "gen_vector_copy")
+MTL_VPT_NAME(2002, "cross")
+MTL_VPT_NAME(2003, "dot")
+MTL_VPT_NAME(2004, "householder")
+MTL_VPT_NAME(2005, "householder_s")
+MTL_VPT_NAME(2006, "infinity_norm")
+MTL_VPT_NAME(2007, "look_at_each_nonzero")
+MTL_VPT_NAME(2008, "look_at_each_nonzero_pos")
+MTL_VPT_NAME(2009, "reduction")
+MTL_VPT_NAME(2010, "max")
+MTL_VPT_NAME(2011, "max_abs_pos")
+MTL_VPT_NAME(2012, "max_of_sums")
+MTL_VPT_NAME(2013, "max_pos")
+MTL_VPT_NAME(2014, "merge_complex_vector")
+MTL_VPT_NAME(2015, "one_norm")
+MTL_VPT_NAME(2016, "diagonal")
+MTL_VPT_NAME(2017, "dyn_vec_expr")
+MTL_VPT_NAME(2018, "Orthogonalize_Vectors")
+MTL_VPT_NAME(2019, "Orthogonalize_Factors")
+MTL_VPT_NAME(2020, "Vector_product")
+MTL_VPT_NAME(2021, "Vector_random")
+MTL_VPT_NAME(2022, "Vec_Vec_rank_update")
+MTL_VPT_NAME(2023, "Vector_dispatch")
+MTL_VPT_NAME(2024, "Vector_rscale")
+MTL_VPT_NAME(2025, "Multi-vector_mult")
+MTL_VPT_NAME(2026, "Transp_Multi-vector_mult")
+MTL_VPT_NAME(2027, "Hermitian_Multi-vector_mult")
+MTL_VPT_NAME(2028, "Vector_scal")
+MTL_VPT_NAME(2029, "Vector_set_zero")
+MTL_VPT_NAME(2030, "Vector_size1D")
+MTL_VPT_NAME(2031, "Vector_size_runtime")
+MTL_VPT_NAME(2032, "Vect_quicksort_lo_to_hi")
+MTL_VPT_NAME(2033, "Vect_quicksort_permutaion_lo_to_hi")
+MTL_VPT_NAME(2034, "split_complex_vector")
+MTL_VPT_NAME(2035, "Vect_entries_sum")
+MTL_VPT_NAME(2037, "Vector_const_trans")
+MTL_VPT_NAME(2038, "Vector_trans")
+MTL_VPT_NAME(2039, "two_norm")
+MTL_VPT_NAME(2040, "dot_simple")
+MTL_VPT_NAME(2041, "unary_dot")
+MTL_VPT_NAME(2042, "dense_copy_ctor")
+MTL_VPT_NAME(2043, "dense_tpl_copy_ctor")
+MTL_VPT_NAME(2044, "blocked_reduction")
+MTL_VPT_NAME(2045, "accumulated_reduction")
+MTL_VPT_NAME(2046, "")
+MTL_VPT_NAME(2047, "")
+MTL_VPT_NAME(2048, "")
+MTL_VPT_NAME(2049, "")
+MTL_VPT_NAME(2050, "")
+MTL_VPT_NAME(2051, "")
+MTL_VPT_NAME(2052, "")
+
+
+// Matrix Vector & single matrix:    3000
+MTL_VPT_NAME(3001, "matrix_copy_ele_times")
+MTL_VPT_NAME(3002, "gen_matrix_copy")
+MTL_VPT_NAME(3003, "copy")
+MTL_VPT_NAME(3004, "clone")
+MTL_VPT_NAME(3005, "compute_summand")
+MTL_VPT_NAME(3006, "crop")
+MTL_VPT_NAME(3007, "mat::diagonal")
+MTL_VPT_NAME(3008, "assign_each_nonzero")
+MTL_VPT_NAME(3009, "fill")
+MTL_VPT_NAME(3010, "frobenius_norm")
+MTL_VPT_NAME(3011, "mat::infinity_norm")
+MTL_VPT_NAME(3012, "invert_diagonal")
+MTL_VPT_NAME(3013, "iota")
+MTL_VPT_NAME(3014, "left_scale_inplace")
+MTL_VPT_NAME(3015, "mat::look_at_each_nonzero")
+MTL_VPT_NAME(3016, "mat::look_at_each_nonzero_pos")
+MTL_VPT_NAME(3017, "fsize_dense_mat_cvec_mult")
+MTL_VPT_NAME(3018, "dense_mat_cvec_mult")
+MTL_VPT_NAME(3019, "mvec_cvec_mult")
+MTL_VPT_NAME(3020, "trans_mvec_cvec_mult")
+MTL_VPT_NAME(3021, "herm_mvec_cvec_mult")
+MTL_VPT_NAME(3022, "sparse_row_cvec_mult") // generic row-major sparse
+MTL_VPT_NAME(3023, "ccs_cvec_mult")
+MTL_VPT_NAME(3024, "mat::max_abs_pos")
+MTL_VPT_NAME(3025, "mat::one_norm")
+MTL_VPT_NAME(3026, "invert_diagonal(compressed)")
+MTL_VPT_NAME(3027, "mat_vect_mult")
+MTL_VPT_NAME(3028, "Vect_sparse_mat_mult")
+MTL_VPT_NAME(3029, "Matrix_scal")
+MTL_VPT_NAME(3030, "Vector_Secular_Equation")
+MTL_VPT_NAME(3031, "Matrix_set_zero")
+MTL_VPT_NAME(3032, "Matrix_size1D")
+MTL_VPT_NAME(3033, "Matrix_size_runtime")
+MTL_VPT_NAME(3034, "Matrix_LU")
+MTL_VPT_NAME(3035, "Vector_Matrix_LU")
+MTL_VPT_NAME(3036, "Sub_matrix_indices")
+MTL_VPT_NAME(3037, "Matrix_svd_reference")
+MTL_VPT_NAME(3038, "Matrix_svd_triplet")
+MTL_VPT_NAME(3039, "Matrix_swapped")
+MTL_VPT_NAME(3040, "Matrix_Trace")
+MTL_VPT_NAME(3041, "Matrix_const_trans")
+MTL_VPT_NAME(3042, "Matrix_trans")
+MTL_VPT_NAME(3043, "Matrix_upper_trisolve")
+MTL_VPT_NAME(3044, "Matrix_upper_trisolve_diagonal")
+MTL_VPT_NAME(3045, "Matrix_upper_trisolve_invers_diag")
+MTL_VPT_NAME(3046, "Matrix_upper_trisolve_DiaTag")
+MTL_VPT_NAME(3047, "scalar_assign")
+MTL_VPT_NAME(3048, "elest_cvec_mult")
+MTL_VPT_NAME(3049, "crs_cvec_mult")
+MTL_VPT_NAME(3050, "sparse_ins::ctor")
+MTL_VPT_NAME(3051, "sparse_ins::dtor")
+MTL_VPT_NAME(3052, "sparse_ins::stretch")
+MTL_VPT_NAME(3053, "sparse_ins::final_place")
+MTL_VPT_NAME(3054, "sparse_ins::insert_spare")
+MTL_VPT_NAME(3055, "mat_crtp_scal_assign")
+MTL_VPT_NAME(3056, "mat_crtp_mat_assign")
+MTL_VPT_NAME(3057, "mat_crtp_sum_assign")
+MTL_VPT_NAME(3058, "mat_crtp_diff_assign")
+MTL_VPT_NAME(3059, "mat_crtp_array_assign")
+MTL_VPT_NAME(3060, "mat_crtp_mvec_assign")
+MTL_VPT_NAME(3061, "copy_band_to_sparse")
+MTL_VPT_NAME(3062, "block_dia_times_cvec")
+MTL_VPT_NAME(3063, "laplacian_setup")
+MTL_VPT_NAME(3064, "vsmat_cvec_mult")
+MTL_VPT_NAME(3065, "adapt_crs_cvec_mult")
+MTL_VPT_NAME(3066, "dense2D_cvec_mult")
+MTL_VPT_NAME(3067, "square_cvec_mult")
+MTL_VPT_NAME(3068, "mat_crtp_mult_assign")
+MTL_VPT_NAME(3069, "sbanded_cvec_mult")
+MTL_VPT_NAME(3070, "mat_cvec_multiplier")
+MTL_VPT_NAME(3071, "Matrix_svd_golub_kahan")
+MTL_VPT_NAME(3072, "Matrix_svd_bidiagonal_qr")
+MTL_VPT_NAME(3073, "Matrix_singular_values")
+MTL_VPT_NAME(3074, "Matrix_svd_thin")
+MTL_VPT_NAME(3075, "crs_multi_vector_mult")
+MTL_VPT_NAME(3076, "simd_crs_cvec_mult")
+MTL_VPT_NAME(3077, "accumulated_crs_cvec_mult")
+MTL_VPT_NAME(3078, "ell_cvec_mult")
+MTL_VPT_NAME(3079, "sliced_ell_cvec_mult")
+MTL_VPT_NAME(3080, "blocked_crs_cvec_mult")
+MTL_VPT_NAME(3081, "")
+
+
+// Matrix matrix operations:        4000
+MTL_VPT_NAME(4001, "cursor_dmat_dmat_mult")
+MTL_VPT_NAME(4002, "dmat_dmat_mult")
+MTL_VPT_NAME(4003, "tiling_dmat_dmat_mult")
+MTL_VPT_NAME(4004, "tiling_44_dmat_dmat_mult")
+MTL_VPT_NAME(4005, "tiling_22_dmat_dmat_mult")
+MTL_VPT_NAME(4006, "wrec_dmat_dmat_mult")
+MTL_VPT_NAME(4007, "recursive_dmat_dmat_mult")
+MTL_VPT_NAME(4008, "xgemm")
+MTL_VPT_NAME(4009, "")
+MTL_VPT_NAME(4010, "mult")
+MTL_VPT_NAME(4011, "gen_mult")
+MTL_VPT_NAME(4012, "mat_mat_mult")
+MTL_VPT_NAME(4013, "matrix_qr")
+MTL_VPT_NAME(4014, "matrix_qr_factors")
+MTL_VPT_NAME(4015, "matrix_random")
+MTL_VPT_NAME(4016, "matrix_scale_inplace")
+MTL_VPT_NAME(4017, "matrix_rscale")
+MTL_VPT_NAME(4018, "matrix_gen_smat_dmat_mult")
+MTL_VPT_NAME(4019, "matrix_gen_tiling_smat_dmat_mult")
+MTL_VPT_NAME(4020, "matrix_smat_smat_mult")
+MTL_VPT_NAME(4021, "")
+MTL_VPT_NAME(4022, "")
+MTL_VPT_NAME(4023, "")
+MTL_VPT_NAME(4024, "")
+MTL_VPT_NAME(4025, "")
+MTL_VPT_NAME(4026, "")
+MTL_VPT_NAME(4027, "")
+MTL_VPT_NAME(4028, "")
+MTL_VPT_NAME(4029, "")
+MTL_VPT_NAME(4030, "")
+MTL_VPT_NAME(4031, "")
+MTL_VPT_NAME(4032, "")
+MTL_VPT_NAME(4033, "")
+MTL_VPT_NAME(4034, "")
+MTL_VPT_NAME(4035, "")
+MTL_VPT_NAME(4036, "read_el_matrix")
+MTL_VPT_NAME(4037, "matrix_market_read_crs")
+MTL_VPT_NAME(4038, "binary_write")
+MTL_VPT_NAME(4039, "binary_load")
+MTL_VPT_NAME(4040, "matrix_market_write_crs")
+MTL_VPT_NAME(4041, "")
+
+
+// Factorizations, preconditioners: 5000
+MTL_VPT_NAME(5001, "cholesky_base")
+MTL_VPT_NAME(5002, "cholesky_solve_base")
+MTL_VPT_NAME(5003, "cholesky_schur_base")
+MTL_VPT_NAME(5004, "cholesky_update_base")
+MTL_VPT_NAME(5005, "cholesky_schur_update")
+MTL_VPT_NAME(5006, "cholesky_tri_solve")
+MTL_VPT_NAME(5007, "cholesky_tri_schur")
+MTL_VPT_NAME(5008, "recursive cholesky")
+MTL_VPT_NAME(5009, "fill_matrix_for_cholesky")
+MTL_VPT_NAME(5010, "qr_sym_imp")
+MTL_VPT_NAME(5011, "qr_algo")
+MTL_VPT_NAME(5012, "eigenvalue_symmetric")
+MTL_VPT_NAME(5013, "hessenberg_q")
+MTL_VPT_NAME(5014, "hessenberg_factors")
+MTL_VPT_NAME(5015, "extract_householder_hessenberg")
+MTL_VPT_NAME(5016, "householder_hessenberg")
+MTL_VPT_NAME(5017, "extract_hessenberg")
+MTL_VPT_NAME(5018, "hessenberg")
+MTL_VPT_NAME(5019, "inv_upper")
+MTL_VPT_NAME(5020, "inv_lower")
+MTL_VPT_NAME(5021, "inv")
+MTL_VPT_NAME(5022, "lower_trisolve")
+MTL_VPT_NAME(5023, "lu")
+MTL_VPT_NAME(5024, "lu(pivot)")
+MTL_VPT_NAME(5025, "lu_f")
+MTL_VPT_NAME(5026, "lu_solve_straight")
+MTL_VPT_NAME(5027, "lu_apply")
+MTL_VPT_NAME(5028, "lu_solve")
+MTL_VPT_NAME(5029, "lu_adjoint_apply")
+MTL_VPT_NAME(5030, "lu_adjoint_solve")
+MTL_VPT_NAME(5031, "pc::id::solve")
+MTL_VPT_NAME(5032, "pc::id.solve")
+MTL_VPT_NAME(5033, "pc::id::adjoint_solve")
+MTL_VPT_NAME(5034, "pc::id.adjoint_solve")
+MTL_VPT_NAME(5035, "ic_0::factorize")
+MTL_VPT_NAME(5036, "ic_0::solve")
+MTL_VPT_NAME(5037, "ic_0::solve_nocopy")
+MTL_VPT_NAME(5038, "ilu_0::factorize")
+MTL_VPT_NAME(5039, "ilu_0::solve")
+MTL_VPT_NAME(5040, "ilu_0::adjoint_solve")
+MTL_VPT_NAME(5041, "lower_trisolve_kernel")
+MTL_VPT_NAME(5042, "upper_trisolve_row")
+MTL_VPT_NAME(5043, "upper_trisolve_col")
+MTL_VPT_NAME(5044, "ic_0::adjoint_solve")
+MTL_VPT_NAME(5045, "ic_0::adjoint_solve_nocopy")
+MTL_VPT_NAME(5046, "upper_trisolve_crs_compact")
+MTL_VPT_NAME(5047, "lower_trisolve_crs_compact")
+MTL_VPT_NAME(5048, "lower_unit_trisolve_crs_compact")
+MTL_VPT_NAME(5049, "ilut::factorize")
+MTL_VPT_NAME(5050, "diagonal::setup")
+MTL_VPT_NAME(5051, "diagonal::solve")
+MTL_VPT_NAME(5052, "imf::factor")
+MTL_VPT_NAME(5053, "imf::ctor")
+MTL_VPT_NAME(5054, "imf::solve")
+MTL_VPT_NAME(5055, "pc::solver::assign_to")
+MTL_VPT_NAME(5056, "sub_matrix_pc::solve")
+MTL_VPT_NAME(5057, "sub_matrix_pc::adjoint_solve")
+MTL_VPT_NAME(5058, "pc::concat::solve")
+MTL_VPT_NAME(5059, "pc::concat::adjoint_solve")
+MTL_VPT_NAME(5060, "umfpack::solver::ctor")
+MTL_VPT_NAME(5061, "umfpack::solver::dtor")
+MTL_VPT_NAME(5062, "umfpack::solve")
+MTL_VPT_NAME(5063, "tridiagonalize")
+MTL_VPT_NAME(5064, "tridiagonal_back_transform")
+MTL_VPT_NAME(5065, "tridiagonal_ql")
+MTL_VPT_NAME(5066, "tridiagonal_bisection")
+MTL_VPT_NAME(5067, "cuppen_tridiagonal")
+MTL_VPT_NAME(5068, "eigen_symmetric")
+MTL_VPT_NAME(5069, "secular_dc")
+MTL_VPT_NAME(5070, "lower_trisolve_multi_rhs")
+MTL_VPT_NAME(5071, "upper_trisolve_multi_rhs")
+MTL_VPT_NAME(5072, "upper_trisolve")
+
+
+// Fused operations:                6000
+MTL_VPT_NAME(6001, "fused::fwd_eval_loop")
+MTL_VPT_NAME(6002, "fused::fwd_eval_loop_unrolled")
+MTL_VPT_NAME(6003, "fused::bwd_eval_loop")
+MTL_VPT_NAME(6004, "fused::bwd_eval_loop_unrolled")
+MTL_VPT_NAME(6005, "fused::fwd_eval_loop_parallel")
+MTL_VPT_NAME(6006, "fused::fwd_eval_loop_deterministic")
+
+
+
+// Iterative solvers:               7000
+MTL_VPT_NAME(7001, "cg_without_pc")
+MTL_VPT_NAME(7002, "cg")
+MTL_VPT_NAME(7003, "bicg")
+MTL_VPT_NAME(7004, "bicgstab")
+MTL_VPT_NAME(7005, "bicgstab_2")
+MTL_VPT_NAME(7006, "bicgstab_ell")
+MTL_VPT_NAME(7007, "cgs")
+MTL_VPT_NAME(7008, "qmr")
+MTL_VPT_NAME(7009, "tfqmr")
+MTL_VPT_NAME(7010, "idr_s")
+MTL_VPT_NAME(7011, "lanczos")
+MTL_VPT_NAME(7012, "arnoldi")
+MTL_VPT_NAME(7013, "lobpcg")
+
+
+// OpenMP
+MTL_VPT_NAME(8001, "omp::dot")
+MTL_VPT_NAME(8002, "omp::reduction")
+MTL_VPT_NAME(8003, "omp::dyn_vec_expr")
+MTL_VPT_NAME(8004, "omp::crs_cvec_mult")
+
+
+
+// multigrid
+MTL_VPT_NAME(8501, "mtl::mg::v_cycle")
+MTL_VPT_NAME(8502, "mtl::mg::w_cycle")
+MTL_VPT_NAME(8503, "mtl::mg::fmg")
+MTL_VPT_NAME(8504, "mtl::mg::two_grid_cycle")
+
+MTL_VPT_NAME(8510, "mtl::mg::geometric_multigrid_solver_impl")
+MTL_VPT_NAME(8511, "mtl::mg::geometric_multigrid_solver_solve1")
+MTL_VPT_NAME(8512, "mtl::mg::geometric_multigrid_solver_solve2")
+
+MTL_VPT_NAME(8515, "mtl::mg::algebraic_multigrid_solver")
+MTL_VPT_NAME(8516, "amg_pc::solve")
+
+MTL_VPT_NAME(8520, "mtl::mg::linear_restriction")
+MTL_VPT_NAME(8521, "mtl::mg::linear_prolongation")
+
+MTL_VPT_NAME(8530, "mtl::mg::gauss_elimination")
+MTL_VPT_NAME(8531, "mtl::mg::back_substitution")
+
+MTL_VPT_NAME(8550, "mtl::mg::jacobi")
+MTL_VPT_NAME(8551, "mtl::mg::gauss_seidel")
+MTL_VPT_NAME(8552, "mtl::mg::jor")
+MTL_VPT_NAME(8553, "mtl::mg::sor")
+
+MTL_VPT_NAME(8572, "boundaries")
+MTL_VPT_NAME(8573, "viscosity")
+MTL_VPT_NAME(8574, "pressure_correction")
+
+MTL_VPT_NAME(8590, "mtl::mg::util::vtk_exporter")
+MTL_VPT_NAME(8591, "mtl::mg::util::csv_exporter")
+
+MTL_VPT_NAME(8610, "amg::amg_matrix_hierarchy")
+MTL_VPT_NAME(8611, "amg::compute_influence")
+MTL_VPT_NAME(8612, "amg::default_coarse_grid_detection::compute_C")
+MTL_VPT_NAME(8614, "amg::utils::compute_potentials")
+MTL_VPT_NAME(8615, "amg::utils::find_max_pos")
+
+MTL_VPT_NAME(8617, "amg::amg_prolongation")
+MTL_VPT_NAME(8618, "amg::compute_weight")
+MTL_VPT_NAME(8619, "amg::compute_mfactors")
+
+MTL_VPT_NAME(8620, "amg::strongly_influenced_points")
+MTL_VPT_NAME(8621, "amg::is_strongly_influenced")
+MTL_VPT_NAME(8622, "amg::strongly_influencing_points")
+
+MTL_VPT_NAME(8630, "amg::amg_operators::amg_restriction")
+MTL_VPT_NAME(8631, "amg::amg_operators::amg_prolongation")
+MTL_VPT_NAME(8635, "amg::amg_operators::amg_weight")
+
+MTL_VPT_NAME(8900, "NaSto::solve()")
+MTL_VPT_NAME(8910, "NaSto::computeGamma()")
+MTL_VPT_NAME(8920, "NaSto::computeBoundaries()")
+MTL_VPT_NAME(8930, "NaSto::computeImplViscosity()")
+MTL_VPT_NAME(8940, "NaSto::computePressureCorr()")
+
+// Test blocks for performance debugging
+MTL_VPT_NAME(9901, "tb1")
+MTL_VPT_NAME(9902, "tb2")
+MTL_VPT_NAME(9903, "tb3")
+MTL_VPT_NAME(9904, "tb4")
+MTL_VPT_NAME(9999, "main")
+
+
+// Only for testing
+MTL_VPT_NAME(9990, "helper_function")
+MTL_VPT_NAME(9991, "function")
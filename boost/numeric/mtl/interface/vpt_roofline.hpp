@@ -0,0 +1,352 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_VPT_VPT_ROOFLINE_INCLUDE
+#define MTL_VPT_VPT_ROOFLINE_INCLUDE
+
+// Roofline instrumentation of the main kernels, enabled with MTL_WITH_ROOFLINE.
+// The kernels (SpMV, vector assignments, dot products and reductions, triangular solvers and dense
+// matrix products) declare a roofline<N> object with the floating point operations and the bytes they
+// move; both are counted analytically from the sizes and the nnz (see utility/roofline_counts.hpp).
+// The time of each call is accumulated per thread and event id. The report relates the achieved
+// GFLOP/s and GB/s to the machine peak that a small probe measures on first use: a STREAM triad on
+// arrays larger than the caches and a chain of independent FMAs on SIMD packs of the native instruction set.
+// When the environment variable MTL_ROOFLINE_REPORT is set, the report is printed to std::cerr at program exit;
+// MTL_ROOFLINE_PEAK="<GB/s>,<GFLOP/s>" replaces the probe, e.g. by the results of STREAM and LINPACK.
+
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#  error "The roofline instrumentation (MTL_WITH_ROOFLINE) needs C++11."
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+#include <boost/numeric/mtl/utility/simd_pack.hpp>
+#include <boost/numeric/mtl/interface/vpt_trace.hpp>
+
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
+
+#ifndef MTL_ROOFLINE_PROBE_SIZE
+#  define MTL_ROOFLINE_PROBE_SIZE (1 << 22)
+#endif
+
+namespace mtl { namespace vpt {
+
+/// Bandwidth and floating point performance of the machine for the roofline model
+struct machine_peak
+{
+    machine_peak(double bandwidth= 0.0, double gflops= 0.0) : bandwidth(bandwidth), gflops(gflops) {}
+
+    /// Attainable GFLOP/s with arithmetic intensity \p intensity (flops per byte)
+    double attainable(double intensity) const { return std::min(gflops, intensity * bandwidth); }
+
+    double bandwidth; ///< Memory bandwidth in GB/s
+    double gflops;    ///< Floating point performance in GFLOP/s
+};
+
+/// Accumulated operations, memory traffic and time of one kernel
+struct roofline_statistics
+{
+    roofline_statistics() : id(0), calls(0), time(0.0), flops(0.0), bytes(0.0) {}
+
+    double gflops() const { return time > 0.0 ? 1e-9 * flops / time : 0.0; }            ///< Achieved GFLOP/s
+    double gbytes_per_second() const { return time > 0.0 ? 1e-9 * bytes / time : 0.0; } ///< Achieved GB/s
+    double intensity() const { return bytes > 0.0 ? flops / bytes : 0.0; }              ///< Flops per byte
+
+    int           id;
+    std::string   name;
+    std::uint64_t calls;
+    double        time;  ///< Seconds
+    double        flops;
+    double        bytes;
+};
+
+namespace detail {
+
+    inline void write_roofline_at_exit();
+
+    // Statistics of one thread, only changed by this thread
+    struct roofline_table
+    {
+	std::mutex                          m; // only contended while reporting
+	std::map<int, roofline_statistics>  kernels;
+    };
+
+    // Owns the tables of all threads; never destroyed so that kernels during static destruction are safe
+    class roofline_registry
+    {
+      public:
+	static roofline_registry& instance()
+	{
+	    static roofline_registry* r= new roofline_registry;
+	    return *r;
+	}
+
+	roofline_table* add()
+	{
+	    std::lock_guard<std::mutex> lock(m);
+	    tables.push_back(std::unique_ptr<roofline_table>(new roofline_table));
+	    return tables.back().get();
+	}
+
+	std::vector<roofline_table*> all()
+	{
+	    std::lock_guard<std::mutex> lock(m);
+	    std::vector<roofline_table*> v;
+	    for (std::size_t i= 0; i < tables.size(); i++)
+		v.push_back(tables[i].get());
+	    return v;
+	}
+
+      private:
+	roofline_registry()
+	{
+	    if (std::getenv("MTL_ROOFLINE_REPORT"))
+		std::atexit(&write_roofline_at_exit);
+	}
+
+	std::mutex                                    m;
+	std::vector<std::unique_ptr<roofline_table> > tables;
+    };
+
+    inline roofline_table& local_roofline_table()
+    {
+	static thread_local roofline_table* table= 0;
+	if (!table)
+	    table= roofline_registry::instance().add();
+	return *table;
+    }
+
+    template <typename Value>
+    inline void roofline_keep(const Value& x)
+    {
+#     if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&x) : "memory");
+#     else
+	static volatile Value sink; sink= x;
+#     endif
+    }
+
+} // namespace detail
+
+/// Time stamp in nanoseconds for the roofline instrumentation
+inline std::uint64_t roofline_clock()
+{
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// Record a call of kernel \p id with \p flops operations and \p bytes of memory traffic that took \p ns nanoseconds
+inline void record_roofline(int id, double flops, double bytes, std::uint64_t ns)
+{
+    detail::roofline_table&     t= detail::local_roofline_table();
+    std::lock_guard<std::mutex> lock(t.m);
+    roofline_statistics&        s= t.kernels[id];
+    s.calls++;
+    s.time+= 1e-9 * double(ns);
+    s.flops+= flops;
+    s.bytes+= bytes;
+}
+
+/// Measure the memory bandwidth with a STREAM triad and the floating point performance with independent FMAs
+/** Runs in parallel with OpenMP. The bandwidth counts 24 bytes per triad entry as STREAM does,
+    i.e. without the write-allocate of the target. The flops are those of the native SIMD packs
+    (selected at compile time). Takes about a second. **/
+inline machine_peak measure_machine_peak()
+{
+    using std::size_t;
+    const size_t n= MTL_ROOFLINE_PROBE_SIZE;
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+    double* ap= &a[0]; const double *bp= &b[0], *cp= &c[0];
+    const double s= 3.0;
+
+    double best_triad= 1e300;
+    for (int r= 0; r < 5; r++) {
+	const std::uint64_t start= roofline_clock();
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel for schedule(static)
+	for (long i= 0; i < long(n); i++)
+	    ap[i]= bp[i] + s * cp[i];
+#     else
+	for (size_t i= 0; i < n; i++)
+	    ap[i]= bp[i] + s * cp[i];
+#     endif
+	detail::roofline_keep(a[n / 2]);
+	best_triad= std::min(best_triad, double(roofline_clock() - start));
+    }
+
+    typedef simd::pack<double> pack_type;
+    const int    chains= 12, iterations= 1 << 19;
+    int          threads= 1;
+    double       best_fma= 1e300;
+    for (int r= 0; r < 3; r++) {
+	const std::uint64_t start= roofline_clock();
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+#     endif
+	{
+#         ifdef MTL_WITH_OPENMP
+#           pragma omp single
+	    threads= omp_get_num_threads();
+#         endif
+	    const pack_type x(1.0 - 1e-12), y(1e-12);
+	    pack_type       acc[chains];
+	    for (int k= 0; k < chains; k++)
+		acc[k]= pack_type(double(k));
+	    for (int i= 0; i < iterations; i++)
+		for (int k= 0; k < chains; k++)
+		    acc[k]= simd::fma(acc[k], x, y);
+	    double sum= 0.0;
+	    for (int k= 0; k < chains; k++)
+		sum+= simd::reduce_add(acc[k]);
+	    detail::roofline_keep(sum);
+	}
+	best_fma= std::min(best_fma, double(roofline_clock() - start));
+    }
+
+    return machine_peak(24.0 * double(n) / best_triad,
+			2.0 * double(pack_type::size) * chains * double(iterations) * threads / best_fma);
+}
+
+namespace detail {
+
+    // Never destroyed since used at exit
+    struct roofline_peak
+    {
+	static roofline_peak& instance()
+	{
+	    static roofline_peak* p= new roofline_peak;
+	    return *p;
+	}
+
+	std::mutex   m;
+	bool         known;
+	machine_peak peak;
+
+      private:
+	roofline_peak() : known(false)
+	{
+	    double bandwidth, gflops;
+	    if (const char* env= std::getenv("MTL_ROOFLINE_PEAK"))
+		if (std::sscanf(env, "%lf,%lf", &bandwidth, &gflops) == 2 && bandwidth > 0.0 && gflops > 0.0)
+		    peak= machine_peak(bandwidth, gflops), known= true;
+	}
+    };
+
+} // namespace detail
+
+/// Machine peak of the roofline report; measured by measure_machine_peak on first use unless set before
+/** Should be called once before the instrumented code runs in parallel threads, especially when measured. **/
+inline machine_peak roofline_peak()
+{
+    detail::roofline_peak&      p= detail::roofline_peak::instance();
+    std::lock_guard<std::mutex> lock(p.m);
+    if (!p.known)
+	p.peak= measure_machine_peak(), p.known= true;
+    return p.peak;
+}
+
+/// Set the machine peak of the roofline report, e.g. from STREAM and LINPACK results
+inline void set_roofline_peak(const machine_peak& peak)
+{
+    detail::roofline_peak&      p= detail::roofline_peak::instance();
+    std::lock_guard<std::mutex> lock(p.m);
+    p.peak= peak;
+    p.known= true;
+}
+
+/// Statistics of all instrumented kernels summed over all threads, sorted by decreasing time
+inline std::vector<roofline_statistics> roofline_summary()
+{
+    std::vector<detail::roofline_table*> tables(detail::roofline_registry::instance().all());
+    std::map<int, roofline_statistics>   stats;
+    for (std::size_t t= 0; t < tables.size(); t++) {
+	std::lock_guard<std::mutex> lock(tables[t]->m);
+	for (std::map<int, roofline_statistics>::const_iterator it= tables[t]->kernels.begin(); it != tables[t]->kernels.end(); ++it) {
+	    roofline_statistics& s= stats[it->first];
+	    s.calls+= it->second.calls;
+	    s.time+= it->second.time;
+	    s.flops+= it->second.flops;
+	    s.bytes+= it->second.bytes;
+	}
+    }
+    std::vector<roofline_statistics> v;
+    for (std::map<int, roofline_statistics>::iterator it= stats.begin(); it != stats.end(); ++it) {
+	it->second.id= it->first;
+	it->second.name= trace_event_name(it->first);
+	v.push_back(it->second);
+    }
+    std::stable_sort(v.begin(), v.end(), [](const roofline_statistics& x, const roofline_statistics& y) { return x.time > y.time; });
+    return v;
+}
+
+/// Remove all recorded statistics; must not be called while instrumented code runs in other threads
+inline void clear_roofline()
+{
+    std::vector<detail::roofline_table*> tables(detail::roofline_registry::instance().all());
+    for (std::size_t t= 0; t < tables.size(); t++) {
+	std::lock_guard<std::mutex> lock(tables[t]->m);
+	tables[t]->kernels.clear();
+    }
+}
+
+/// Print the roofline report as table to \p os
+/** For each kernel: the calls, the time, the achieved GFLOP/s and GB/s, the arithmetic intensity,
+    the fraction of the peak bandwidth and the fraction of the attainable performance
+    min(peak GFLOP/s, intensity * peak bandwidth). **/
+inline void print_roofline(std::ostream& os)
+{
+    const machine_peak               peak(roofline_peak());
+    std::vector<roofline_statistics> v(roofline_summary());
+    char line[220];
+    std::snprintf(line, sizeof(line), "Machine peak: %.2f GB/s, %.2f GFLOP/s, ridge point %.3f flop/byte\n",
+		  peak.bandwidth, peak.gflops, peak.bandwidth > 0.0 ? peak.gflops / peak.bandwidth : 0.0);
+    os << line;
+    std::snprintf(line, sizeof(line), "%-32s %6s %10s %12s %10s %10s %10s %8s %8s\n",
+		  "kernel", "id", "calls", "time [s]", "GFLOP/s", "GB/s", "flop/byte", "% BW", "% roof");
+    os << line;
+    for (std::size_t i= 0; i < v.size(); i++) {
+	const roofline_statistics& s= v[i];
+	const double attainable= peak.attainable(s.intensity());
+	std::snprintf(line, sizeof(line), "%-32.32s %6d %10llu %12.6f %10.3f %10.3f %10.4f %8.1f %8.1f\n",
+		      s.name.c_str(), s.id, (unsigned long long)(s.calls), s.time, s.gflops(), s.gbytes_per_second(), s.intensity(),
+		      peak.bandwidth > 0.0 ? 100.0 * s.gbytes_per_second() / peak.bandwidth : 0.0,
+		      attainable > 0.0 ? 100.0 * s.gflops() / attainable : 0.0);
+	os << line;
+    }
+}
+
+namespace detail {
+
+    inline void write_roofline_at_exit()
+    {
+	try {
+	    print_roofline(std::cerr);
+	} catch (...) {}
+    }
+
+} // namespace detail
+
+}} // namespace mtl::vpt
+
+#endif // MTL_VPT_VPT_ROOFLINE_INCLUDE
@@ -0,0 +1,492 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_VPT_VPT_TRACE_INCLUDE
+#define MTL_VPT_VPT_TRACE_INCLUDE
+
+// Built-in tracing of the vampir_trace events, enabled with MTL_WITH_TRACE.
+// Every thread records its events into its own ring buffer without locks. After the run (or when the
+// traced threads are idle) the events are exported as Chrome trace (JSON, also read by Perfetto) or
+// aggregated into a summary per event.
+// With MTL_TRACE_COUNTERS, every event also records the cycles, instructions and last-level cache misses
+// of its thread with perf_event_open (a system call per event, thus only for coarse-grained events).
+// When the environment variable MTL_TRACE_FILE is set, the trace is written to this file at program exit;
+// when MTL_TRACE_SUMMARY is set, the summary is printed to std::cerr at program exit.
+
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#  error "The built-in tracing (MTL_WITH_TRACE) needs C++11."
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+
+#include <boost/numeric/mtl/utility/exception.hpp>
+#ifdef MTL_TRACE_COUNTERS
+#  include <boost/numeric/mtl/utility/perf_counter.hpp>
+#endif
+
+#ifndef MTL_TRACE_BUFFER_SIZE
+#  define MTL_TRACE_BUFFER_SIZE (1 << 18)
+#endif
+
+namespace mtl { namespace vpt {
+
+/// Number of hardware counters per event: cycles, instructions and last-level cache misses
+const int trace_num_counters= 3;
+
+/// Bytes per last-level cache miss to estimate the memory traffic
+const int trace_cache_line= 64;
+
+static_assert(MTL_TRACE_BUFFER_SIZE > 0 && (MTL_TRACE_BUFFER_SIZE & (MTL_TRACE_BUFFER_SIZE - 1)) == 0,
+	      "MTL_TRACE_BUFFER_SIZE must be a power of 2.");
+
+/// Event recorded by the built-in tracing
+struct trace_event
+{
+    std::uint64_t time;  ///< Nanoseconds of std::chrono::steady_clock
+    int           id;    ///< Number N of vampir_trace<N>
+    int           enter; ///< 1 at the entry and 0 at the end of the traced block
+#ifdef MTL_TRACE_COUNTERS
+    std::uint64_t counters[trace_num_counters]; ///< Counted in the thread since its first event
+#endif
+};
+
+/// Ring buffer of the events of one thread
+/** Only the owning thread writes, readers take a snapshot.
+    When the buffer is full, the oldest events are overwritten. **/
+class trace_buffer
+{
+    trace_buffer(const trace_buffer&);
+    trace_buffer& operator=(const trace_buffer&);
+
+  public:
+    trace_buffer(std::size_t capacity, int thread) : events(capacity), head(0), thread(thread)
+    {
+#     ifdef MTL_TRACE_COUNTERS
+	// Created in the owning thread, missing events are counted as 0
+	const char* names[]= {"cycles", "instructions", "cache-misses"};
+	for (int i= 0; i < trace_num_counters; i++)
+	    index[i]= counter.is_event_supported(names[i]) ? counter.add_event(names[i]) : -1;
+	if (counter.num_events() > 0)
+	    counter.start();
+#     endif
+    }
+
+    /// Append event
+    void record(int id, bool enter)
+    {
+	const std::uint64_t h= head.load(std::memory_order_relaxed);
+	trace_event& e= events[h & (events.size() - 1)];
+	e.time= std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                          std::chrono::steady_clock::now().time_since_epoch()).count());
+	e.id= id;
+	e.enter= enter;
+#     ifdef MTL_TRACE_COUNTERS
+	const bool valid= counter.num_events() > 0 && counter.try_read();
+	for (int i= 0; i < trace_num_counters; i++)
+	    e.counters[i]= valid && index[i] >= 0 ? std::uint64_t(counter[index[i]]) : 0;
+#     endif
+	head.store(h + 1, std::memory_order_release);
+    }
+
+    /// Retained events in chronological order
+    std::vector<trace_event> snapshot() const
+    {
+	const std::uint64_t h= head.load(std::memory_order_acquire), n= std::min<std::uint64_t>(h, events.size());
+	std::vector<trace_event> v;
+	v.reserve(n);
+	for (std::uint64_t i= h - n; i < h; i++)
+	    v.push_back(events[i & (events.size() - 1)]);
+	return v;
+    }
+
+    /// Number of overwritten events
+    std::uint64_t dropped() const
+    {
+	const std::uint64_t h= head.load(std::memory_order_acquire);
+	return h > events.size() ? h - events.size() : 0;
+    }
+
+    /// Remove all events
+    void clear() { head.store(0, std::memory_order_release); }
+
+    /// Number of the thread in the order of the first traced event
+    int thread_id() const { return thread; }
+
+  private:
+    std::vector<trace_event>   events;
+    std::atomic<std::uint64_t> head;
+    int                        thread;
+#ifdef MTL_TRACE_COUNTERS
+    utility::perf_counter_t    counter;
+    int                        index[trace_num_counters];
+#endif
+};
+
+namespace detail {
+
+    inline void write_trace_at_exit();
+
+    // Owns the buffers of all threads; never destroyed so that tracing during static destruction is safe
+    class trace_registry
+    {
+      public:
+	static trace_registry& instance()
+	{
+	    static trace_registry* r= new trace_registry;
+	    return *r;
+	}
+
+	trace_buffer* add()
+	{
+	    std::lock_guard<std::mutex> lock(m);
+	    buffers.push_back(std::unique_ptr<trace_buffer>(new trace_buffer(MTL_TRACE_BUFFER_SIZE, int(buffers.size()))));
+	    return buffers.back().get();
+	}
+
+	std::vector<trace_buffer*> all()
+	{
+	    std::lock_guard<std::mutex> lock(m);
+	    std::vector<trace_buffer*> v;
+	    for (std::size_t i= 0; i < buffers.size(); i++)
+		v.push_back(buffers[i].get());
+	    return v;
+	}
+
+      private:
+	trace_registry()
+	{
+	    if (std::getenv("MTL_TRACE_FILE") || std::getenv("MTL_TRACE_SUMMARY"))
+		std::atexit(&write_trace_at_exit);
+	}
+
+	std::mutex                                 m;
+	std::vector<std::unique_ptr<trace_buffer> > buffers;
+    };
+
+    inline trace_buffer& local_trace_buffer()
+    {
+	static thread_local trace_buffer* buffer= 0;
+	if (!buffer)
+	    buffer= trace_registry::instance().add();
+	return *buffer;
+    }
+
+    inline std::map<int, std::string> trace_names()
+    {
+	std::map<int, std::string> names;
+#       define MTL_VPT_NAME(Id, Name) names[Id]= Name;
+#       include <boost/numeric/mtl/interface/vpt_names.hpp>
+#       undef MTL_VPT_NAME
+	return names;
+    }
+
+    // Completed traced block
+    struct trace_span
+    {
+	int           id, thread;
+	std::uint64_t begin, end, self; // nanoseconds since the first retained event
+	bool          outermost;        // not nested in a block with the same id
+	std::uint64_t counters[trace_num_counters];
+    };
+
+    struct trace_frame
+    {
+	int           id;
+	std::uint64_t begin, children;
+	trace_event   entry;
+    };
+
+    // Counter increments from a to b
+#ifdef MTL_TRACE_COUNTERS
+    inline void trace_counter_difference(const trace_event& a, const trace_event& b, std::uint64_t* counters)
+    {
+	for (int i= 0; i < trace_num_counters; i++)
+	    counters[i]= b.counters[i] >= a.counters[i] ? b.counters[i] - a.counters[i] : 0;
+    }
+#else
+    inline void trace_counter_difference(const trace_event&, const trace_event&, std::uint64_t* counters)
+    {
+	std::fill(counters, counters + trace_num_counters, std::uint64_t(0));
+    }
+#endif
+
+    // Match the entries and ends of all threads; unmatched events are ignored
+    inline std::vector<trace_span> trace_spans()
+    {
+	std::vector<trace_buffer*>             buffers(trace_registry::instance().all());
+	std::vector<std::vector<trace_event> > events;
+	std::uint64_t                          origin= std::uint64_t(-1);
+	for (std::size_t t= 0; t < buffers.size(); t++) {
+	    events.push_back(buffers[t]->snapshot());
+	    if (!events.back().empty())
+		origin= std::min(origin, events.back().front().time);
+	}
+
+	std::vector<trace_span> spans;
+	for (std::size_t t= 0; t < buffers.size(); t++) {
+	    std::vector<trace_frame> stack;
+	    std::map<int, int>       active;
+	    for (std::size_t i= 0; i < events[t].size(); i++) {
+		const trace_event& e= events[t][i];
+		if (e.enter) {
+		    trace_frame f= {e.id, e.time, 0, e};
+		    stack.push_back(f);
+		    active[e.id]++;
+		    continue;
+		}
+		std::size_t k= stack.size();
+		while (k > 0 && stack[k-1].id != e.id)
+		    k--;
+		if (k == 0) // entry overwritten
+		    continue;
+		for (; stack.size() > k; stack.pop_back()) // entries without end
+		    active[stack.back().id]--;
+		const trace_frame f= stack.back();
+		stack.pop_back();
+		const std::uint64_t duration= e.time - f.begin;
+		trace_span s= {e.id, buffers[t]->thread_id(), f.begin - origin, e.time - origin,
+			       duration - std::min(duration, f.children), --active[e.id] == 0, {}};
+		trace_counter_difference(f.entry, e, s.counters);
+		spans.push_back(s);
+		if (!stack.empty())
+		    stack.back().children+= duration;
+	    }
+	}
+	return spans;
+    }
+
+    inline void write_json_string(std::ostream& os, const std::string& s)
+    {
+	os << '"';
+	for (std::size_t i= 0; i < s.size(); i++) {
+	    const unsigned char c= (unsigned char)(s[i]);
+	    if (c == '"' || c == '\\')
+		os << '\\' << s[i];
+	    else if (c < 0x20) {
+		char buffer[8];
+		std::snprintf(buffer, sizeof(buffer), "\\u%04x", unsigned(c));
+		os << buffer;
+	    } else
+		os << s[i];
+	}
+	os << '"';
+    }
+
+    // Nanoseconds as microseconds with 3 decimals
+    inline void write_microseconds(std::ostream& os, std::uint64_t ns)
+    {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%llu.%03u", (unsigned long long)(ns / 1000), unsigned(ns % 1000));
+	os << buffer;
+    }
+
+} // namespace detail
+
+/// Record the entry (\p enter true) or the end of the event \p id for the calling thread
+inline void record_trace_event(int id, bool enter)
+{
+    detail::local_trace_buffer().record(id, enter);
+}
+
+namespace detail {
+
+    // Never destroyed since used at exit
+    struct trace_name_table
+    {
+	static trace_name_table& instance()
+	{
+	    static trace_name_table* t= new trace_name_table;
+	    return *t;
+	}
+
+	std::mutex                 m;
+	std::map<int, std::string> names;
+
+      private:
+	trace_name_table() : names(trace_names()) {}
+    };
+
+} // namespace detail
+
+/// Set the name of event \p id, e.g. for the events of applications (with numbers above 10,000)
+inline void set_trace_event_name(int id, const std::string& name)
+{
+    detail::trace_name_table& t= detail::trace_name_table::instance();
+    std::lock_guard<std::mutex> lock(t.m);
+    t.names[id]= name;
+}
+
+/// Name of event \p id from the vampir_trace name list, "vpt_<id>" for events without name
+inline std::string trace_event_name(int id)
+{
+    detail::trace_name_table& t= detail::trace_name_table::instance();
+    {
+	std::lock_guard<std::mutex> lock(t.m);
+	std::map<int, std::string>::const_iterator it= t.names.find(id);
+	if (it != t.names.end() && !it->second.empty())
+	    return it->second;
+    }
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "vpt_%d", id);
+    return buffer;
+}
+
+/// Remove all recorded events; must not be called while traced code runs in other threads
+inline void clear_trace()
+{
+    std::vector<trace_buffer*> buffers(detail::trace_registry::instance().all());
+    for (std::size_t t= 0; t < buffers.size(); t++)
+	buffers[t]->clear();
+}
+
+/// Number of events lost by overflow of the ring buffers (see MTL_TRACE_BUFFER_SIZE)
+inline std::uint64_t trace_dropped_events()
+{
+    std::vector<trace_buffer*> buffers(detail::trace_registry::instance().all());
+    std::uint64_t              dropped= 0;
+    for (std::size_t t= 0; t < buffers.size(); t++)
+	dropped+= buffers[t]->dropped();
+    return dropped;
+}
+
+/// Write the completed events as Chrome trace (JSON) to \p os
+/** The output can be viewed with chrome://tracing or https://ui.perfetto.dev.
+    Events whose entry or end is not recorded (overwritten or still running) are omitted. **/
+inline void write_chrome_trace(std::ostream& os)
+{
+    std::vector<detail::trace_span> spans(detail::trace_spans());
+    os << "{\"traceEvents\":[";
+    for (std::size_t i= 0; i < spans.size(); i++) {
+	const detail::trace_span& s= spans[i];
+	os << (i ? ",\n" : "\n") << "{\"name\":";
+	detail::write_json_string(os, trace_event_name(s.id));
+	os << ",\"cat\":\"mtl\",\"ph\":\"X\",\"pid\":0,\"tid\":" << s.thread << ",\"ts\":";
+	detail::write_microseconds(os, s.begin);
+	os << ",\"dur\":";
+	detail::write_microseconds(os, s.end - s.begin);
+	os << ",\"args\":{\"id\":" << s.id;
+#     ifdef MTL_TRACE_COUNTERS
+	os << ",\"cycles\":" << s.counters[0] << ",\"instructions\":" << s.counters[1]
+	   << ",\"cache_misses\":" << s.counters[2];
+#     endif
+	os << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+/// Write the completed events as Chrome trace (JSON) to the file \p file_name
+inline void write_chrome_trace(const std::string& file_name)
+{
+    std::ofstream os(file_name.c_str());
+    MTL_THROW_IF(!os, io_error(("Cannot create file " + file_name).c_str()));
+    write_chrome_trace(os);
+    MTL_THROW_IF(!os, io_error(("Cannot write file " + file_name).c_str()));
+}
+
+/// Aggregated times of one event over all threads
+struct trace_statistics
+{
+    int         id;
+    std::string name;
+    std::size_t count;  ///< Number of completed blocks
+    double      total;  ///< Seconds within the blocks, nested blocks of the same event are counted once
+    double      self;   ///< Seconds within the blocks without nested traced blocks
+    double      cycles;       ///< Counted like total time with MTL_TRACE_COUNTERS, otherwise 0
+    double      instructions; ///< Counted like total time with MTL_TRACE_COUNTERS, otherwise 0
+    double      bytes;        ///< Memory traffic estimated from last-level cache misses with MTL_TRACE_COUNTERS
+};
+
+/// Statistics of all recorded events, sorted by decreasing self time
+inline std::vector<trace_statistics> trace_summary()
+{
+    std::vector<detail::trace_span> spans(detail::trace_spans());
+    std::map<int, trace_statistics> stats;
+    for (std::size_t i= 0; i < spans.size(); i++) {
+	const detail::trace_span& s= spans[i];
+	std::map<int, trace_statistics>::iterator it= stats.find(s.id);
+	if (it == stats.end()) {
+	    trace_statistics st= {s.id, trace_event_name(s.id), 0, 0.0, 0.0, 0.0, 0.0, 0.0};
+	    it= stats.insert(std::make_pair(s.id, st)).first;
+	}
+	it->second.count++;
+	if (s.outermost) {
+	    it->second.total+= 1e-9 * double(s.end - s.begin);
+	    it->second.cycles+= double(s.counters[0]);
+	    it->second.instructions+= double(s.counters[1]);
+	    it->second.bytes+= double(trace_cache_line) * double(s.counters[2]);
+	}
+	it->second.self+= 1e-9 * double(s.self);
+    }
+    std::vector<trace_statistics> v;
+    for (std::map<int, trace_statistics>::const_iterator it= stats.begin(); it != stats.end(); ++it)
+	v.push_back(it->second);
+    std::stable_sort(v.begin(), v.end(), [](const trace_statistics& x, const trace_statistics& y) { return x.self > y.self; });
+    return v;
+}
+
+/// Print the trace summary as table to \p os
+inline void print_trace_summary(std::ostream& os)
+{
+    std::vector<trace_statistics> v(trace_summary());
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-40s %6s %12s %14s %14s", "event", "id", "count", "total [s]", "self [s]");
+    os << line;
+#ifdef MTL_TRACE_COUNTERS
+    std::snprintf(line, sizeof(line), " %8s %12s %10s", "IPC", "bytes", "GB/s");
+    os << line;
+#endif
+    os << '\n';
+    for (std::size_t i= 0; i < v.size(); i++) {
+	std::snprintf(line, sizeof(line), "%-40.40s %6d %12llu %14.6f %14.6f", v[i].name.c_str(), v[i].id,
+		      (unsigned long long)(v[i].count), v[i].total, v[i].self);
+	os << line;
+#     ifdef MTL_TRACE_COUNTERS
+	std::snprintf(line, sizeof(line), " %8.3f %12.4g %10.3f", v[i].cycles > 0.0 ? v[i].instructions / v[i].cycles : 0.0,
+		      v[i].bytes, v[i].total > 0.0 ? 1e-9 * v[i].bytes / v[i].total : 0.0);
+	os << line;
+#     endif
+	os << '\n';
+    }
+    if (std::uint64_t dropped= trace_dropped_events())
+	os << dropped << " events were overwritten, increase MTL_TRACE_BUFFER_SIZE for a complete trace.\n";
+}
+
+namespace detail {
+
+    inline void write_trace_at_exit()
+    {
+	try {
+	    if (const char* file_name= std::getenv("MTL_TRACE_FILE"))
+		write_chrome_trace(std::string(file_name));
+	    if (std::getenv("MTL_TRACE_SUMMARY"))
+		print_trace_summary(std::cerr);
+	} catch (...) {}
+    }
+
+} // namespace detail
+
+}} // namespace mtl::vpt
+
+#endif // MTL_VPT_VPT_TRACE_INCLUDE
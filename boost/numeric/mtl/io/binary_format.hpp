@@ -0,0 +1,646 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_IO_BINARY_FORMAT_INCLUDE
+#define MTL_IO_BINARY_FORMAT_INCLUDE
+
+// Native binary format for dense_vector, dense2D, compressed2D and element_structure.
+// A file consists of a binary_header followed by the raw arrays of the collection,
+// each starting at an offset that is a multiple of 64 bytes.
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <complex>
+#include <limits>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/io/mapped_file.hpp>
+#include <boost/numeric/mtl/io/matrix_file.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/is_row_major.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/compressed2D.hpp>
+#include <boost/numeric/mtl/matrix/element_structure.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+
+namespace mtl { namespace io {
+
+/// Current version of the binary format; files with higher versions are rejected
+const boost::uint32_t binary_version= 1;
+
+/// Kinds of collections in binary files
+enum binary_kind { binary_dense_vector= 1, binary_dense2D= 2, binary_compressed2D= 3, binary_element_structure= 4 };
+
+/// Kinds of values and indices in binary files (their size is stored separately)
+enum binary_value_kind { binary_real= 1, binary_complex= 2, binary_signed= 3, binary_unsigned= 4 };
+
+/// Flags in binary files
+enum binary_flag { binary_column_major= 1 };
+
+/// Header of binary files
+/** The arrays are:
+    - dense_vector: 0 values (rows entries);
+    - dense2D: 0 values (rows * cols, column-wise if binary_column_major is set);
+    - compressed2D: 0 starts (rows+1 or cols+1), 1 minor indices (entries), 2 values (entries);
+    - element_structure with entries elements: 0 index starts (entries+1), 1 indices,
+      2 values (row-wise element matrices), 3 neighbor starts (entries+1), 4 neighbor positions. **/
+struct binary_header
+{
+    char            magic[8];     ///< "MTL4BIN" with terminating zero
+    boost::uint32_t version;      ///< Format version
+    boost::uint32_t byte_order;   ///< 0x01020304 in the byte order of the writer
+    boost::uint32_t kind;         ///< Collection kind (binary_kind)
+    boost::uint32_t flags;        ///< Or-ed binary_flag values
+    boost::uint32_t value_kind;   ///< Kind of the values (binary_value_kind)
+    boost::uint32_t value_bytes;  ///< Size of a value
+    boost::uint32_t major_bytes;  ///< Size of the (unsigned) entries in start arrays
+    boost::uint32_t minor_kind;   ///< Kind of the minor indices, element indices and neighbor positions
+    boost::uint32_t minor_bytes;  ///< Size of the minor indices, element indices and neighbor positions
+    boost::uint32_t reserved32;
+    boost::uint64_t rows, cols;   ///< Dimensions (a vector has one column; element structures as many rows as variables)
+    boost::uint64_t entries;      ///< Number of non-zeros in compressed2D and of elements in element_structure
+    boost::uint64_t offset[6];    ///< Byte positions of the arrays
+    boost::uint64_t reserved64;
+};
+
+BOOST_STATIC_ASSERT((sizeof(binary_header) == 128));
+
+namespace detail {
+
+    template <typename Value>
+    struct binary_value_traits
+    {
+	static const boost::uint32_t kind= std::numeric_limits<Value>::is_integer
+	                                   ? (std::numeric_limits<Value>::is_signed ? binary_signed : binary_unsigned) : binary_real;
+    };
+
+    template <typename Value>
+    struct binary_value_traits<std::complex<Value> >
+    {
+	static const boost::uint32_t kind= binary_complex;
+    };
+
+    inline std::size_t binary_align(std::size_t n) { return (n + 63) / 64 * 64; }
+
+    template <typename Value>
+    inline void swap_bytes(Value& x)
+    {
+	char* p= reinterpret_cast<char*>(&x);
+	for (std::size_t i= 0, j= sizeof(Value) - 1; i < j; i++, j--)
+	    std::swap(p[i], p[j]);
+    }
+
+    template <typename Value>
+    inline void swap_bytes(std::complex<Value>& x)
+    {
+	Value r= x.real(), i= x.imag();
+	swap_bytes(r); swap_bytes(i);
+	x= std::complex<Value>(r, i);
+    }
+
+    template <typename Source, typename Target>
+    inline void assign_binary_value(const Source& s, Target& t) { t= Target(s); }
+
+    template <typename Source, typename Target>
+    inline void assign_binary_value(const Source& s, std::complex<Target>& t) { t= std::complex<Target>(Target(s)); }
+
+    template <typename Source, typename Target>
+    inline void assign_binary_value(const std::complex<Source>& s, std::complex<Target>& t) { t= std::complex<Target>(s); }
+
+    template <typename Source, typename Target>
+    inline void assign_binary_value(const std::complex<Source>&, Target&)
+    {
+	MTL_THROW(io_error("Complex values in binary file cannot be read into real or integer types"));
+    }
+
+    template <typename Source, typename Target>
+    inline void convert_binary(const char* p, std::size_t n, bool swapped, Target* dest)
+    {
+	for (std::size_t i= 0; i < n; i++) {
+	    Source s;
+	    std::memcpy(&s, p + i * sizeof(Source), sizeof(Source));
+	    if (swapped)
+		swap_bytes(s);
+	    assign_binary_value(s, dest[i]);
+	}
+    }
+}
+
+/// Output file stream for the native binary format
+/** The values are written in the byte order and representation of this platform.
+    \sa binary_file **/
+class binary_ostream
+{
+    typedef binary_ostream self;
+  public:
+    /// Create file \p file_name; throws io_error if this is not possible
+    explicit binary_ostream(const std::string& file_name)
+      : file_name(file_name), os(file_name.c_str(), std::ios::binary), pos(0)
+    {
+	MTL_THROW_IF(!os, io_error(("Cannot create file " + file_name).c_str()));
+    }
+
+    /// Write dense vector
+    template <typename Value, typename Parameters>
+    self& operator<<(const vec::dense_vector<Value, Parameters>& v)
+    {
+	vampir_trace<4038> tracer;
+	const std::size_t n= size(v), bytes[]= {n * sizeof(Value)};
+	binary_header h= header<Value>(binary_dense_vector, n, 1);
+	layout(h, bytes, 1);
+	write_header(h);
+	if (n > 0)
+	    write(h.offset[0], &v[0], bytes[0]);
+	return finish();
+    }
+
+    /// Write dense matrix (also sub-matrices)
+    template <typename Value, typename Parameters>
+    self& operator<<(const mat::dense2D<Value, Parameters>& A)
+    {
+	vampir_trace<4038> tracer;
+	const bool row= traits::is_row_major<Parameters>::value;
+	const std::size_t r= num_rows(A), c= num_cols(A), lines= row ? r : c, line= row ? c : r,
+	                  bytes[]= {r * c * sizeof(Value)};
+	binary_header h= header<Value>(binary_dense2D, r, c);
+	h.flags= row ? 0 : binary_column_major;
+	layout(h, bytes, 1);
+	write_header(h);
+	if (A.get_ldim() == line)
+	    write(h.offset[0], A.address_data(), bytes[0]);
+	else
+	    for (std::size_t i= 0; i < lines; i++)
+		write(h.offset[0] + i * line * sizeof(Value), A.address_data() + i * A.get_ldim(), line * sizeof(Value));
+	return finish();
+    }
+
+    /// Write sparse matrix with its start and index arrays
+    template <typename Value, typename Parameters>
+    self& operator<<(const mat::compressed2D<Value, Parameters>& A)
+    {
+	vampir_trace<4038> tracer;
+	typedef typename mat::compressed2D<Value, Parameters>::size_type        size_type;
+	typedef typename mat::compressed2D<Value, Parameters>::minor_index_type minor_index_type;
+	const bool        row= traits::is_row_major<Parameters>::value;
+	const std::size_t nnz= A.nnz(), dim1= row ? num_rows(A) : num_cols(A),
+	                  bytes[]= {(dim1 + 1) * sizeof(size_type), nnz * sizeof(minor_index_type), nnz * sizeof(Value)};
+	binary_header h= header<Value>(binary_compressed2D, num_rows(A), num_cols(A));
+	h.flags= row ? 0 : binary_column_major;
+	index_types<size_type, minor_index_type>(h);
+	h.entries= nnz;
+	layout(h, bytes, 3);
+	write_header(h);
+	const std::vector<size_type> empty_starts(A.ref_major().size() == dim1 + 1 ? 0 : dim1 + 1, size_type(0));
+	write(h.offset[0], empty_starts.empty() ? &A.ref_major()[0] : &empty_starts[0], bytes[0]);
+	if (nnz > 0) {
+	    write(h.offset[1], &A.ref_minor()[0], bytes[1]);
+	    write(h.offset[2], &A.data[0], bytes[2]);
+	}
+	return finish();
+    }
+
+    /// Write element structure; neighbors are stored by their position
+    template <typename Value>
+    self& operator<<(const mat::element_structure<Value>& es)
+    {
+	vampir_trace<4038> tracer;
+	typedef typename mat::element_structure<Value>::element_iterator iterator;
+	const std::size_t ne= es.get_total_elements();
+	std::vector<boost::uint64_t> index_starts(1, 0), neighbor_starts(1, 0);
+	std::size_t values= 0;
+	for (iterator it= es.element_begin(); it != es.element_end(); ++it) {
+	    index_starts.push_back(index_starts.back() + it->nb_vars());
+	    neighbor_starts.push_back(neighbor_starts.back() + it->get_neighbors().size());
+	    values+= it->nb_values();
+	}
+	const std::size_t bytes[]= {(ne + 1) * 8, index_starts.back() * sizeof(int), values * sizeof(Value),
+				    (ne + 1) * 8, neighbor_starts.back() * sizeof(int)};
+	binary_header h= header<Value>(binary_element_structure, es.get_total_vars(), es.get_total_vars());
+	index_types<boost::uint64_t, int>(h);
+	h.entries= ne;
+	layout(h, bytes, 5);
+	write_header(h);
+	write(h.offset[0], &index_starts[0], bytes[0]);
+	pad(h.offset[1]);
+	for (iterator it= es.element_begin(); it != es.element_end(); ++it)
+	    if (it->nb_vars() > 0)
+		write(&it->get_indices()[0], it->nb_vars() * sizeof(int));
+	pad(h.offset[2]);
+	for (iterator it= es.element_begin(); it != es.element_end(); ++it)
+	    write(it->get_values().address_data(), it->nb_values() * sizeof(Value));
+	write(h.offset[3], &neighbor_starts[0], bytes[3]);
+	pad(h.offset[4]);
+	for (iterator it= es.element_begin(); it != es.element_end(); ++it)
+	    for (std::size_t i= 0; i < it->get_neighbors().size(); i++) {
+		const int position= int(it->get_neighbors()[i] - es.element_begin());
+		write(&position, sizeof(int));
+	    }
+	return finish();
+    }
+
+  private:
+    template <typename Value>
+    binary_header header(binary_kind kind, std::size_t r, std::size_t c)
+    {
+	binary_header h;
+	std::memset(&h, 0, sizeof(h));
+	std::memcpy(h.magic, "MTL4BIN", 8);
+	h.version= binary_version;
+	h.byte_order= 0x01020304;
+	h.kind= kind;
+	h.value_kind= detail::binary_value_traits<Value>::kind;
+	h.value_bytes= sizeof(Value);
+	h.rows= r; h.cols= c; h.entries= r * c;
+	return h;
+    }
+
+    template <typename Major, typename Minor>
+    void index_types(binary_header& h)
+    {
+	h.major_bytes= sizeof(Major);
+	h.minor_kind= detail::binary_value_traits<Minor>::kind;
+	h.minor_bytes= sizeof(Minor);
+    }
+
+    void layout(binary_header& h, const std::size_t* bytes, int n)
+    {
+	std::size_t p= detail::binary_align(sizeof(binary_header));
+	for (int i= 0; i < n; i++) {
+	    h.offset[i]= p;
+	    p= detail::binary_align(p + bytes[i]);
+	}
+    }
+
+    void write_header(const binary_header& h) { write(&h, sizeof(h)); }
+
+    // Fill with zeros up to offset
+    void pad(boost::uint64_t offset)
+    {
+	static const char zeros[64]= {0};
+	MTL_DEBUG_THROW_IF(offset < pos, logic_error("Binary arrays written out of order"));
+	while (offset > pos) {
+	    const std::size_t n= std::min(std::size_t(offset - pos), sizeof(zeros));
+	    os.write(zeros, std::streamsize(n));
+	    pos+= n;
+	}
+    }
+
+    void write(const void* p, std::size_t n)
+    {
+	os.write(static_cast<const char*>(p), std::streamsize(n));
+	pos+= n;
+    }
+
+    void write(boost::uint64_t offset, const void* p, std::size_t n)
+    {
+	pad(offset);
+	write(p, n);
+    }
+
+    self& finish()
+    {
+	os.flush();
+	MTL_THROW_IF(!os, io_error(("Error in writing file " + file_name).c_str()));
+	return *this;
+    }
+
+    std::string   file_name;
+    std::ofstream os;
+    std::size_t   pos;
+};
+
+/// Memory-mapped file in the native binary format
+/** load() lets dense vectors, dense matrices and element structures refer directly to the mapped
+    arrays when the file has the value type, orientation and byte order of the collection.
+    The file is mapped copy-on-write: the collections can be modified without changing the file
+    (but the changes are seen by all collections loaded from this binary_file)
+    and only the touched pages are read from disk.  Such collections must not be used
+    after the binary_file is destroyed.  In all other cases, the values are converted and copied.
+    Sparse matrices are always copied since compressed2D owns its arrays.
+    \code
+    mtl::io::binary_file f("A.bin");
+    mtl::dense2D<double> A;
+    f.load(A);   // A refers to the mapped memory of f
+    \endcode **/
+class binary_file
+{
+  public:
+    /// Map the file \p file_name; throws file_not_found or io_error if it is not a valid binary file
+    explicit binary_file(const std::string& file_name) : file(file_name, true), file_name(file_name)
+    {
+	MTL_THROW_IF(file.size() < sizeof(binary_header) || std::memcmp(file.data(), "MTL4BIN", 8) != 0,
+		     io_error((file_name + " is not a binary MTL file").c_str()));
+	std::memcpy(&my_header, file.data(), sizeof(binary_header));
+	swapped= my_header.byte_order == 0x04030201;
+	if (swapped)
+	    swap_header();
+	MTL_THROW_IF(my_header.byte_order != 0x01020304, io_error(("Unknown byte order in " + file_name).c_str()));
+	MTL_THROW_IF(my_header.version > binary_version,
+		     io_error(("Binary format of " + file_name + " is newer than this library").c_str()));
+    }
+
+    /// The header of the file
+    const binary_header& header() const { return my_header; }
+
+    /// Whether the file was written on a platform with different byte order
+    bool is_swapped() const { return swapped; }
+
+    /// Load dense vector; returns true if \p v refers to the file (like a vector constructed from an address)
+    template <typename Value, typename Parameters>
+    bool load(vec::dense_vector<Value, Parameters>& v, bool zero_copy= true)
+    {
+	vampir_trace<4039> tracer;
+	check_kind(binary_dense_vector, "a dense vector");
+	const std::size_t n= my_header.rows;
+	char* p= array(0, n, my_header.value_bytes);
+	if (zero_copy && wrap(v, n, view<Value>(p), boost::mpl::bool_<Parameters::on_stack>()))
+	    return true;
+	v.change_dim(n);
+	convert(p, n, my_header.value_kind, my_header.value_bytes, v.address_data());
+	return false;
+    }
+
+    /// Load dense matrix; returns true if \p A refers to the file
+    template <typename Value, typename Parameters>
+    bool load(mat::dense2D<Value, Parameters>& A, bool zero_copy= true)
+    {
+	vampir_trace<4039> tracer;
+	check_kind(binary_dense2D, "a dense matrix");
+	const std::size_t r= my_header.rows, c= my_header.cols;
+	const bool        row= !(my_header.flags & binary_column_major);
+	char*             p= array(0, r * c, my_header.value_bytes);
+	if (row == traits::is_row_major<Parameters>::value) {
+	    if (zero_copy && wrap(A, r, c, view<Value>(p), boost::mpl::bool_<Parameters::on_stack>()))
+		return true;
+	    A.change_dim(r, c);
+	    if (A.get_ldim() == (row ? c : r)) {
+		convert(p, r * c, my_header.value_kind, my_header.value_bytes, A.address_data());
+		return false;
+	    }
+	}
+	// Other orientation or sub-matrix
+	std::vector<Value> buffer(r * c);
+	convert(p, r * c, my_header.value_kind, my_header.value_bytes, &buffer[0]);
+	A.change_dim(r, c);
+	for (std::size_t i= 0; i < r; i++)
+	    for (std::size_t j= 0; j < c; j++)
+		A[i][j]= buffer[row ? i * c + j : j * r + i];
+	return false;
+    }
+
+    /// Load sparse matrix (always copied); returns false
+    template <typename Value, typename Parameters>
+    bool load(mat::compressed2D<Value, Parameters>& A, bool= true)
+    {
+	vampir_trace<4039> tracer;
+	check_kind(binary_compressed2D, "a sparse matrix");
+	const bool row= !(my_header.flags & binary_column_major);
+	if (row != traits::is_row_major<Parameters>::value) {
+	    typedef mat::parameters<typename boost::mpl::if_c<traits::is_row_major<Parameters>::value, col_major, row_major>::type,
+				    typename Parameters::index, typename Parameters::dimensions, Parameters::on_stack,
+				    typename Parameters::size_type, typename Parameters::allocator,
+				    typename Parameters::minor_index_type> other_parameters;
+	    mat::compressed2D<Value, other_parameters> B;
+	    load(B);
+	    A.change_dim(num_rows(B), num_cols(B));
+	    A= B;
+	    return false;
+	}
+
+	const std::size_t r= my_header.rows, c= my_header.cols, nnz= my_header.entries,
+	                  dim1= row ? r : c, dim2= row ? c : r;
+	const char *starts= array(0, dim1 + 1, my_header.major_bytes), *indices= array(1, nnz, my_header.minor_bytes),
+	           *values= array(2, nnz, my_header.value_bytes);
+	A.change_dim(r, c);
+	A.set_nnz(nnz);
+	convert(starts, dim1 + 1, binary_unsigned, my_header.major_bytes, &A.ref_major()[0]);
+	if (nnz > 0) {
+	    convert(indices, nnz, my_header.minor_kind, my_header.minor_bytes, &A.ref_minor()[0]);
+	    convert(values, nnz, my_header.value_kind, my_header.value_bytes, &A.data[0]);
+	}
+	// Corrupt arrays would let the operations access arbitrary memory
+	bool valid= A.ref_major()[0] == 0 && std::size_t(A.ref_major()[dim1]) == nnz;
+	for (std::size_t i= 0; valid && i < dim1; i++)
+	    valid= A.ref_major()[i] <= A.ref_major()[i+1];
+	for (std::size_t j= 0; valid && j < nnz; j++)
+	    valid= std::size_t(A.ref_minor()[j]) < dim2;
+	if (!valid) {
+	    A.make_empty();
+	    MTL_THROW(io_error(("Inconsistent sparse matrix in " + file_name).c_str()));
+	}
+	return false;
+    }
+
+    /// Load element structure; returns true if the element indices and matrices refer to the file
+    /** The elements are numbered by their position. **/
+    template <typename Value>
+    bool load(mat::element_structure<Value>& es, bool zero_copy= true)
+    {
+	vampir_trace<4039> tracer;
+	typedef typename mat::element_structure<Value>::element_type element_type;
+	typedef typename element_type::index_type                   index_type;
+	typedef typename element_type::matrix_type                  matrix_type;
+	check_kind(binary_element_structure, "an element structure");
+	const std::size_t ne= my_header.entries;
+
+	std::vector<std::size_t> index_starts(ne + 1), neighbor_starts(ne + 1);
+	convert(array(0, ne + 1, my_header.major_bytes), ne + 1, binary_unsigned, my_header.major_bytes, &index_starts[0]);
+	convert(array(3, ne + 1, my_header.major_bytes), ne + 1, binary_unsigned, my_header.major_bytes, &neighbor_starts[0]);
+	std::size_t values= 0;
+	for (std::size_t e= 0; e < ne; e++) {
+	    MTL_THROW_IF(index_starts[e] > index_starts[e+1] || neighbor_starts[e] > neighbor_starts[e+1],
+			 io_error(("Inconsistent element structure in " + file_name).c_str()));
+	    values+= (index_starts[e+1] - index_starts[e]) * (index_starts[e+1] - index_starts[e]);
+	}
+	char *indices= array(1, index_starts[ne], my_header.minor_bytes), *vals= array(2, values, my_header.value_bytes);
+	std::vector<int> neighbors(neighbor_starts[ne]);
+	if (!neighbors.empty())
+	    convert(array(4, neighbors.size(), my_header.minor_bytes), neighbors.size(), my_header.minor_kind,
+		    my_header.minor_bytes, &neighbors[0]);
+	for (std::size_t k= 0; k < neighbors.size(); k++)
+	    MTL_THROW_IF(neighbors[k] < 0 || std::size_t(neighbors[k]) >= ne,
+			 io_error(("Inconsistent element neighbors in " + file_name).c_str()));
+
+	int*   index_view= zero_copy ? view<int>(indices, my_header.minor_kind, my_header.minor_bytes) : 0;
+	Value* value_view= zero_copy ? view<Value>(vals) : 0;
+	element_type* elements= ne > 0 ? new element_type[ne] : 0;
+	try { // es owns the elements only after consume
+	    for (std::size_t e= 0, value_pos= 0; e < ne; e++) {
+		element_type&     el= elements[e];
+		const std::size_t s= index_starts[e+1] - index_starts[e];
+		el.get_id()= int(e);
+		if (index_view) {
+		    index_type tmp(s, index_view + index_starts[e]);
+		    swap(tmp, el.get_indices());
+		} else {
+		    el.get_indices().change_dim(s);
+		    convert(indices + index_starts[e] * my_header.minor_bytes, s, my_header.minor_kind, my_header.minor_bytes,
+			    s > 0 ? &el.get_indices()[0] : 0);
+		}
+		for (std::size_t k= 0; k < s; k++)
+		    MTL_THROW_IF(el.get_indices()[k] < 0 || boost::uint64_t(el.get_indices()[k]) >= my_header.rows,
+				 io_error(("Inconsistent element indices in " + file_name).c_str()));
+		if (value_view) {
+		    matrix_type tmp(s, s, value_view + value_pos);
+		    swap(tmp, el.get_values());
+		} else {
+		    el.get_values().change_dim(s, s);
+		    convert(vals + value_pos * my_header.value_bytes, s * s, my_header.value_kind, my_header.value_bytes,
+			    el.get_values().address_data());
+		}
+		value_pos+= s * s;
+		for (std::size_t k= neighbor_starts[e]; k < neighbor_starts[e+1]; k++)
+		    el.get_neighbors().push_back(elements + neighbors[k]);
+	    }
+	} catch (...) {
+	    delete[] elements;
+	    throw;
+	}
+	es.consume(int(ne), int(my_header.rows), elements);
+	return index_view && value_view;
+    }
+
+  private:
+    void check_kind(binary_kind kind, const char* what) const
+    {
+	const std::string message= file_name + " does not contain " + what;
+	MTL_THROW_IF(my_header.kind != boost::uint32_t(kind), io_error(message.c_str()));
+    }
+
+    // Begin of array i with n entries of size bytes; throws if it is not within the file
+    char* array(int i, std::size_t n, std::size_t bytes)
+    {
+	const boost::uint64_t offset= my_header.offset[i];
+	MTL_THROW_IF(bytes == 0 || (n > 0 && (offset < sizeof(binary_header) || offset > file.size()
+					     || n > (file.size() - offset) / bytes)),
+		     io_error(("Binary file " + file_name + " is truncated or corrupt").c_str()));
+	return file.data() + offset;
+    }
+
+    template <typename Value>
+    Value* view(char* p) { return view<Value>(p, my_header.value_kind, my_header.value_bytes); }
+
+    // Typed pointer if p contains Values in our byte order, otherwise 0
+    template <typename Value>
+    Value* view(char* p, boost::uint32_t kind, boost::uint32_t bytes)
+    {
+	return !swapped && kind == detail::binary_value_traits<Value>::kind && bytes == sizeof(Value)
+	       && reinterpret_cast<std::size_t>(p) % boost::alignment_of<Value>::value == 0 ? reinterpret_cast<Value*>(p) : 0;
+    }
+
+    template <typename Value, typename Parameters>
+    bool wrap(vec::dense_vector<Value, Parameters>& v, std::size_t n, Value* a, boost::mpl::false_)
+    {
+	if (!a)
+	    return false;
+	vec::dense_vector<Value, Parameters> tmp(n, a);
+	swap(v, tmp);
+	return true;
+    }
+
+    template <typename Value, typename Parameters>
+    bool wrap(mat::dense2D<Value, Parameters>& A, std::size_t r, std::size_t c, Value* a, boost::mpl::false_)
+    {
+	if (!a)
+	    return false;
+	mat::dense2D<Value, Parameters> tmp(r, c, a);
+	swap(A, tmp);
+	return true;
+    }
+
+    // Collections on the stack are always copied
+    template <typename Collection>
+    bool wrap(Collection&, std::size_t, typename Collection::value_type*, boost::mpl::true_) { return false; }
+    template <typename Collection>
+    bool wrap(Collection&, std::size_t, std::size_t, typename Collection::value_type*, boost::mpl::true_) { return false; }
+
+    template <typename Target>
+    void convert(const char* p, std::size_t n, boost::uint32_t kind, boost::uint32_t bytes, Target* dest) const
+    {
+	using detail::convert_binary;
+	if (n == 0)
+	    return;
+	if (kind == binary_real && bytes == sizeof(float))
+	    convert_binary<float>(p, n, swapped, dest);
+	else if (kind == binary_real && bytes == sizeof(double))
+	    convert_binary<double>(p, n, swapped, dest);
+	else if (kind == binary_real && bytes == sizeof(long double))
+	    convert_binary<long double>(p, n, swapped, dest);
+	else if (kind == binary_complex && bytes == sizeof(std::complex<float>))
+	    convert_binary<std::complex<float> >(p, n, swapped, dest);
+	else if (kind == binary_complex && bytes == sizeof(std::complex<double>))
+	    convert_binary<std::complex<double> >(p, n, swapped, dest);
+	else if (kind == binary_signed && bytes == 4)
+	    convert_binary<boost::int32_t>(p, n, swapped, dest);
+	else if (kind == binary_signed && bytes == 8)
+	    convert_binary<boost::int64_t>(p, n, swapped, dest);
+	else if (kind == binary_unsigned && bytes == 4)
+	    convert_binary<boost::uint32_t>(p, n, swapped, dest);
+	else if (kind == binary_unsigned && bytes == 8)
+	    convert_binary<boost::uint64_t>(p, n, swapped, dest);
+	else if ((kind == binary_signed || kind == binary_unsigned) && bytes == 2)
+	    kind == binary_signed ? convert_binary<boost::int16_t>(p, n, swapped, dest)
+		                  : convert_binary<boost::uint16_t>(p, n, swapped, dest);
+	else
+	    MTL_THROW(io_error(("Unsupported value type in " + file_name).c_str()));
+    }
+
+    void swap_header()
+    {
+	using detail::swap_bytes;
+	swap_bytes(my_header.version); swap_bytes(my_header.byte_order); swap_bytes(my_header.kind);
+	swap_bytes(my_header.flags); swap_bytes(my_header.value_kind); swap_bytes(my_header.value_bytes);
+	swap_bytes(my_header.major_bytes); swap_bytes(my_header.minor_kind); swap_bytes(my_header.minor_bytes);
+	swap_bytes(my_header.rows); swap_bytes(my_header.cols); swap_bytes(my_header.entries);
+	for (int i= 0; i < 6; i++)
+	    swap_bytes(my_header.offset[i]);
+    }
+
+    mapped_file   file;
+    std::string   file_name;
+    binary_header my_header;
+    bool          swapped;
+};
+
+/// Input file stream for the native binary format; the collections are always copied
+/** For collections that refer to the file without copying see binary_file. **/
+class binary_istream
+{
+    typedef binary_istream self;
+  public:
+    explicit binary_istream(const std::string& file_name) : file(file_name) {}
+
+    template <typename Collection>
+    self& operator>>(Collection& c)
+    {
+	file.load(c, false);
+	return *this;
+    }
+
+  private:
+    binary_file file;
+};
+
+}} // namespace mtl::io
+
+#endif // MTL_IO_BINARY_FORMAT_INCLUDE
@@ -0,0 +1,100 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_IO_FORMAT_NUMBER_INCLUDE
+#define MTL_IO_FORMAT_NUMBER_INCLUDE
+
+// Number formatting into character buffers (counterpart of parse_number.hpp).
+// All functions write at most max_formatted_number characters and return the position behind the number.
+
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <complex>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#if __cplusplus >= 201703L
+#  include <charconv>
+#endif
+#if defined(__cpp_lib_to_chars)
+#  define MTL_IO_WITH_TO_CHARS
+#endif
+
+namespace mtl { namespace io {
+
+/// Maximal number of characters written by the format functions for one (real or integer) number
+const std::size_t max_formatted_number= 48;
+
+/// Write non-negative integer \p v
+inline char* format_unsigned(char* p, unsigned long long v)
+{
+    char digits[24], *d= digits;
+    do {
+	*d++= char('0' + v % 10);
+	v/= 10;
+    } while (v != 0);
+    while (d != digits)
+	*p++= *--d;
+    return p;
+}
+
+/// Write integer \p v
+inline char* format_integer(char* p, long long v)
+{
+    if (v >= 0)
+	return format_unsigned(p, (unsigned long long)(v));
+    *p++= '-';
+    return format_unsigned(p, 0ull - (unsigned long long)(v));
+}
+
+/// Write floating point number \p v with the fewest digits that read back to the same value
+/** Without std::to_chars (C++17), the number is written with enough digits by snprintf. **/
+template <typename Value>
+inline char* format_real(char* p, Value v)
+{
+#ifdef MTL_IO_WITH_TO_CHARS
+    return std::to_chars(p, p + max_formatted_number, v).ptr;
+#else
+    const int n= std::snprintf(p, max_formatted_number, "%.*Lg", std::numeric_limits<Value>::digits10 + 3, (long double)(v));
+    return p + (n > 0 ? n : 0);
+#endif
+}
+
+/// Write integral value
+template <typename Value>
+inline typename boost::enable_if<boost::is_integral<Value>, char*>::type
+format_value(char* p, const Value& v)
+{
+    return boost::is_signed<Value>::value ? format_integer(p, (long long)(v)) : format_unsigned(p, (unsigned long long)(v));
+}
+
+/// Write floating point value
+template <typename Value>
+inline typename boost::disable_if<boost::is_integral<Value>, char*>::type
+format_value(char* p, const Value& v)
+{
+    return format_real(p, v);
+}
+
+/// Write complex value as real and imaginary part separated by a blank
+template <typename Value>
+inline char* format_value(char* p, const std::complex<Value>& v)
+{
+    p= format_real(p, v.real());
+    *p++= ' ';
+    return format_real(p, v.imag());
+}
+
+}} // namespace mtl::io
+
+#endif // MTL_IO_FORMAT_NUMBER_INCLUDE
@@ -0,0 +1,131 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_IO_GZIP_OSTREAM_INCLUDE
+#define MTL_IO_GZIP_OSTREAM_INCLUDE
+
+#ifdef MTL_WITH_ZLIB
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <streambuf>
+#include <zlib.h>
+
+#include <boost/numeric/mtl/utility/exception.hpp>
+
+namespace mtl { namespace io {
+
+/// Stream buffer that compresses its output into a gzip file with zlib
+class gzip_streambuf
+  : public std::streambuf
+{
+    // Not copyable
+    gzip_streambuf(const gzip_streambuf&);
+    gzip_streambuf& operator=(const gzip_streambuf&);
+
+  public:
+    /// Create \p file_name with compression \p level (1 is fastest, 9 is smallest)
+    explicit gzip_streambuf(const std::string& file_name, int level= 1) : buffer(1 << 20)
+    {
+	const char mode[]= {'w', 'b', char('0' + (level < 1 ? 1 : level > 9 ? 9 : level)), '\0'};
+	file= gzopen(file_name.c_str(), mode);
+	MTL_THROW_IF(!file, io_error(("Cannot create file " + file_name).c_str()));
+	gzbuffer(file, 1 << 18);
+	setp(&buffer[0], &buffer[0] + buffer.size());
+    }
+
+    ~gzip_streambuf() { close(); }
+
+    /// Compress the remaining output and close the file; returns false on errors
+    bool close()
+    {
+	if (!file)
+	    return true;
+	const bool ok= sync() == 0;
+	const int  status= gzclose(file);
+	file= 0;
+	return ok && status == Z_OK;
+    }
+
+  protected:
+    int_type overflow(int_type c)
+    {
+	if (sync() != 0)
+	    return traits_type::eof();
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+	    *pptr()= traits_type::to_char_type(c);
+	    pbump(1);
+	}
+	return traits_type::not_eof(c);
+    }
+
+    // Large blocks are passed directly to zlib
+    std::streamsize xsputn(const char* s, std::streamsize n)
+    {
+	if (n < std::streamsize(buffer.size()) / 4)
+	    return std::streambuf::xsputn(s, n);
+	if (sync() != 0)
+	    return 0;
+	return compress(s, std::size_t(n)) ? n : 0;
+    }
+
+    int sync()
+    {
+	const std::size_t n= std::size_t(pptr() - pbase());
+	setp(&buffer[0], &buffer[0] + buffer.size());
+	return n == 0 || compress(&buffer[0], n) ? 0 : -1;
+    }
+
+  private:
+    bool compress(const char* s, std::size_t n)
+    {
+	for (const std::size_t chunk= 1u << 30; n > 0; ) {
+	    const unsigned m= unsigned(n < chunk ? n : chunk);
+	    if (!file || gzwrite(file, s, m) != int(m))
+		return false;
+	    s+= m; n-= m;
+	}
+	return true;
+    }
+
+    gzFile            file;
+    std::vector<char> buffer;
+};
+
+/// Output stream into a gzip-compressed file
+class gzip_ostream
+  : public std::ostream
+{
+  public:
+    explicit gzip_ostream(const std::string& file_name, int level= 1) : std::ostream(0), buf(file_name, level)
+    {
+	rdbuf(&buf);
+    }
+
+    /// Write the remaining output and close the file
+    void close()
+    {
+	flush();
+	if (!buf.close())
+	    setstate(std::ios::badbit);
+    }
+
+  private:
+    gzip_streambuf buf;
+};
+
+}} // namespace mtl::io
+
+#endif // MTL_WITH_ZLIB
+
+#endif // MTL_IO_GZIP_OSTREAM_INCLUDE
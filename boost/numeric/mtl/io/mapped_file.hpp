@@ -0,0 +1,115 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_IO_MAPPED_FILE_INCLUDE
+#define MTL_IO_MAPPED_FILE_INCLUDE
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstddef>
+
+#include <boost/numeric/mtl/utility/exception.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  define MTL_IO_WITH_MMAP
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace mtl { namespace io {
+
+/// View of a whole file; memory-mapped on POSIX systems, otherwise read into a buffer
+/** The pages of a mapped file are only read when they are accessed so that large files
+    can be processed in parallel without an extra copy.
+    A writable mapping is private (copy-on-write): modifications are never written back to the file. **/
+class mapped_file
+{
+    // Not copyable
+    mapped_file(const mapped_file&);
+    mapped_file& operator=(const mapped_file&);
+
+  public:
+    /// Map the file \p file_name (writable if \p writable); throws file_not_found if it cannot be opened
+    explicit mapped_file(const std::string& file_name, bool writable= false) 
+      : my_data(0), my_size(0), mapped(false)
+    {
+#     ifdef MTL_IO_WITH_MMAP
+	int fd= ::open(file_name.c_str(), O_RDONLY);
+	MTL_THROW_IF(fd < 0, file_not_found(("Cannot open file " + file_name).c_str()));
+	struct stat st;
+	const bool regular= ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+	if (regular && st.st_size > 0) {
+	    void* p= ::mmap(0, std::size_t(st.st_size), writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+	    if (p != MAP_FAILED) {
+		my_data= static_cast<char*>(p); my_size= std::size_t(st.st_size); mapped= true;
+#             ifdef POSIX_MADV_SEQUENTIAL
+		if (!writable) // read-only files are parsed front to back
+		    ::posix_madvise(p, my_size, POSIX_MADV_SEQUENTIAL);
+#             endif
+	    }
+	}
+	::close(fd);
+	if (mapped || (regular && st.st_size == 0))
+	    return;
+#     endif
+	read_into_buffer(file_name);
+    }
+
+    ~mapped_file()
+    {
+#     ifdef MTL_IO_WITH_MMAP
+	if (mapped)
+	    ::munmap(my_data, my_size);
+#     endif
+    }
+
+    /// First character of the file
+    const char* data() const { return my_data; }
+    /// First character of the file; may only be modified if the file is mapped writable
+    char* data() { return my_data; }
+    /// Past-the-end character of the file
+    const char* end() const { return my_data + my_size; }
+    /// Number of bytes
+    std::size_t size() const { return my_size; }
+    /// Whether the file is memory-mapped (and not copied)
+    bool is_mapped() const { return mapped; }
+
+  private:
+    // Fallback for systems without mmap and special files that cannot be mapped
+    void read_into_buffer(const std::string& file_name)
+    {
+	std::ifstream is(file_name.c_str(), std::ios::binary);
+	MTL_THROW_IF(!is, file_not_found(("Cannot open file " + file_name).c_str()));
+	const std::size_t chunk= 1 << 20;
+	for (std::size_t n= 0; is; ) {
+	    buffer.resize(n + chunk);
+	    is.read(&buffer[n], std::streamsize(chunk));
+	    n+= std::size_t(is.gcount());
+	    buffer.resize(n);
+	}
+	my_data= buffer.empty() ? 0 : &buffer[0];
+	my_size= buffer.size();
+    }
+
+    char*             my_data;
+    std::size_t       my_size;
+    bool              mapped;
+    std::vector<char> buffer;
+};
+
+}} // namespace mtl::io
+
+#endif // MTL_IO_MAPPED_FILE_INCLUDE
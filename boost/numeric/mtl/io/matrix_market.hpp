@@ -19,6 +19,8 @@
 #include <limits>
 #include <locale>
 #include <complex>
+#include <vector>
+#include <algorithm>
 
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_floating_point.hpp>
@@ -28,19 +30,35 @@
 
 #include <boost/numeric/mtl/io/matrix_file.hpp>
 #include <boost/numeric/mtl/io/read_filter.hpp>
+#include <boost/numeric/mtl/io/mapped_file.hpp>
+#include <boost/numeric/mtl/io/parse_number.hpp>
+#include <boost/numeric/mtl/io/format_number.hpp>
+#include <boost/numeric/mtl/io/gzip_ostream.hpp>
 #include <boost/numeric/mtl/utility/property_map.hpp>
 #include <boost/numeric/mtl/utility/range_generator.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/category.hpp>
 #include <boost/numeric/mtl/utility/string_to_enum.hpp>
+#include <boost/numeric/mtl/utility/is_row_major.hpp>
+#include <boost/numeric/mtl/utility/zipped_sort.hpp>
 #include <boost/numeric/mtl/matrix/inserter.hpp>
 #include <boost/numeric/mtl/operation/set_to_zero.hpp>
+#include <boost/numeric/mtl/operation/conj.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
 
 namespace mtl { namespace io {
 
 
 /// Input file stream for files in matrix market format
+/** Sparse files that are read by file name into a compressed2D are memory-mapped and parsed
+    in parallel (with MTL_WITH_OPENMP): the file is split at line boundaries, the first pass counts
+    the entries per row (column) and the second stores them directly into the CRS (CCS) arrays.
+    Duplicate entries (not allowed in the format) are summed up in this case. **/
 class matrix_market_istream
 {
     class pattern_type {};
@@ -59,8 +77,8 @@ class matrix_market_istream
     }
 
   public:
-    explicit matrix_market_istream(const char* p) : new_stream(new std::ifstream(p)), my_stream(*new_stream) { check_stream(p); }
-    explicit matrix_market_istream(const std::string& s) : new_stream(new std::ifstream(s.c_str())), my_stream(*new_stream) { check_stream(s); }
+    explicit matrix_market_istream(const char* p) : new_stream(new std::ifstream(p)), my_stream(*new_stream), file_name(p) { check_stream(p); }
+    explicit matrix_market_istream(const std::string& s) : new_stream(new std::ifstream(s.c_str())), my_stream(*new_stream), file_name(s) { check_stream(s); }
     explicit matrix_market_istream(std::istream& s= std::cin) : new_stream(0), my_stream(s) { check_stream(); }
 
     ~matrix_market_istream() 
@@ -151,13 +169,226 @@ class matrix_market_istream
     std::complex<double> which_value(std::complex<double> v, std::complex<double>) { return v; }
     std::complex<float> which_value(std::complex<double> v, std::complex<float>) { return std::complex<float>(float(real(v)), float(imag(v))); }
 
+    // Generic matrices are read with inserter
+    template <typename Matrix>
+    bool read_parallel(Matrix&, const std::string&) { return false; }
+
+    template <typename Value, typename Parameters>
+    bool read_parallel(mat::compressed2D<Value, Parameters>& A, const std::string& value_format);
+
+    template <typename Value, typename Parameters, typename FileValue>
+    void read_crs(mat::compressed2D<Value, Parameters>& A, const char* first, const char* last, FileValue);
+
+    // Parse the next entry in [p, end) and set p behind its line; returns 1 for an entry, 0 at the end and -1 for errors
+    template <typename Value>
+    int next_entry(const char*& p, const char* end, std::size_t& r, std::size_t& c, Value& v, bool with_value) const
+    {
+	while (p != end) {
+	    const char* q= skip_blanks(p, end);
+	    if (q == end || *q == '\n' || *q == '\r' || *q == '%') { // empty line or comment
+		p= skip_line(q, end);
+		continue;
+	    }
+	    if (!(q= parse_unsigned(q, end, r)) || !(q= parse_unsigned(q, end, c)) || (with_value && !(q= parse_value(q, end, v))))
+		return -1;
+	    p= skip_line(q, end);
+	    return r >= 1 && r <= nrows && c >= 1 && c <= ncols ? 1 : -1;
+	}
+	return 0;
+    }
+
+    const char* parse_value(const char* p, const char*, pattern_type&) const { return p; }
+    const char* parse_value(const char* p, const char* end, double& v) const { return parse_real(p, end, v); }
+    const char* parse_value(const char* p, const char* end, long& v) const { return parse_integer(p, end, v); }
+    const char* parse_value(const char* p, const char* end, std::complex<double>& v) const
+    {
+	double r, i;
+	if (!(p= parse_real(p, end, r)) || !(p= parse_real(p, end, i)))
+	    return 0;
+	v= std::complex<double>(r, i);
+	return p;
+    }
+
+    // Value of the mirrored entry in symmetric, skew-symmetric and Hermitian matrices
+    template <typename MValue>
+    MValue mirrored_value(const MValue& v) const
+    {
+	using mtl::conj;
+	return my_symmetry == skew ? MValue(-v) : my_symmetry == Hermitian ? MValue(conj(v)) : v;
+    }
+
     std::ifstream      *new_stream;
     std::istream       &my_stream;
+    std::string        file_name;
     enum symmetry {general, symmetric, skew, Hermitian} my_symmetry;
     enum sparsity {coordinate, array} my_sparsity;
     std::size_t nrows, ncols, nnz;
 };
 
+namespace detail {
+
+    template <typename T>
+    inline void atomic_increment(T& x)
+    {
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp atomic
+#     endif
+	x++;
+    }
+
+    template <typename T>
+    inline T atomic_post_increment(T& x)
+    {
+	T old;
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp atomic capture
+#     endif
+	old= x++;
+	return old;
+    }
+}
+
+template <typename Value, typename Parameters>
+bool matrix_market_istream::read_parallel(mat::compressed2D<Value, Parameters>& A, const std::string& value_format)
+{
+    if (!new_stream || my_sparsity != coordinate)
+	return false;
+    const std::streamoff offset= my_stream.tellg(); // behind nnz in the header
+    if (offset < 0)
+	return false;
+    mapped_file file(file_name);
+    MTL_THROW_IF(std::size_t(offset) > file.size(), io_error("Matrix Market file changed while reading"));
+    const char *first= file.data() + offset, *last= file.end();
+
+    if (value_format == std::string("real"))
+	read_crs(A, first, last, double());
+    else if (value_format == std::string("integer"))
+	read_crs(A, first, last, long());
+    else if (value_format == std::string("complex"))
+	read_crs(A, first, last, std::complex<double>());
+    else if (value_format == std::string("pattern"))
+	read_crs(A, first, last, pattern_type());
+    else
+	MTL_THROW(runtime_error("Unknown tag for matrix value type in file"));
+    return true;
+}
+
+template <typename Value, typename Parameters, typename FileValue>
+void matrix_market_istream::read_crs(mat::compressed2D<Value, Parameters>& A, const char* first, const char* last, FileValue)
+{
+    vampir_trace<4037> tracer;
+    typedef mat::compressed2D<Value, Parameters>        matrix_type;
+    typedef typename matrix_type::size_type             size_type;
+    typedef typename matrix_type::minor_index_type      minor_index_type;
+    const bool        row_major= mtl::traits::is_row_major<Parameters>::value, mirror= my_symmetry != general;
+    const std::size_t dim1= A.dim1();
+    which_value(FileValue(), Value()); // throws for complex files in real matrices
+
+    // Split the file at line boundaries into more chunks than threads for load balance
+    std::size_t nc= 1;
+#ifdef MTL_WITH_OPENMP
+    nc= 8 * std::size_t(omp_get_max_threads());
+#endif
+    nc= std::max(std::min(nc, std::size_t(last - first) / 4096), std::size_t(1));
+    std::vector<const char*> bounds(nc + 1, last);
+    bounds[0]= first;
+    for (std::size_t t= 1; t < nc; t++)
+	bounds[t]= skip_line(std::max(first + std::size_t(last - first) / nc * t, bounds[t-1]), last);
+
+    // First pass: count entries per row (column) in starts[i+1]
+    typename matrix_type::index_vector_type& starts= A.ref_major();
+    std::vector<std::size_t> entries(nc, 0);
+    std::vector<int>         failed(nc, 0);
+    const long               lnc= long(nc);
+#ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long t= 0; t < lnc; t++) {
+	const char *p= bounds[t], *end= bounds[t+1];
+	std::size_t r, c;
+	pattern_type dummy;
+	int status;
+	while ((status= next_entry(p, end, r, c, dummy, false)) > 0) {
+	    detail::atomic_increment(starts[row_major ? r : c]);
+	    if (mirror && r != c)
+		detail::atomic_increment(starts[row_major ? c : r]);
+	    entries[t]++;
+	}
+	failed[t]= status < 0;
+    }
+    MTL_THROW_IF(std::find(failed.begin(), failed.end(), 1) != failed.end(),
+		 io_error("Invalid entry in Matrix Market file"));
+    std::size_t total= 0;
+    for (std::size_t t= 0; t < nc; t++)
+	total+= entries[t];
+    MTL_THROW_IF(total != nnz, io_error("Number of entries in Matrix Market file differs from its header"));
+
+    for (std::size_t i= 0; i < dim1; i++)
+	starts[i+1]+= starts[i];
+    A.set_nnz(starts[dim1]);
+
+    // Second pass: store the entries at the next free position of their row (column)
+    std::vector<size_type>        pos(starts.begin(), starts.end() - 1);
+    typename matrix_type::minor_vector_type& indices= A.ref_minor();
+    Value*                                   data= A.data.empty() ? 0 : &A.data[0];
+#ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (long t= 0; t < lnc; t++) {
+	const char *p= bounds[t], *end= bounds[t+1];
+	std::size_t r, c;
+	FileValue   v;
+	int         status;
+	try {
+	    while ((status= next_entry(p, end, r, c, v, true)) > 0) {
+		const std::size_t major= row_major ? r - 1 : c - 1, minor= row_major ? c - 1 : r - 1;
+		const Value       mv= which_value(v, Value());
+		size_type         k= detail::atomic_post_increment(pos[major]);
+		indices[k]= minor_index_type(minor); data[k]= mv;
+		if (mirror && r != c) {
+		    k= detail::atomic_post_increment(pos[minor]);
+		    indices[k]= minor_index_type(major); data[k]= mirrored_value(mv);
+		}
+	    }
+	    failed[t]= status < 0;
+	} catch (...) {
+	    failed[t]= 1;
+	}
+    }
+    MTL_THROW_IF(std::find(failed.begin(), failed.end(), 1) != failed.end(),
+		 io_error("Invalid value in Matrix Market file"));
+
+    // Sort rows (columns) on indices and detect duplicates
+    const long ldim1= long(dim1);
+    int        duplicates= 0;
+#ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for schedule(dynamic, 256) reduction(+: duplicates)
+#endif
+    for (long i= 0; i < ldim1; i++) {
+	if (starts[i+1] - starts[i] > 1) {
+	    std::sort(utility::zip_it<minor_index_type, Value>(&indices[0], data, starts[i]),
+		      utility::zip_it<minor_index_type, Value>(&indices[0], data, starts[i+1]), utility::less_0());
+	    for (size_type j= starts[i] + 1; j < starts[i+1]; j++)
+		duplicates+= indices[j] == indices[j-1];
+	}
+    }
+    if (duplicates == 0)
+	return;
+
+    size_type k= 0;
+    for (std::size_t i= 0; i < dim1; i++) {
+	const size_type s= starts[i], e= starts[i+1];
+	starts[i]= k;
+	for (size_type j= s; j < e; j++)
+	    if (k > starts[i] && indices[k-1] == indices[j])
+		data[k-1]+= data[j];
+	    else
+		indices[k]= indices[j], data[k++]= data[j];
+    }
+    starts[dim1]= k;
+    A.set_nnz(k);
+}
+
 
 
 // Matrix version
@@ -198,6 +429,9 @@ matrix_market_istream& matrix_market_istream::read(Matrix& A, tag::matrix)
     } else
 	slot_size= A.dim2(); // maximal value (if A is dense it does not matter anyway)
 
+    if (read_parallel(A, value_format))
+	return *this;
+
     // Create enough space in sparse matrices
     mat::inserter<Matrix> ins(A, slot_size);
 
@@ -216,12 +450,18 @@ matrix_market_istream& matrix_market_istream::read(Matrix& A, tag::matrix)
 }
 
 
+/// Output file stream for files in matrix market format
+/** The entries of a compressed2D are formatted in parallel (with MTL_WITH_OPENMP) into per-thread buffers
+    of blocks of rows (columns), which are written in order so that the memory is bounded.
+    Floating point values are written with the shortest representation that reads back exactly
+    if std::to_chars is available (C++17).
+    With MTL_WITH_ZLIB, files whose names end with ".gz" are gzip-compressed. **/
 class matrix_market_ostream 
 {
     typedef matrix_market_ostream        self;
 public:
-    explicit matrix_market_ostream(const char* p) : new_stream(new std::ofstream(p)), my_stream(*new_stream) {}
-    explicit matrix_market_ostream(const std::string& s) : new_stream(new std::ofstream(s.c_str())), my_stream(*new_stream) {}
+    explicit matrix_market_ostream(const char* p) : new_stream(open(p)), my_stream(*new_stream) {}
+    explicit matrix_market_ostream(const std::string& s) : new_stream(open(s)), my_stream(*new_stream) {}
     explicit matrix_market_ostream(std::ostream& s= std::cout) : new_stream(0), my_stream(s) {}
 
     ~matrix_market_ostream() { if (new_stream) delete new_stream; }
@@ -233,9 +473,26 @@ public:
     }
 
     /// Close only my own file, i.e. if filename and not stream is passed in constructor
-    void close() { if (new_stream) new_stream->close(); }
+    void close() 
+    { 
+	if (std::ofstream* file= dynamic_cast<std::ofstream*>(new_stream))
+	    file->close();
+#     ifdef MTL_WITH_ZLIB
+	if (gzip_ostream* file= dynamic_cast<gzip_ostream*>(new_stream))
+	    file->close();
+#     endif
+    }
 
 private:
+    static std::ostream* open(const std::string& file_name)
+    {
+#     ifdef MTL_WITH_ZLIB
+	if (file_name.size() > 3 && file_name.compare(file_name.size() - 3, 3, ".gz") == 0)
+	    return new gzip_ostream(file_name);
+#     endif
+	return new std::ofstream(file_name.c_str());
+    }
+
     template <typename Matrix> self& write(const Matrix& A, tag::matrix)
     {
 	matrix_status_line(A);
@@ -248,6 +505,8 @@ private:
     template <typename Matrix> self& write_sparse_matrix(const Matrix& A)
     {
 	my_stream << num_rows(A) << " " << num_cols(A) << " " << A.nnz() << "\n";
+	if (write_parallel(A))
+	    return *this;
 	
 	typename mtl::traits::row<Matrix>::type             row(A); 
 	typename mtl::traits::col<Matrix>::type             col(A); 
@@ -261,6 +520,78 @@ private:
 	return *this;
     }
 
+    template <typename Matrix> bool write_parallel(const Matrix&) { return false; }
+
+    template <typename Value, typename Parameters>
+    bool write_parallel(const mat::compressed2D<Value, Parameters>& A)
+    {
+	vampir_trace<4040> tracer;
+	if (A.nnz() == 0)
+	    return true;
+	const bool        row= traits::is_row_major<Parameters>::value;
+	const std::size_t dim1= row ? num_rows(A) : num_cols(A), block_entries= 1 << 14;
+
+	// Blocks of rows (columns) with about block_entries entries; longer rows form their own block
+	const typename mat::compressed2D<Value, Parameters>::size_type* starts= &A.ref_major()[0];
+	std::vector<std::size_t> blocks(1, 0);
+	while (blocks.back() < dim1) {
+	    const std::size_t first= blocks.back(),
+		              last= std::upper_bound(starts + first + 1, starts + dim1 + 1, starts[first] + block_entries) - starts - 1;
+	    blocks.push_back(std::max(last, first + 1));
+	}
+
+	// Rounds of 2 blocks per thread are formatted in parallel and written in order
+#     ifdef MTL_WITH_OPENMP
+	const int round= 2 * omp_get_max_threads();
+#     else
+	const int round= 1;
+#     endif
+	std::vector<std::vector<char> > buffers(round);
+	std::vector<std::size_t>        sizes(round);
+	const int nb= int(blocks.size()) - 1;
+	for (int k= 0; k < nb; k+= round) {
+	    const int m= std::min(round, nb - k);
+#         ifdef MTL_WITH_OPENMP
+#           pragma omp parallel for schedule(dynamic)
+#         endif
+	    for (int b= 0; b < m; b++)
+		sizes[b]= format_block(A, blocks[k+b], blocks[k+b+1], buffers[b]);
+	    for (int b= 0; b < m; b++)
+		if (sizes[b] > 0) // blocks of empty rows (columns)
+		    my_stream.write(&buffers[b][0], std::streamsize(sizes[b]));
+	}
+	MTL_THROW_IF(!my_stream, io_error("Error in writing Matrix Market file"));
+	return true;
+    }
+
+    // Format the entries of rows (columns) [first, last) into buffer and return the number of characters
+    template <typename Value, typename Parameters>
+    std::size_t format_block(const mat::compressed2D<Value, Parameters>& A, std::size_t first, std::size_t last, 
+			     std::vector<char>& buffer) const
+    {
+	const bool        row= traits::is_row_major<Parameters>::value;
+	const std::size_t max_entry= 5 * max_formatted_number;
+	const typename mat::compressed2D<Value, Parameters>::size_type*        starts= &A.ref_major()[0];
+	const typename mat::compressed2D<Value, Parameters>::minor_index_type* indices= &A.ref_minor()[0];
+	const Value*                                                           data= &A.data[0];
+
+	std::size_t pos= 0;
+	for (std::size_t i= first; i < last; i++)
+	    for (std::size_t j= starts[i], end= starts[i+1]; j < end; j++) {
+		if (buffer.size() < pos + max_entry)
+		    buffer.resize(2 * buffer.size() + max_entry);
+		char* p= &buffer[pos];
+		p= format_unsigned(p, (row ? i : std::size_t(indices[j])) + 1);
+		*p++= ' ';
+		p= format_unsigned(p, (row ? std::size_t(indices[j]) : i) + 1);
+		*p++= ' ';
+		p= format_value(p, data[j]);
+		*p++= '\n';
+		pos= std::size_t(p - &buffer[0]);
+	    }
+	return pos;
+    }
+
     template <typename Matrix> self& write_dense_matrix(const Matrix& A)
     {
 	my_stream << num_rows(A) << " " << num_cols(A) << "\n";
@@ -325,7 +656,7 @@ private:
     }
 
 protected:
-    std::ofstream      *new_stream;
+    std::ostream       *new_stream;
     std::ostream       &my_stream;
 };
 
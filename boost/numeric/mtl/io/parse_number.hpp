@@ -0,0 +1,188 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_IO_PARSE_NUMBER_INCLUDE
+#define MTL_IO_PARSE_NUMBER_INCLUDE
+
+// Number parsing on character ranges that are not null-terminated (e.g. memory-mapped files).
+// All functions skip leading blanks and tabs, return the position behind the number,
+// and return 0 if there is no number or it is not followed by white space or the end of the range.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <limits>
+#if __cplusplus >= 201703L
+#  include <charconv>
+#endif
+#if defined(__cpp_lib_to_chars)
+#  define MTL_IO_WITH_FROM_CHARS
+#endif
+
+namespace mtl { namespace io {
+
+namespace detail {
+
+    inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+    inline bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+    inline const char* end_of_number(const char* p, const char* end)
+    {
+	return p == end || is_space(*p) ? p : 0;
+    }
+
+    // Exact powers of ten in double
+    inline double exact_power10(int e)
+    {
+	static const double p[]= {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+	return p[e];
+    }
+
+    // Slow path for long mantissas, large exponents, inf and nan: from_chars if available, otherwise strtod
+    inline const char* parse_real_slow(const char* p, const char* end, double& v)
+    {
+#     ifdef MTL_IO_WITH_FROM_CHARS
+	const std::from_chars_result result= std::from_chars(p != end && *p == '+' ? p + 1 : p, end, v);
+	if (result.ec == std::errc())
+	    return end_of_number(result.ptr, end);
+#     endif
+	const char* q= p;
+	while (q != end && !is_space(*q))
+	    ++q;
+	if (q == p)
+	    return 0;
+	const std::size_t n= std::size_t(q - p);
+	char              buffer[64];
+	std::string       long_token;
+	const char*       token= buffer;
+	if (n < sizeof(buffer))
+	    std::memcpy(buffer, p, n), buffer[n]= '\0';
+	else
+	    long_token.assign(p, q), token= long_token.c_str();
+	char* last;
+	v= std::strtod(token, &last);
+	return last == token + n ? q : 0;
+    }
+}
+
+/// Skip blanks and tabs (but not line breaks)
+inline const char* skip_blanks(const char* p, const char* end)
+{
+    while (p != end && (*p == ' ' || *p == '\t'))
+	++p;
+    return p;
+}
+
+/// Position behind the next line break (or \p end)
+inline const char* skip_line(const char* p, const char* end)
+{
+    const void* nl= std::memchr(p, '\n', std::size_t(end - p));
+    return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+/// Parse non-negative integer into \p v
+inline const char* parse_unsigned(const char* p, const char* end, std::size_t& v)
+{
+    p= skip_blanks(p, end);
+    if (p == end || !detail::is_digit(*p))
+	return 0;
+    const std::size_t max_value= std::numeric_limits<std::size_t>::max();
+    v= 0;
+    for (; p != end && detail::is_digit(*p); ++p) {
+	const std::size_t d= std::size_t(*p - '0');
+	if (v > (max_value - d) / 10)
+	    return 0;
+	v= 10 * v + d;
+    }
+    return detail::end_of_number(p, end);
+}
+
+/// Parse integer with optional sign into \p v
+inline const char* parse_integer(const char* p, const char* end, long& v)
+{
+    p= skip_blanks(p, end);
+    bool negative= false;
+    if (p != end && (*p == '-' || *p == '+'))
+	negative= *p++ == '-';
+    std::size_t u;
+    if (!(p= parse_unsigned(p, end, u)) || u > std::size_t(std::numeric_limits<long>::max()))
+	return 0;
+    v= negative ? -long(u) : long(u);
+    return p;
+}
+
+/// Parse floating point number into \p v
+/** Numbers with at most 19 significant digits whose mantissa and power of ten are exactly
+    representable are computed with one multiplication or division (correctly rounded);
+    all others are passed to std::from_chars (C++17) or strtod. **/
+inline const char* parse_real(const char* p, const char* end, double& v)
+{
+    using detail::is_digit;
+    p= skip_blanks(p, end);
+    const char* start= p;
+    bool negative= false;
+    if (p != end && (*p == '-' || *p == '+'))
+	negative= *p++ == '-';
+
+    unsigned long long mantissa= 0;
+    int digits= 0, exponent= 0;
+    bool any_digit= false, truncated= false;
+    for (; p != end && is_digit(*p); ++p, any_digit= true)
+	if (digits < 19) {
+	    mantissa= 10 * mantissa + (*p - '0');
+	    digits+= mantissa != 0;
+	} else
+	    exponent++, truncated= truncated || *p != '0';
+    if (p != end && *p == '.') {
+	for (++p; p != end && is_digit(*p); ++p, any_digit= true)
+	    if (digits < 19) {
+		mantissa= 10 * mantissa + (*p - '0');
+		digits+= mantissa != 0;
+		exponent--;
+	    } else
+		truncated= truncated || *p != '0';
+    }
+    if (!any_digit)
+	return detail::parse_real_slow(start, end, v);
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+	++p;
+	bool negative_exponent= false;
+	if (p != end && (*p == '-' || *p == '+'))
+	    negative_exponent= *p++ == '-';
+	if (p == end || !is_digit(*p))
+	    return 0;
+	int e= 0;
+	for (; p != end && is_digit(*p); ++p)
+	    if (e < 100000)
+		e= 10 * e + (*p - '0');
+	exponent+= negative_exponent ? -e : e;
+    }
+    if (!detail::end_of_number(p, end))
+	return 0;
+
+    if (!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+	const double m= double(mantissa);
+	v= exponent < 0 ? m / detail::exact_power10(-exponent) : m * detail::exact_power10(exponent);
+	if (negative)
+	    v= -v;
+	return p;
+    }
+    return detail::parse_real_slow(start, end, v);
+}
+
+}} // namespace mtl::io
+
+#endif // MTL_IO_PARSE_NUMBER_INCLUDE
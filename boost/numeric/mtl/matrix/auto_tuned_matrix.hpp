@@ -0,0 +1,535 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_MATRIX_AUTO_TUNED_MATRIX_INCLUDE
+#define MTL_MATRIX_AUTO_TUNED_MATRIX_INCLUDE
+
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#  error "auto_tuned_matrix needs C++11."
+#endif
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <algorithm>
+
+#include <boost/static_assert.hpp>
+
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/utility/tag.hpp>
+#include <boost/numeric/mtl/utility/ashape.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/is_row_major.hpp>
+#include <boost/numeric/mtl/matrix/compressed2D.hpp>
+#include <boost/numeric/mtl/matrix/ell_matrix.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/vector/mat_cvec_multiplier.hpp>
+#include <boost/numeric/mtl/operation/set_to_zero.hpp>
+#include <boost/numeric/mtl/operation/assign_mode.hpp>
+#include <boost/numeric/mtl/operation/mat_vec_mult.hpp>
+#include <boost/numeric/mtl/operation/structure_analysis.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+
+namespace mtl { namespace mat {
+
+/// Kernels of matrix-vector products among which \ref auto_tuned_matrix selects
+namespace spmv_kernel {
+    enum type { crs, crs_unrolled, ell, sliced_ell, blocked_crs };
+
+    /// Number of kernels
+    const int number= 5;
+
+    /// Name of kernel \p k
+    inline const char* name(type k)
+    {
+	static const char* names[]= { "crs", "crs_unrolled", "ell", "sliced_ell", "blocked_crs" };
+	return names[k];
+    }
+}
+
+/// Thread schedules of the kernels in \ref auto_tuned_matrix
+/** builtin is the parallelization of MTL's own kernels (with MTL_WITH_OPENMP), the others apply to sliced_ell and blocked_crs. **/
+namespace spmv_schedule {
+    enum type { builtin, serial, omp_static, omp_dynamic };
+
+    /// Number of schedules
+    const int number= 4;
+
+    /// Name of schedule \p s
+    inline const char* name(type s)
+    {
+	static const char* names[]= { "builtin", "serial", "omp_static", "omp_dynamic" };
+	return names[s];
+    }
+}
+
+/// Variant of the matrix-vector product selected for a matrix and its measured time
+/** Can be written to a file so that later runs with the same matrix skip the tuning. **/
+struct spmv_tuning
+{
+    spmv_tuning(spmv_kernel::type kernel= spmv_kernel::crs, unsigned parameter= 0, spmv_schedule::type schedule= spmv_schedule::builtin)
+      : kernel(kernel), parameter(parameter), schedule(schedule), rows(0), cols(0), nnz(0),
+	seconds(std::numeric_limits<double>::infinity()) {}
+
+    /// Whether the variant was selected for a matrix with these dimensions and number of non-zeros
+    bool matches(std::size_t r, std::size_t c, std::size_t n) const { return rows == r && cols == c && nnz == n; }
+
+    /// Whether parameter is supported by the kernel
+    bool valid_parameter() const
+    {
+	switch (kernel) {
+	  case spmv_kernel::crs_unrolled: return parameter == 1 || parameter == 2 || parameter == 4 || parameter == 8;
+	  case spmv_kernel::sliced_ell:   return parameter == 8 || parameter == 32;
+	  case spmv_kernel::blocked_crs:  return parameter == 2 || parameter == 4;
+	  default:                        return true;
+	}
+    }
+
+    /// Write as one line: mtl_spmv_tuning version rows cols nnz kernel parameter schedule seconds
+    void write(std::ostream& os) const
+    {
+	os << "mtl_spmv_tuning 1 " << rows << ' ' << cols << ' ' << nnz << ' ' << spmv_kernel::name(kernel) << ' '
+	   << parameter << ' ' << spmv_schedule::name(schedule) << ' ' << seconds << '\n';
+    }
+
+    /// Read a line written by write
+    void read(std::istream& is)
+    {
+	std::string magic, k, s;
+	int         version= 0;
+	is >> magic >> version >> rows >> cols >> nnz >> k >> parameter >> s >> seconds;
+	MTL_THROW_IF(!is || magic != "mtl_spmv_tuning" || version != 1, io_error("Invalid SpMV tuning"));
+	int ki= 0, si= 0;
+	while (ki < spmv_kernel::number && k != spmv_kernel::name(spmv_kernel::type(ki))) ki++;
+	while (si < spmv_schedule::number && s != spmv_schedule::name(spmv_schedule::type(si))) si++;
+	MTL_THROW_IF(ki == spmv_kernel::number || si == spmv_schedule::number, io_error("Unknown kernel or schedule in SpMV tuning"));
+	kernel= spmv_kernel::type(ki); schedule= spmv_schedule::type(si);
+	MTL_THROW_IF(!valid_parameter(), io_error("Unsupported kernel parameter in SpMV tuning"));
+    }
+
+    /// Write to file \p file_name
+    void save(const std::string& file_name) const
+    {
+	std::ofstream os(file_name.c_str());
+	MTL_THROW_IF(!os, io_error(("Cannot create file " + file_name).c_str()));
+	write(os);
+    }
+
+    /// Read from file \p file_name; returns false if the file cannot be opened
+    bool load(const std::string& file_name)
+    {
+	std::ifstream is(file_name.c_str());
+	if (!is)
+	    return false;
+	read(is);
+	return true;
+    }
+
+    spmv_kernel::type   kernel;
+    unsigned            parameter; ///< Rows of crs_unrolled, slice height of sliced_ell, block size of blocked_crs
+    spmv_schedule::type schedule;
+    std::size_t         rows, cols, nnz; ///< Matrix for which the variant was selected
+    double              seconds;  ///< Minimal time of the product
+};
+
+namespace detail {
+
+    // Candidates are skipped when they store less than this ratio of non-zeros
+    const double auto_tuned_min_efficiency= 0.5;
+
+    // Run body(i) for i in [0, n) with the given schedule
+    template <typename Body>
+    void spmv_loop(std::size_t n, spmv_schedule::type schedule, Body body)
+    {
+#     ifdef MTL_WITH_OPENMP
+	const long ln= long(n);
+	if (schedule == spmv_schedule::omp_static) {
+#           pragma omp parallel for schedule(static)
+	    for (long i= 0; i < ln; i++)
+		body(std::size_t(i));
+	    return;
+	}
+	if (schedule == spmv_schedule::omp_dynamic) {
+#           pragma omp parallel for schedule(dynamic, 16)
+	    for (long i= 0; i < ln; i++)
+		body(std::size_t(i));
+	    return;
+	}
+#     else
+	(void) schedule;
+#     endif
+	for (std::size_t i= 0; i < n; i++)
+	    body(i);
+    }
+
+    // Sliced ELLPACK: slices of height rows are padded to their longest row and stored column-wise
+    template <typename Value, typename Size>
+    struct sliced_ell_data
+    {
+	void clear() { height= 0; starts.clear(); indices.clear(); values.clear(); }
+
+	// Fraction of non-zeros among the stored entries for slices of height h
+	template <typename Parameters>
+	static double efficiency(const compressed2D<Value, Parameters>& A, unsigned h)
+	{
+	    const Size nr= num_rows(A), *st= A.address_major();
+	    double     stored= 0.0;
+	    for (Size r0= 0; r0 < nr; r0+= h) {
+		Size width= 0;
+		for (Size r= r0, rend= std::min<Size>(r0 + h, nr); r < rend; r++)
+		    width= std::max(width, st[r+1] - st[r]);
+		stored+= double(width) * h;
+	    }
+	    return stored > 0.0 ? double(A.nnz()) / stored : 1.0;
+	}
+
+	template <typename Parameters>
+	void assign(const compressed2D<Value, Parameters>& A, unsigned h)
+	{
+	    const Size nr= num_rows(A), ns= (nr + h - 1) / h, *st= A.address_major();
+	    height= h;
+	    starts.assign(ns + 1, 0);
+	    for (Size s= 0; s < ns; s++) {
+		Size width= 0;
+		for (Size r= s * h, rend= std::min<Size>(r + h, nr); r < rend; r++)
+		    width= std::max(width, st[r+1] - st[r]);
+		starts[s+1]= starts[s] + width * h;
+	    }
+	    indices.assign(starts[ns], 0);
+	    values.assign(starts[ns], Value(0));
+	    for (Size r= 0; r < nr; r++) {
+		const Size s= r / h, width= (starts[s+1] - starts[s]) / h;
+		Size       pos= starts[s] + r % h, k= 0;
+		for (Size j= st[r]; j < st[r+1]; j++, k++, pos+= h)
+		    indices[pos]= Size(A.address_minor()[j]), values[pos]= A.address_data()[j];
+		for (; k < width; k++, pos+= h) // padding refers to the last column of the row for locality
+		    indices[pos]= st[r] < st[r+1] ? Size(A.address_minor()[st[r+1]-1]) : 0;
+	    }
+	}
+
+	template <unsigned H, typename VectorIn, typename VectorOut, typename Assign>
+	void mult(Size nr, const VectorIn& v, VectorOut& w, Assign, spmv_schedule::type schedule) const
+	{
+	    vampir_trace<3079> tracer;
+	    spmv_loop(starts.size() - 1, schedule, [&](std::size_t s) {
+		    Value tmp[H];
+		    for (unsigned r= 0; r < H; r++)
+			tmp[r]= Value(0);
+		    for (Size k= starts[s], kend= starts[s+1]; k < kend; k+= H) {
+			const Value *val= &values[k];
+			const Size  *idx= &indices[k];
+			for (unsigned r= 0; r < H; r++)
+			    tmp[r]+= val[r] * v[idx[r]];
+		    }
+		    const Size r0= Size(s) * H, rend= std::min<Size>(H, nr - r0);
+		    for (Size r= 0; r < rend; r++)
+			Assign::first_update(w[r0 + r], tmp[r]);
+		});
+	}
+
+	unsigned           height;
+	std::vector<Size>  starts, indices;
+	std::vector<Value> values;
+    };
+
+    // Blocked CRS with dense square blocks of bsize, requires that bsize divides the dimensions
+    template <typename Value, typename Size>
+    struct blocked_crs_data
+    {
+	void clear() { bsize= 0; starts.clear(); columns.clear(); values.clear(); }
+
+	template <typename Parameters>
+	static bool applicable(const compressed2D<Value, Parameters>& A, unsigned b)
+	{
+	    return num_rows(A) % b == 0 && num_cols(A) % b == 0 && num_rows(A) > 0
+		&& structure_block_fill_ratio(num_rows(A), num_cols(A), A.address_major(), A.address_minor(), b)
+		   >= auto_tuned_min_efficiency;
+	}
+
+	template <typename Parameters>
+	void assign(const compressed2D<Value, Parameters>& A, unsigned b)
+	{
+	    const Size nbr= num_rows(A) / b, *st= A.address_major();
+	    bsize= b;
+	    starts.assign(nbr + 1, 0);
+	    columns.clear(); values.clear();
+	    std::vector<Size> block_cols;
+	    for (Size br= 0; br < nbr; br++) {
+		block_cols.clear();
+		for (Size j= st[br * b]; j < st[br * b + b]; j++)
+		    block_cols.push_back(Size(A.address_minor()[j]) / b * b);
+		std::sort(block_cols.begin(), block_cols.end());
+		block_cols.erase(std::unique(block_cols.begin(), block_cols.end()), block_cols.end());
+		starts[br+1]= starts[br] + block_cols.size();
+		columns.insert(columns.end(), block_cols.begin(), block_cols.end());
+		values.resize(values.size() + block_cols.size() * b * b, Value(0));
+		for (Size r= br * b; r < br * b + b; r++)
+		    for (Size j= st[r]; j < st[r+1]; j++) {
+			const Size c= Size(A.address_minor()[j]),
+			           k= starts[br] + Size(std::lower_bound(block_cols.begin(), block_cols.end(), c / b * b) - block_cols.begin());
+			values[k * b * b + (r % b) * b + c % b]= A.address_data()[j];
+		    }
+	    }
+	}
+
+	template <unsigned B, typename VectorIn, typename VectorOut, typename Assign>
+	void mult(const VectorIn& v, VectorOut& w, Assign, spmv_schedule::type schedule) const
+	{
+	    vampir_trace<3080> tracer;
+	    spmv_loop(starts.size() - 1, schedule, [&](std::size_t br) {
+		    Value tmp[B];
+		    for (unsigned r= 0; r < B; r++)
+			tmp[r]= Value(0);
+		    for (Size k= starts[br], kend= starts[br+1]; k < kend; k++) {
+			const Value *block= &values[k * B * B];
+			const Size  c0= columns[k];
+			for (unsigned r= 0; r < B; r++)
+			    for (unsigned c= 0; c < B; c++)
+				tmp[r]+= block[r * B + c] * v[c0 + c];
+		    }
+		    for (unsigned r= 0; r < B; r++)
+			Assign::first_update(w[br * B + r], tmp[r]);
+		});
+	}
+
+	unsigned           bsize;
+	std::vector<Size>  starts, columns;
+	std::vector<Value> values;
+    };
+
+} // namespace detail
+
+/// Sparse matrix that selects the fastest matrix-vector product for its structure by benchmarking on construction
+/** The candidates are compressed2D with MTL's default kernel and with 1, 2, 4 and 8 unrolled rows,
+    ell_matrix, sliced ELLPACK with slices of 8 and 32 rows, and blocked CRS with 2x2 and 4x4 blocks.
+    Formats that would store more than twice the non-zeros are skipped.
+    Sliced ELLPACK and blocked CRS are timed serially and, with MTL_WITH_OPENMP, with static and dynamic schedule.
+    Only the data layout of the winner is kept.
+    The matrix can be used like any linear operator, e.g. in ITL solvers, but not modified.
+    The selection is available as \ref spmv_tuning and can be stored and reused to skip the tuning. **/
+template <typename Value, typename Parameters= mat::parameters<> >
+class auto_tuned_matrix
+{
+    BOOST_STATIC_ASSERT((mtl::traits::is_row_major<Parameters>::value));
+    typedef auto_tuned_matrix self;
+  public:
+    typedef Value                           value_type;
+    typedef typename Parameters::size_type  size_type;
+    typedef compressed2D<Value, Parameters> source_type;
+
+    /// Benchmark the variants on \p A with \p repetitions products each and keep the fastest
+    explicit auto_tuned_matrix(const source_type& A, int repetitions= 10) { init(A); tune(A, repetitions); }
+
+    /// Use variant \p t if it was selected for a matrix of the same size as \p A and applies to it, otherwise tune
+    auto_tuned_matrix(const source_type& A, const spmv_tuning& t, int repetitions= 10)
+    {
+	init(A);
+	if (usable(A, t))
+	    build(A, t);
+	else
+	    tune(A, repetitions);
+    }
+
+    /// Take the variant from file \p tuning_file if it was selected for a matrix of the same size and applies, otherwise tune and write it to the file
+    auto_tuned_matrix(const source_type& A, const std::string& tuning_file, int repetitions= 10)
+    {
+	init(A);
+	spmv_tuning t;
+	if (t.load(tuning_file) && usable(A, t))
+	    build(A, t);
+	else {
+	    tune(A, repetitions);
+	    selected.save(tuning_file);
+	}
+    }
+
+    /// The selected variant
+    const spmv_tuning& tuning() const { return selected; }
+
+    /// All variants timed on construction (empty if the selection was given)
+    const std::vector<spmv_tuning>& candidates() const { return timed; }
+
+    size_type num_rows() const { return nrows; } ///< Number of rows
+    size_type num_cols() const { return ncols; } ///< Number of columns
+    size_type nnz() const { return my_nnz; }     ///< Number of non-zeros
+
+    /// Compute the product of the matrix with \p v and assign it to \p w with \p Assign
+    template <typename VectorIn, typename VectorOut, typename Assign>
+    void mult(const VectorIn& v, VectorOut& w, Assign) const
+    {
+	MTL_DEBUG_THROW_IF(size(v) != ncols || size(w) != nrows, incompatible_size());
+	const unsigned p= selected.parameter;
+	switch (selected.kernel) {
+	  case spmv_kernel::crs:
+	    if (Assign::init_to_zero && crs.nnz() < nrows) // kernel for very sparse matrices skips empty rows
+		set_to_zero(w);
+	    mat_cvec_mult(crs, v, w, Assign(), tag::flat<tag::sparse>());
+	    break;
+	  case spmv_kernel::crs_unrolled:
+	    if (Assign::init_to_zero && crs.nnz() < nrows)
+		set_to_zero(w);
+	    if (p == 1) smat_cvec_mult<1>(crs, v, w, Assign(), tag::row_major());
+	    else if (p == 2) smat_cvec_mult<2>(crs, v, w, Assign(), tag::row_major());
+	    else if (p == 4) smat_cvec_mult<4>(crs, v, w, Assign(), tag::row_major());
+	    else smat_cvec_mult<8>(crs, v, w, Assign(), tag::row_major());
+	    break;
+	  case spmv_kernel::ell:
+	    mat_cvec_mult(ell, v, w, Assign(), tag::flat<tag::sparse>());
+	    break;
+	  case spmv_kernel::sliced_ell:
+	    if (p == 8) sell.template mult<8>(nrows, v, w, Assign(), selected.schedule);
+	    else sell.template mult<32>(nrows, v, w, Assign(), selected.schedule);
+	    break;
+	  case spmv_kernel::blocked_crs:
+	    if (p == 2) bcrs.template mult<2>(v, w, Assign(), selected.schedule);
+	    else bcrs.template mult<4>(v, w, Assign(), selected.schedule);
+	    break;
+	}
+    }
+
+    /// Multiplication is procastinated until we know where the product goes
+    template <typename VectorIn>
+    vec::mat_cvec_multiplier<self, VectorIn> operator*(const VectorIn& v) const
+    {	return vec::mat_cvec_multiplier<self, VectorIn>(*this, v);    }
+
+  private:
+    typedef std::chrono::steady_clock clock;
+
+    void init(const source_type& A)
+    {
+	nrows= mtl::mat::num_rows(A); ncols= mtl::mat::num_cols(A); my_nnz= A.nnz();
+    }
+
+    // Whether variant t was selected for a matrix like A and can be built for A
+    bool usable(const source_type& A, const spmv_tuning& t) const
+    {
+	return t.matches(nrows, ncols, my_nnz) && t.valid_parameter()
+	    && (t.kernel != spmv_kernel::blocked_crs || detail::blocked_crs_data<Value, size_type>::applicable(A, t.parameter));
+    }
+
+    // Create the layout for variant t and release the others
+    void build(const source_type& A, const spmv_tuning& t)
+    {
+	selected= t;
+	if (t.kernel == spmv_kernel::crs || t.kernel == spmv_kernel::crs_unrolled) {
+	    if (mtl::mat::num_rows(crs) != nrows || mtl::mat::num_cols(crs) != ncols || crs.nnz() != my_nnz)
+		crs= A;
+	} else
+	    crs.change_dim(0, 0);
+	if (t.kernel == spmv_kernel::ell) {
+	    ell.change_dim(nrows, ncols);
+	    ell= A;
+	} else
+	    ell.change_dim(0, 0);
+	if (t.kernel == spmv_kernel::sliced_ell)
+	    sell.assign(A, t.parameter);
+	else
+	    sell.clear();
+	if (t.kernel == spmv_kernel::blocked_crs)
+	    bcrs.assign(A, t.parameter);
+	else
+	    bcrs.clear();
+    }
+
+    void tune(const source_type& A, int repetitions)
+    {
+	MTL_THROW_IF(repetitions < 1, logic_error("At least one repetition needed"));
+	std::vector<spmv_tuning> c;
+	c.push_back(spmv_tuning(spmv_kernel::crs));
+	for (unsigned p= 1; p <= 8; p*= 2)
+	    c.push_back(spmv_tuning(spmv_kernel::crs_unrolled, p));
+	if (A.nnz() > 0) {
+	    const structure_analysis a(analyze_structure(A));
+	    if (a.ell_efficiency() >= detail::auto_tuned_min_efficiency)
+		c.push_back(spmv_tuning(spmv_kernel::ell));
+	    for (unsigned h= 8; h <= 32; h*= 4)
+		if (detail::sliced_ell_data<Value, size_type>::efficiency(A, h) >= detail::auto_tuned_min_efficiency)
+		    add_schedules(c, spmv_tuning(spmv_kernel::sliced_ell, h));
+	    for (unsigned b= 2; b <= 4; b*= 2)
+		if (detail::blocked_crs_data<Value, size_type>::applicable(A, b))
+		    add_schedules(c, spmv_tuning(spmv_kernel::blocked_crs, b));
+	}
+
+	vec::dense_vector<Value> x(ncols, Value(1)), y(nrows);
+	spmv_tuning              best;
+	for (std::size_t i= 0; i < c.size(); i++) {
+	    build(A, c[i]);
+	    mult(x, y, assign::assign_sum()); // warm-up
+	    for (int r= 0; r < repetitions; r++) {
+		clock::time_point start= clock::now();
+		mult(x, y, assign::assign_sum());
+		c[i].seconds= std::min(c[i].seconds, std::chrono::duration<double>(clock::now() - start).count());
+	    }
+	    c[i].rows= nrows; c[i].cols= ncols; c[i].nnz= my_nnz;
+	    if (c[i].seconds < best.seconds)
+		best= c[i];
+	}
+	build(A, best);
+	timed.swap(c);
+    }
+
+    static void add_schedules(std::vector<spmv_tuning>& c, spmv_tuning t)
+    {
+	t.schedule= spmv_schedule::serial;
+	c.push_back(t);
+#     ifdef MTL_WITH_OPENMP
+	t.schedule= spmv_schedule::omp_static;
+	c.push_back(t);
+	t.schedule= spmv_schedule::omp_dynamic;
+	c.push_back(t);
+#     endif
+    }
+
+    size_type                                     nrows, ncols, my_nnz;
+    spmv_tuning                                   selected;
+    std::vector<spmv_tuning>                      timed;
+    source_type                                   crs;
+    ell_matrix<Value, Parameters>                 ell;
+    detail::sliced_ell_data<Value, size_type>     sell;
+    detail::blocked_crs_data<Value, size_type>    bcrs;
+};
+
+template <typename Value, typename Parameters>
+inline std::size_t size(const auto_tuned_matrix<Value, Parameters>& A)
+{ return std::size_t(A.num_rows()) * std::size_t(A.num_cols()); } ///< Matrix size
+
+template <typename Value, typename Parameters>
+inline std::size_t num_rows(const auto_tuned_matrix<Value, Parameters>& A) { return A.num_rows(); } ///< Number of rows
+
+template <typename Value, typename Parameters>
+inline std::size_t num_cols(const auto_tuned_matrix<Value, Parameters>& A) { return A.num_cols(); } ///< Number of columns
+
+}} // namespace mtl::mat
+
+namespace mtl {
+
+    template <typename Value, typename Parameters>
+    struct Collection<mat::auto_tuned_matrix<Value, Parameters> >
+    {
+	typedef Value                           value_type;
+	typedef typename Parameters::size_type  size_type;
+    };
+
+    namespace ashape {
+	template <typename Value, typename Parameters>
+	struct ashape_aux<mtl::mat::auto_tuned_matrix<Value, Parameters> >
+	{	typedef nonscal type;    };
+    }
+}
+
+#endif // MTL_MATRIX_AUTO_TUNED_MATRIX_INCLUDE
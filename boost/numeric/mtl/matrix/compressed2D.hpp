@@ -17,6 +17,7 @@
 #include <vector>
 #include <map>
 #include <cmath>
+#include <limits>
 #include <boost/tuple/tuple.hpp>
 #include <boost/type_traits/is_same.hpp>
 #include <boost/mpl/if.hpp>
@@ -29,6 +30,7 @@
 #include <boost/numeric/mtl/utility/assert.hpp>
 #include <boost/numeric/mtl/utility/maybe.hpp>
 #include <boost/numeric/mtl/utility/shrink_stl_vector.hpp>
+#include <boost/numeric/mtl/utility/allocation.hpp>
 #include <boost/numeric/mtl/utility/zipped_sort.hpp>
 #include <boost/numeric/mtl/detail/base_cursor.hpp>
 #include <boost/numeric/mtl/operation/is_negative.hpp>
@@ -189,13 +191,14 @@ struct compressed2D_indexer
 	if (ma.indices.empty())
 	    return result_type(0, false);
 
-	const size_type *first = &ma.indices[0] + ma.starts[major],
-	             *last = &ma.indices[0] + ma.starts[major+1];
+	typedef typename Matrix::minor_index_type minor_index_type;
+	const minor_index_type *first = &ma.indices[0] + ma.starts[major],
+	                       *last = &ma.indices[0] + ma.starts[major+1];
 	// if empty row (or column) return start of next one
 	if (first == last) 
 	    return result_type(first - &ma.indices[0], false);
 
-	const size_type *index= first;
+	const minor_index_type *index= first;
 	if (last - index <= int(compressed_linear_search_limit))
 	    while (index != last && *index < minor) ++index;
 	else
@@ -272,11 +275,30 @@ class compressed2D
     {
 	if (new_nnz != 0) {
 	    this->my_nnz = size_type(new_nnz);
-	    data.resize(this->my_nnz);
-	    indices.resize(this->my_nnz, 0);
+	    allocation::resize(data, this->my_nnz);
+	    allocation::resize(indices, this->my_nnz);
 	}
     }
 
+#ifdef MTL_NUMA_FIRST_TOUCH
+    // Copy of the arrays of src where each thread first touches the rows (columns) that it processes in the kernels
+    void first_touch_copy(const self& src)
+    {
+	using std::swap;
+	value_vector_type new_data(src.data.size());      // not initialized with allocation::allocator
+	index_vector_type new_starts(src.starts.size());
+	minor_vector_type new_indices(src.indices.size());
+	if (!src.starts.empty())
+	    numa::copy_rows(src.starts.size() - 1, &src.starts[0], src.indices.empty() ? 0 : &src.indices[0], 
+			    src.data.empty() ? 0 : &src.data[0], &new_starts[0], 
+			    new_indices.empty() ? 0 : &new_indices[0], new_data.empty() ? 0 : &new_data[0]);
+	swap(data, new_data);
+	swap(starts, new_starts);
+	swap(indices, new_indices);
+	this->my_nnz= src.my_nnz;
+    }
+#endif
+
   public:
     typedef Parameters                               parameters;
     typedef typename Parameters::orientation         orientation;
@@ -288,11 +310,24 @@ class compressed2D
     typedef value_type                               const_reference;
 
     typedef typename Parameters::size_type           size_type;
+    typedef typename Parameters::allocator           allocator_type;    ///< Allocation policy of the arrays
+    typedef typename allocation::vector<value_type, allocator_type>::type value_vector_type; ///< Type of data vector
+    typedef typename Parameters::minor_index_type    minor_index_type;  ///< Type of minor indices (e.g. column indices in CRS)
+    typedef typename allocation::vector<size_type, allocator_type>::type  index_vector_type; ///< Type of start vector
+    typedef typename allocation::vector<minor_index_type, allocator_type>::type minor_vector_type; ///< Type of index vector
     typedef crtp_matrix_assign<self, Elt, size_type>  assign_base;
     typedef compressed2D_indexer<size_type>          indexer_type;
 
     void check() const { MTL_CRASH_IF(inserting, "Access during insertion!"); }
 
+    /// Throws range_error if the largest minor index of an \p r by \p c matrix cannot be represented by \p minor_index_type
+    void check_minor_range(size_type r, size_type c) const
+    {
+	const size_type minor= boost::is_same<orientation, row_major>::value ? c : r;
+	MTL_THROW_IF(minor > 0 && minor - 1 > size_type(std::numeric_limits<minor_index_type>::max()),
+		     range_error("Minor index too large for minor_index_type"));
+    }
+
     /// Removes all values; e.g. for set_to_zero
     void make_empty()
     {
@@ -308,6 +343,7 @@ class compressed2D
     {
 	check();
 	if (this->num_rows() != r || this->num_cols() != c) {
+	    check_minor_range(r, c);
 	    super::change_dim(r, c);
 	    starts.resize(this->dim1()+1);
 	    make_empty();
@@ -318,8 +354,8 @@ class compressed2D
     void set_nnz(size_type n)
     {
 	check();
-	indices.resize(n);
-	data.resize(n);
+	allocation::resize(indices, n);
+	allocation::resize(data, n);
 	this->my_nnz= n;
     }
 
@@ -335,6 +371,7 @@ class compressed2D
     explicit compressed2D (mtl::non_fixed::dimensions d, size_t nnz = 0) 
       : super(d), inserting(false)
     {
+	check_minor_range(this->num_rows(), this->num_cols());
 	starts.resize(super::dim1() + 1, 0);
 	allocate(nnz);
     }
@@ -343,6 +380,7 @@ class compressed2D
     explicit compressed2D (size_type num_rows, size_type num_cols, size_t nnz = 0) 
       : super(non_fixed::dimensions(num_rows, num_cols)), inserting(false)
     {
+	check_minor_range(this->num_rows(), this->num_cols());
 	starts.resize(super::dim1() + 1, 0);
 	allocate(nnz);
     }
@@ -363,16 +401,21 @@ class compressed2D
       indices.assign(Minor, Minor + nnz);
     }
 
+#if defined(MTL_NUMA_FIRST_TOUCH)
+    /// Copy constructor that places the rows (columns) on the NUMA nodes of the threads processing them
+    compressed2D(const self& src) : super(src), inserting(false)
+    {
+	first_touch_copy(src);
+    }
+
     // Default is faster !!! Only used with move constructor and without defaults
-#if (!defined(MTL_WITH_DEFAULTIMPL) && defined(MTL_WITH_MOVE))
+#elif (!defined(MTL_WITH_DEFAULTIMPL) && defined(MTL_WITH_MOVE))
     /// Copy constructor (just in case that is not generated by all compilers (generic matrix copy slower))
     compressed2D(const self& src) 
       : super(src), data(src.data),
 	starts(src.starts), indices(src.indices), inserting(false)
     {}
-#endif
-
-#if defined(MTL_WITH_DEFAULTIMPL)
+#elif defined(MTL_WITH_DEFAULTIMPL)
     compressed2D(const compressed2D&) = default;
 #endif
 
@@ -425,11 +468,15 @@ class compressed2D
 	    return *this;
 	check(); 
 	this->checked_change_dim(src.num_rows(), src.num_cols());
+#     ifdef MTL_NUMA_FIRST_TOUCH
+	first_touch_copy(src);
+#     else
 	set_nnz(src.nnz());
 
 	starts= src.starts;
 	indices= src.indices;
 	data= src.data;
+#     endif
 	inserting = src.inserting;
 	return *this;
     }
@@ -590,7 +637,7 @@ class compressed2D
 	value_type z= zero(data[0]);
 	size_type nzi= 0; // Where to copy next non-zero
 	
-	std::vector<size_type>  new_starts(this->dim1() + 1);
+	index_vector_type  new_starts(this->dim1() + 1);
 	new_starts[0] = 0;
 
 	for (size_type i = 0; i < this->dim1(); i++) {
@@ -611,18 +658,18 @@ class compressed2D
     /// Address of first major index; to be used with care. [advanced]
     const size_type* address_major() const { check(); return &starts[0]; }
     /// Address of first minor index; to be used with care. [advanced]
-    size_type* address_minor() { check(); return &indices[0]; }
+    minor_index_type* address_minor() { check(); return &indices[0]; }
     /// Address of first minor index; to be used with care. [advanced]
-    const size_type* address_minor() const { check(); return &indices[0]; }
+    const minor_index_type* address_minor() const { check(); return &indices[0]; }
     /// Address of first data entry; to be used with care. [advanced]
     value_type* address_data() { check(); return &data[0]; }
     /// Address of first data entry; to be used with care. [advanced]
     const value_type* address_data() const { check(); return &data[0]; }
 
-    const std::vector<size_type>& ref_major() const { return starts; } ///< Refer start vector [advanced]
-          std::vector<size_type>& ref_major()       { return starts; } ///< Refer start vector [advanced]
-    const std::vector<size_type>& ref_minor() const { return indices; } ///< Refer index vector [advanced]
-          std::vector<size_type>& ref_minor()       { return indices; } ///< Refer index vector [advanced]
+    const index_vector_type& ref_major() const { return starts; } ///< Refer start vector [advanced]
+          index_vector_type& ref_major()       { return starts; } ///< Refer start vector [advanced]
+    const minor_vector_type& ref_minor() const { return indices; } ///< Refer index vector [advanced]
+          minor_vector_type& ref_minor()       { return indices; } ///< Refer index vector [advanced]
 
     /// Release unused space in STL vectors
     void shrink() 
@@ -645,10 +692,10 @@ class compressed2D
     template <typename, typename> friend struct compressed_minor_cursor;
 
     indexer_type            indexer;
-    std::vector<value_type> data; 
+    value_vector_type       data; 
   protected:
-    std::vector<size_type>  starts;
-    std::vector<size_type>  indices;
+    index_vector_type       starts;
+    minor_vector_type       indices;
     bool                    inserting;
 };
 
@@ -666,6 +713,10 @@ struct compressed2D_inserter
     typedef compressed2D<Elt, Parameters>     matrix_type;
     typedef typename matrix_type::size_type   size_type;
     typedef typename matrix_type::value_type  value_type;
+    typedef typename matrix_type::value_vector_type value_vector_type;
+    typedef typename matrix_type::index_vector_type index_vector_type;
+    typedef typename matrix_type::minor_index_type  minor_index_type;
+    typedef typename matrix_type::minor_vector_type minor_vector_type;
     typedef std::pair<size_type, size_type>   size_pair;
     typedef std::map<size_pair, value_type>   map_type;
     typedef operations::update_proxy<self, size_type>   proxy_type;
@@ -694,6 +745,9 @@ struct compressed2D_inserter
 	if (num_rows(matrix) > 0 && num_cols(matrix) > 0) {
 	    final_place();
 	    insert_spare();
+#         ifdef MTL_NUMA_FIRST_TOUCH
+	    matrix.first_touch_copy(matrix); // replace entries serially inserted
+#         endif
 	}
 	matrix.inserting = false;
 	//std::cout << "Finish: set inserting to false.\n";
@@ -707,6 +761,7 @@ struct compressed2D_inserter
     {
 	vampir_trace<3050> tracer;
 	MTL_THROW_IF(matrix.inserting, runtime_error("Two inserters on same matrix"));
+	matrix.check_minor_range(matrix.num_rows(), matrix.num_cols());
 	matrix.inserting = true;
 	if (size(matrix) > 0)
 	    stretch();
@@ -810,10 +865,10 @@ struct compressed2D_inserter
     }
 
     // not so nice functions needed for direct access, e.g. in factorizations
-    std::vector<size_type> const& ref_major() const { return starts; } ///< Refer start vector [advanced]
-    std::vector<size_type> const& ref_minor() const { return indices; } ///< Refer index vector [advanced]
+    index_vector_type const& ref_major() const { return starts; } ///< Refer start vector [advanced]
+    minor_vector_type const& ref_minor() const { return indices; } ///< Refer index vector [advanced]
     std::vector<size_type> const& ref_slot_ends() const { return slot_ends; } ///< Refer slot-end vector [advanced]
-    std::vector<value_type> const& ref_elements() const { return elements; } ///< Refer element vector [advanced]
+    value_vector_type const& ref_elements() const { return elements; } ///< Refer element vector [advanced]
 
   private:
     utilities::maybe<typename self::size_type> matrix_offset(size_pair) const;
@@ -852,9 +907,9 @@ struct compressed2D_inserter
 
   protected:
     compressed2D<Elt, Parameters>&      matrix;
-    std::vector<value_type>&            elements;
-    std::vector<size_type>&             starts;
-    std::vector<size_type>&             indices;
+    value_vector_type&                  elements;
+    index_vector_type&                  starts;
+    minor_vector_type&                  indices;
     size_type                           slot_size;
     std::vector<size_type>              slot_ends;
     map_type                            spare;
@@ -874,7 +929,7 @@ void compressed2D_inserter<Elt, Parameters, Updater>::stretch()
 	    slot_ends[i]= starts[i]= s;
 	size_type new_total= (slot_ends[matrix.dim1()]= starts[matrix.dim1()]) + slot_size;
 	elements.reserve(new_total); indices.reserve(new_total);
-	elements.resize(new_total); indices.resize(new_total);
+	allocation::resize(elements, new_total); allocation::resize(indices, new_total);
 	return;
     }
 
@@ -888,7 +943,7 @@ void compressed2D_inserter<Elt, Parameters, Updater>::stretch()
 	return;
     }
 
-    std::vector<size_type>  new_starts(matrix.dim1() + 1);
+    index_vector_type       new_starts(matrix.dim1() + 1);
     new_starts[0] = 0;
     for (size_type i = 0; i < matrix.dim1(); i++) {
 	size_type entries = starts[i+1] - starts[i];
@@ -897,8 +952,8 @@ void compressed2D_inserter<Elt, Parameters, Updater>::stretch()
     }
     // Add an additional slot for temporaries
     size_type new_total= (slot_ends[matrix.dim1()]= new_starts[matrix.dim1()]) + slot_size;
-    elements.resize(new_total);
-    indices.resize(new_total);
+    allocation::resize(elements, new_total);
+    allocation::resize(indices, new_total);
     // for (int i= 0; i < matrix.dim1()+1; i++) std::cout << "Slot " << i << " is [" << new_starts[i] << ", " << slot_ends[i] << ")\n";
    
     // copy normally if not overlapping and backward if overlapping
@@ -928,12 +983,12 @@ compressed2D_inserter<Elt, Parameters, Updater>::matrix_offset(size_pair mm) con
 	return utilities::maybe<size_type> (0, false);
 
     // &v[i] isn't liked by all libs -> &v[0]+i circumvents complaints
-    const size_type *first = &indices[0] + starts[major],
-  	            *last =  &indices[0] + slot_ends[major];
+    const minor_index_type *first = &indices[0] + starts[major],
+  	                   *last =  &indices[0] + slot_ends[major];
     if (first == last) 
 	return utilities::maybe<size_type> (first - &indices[0], false);
 
-    const size_type *index= first;
+    const minor_index_type *index= first;
     if (last - index < 10)
 	while (index != last && *index < minor) ++index;
     else
@@ -1005,16 +1060,18 @@ compressed2D_inserter<Elt, Parameters, Updater>::sorted_block_insertion(const el
     using std::copy; using std::copy_backward; using std::min;
     using mtl::size; using mtl::num_rows; using mtl::num_cols;
     using namespace mtl::utility;
-    typedef zip_it<size_type, value_type> it_type;
+    typedef zip_it<minor_index_type, value_type> it_type;
 
     size_type m= size(iblock.rows), n= size(iblock.cols);
     MTL_THROW_IF(m != num_rows(iblock.matrix) || n != num_cols(iblock.matrix), incompatible_size());
     MTL_THROW_IF(&iblock.matrix[0][1] - &iblock.matrix[0][0] != 1, logic_error("Rows must be consecutive"));
 
-    size_type rmax= matrix.dim1(), &index_max0= indices[starts[rmax]];
+    size_type rmax= matrix.dim1();
+    minor_index_type& index_max0= indices[starts[rmax]];
     value_type& value_max0= elements[starts[rmax]];
     for (size_type i= 0; i < m; i++) {
-	size_type r= iblock.rows[i], &index_0= indices[starts[r]];
+	size_type r= iblock.rows[i];
+	minor_index_type& index_0= indices[starts[r]];
 	value_type& value_0= elements[starts[r]];
 	if (slot_ends[r] == starts[r]) {
 	    size_type to_copy= min(starts[r+1] - starts[r], n);
@@ -1076,7 +1133,7 @@ void compressed2D_inserter<Elt, Parameters, Updater>::final_place()
     vampir_trace<3053> tracer;
 
     size_type          dim1 = matrix.dim1();
-    std::vector<size_type>  new_starts(dim1 + 1);
+    index_vector_type       new_starts(dim1 + 1);
     new_starts[0] = 0;
 
     if (spare.empty()) {
@@ -1114,8 +1171,8 @@ void compressed2D_inserter<Elt, Parameters, Updater>::final_place()
 
     size_type new_total = new_starts[dim1], old_total = starts[dim1];
     if (new_total > old_total) {
-	elements.resize(new_total);
-	indices.resize(new_total); }
+	allocation::resize(elements, new_total);
+	allocation::resize(indices, new_total); }
  
     operations::shift_blocks(dim1, starts, new_starts, slot_ends, elements);
     operations::shift_blocks(dim1, starts, new_starts, slot_ends, indices);
@@ -169,14 +169,14 @@ template <typename Value, typename Parameters = parameters<> >
 class dense2D
     : public base_sub_matrix<Value, Parameters>,
     public mtl::detail::contiguous_memory_block< Value, Parameters::on_stack,
-    detail::dense2D_array_size<Parameters, Parameters::on_stack>::value >,
+    detail::dense2D_array_size<Parameters, Parameters::on_stack>::value, typename Parameters::allocator >,
     public crtp_base_matrix< dense2D<Value, Parameters>, Value, std::size_t >,
     public mat_expr< dense2D<Value, Parameters> >
 {
     typedef dense2D                                           self;
     typedef base_sub_matrix<Value, Parameters>                super;
     typedef mtl::detail::contiguous_memory_block<Value, Parameters::on_stack,
-	detail::dense2D_array_size<Parameters, Parameters::on_stack>::value>     memory_base;
+	detail::dense2D_array_size<Parameters, Parameters::on_stack>::value, typename Parameters::allocator>     memory_base;
     typedef mat_expr< dense2D<Value, Parameters> >            expr_base;
     typedef crtp_base_matrix< self, Value, std::size_t >      crtp_base;
     typedef crtp_matrix_assign< self, Value, std::size_t >    assign_base;
@@ -102,6 +102,15 @@ class multi_vector
 	this->my_nnz= num_cols * size(v);
     }
 
+    /// Copy constructor, the copy has its own memory
+    multi_vector(const self& src)
+      : super(non_fixed::dimensions(src.num_rows(), src.num_cols())), data(src.num_cols())
+    {
+	setup_data(src.num_rows(), src.num_cols(), mtl::traits::is_composable_vector<Vector>());
+	self_assignment(src, mtl::traits::is_composable_vector<Vector>());
+	this->my_nnz= src.num_rows() * src.num_cols();
+    }
+
     ~multi_vector() { delete master; }
 
   private:
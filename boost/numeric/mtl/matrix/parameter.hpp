@@ -18,11 +18,15 @@
 #include <boost/numeric/mtl/detail/index.hpp>
 #include <boost/numeric/mtl/matrix/dimension.hpp>
 #include <boost/numeric/mtl/utility/is_static.hpp>
+#include <boost/numeric/mtl/utility/allocation.hpp>
 
 namespace mtl { namespace mat {
 
 /// Type for bundling template parameters of common matrix types
 /** OnStack = true can only be used with fixed::dimensions.
+    MinorIndex is the type of the minor indices in compressed2D (column indices of row-major matrices)
+    while its starts use SizeType.  E.g. unsigned minor indices with 64-bit starts halve the index traffic
+    of sparse matrix-vector products when the number of non-zeros exceeds 2^32 but the dimensions do not.
     \sa \ref matrix_parameters
     \sa \ref tuning_fsize
     \sa \ref tuning_sizetype **/
@@ -30,7 +34,9 @@ template <typename Orientation= row_major,
 	  typename Index= index::c_index,
 	  typename Dimensions= mtl::non_fixed::dimensions,
 	  bool OnStack= mtl::traits::is_static<Dimensions>::value,
-	  typename SizeType= std::size_t>
+	  typename SizeType= std::size_t,
+	  typename Allocator= mtl::allocation::default_policy,
+	  typename MinorIndex= SizeType>
 struct parameters 
 {
     typedef Orientation orientation;
@@ -38,6 +44,8 @@ struct parameters
     typedef Dimensions  dimensions;
     static bool const   on_stack= OnStack;
     typedef SizeType    size_type;
+    typedef Allocator   allocator;   ///< Allocation policy of the heap memory, see mtl::allocation
+    typedef MinorIndex  minor_index_type; ///< Type of minor indices in sparse matrices
 
     // Matrix dimensions must be known at compile time to be on the stack
     // MTL_STATIC_ASSERT(( !on_stack || dimensions::is_static ), "Types to be stored on stack must provide static size.");
@@ -46,6 +54,10 @@ struct parameters
 /// Short-cut to define parameters with unsigned and defaults otherwise
 typedef parameters<row_major, index::c_index, mtl::non_fixed::dimensions, false, unsigned> unsigned_parameters;
 
+/// Short-cut to define parameters with unsigned minor indices (and std::size_t starts) and defaults otherwise
+typedef parameters<row_major, index::c_index, mtl::non_fixed::dimensions, false, std::size_t,
+		   mtl::allocation::default_policy, unsigned> unsigned_index_parameters;
+
 }} // namespace mtl::matrix
 
 #endif // MTL_MATRIX_PARAMETERS_INCLUDE
@@ -55,7 +55,7 @@ namespace mtl {
     /// Namespace for matrices and views and operations exclusively on matrices
     namespace mat {
 
-	template <typename Orientation, typename Index, typename Dimensions, bool OnStack, typename SizeType> struct parameters;
+	template <typename Orientation, typename Index, typename Dimensions, bool OnStack, typename SizeType, typename Allocator, typename MinorIndex> struct parameters;
 
         template <typename Value, typename Parameters> class dense2D;
 
@@ -230,6 +230,7 @@ namespace mtl {
 	template <unsigned BSize, typename Vector> class unrolled1;  
 
 	template <typename Scalar, typename Vector, typename Functor, typename Assign> struct reduction_index_evaluator;
+	template <typename VectorOut, typename Matrix, typename VectorIn, typename Assign> struct row_mat_cvec_index_evaluator;
 	template <typename Scalar, typename Vector1, typename Vector2, typename ConjOpt, typename Assign> struct dot_index_evaluator;
 	template <unsigned long Unroll, typename Vector1, typename Vector2, typename ConjOpt> struct dot_class;
 
@@ -435,8 +436,17 @@ namespace mtl {
 	template <typename Matrix> struct const_crtp_matrix_range_bracket;
     }
 
+    namespace allocation {
+	struct heap;
+	struct aligned;
+	struct first_touch;
+	struct pooled;
+	struct default_policy;
+	class arena;
+    }
+
     namespace detail {
-	template <typename Value, bool OnStack, unsigned Size= 0> struct contiguous_memory_block;
+	template <typename Value, bool OnStack, unsigned Size= 0, typename Allocator= allocation::default_policy> struct contiguous_memory_block;
 	template <typename Matrix, typename Updater> struct trivial_inserter;
 	template <typename Collection> struct with_format_t;
     }
@@ -470,6 +480,10 @@ namespace mtl {
 
 	template <typename MatrixIStream, typename MatrixOStream> class matrix_file;
 	typedef matrix_file<matrix_market_istream, matrix_market_ostream> matrix_market;
+
+	class binary_istream;
+	class binary_ostream;
+	typedef matrix_file<binary_istream, binary_ostream> binary;
     }
 
     // Multiplication functors
@@ -0,0 +1,219 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_ACCUMULATION_INCLUDE
+#define MTL_ACCUMULATION_INCLUDE
+
+#include <cmath>
+#include <math.h>
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/numeric/linear_algebra/identity.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/operation/conj.hpp>
+#include <boost/numeric/mtl/operation/size.hpp>
+#include <boost/numeric/mtl/utility/static_assert.hpp>
+#include <boost/numeric/mtl/vector/blocked_reduction.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
+
+namespace mtl {
+
+/// Accumulation policies for the sums in dot, unary_dot, two_norm, sum and sparse matrix-vector products
+/** Pass a policy object as additional argument, e.g. dot(v, w, accumulation::dot2()).
+    The compensated policies are only defined for real floating-point values and
+    rely on IEEE arithmetic: do not compile them with -ffast-math or similar. **/
+namespace accumulation {
+
+    /// Ordinary floating-point summation
+    struct plain {};
+
+    /// Compensated summation after Kahan in the variant of Neumaier
+    /** The rounding errors of the additions are accumulated separately and added at the end;
+	the products in dot products are still rounded. **/
+    struct kahan {};
+
+    /// Dot2 of Ogita, Rump and Oishi with error-free transformations of sums and products (using FMA)
+    /** The result is as accurate as if computed in twice the working precision and then rounded.
+	Efficient with hardware FMA (e.g. -mfma or -march=native), otherwise std::fma is emulated slowly. **/
+    struct dot2 {};
+
+    /// Whether \p T is an accumulation policy
+    template <typename T> struct is_policy : boost::mpl::false_ {};
+    template <> struct is_policy<plain> : boost::mpl::true_ {};
+    template <> struct is_policy<kahan> : boost::mpl::true_ {};
+    template <> struct is_policy<dot2>  : boost::mpl::true_ {};
+
+    /// Sum \p s and error \p e of a + b without rounding error, i.e. s + e == a + b exactly (Knuth's TwoSum)
+    /** \p a and \p b are passed by value such that \p s can be one of the summands. **/
+    template <typename Value>
+    inline void two_sum(Value a, Value b, Value& s, Value& e)
+    {
+	s= a + b;
+	const Value bb= s - a;
+	e= (a - (s - bb)) + (b - bb);
+    }
+
+    /// Product \p p and error \p e of a * b without rounding error, i.e. p + e == a * b exactly
+    template <typename Value>
+    inline void two_prod(Value a, Value b, Value& p, Value& e)
+    {
+#     if __cplusplus >= 201103L
+	using std::fma;
+	p= a * b;
+	e= fma(a, b, -p);
+#     else
+	p= a * b;
+	e= Value(::fma(a, b, -p)); // C99 version in double: exact for float as well
+#     endif
+    }
+
+    /// Accumulator of \p Value with accumulation \p Policy
+    /** add(x) adds x, add_product(a, b) adds a * b, join(acc) adds the sum of accumulator acc,
+	and value() returns the current sum. **/
+    template <typename Policy, typename Value> class accumulator;
+
+    template <typename Value>
+    class accumulator<plain, Value>
+    {
+      public:
+	accumulator() : s(math::zero(Value())) {}
+
+	void add(const Value& x) { s+= x; }
+	void add_product(const Value& a, const Value& b) { s+= a * b; }
+	void join(const accumulator& acc) { s+= acc.s; }
+	Value value() const { return s; }
+      private:
+	Value s;
+    };
+
+    template <typename Value>
+    class accumulator<kahan, Value>
+    {
+	MTL_STATIC_ASSERT((boost::is_floating_point<Value>::value), "Compensated summation requires real floating-point values.");
+      public:
+	accumulator() : s(0), c(0) {}
+
+	void add(const Value& x)
+	{
+	    using std::abs;
+	    const Value t= s + x;
+	    if (abs(s) >= abs(x))
+		c+= (s - t) + x;
+	    else
+		c+= (x - t) + s;
+	    s= t;
+	}
+
+	void add_product(const Value& a, const Value& b) { add(a * b); }
+	void join(const accumulator& acc) { add(acc.s); c+= acc.c; }
+	Value value() const { return s + c; }
+      private:
+	Value s, c; // sum and compensation
+    };
+
+    template <typename Value>
+    class accumulator<dot2, Value>
+    {
+	MTL_STATIC_ASSERT((boost::is_floating_point<Value>::value), "Dot2 requires real floating-point values.");
+      public:
+	accumulator() : s(0), c(0) {}
+
+	void add(const Value& x)
+	{
+	    Value e;
+	    two_sum(s, x, s, e);
+	    c+= e;
+	}
+
+	void add_product(const Value& a, const Value& b)
+	{
+	    Value p, ep, es;
+	    two_prod(a, b, p, ep);
+	    two_sum(s, p, s, es);
+	    c+= es + ep;
+	}
+
+	void join(const accumulator& acc) { add(acc.s); c+= acc.c; }
+	Value value() const { return s + c; }
+      private:
+	Value s, c; // sum and accumulated errors
+    };
+
+    namespace detail {
+
+	// Accumulated conj(v1[i]) * v2[i] for i in [from, to)
+	template <typename Policy, typename Value, typename Vector1, typename Vector2>
+	struct dot_block
+	{
+	    dot_block(const Vector1& v1, const Vector2& v2) : v1(v1), v2(v2) {}
+
+	    accumulator<Policy, Value> operator()(std::size_t from, std::size_t to) const
+	    {
+		using mtl::conj;
+		accumulator<Policy, Value> acc;
+		for (std::size_t i= from; i < to; i++)
+		    acc.add_product(conj(v1[i]), v2[i]);
+		return acc;
+	    }
+
+	    const Vector1& v1;
+	    const Vector2& v2;
+	};
+
+	// Accumulated v[i] for i in [from, to)
+	template <typename Policy, typename Value, typename Vector>
+	struct sum_block
+	{
+	    explicit sum_block(const Vector& v) : v(v) {}
+
+	    accumulator<Policy, Value> operator()(std::size_t from, std::size_t to) const
+	    {
+		accumulator<Policy, Value> acc;
+		for (std::size_t i= from; i < to; i++)
+		    acc.add(v[i]);
+		return acc;
+	    }
+
+	    const Vector& v;
+	};
+    }
+
+    /// Dot product hermitian(v1) * v2 with accumulation \p Policy
+    /** Computed in blocks of vec::reduction_block_size (in parallel with OpenMP) whose accumulators
+	are joined in a fixed tree, see vec::blocked_reduction. Thus the results do not depend on the number of threads. **/
+    template <typename Value, typename Policy, typename Vector1, typename Vector2>
+    inline Value reduce_dot(const Vector1& v1, const Vector2& v2, Policy)
+    {
+	vampir_trace<2045> tracer;
+	roofline<2045> roof(mtl::traits::roofline_vector_flops(v1) + mtl::traits::roofline_vector_flops(v2) + 2.0 * mtl::size(v1),
+			    mtl::traits::roofline_vector_bytes(v1) + mtl::traits::roofline_vector_bytes(v2));
+	return vec::blocked_reduction(std::size_t(mtl::size(v1)), detail::dot_block<Policy, Value, Vector1, Vector2>(v1, v2),
+				      vec::evaluator_join(), accumulator<Policy, Value>()).value();
+    }
+
+    /// Sum of the entries of \p v with accumulation \p Policy
+    template <typename Value, typename Policy, typename Vector>
+    inline Value reduce_sum(const Vector& v, Policy)
+    {
+	vampir_trace<2045> tracer;
+	roofline<2045> roof(mtl::traits::roofline_vector_flops(v) + mtl::size(v), mtl::traits::roofline_vector_bytes(v));
+	return vec::blocked_reduction(std::size_t(mtl::size(v)), detail::sum_block<Policy, Value, Vector>(v),
+				      vec::evaluator_join(), accumulator<Policy, Value>()).value();
+    }
+
+} // namespace accumulation
+
+} // namespace mtl
+
+#endif // MTL_ACCUMULATION_INCLUDE
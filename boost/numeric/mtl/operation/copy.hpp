@@ -33,6 +33,8 @@
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 #include <boost/type_traits/is_same.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <iostream>
 #include <limits>
@@ -134,16 +136,20 @@ namespace mtl {
 		{ return i == std::numeric_limits<T>::min() ? std::numeric_limits<T>::max() : -i; }
     }
 
-    template <typename Updater, typename ValueSrc, typename Para, typename ValueDest>
-    typename boost::enable_if<boost::is_same<Updater, operations::update_store<ValueDest> > >::type
-    inline gen_matrix_copy(const mat::banded_view<mtl::mat::compressed2D<ValueSrc, Para> >& src, mtl::mat::compressed2D<ValueDest, Para>& dest, bool)
+    // Parameters can differ (e.g. in the index types) as long as the orientation is the same
+    template <typename Updater, typename ValueSrc, typename Para, typename ValueDest, typename ParaDest>
+    typename boost::enable_if<boost::mpl::and_<boost::is_same<Updater, operations::update_store<ValueDest> >,
+					       boost::mpl::bool_<traits::is_row_major<Para>::value == traits::is_row_major<ParaDest>::value> > >::type
+    inline gen_matrix_copy(const mat::banded_view<mtl::mat::compressed2D<ValueSrc, Para> >& src, mtl::mat::compressed2D<ValueDest, ParaDest>& dest, bool)
     {
 	vampir_trace<3061> tracer;
-	typedef typename Para::size_type size_type;
 	dest.change_dim(num_rows(src), num_cols(src)); // contains make_empty
 	set_to_zero(dest);
 	const mtl::mat::compressed2D<ValueSrc, Para>  &sref= src.ref;
-	const std::vector<size_type>        &sstarts= sref.ref_major(), &sindices= sref.ref_minor();
+	typedef typename mtl::mat::compressed2D<ValueSrc, Para>::index_vector_type index_vector_type;
+	typedef typename mtl::mat::compressed2D<ValueSrc, Para>::minor_vector_type minor_vector_type;
+	const index_vector_type             &sstarts= sref.ref_major();
+	const minor_vector_type             &sindices= sref.ref_minor();
 	long first, last;
 	if (traits::is_row_major<Para>::value) {
 	    first= src.get_begin();
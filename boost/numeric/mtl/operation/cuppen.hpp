@@ -16,6 +16,9 @@
 #define MTL_MATRIX_CUPPEN_INCLUDE
 
 #include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/mtl/utility/assert.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
@@ -24,100 +27,259 @@
 #include <boost/numeric/mtl/operation/secular.hpp>
 #include <boost/numeric/mtl/operation/sort.hpp>
 #include <boost/numeric/mtl/operation/trans.hpp>
+#include <boost/numeric/mtl/operation/tridiagonal.hpp>
 #include <boost/numeric/mtl/utility/domain.hpp>
-#include <boost/numeric/mtl/matrix/permutation.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/parameter.hpp>
 
 #include <boost/numeric/mtl/vector/dense_vector.hpp>
-#include <boost/numeric/itl/iteration/basic_iteration.hpp>
-#include <boost/numeric/itl/krylov/fsm.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
 
 namespace mtl { namespace mat {
 
+/// Tridiagonal matrices up to this size are solved directly with the QL algorithm in cuppen_tridiagonal
+const std::size_t cuppen_leaf_size= 24;
+
+/// Sub-problems larger than this are solved as independent OpenMP tasks in cuppen_tridiagonal
+const std::size_t cuppen_task_size= 128;
+
+namespace impl {
+
+    template <typename Vector>
+    struct cuppen_less
+    {
+	explicit cuppen_less(const Vector& v) : v(v) {}
+	bool operator()(std::size_t i, std::size_t j) const { return v[i] < v[j]; }
+	const Vector& v;
+    };
+
+    /// Merges the eigen-decompositions of the two halves coupled by the off-diagonal entry \p b
+    /** Rank-one modification with deflation of small z components and close eigenvalues (Givens rotations),
+	secular equation for the remaining eigenvalues and eigenvectors from the Loewner theorem (Gu/Eisenstat).
+	The new eigenvectors are the product of the old ones with the eigenvectors of the rank-one problem. **/
+    template <typename Vector, typename Matrix>
+    void cuppen_merge(const Vector& d1, const Matrix& Q1, const Vector& d2, const Matrix& Q2,
+		      typename Collection<Vector>::value_type b, Vector& d, Matrix& Q)
+    {
+	using std::abs; using std::sqrt;
+	typedef typename Collection<Vector>::value_type   value_type;
+	typedef std::vector<std::size_t>                  index_vector;
+
+	const std::size_t m1= size(d1), m2= size(d2), n= m1 + m2;
+	const value_type  zero= math::zero(b), one= math::one(b), eps= std::numeric_limits<value_type>::epsilon(),
+	                  rho= 2 * abs(b), sq= one / sqrt(value_type(2));
+
+	// z = Q' * u normalized to unit length, with u = (0, ..., 0, 1, signum(b), 0, ..., 0)
+	Vector dd(n), z(n);
+	for (std::size_t i= 0; i < m1; i++)
+	    dd[i]= d1[i], z[i]= sq * Q1(m1-1, i);
+	for (std::size_t i= 0; i < m2; i++)
+	    dd[m1+i]= d2[i], z[m1+i]= (b < zero ? -sq : sq) * Q2(0, i);
+
+	index_vector perm(n);
+	for (std::size_t i= 0; i < n; i++)
+	    perm[i]= i;
+	std::sort(perm.begin(), perm.end(), cuppen_less<Vector>(dd));
+
+	// Block-diagonal eigenvectors of the halves in sorted order
+	Vector ds(n), zs(n);
+	Matrix Qs(n, n);
+	Qs= zero;
+	value_type dmax= zero, zmax= zero;
+	for (std::size_t j= 0; j < n; j++) {
+	    const std::size_t p= perm[j];
+	    ds[j]= dd[p]; zs[j]= z[p];
+	    dmax= std::max(dmax, value_type(abs(ds[j]))); zmax= std::max(zmax, value_type(abs(zs[j])));
+	    if (p < m1)
+		for (std::size_t i= 0; i < m1; i++)
+		    Qs(i, j)= Q1(i, p);
+	    else
+		for (std::size_t i= 0; i < m2; i++)
+		    Qs(m1+i, j)= Q2(i, p-m1);
+	}
+
+	// Deflation
+	const value_type tol= 8 * eps * std::max(dmax, zmax);
+	index_vector     nd, defl;
+	std::size_t      pj= n;                                  // n means no predecessor yet
+	for (std::size_t j= 0; j < n; j++) {
+	    if (rho * abs(zs[j]) <= tol) {
+		defl.push_back(j);
+		continue;
+	    }
+	    if (pj == n) {
+		pj= j;
+		continue;
+	    }
+	    value_type s= zs[pj], c= zs[j], tau= sqrt(c * c + s * s), t= ds[j] - ds[pj];
+	    c/= tau; s= -s / tau;
+	    if (abs(t * c * s) <= tol) {                          // close eigenvalues: rotate z[pj] to zero
+		zs[j]= tau; zs[pj]= zero;
+		for (std::size_t i= 0; i < n; i++) {
+		    value_type x= Qs(i, pj), y= Qs(i, j);
+		    Qs(i, pj)= c * x + s * y;
+		    Qs(i, j)= c * y - s * x;
+		}
+		t= ds[pj] * c * c + ds[j] * s * s;
+		ds[j]= ds[pj] * s * s + ds[j] * c * c;
+		ds[pj]= t;
+		defl.push_back(pj);
+	    } else
+		nd.push_back(pj);
+	    pj= j;
+	}
+	if (pj != n)
+	    nd.push_back(pj);
+
+	// Eigen-decomposition of the non-deflated rank-one problem
+	const std::size_t k= nd.size();
+	Vector            lambda(k);
+	Matrix            Qk(n, k), Qnew(n, k);
+	if (k > 0) {
+	    Vector dk(k), zk(k);
+	    Matrix U(k, k);
+	    for (std::size_t j= 0; j < k; j++) {
+		dk[j]= ds[nd[j]]; zk[j]= zs[nd[j]];
+		for (std::size_t i= 0; i < n; i++)
+		    Qk(i, j)= Qs(i, nd[j]);
+	    }
+	    if (k == 1) {
+		lambda[0]= dk[0] + rho * zk[0] * zk[0];
+		U= one;
+	    } else {
+		vec::secular_dc(dk, zk, rho, lambda, U);      // U holds delta(i, j) = dk[i] - lambda[j]
+
+		Vector zhat(k);                                // z consistent with the computed eigenvalues
+		for (std::size_t i= 0; i < k; i++) {
+		    value_type p= -U(i, k-1) / rho;
+		    for (std::size_t j= 0; j < i; j++)
+			p*= -U(i, j) / (dk[j] - dk[i]);
+		    for (std::size_t j= i; j + 1 < k; j++)
+			p*= -U(i, j) / (dk[j+1] - dk[i]);
+		    zhat[i]= zk[i] < zero ? value_type(-sqrt(abs(p))) : sqrt(abs(p));
+		}
+		for (std::size_t j= 0; j < k; j++) {
+		    value_type nrm= zero;
+		    for (std::size_t i= 0; i < k; i++) {
+			U(i, j)= zhat[i] / U(i, j);
+			nrm+= U(i, j) * U(i, j);
+		    }
+		    nrm= one / sqrt(nrm);
+		    for (std::size_t i= 0; i < k; i++)
+			U(i, j)*= nrm;
+		}
+	    }
+	    Qnew= Qk * U;
+	}
+
+	// Gather eigenpairs in ascending order
+	Vector       all(n);
+	index_vector order(n);
+	for (std::size_t j= 0; j < k; j++)
+	    all[j]= lambda[j];
+	for (std::size_t j= 0; j < defl.size(); j++)
+	    all[k+j]= ds[defl[j]];
+	for (std::size_t i= 0; i < n; i++)
+	    order[i]= i;
+	std::sort(order.begin(), order.end(), cuppen_less<Vector>(all));
+
+	for (std::size_t j= 0; j < n; j++) {
+	    const std::size_t o= order[j];
+	    d[j]= all[o];
+	    if (o < k)
+		for (std::size_t i= 0; i < n; i++)
+		    Q(i, j)= Qnew(i, o);
+	    else
+		for (std::size_t i= 0; i < n; i++)
+		    Q(i, j)= Qs(i, defl[o-k]);
+	}
+    }
+
+    /// Recursive divide-and-conquer; the two halves are independent OpenMP tasks if large enough
+    template <typename Vector, typename Matrix>
+    void cuppen_dc(Vector& d, Vector& e, Matrix& Q)
+    {
+	using std::abs;
+	typedef typename Collection<Vector>::value_type   value_type;
+	const std::size_t n= size(d);
+
+	if (n <= cuppen_leaf_size) {
+	    Q= math::one(value_type());
+	    tridiagonal_ql(d, e, Q, true);
+	    return;
+	}
+
+	const std::size_t m= n / 2;
+	const value_type  b= e[m-1];
+	Vector            d1(m), e1(m), d2(n-m), e2(n-m);
+	for (std::size_t i= 0; i < m; i++)
+	    d1[i]= d[i], e1[i]= e[i];
+	for (std::size_t i= m; i < n; i++)
+	    d2[i-m]= d[i], e2[i-m]= e[i];
+	e1[m-1]= math::zero(b);
+	d1[m-1]-= abs(b);
+	d2[0]-= abs(b);
+
+	Matrix Q1(m, m), Q2(n-m, n-m);
+#       ifdef MTL_WITH_OPENMP
+#       pragma omp task shared(d1, e1, Q1) if (n > cuppen_task_size)
+#       endif
+	cuppen_dc(d1, e1, Q1);
+	cuppen_dc(d2, e2, Q2);
+#       ifdef MTL_WITH_OPENMP
+#       pragma omp taskwait
+#       endif
+
+	cuppen_merge(d1, Q1, d2, Q2, b, d, Q);
+    }
+
+} // namespace impl
+
+
+/// Eigenvalues and eigenvectors of the symmetric tridiagonal matrix with diagonal d and sub-diagonal e
+/** Cuppen's divide and conquer algorithm with deflation. On exit d contains the eigenvalues in ascending
+    order, e is destroyed and the columns of Q are the corresponding eigenvectors.
+    Q is a column-major dense2D matrix. With OpenMP the independent sub-problems are solved in parallel. **/
+template <typename Vector, typename Value, typename Parameters>
+void cuppen_tridiagonal(Vector& d, Vector& e, dense2D<Value, Parameters>& Q)
+{
+    vampir_trace<5067> tracer;
+    const std::size_t n= size(d);
+    MTL_THROW_IF(size(e) < n, incompatible_size());
+    Q.change_dim(n, n);
+    if (n == 0) return;
+
+#   ifdef MTL_WITH_OPENMP
+#   pragma omp parallel
+#   pragma omp single
+#   endif
+    impl::cuppen_dc(d, e, Q);
+}
+
 /// Eigenvalues of triangle matrix A with Cuppen's divide and conquer algorithm
 /** Eigenvalues are returned in vector lambda. A is overwritten. **/
 template <typename Matrix, typename Vector>
 void inline cuppen_inplace(Matrix& A, Matrix& Q, Vector& lambda)
 {
-    using std::abs; using mtl::irange; using mtl::imax; using mtl::iall; using vec::iota;
-
     typedef typename Collection<Matrix>::value_type     value_type;
     typedef typename Collection<Matrix>::size_type      size_type;
-    typedef vec::dense_vector<size_type, vec::parameters<> >   size_vector; // todo: with type trait
+    typedef vec::dense_vector<value_type, vec::parameters<> >          vector_type;
 
     size_type        nrows= num_rows(A);
     MTL_CRASH_IF(nrows != num_cols(A), "Matrix not square");
-    const value_type zero= 0, one= 1;   
-    
-    if (nrows == 1){
-	lambda[0]= A[0][0];
-	Q= one;
-    } else {
-	size_type     m= size_type(nrows/2);
-	irange        till_m(m), from_m(m, imax);
-
-	size_vector   perm(nrows);
-	Matrix        T1(A[till_m][till_m]), T2(A[from_m][from_m]),                               // sub-matrices of A
-	              Q0(nrows, nrows), Q1(Q0[till_m][till_m]), Q2(Q0[from_m][from_m]);           // Q0 and sub-matrices
-	Vector        v(nrows, zero), diag(nrows), lambda1(diag[till_m]), lambda2(diag[from_m]);  // sub-vectors of diag
-
-	//DIVIDE
-	value_type    b= A[m-1][m];
-	T1[m-1][m-1]-= abs(b);
-	T2[0][0]-= abs(b);
-
-	v[m-1]= b > zero ? one : -one;
-	v[m]= one;
-
-	cuppen_inplace(T1, Q1, lambda1);
-	cuppen_inplace(T2, Q2, lambda2);
-
-	Q0[till_m][from_m]= zero; Q0[from_m][till_m]= zero; // zero out non-diagonal blocks
-
-	T1[m-1][m-1]+= abs(b);
-	T2[0][0]+= abs(b);
-
-	iota(perm);
-	sort(diag, perm);
-
-	// CONQUER, start with eq. (3.0.2) using rows (not columns)
-	v[till_m]= b < zero ? Vector(-trans(Q1[m-1][iall])) : trans(Q1[m-1][iall]); 
-	v[from_m]= trans(Q2[0][iall]);
-
-	// permutation on v
-	mtl::mat::traits::permutation<>::type P= mtl::mat::permutation(perm); 
-	Vector v1(P * v);
-	
-	lambda= secular(v1, diag, abs(b));   // solve secular equation 
-
-	// std::cout << "lambda is " << lambda << "\ndiag is " << diag << '\n';
-	//Lemma 3.0.2  ... calculate eigenvectors
-	Matrix Q_tilde(nrows, nrows);
-	for (size_type i = 0; i < nrows; i++) {
-	    for (size_type j= 0; j < size(diag); ++j)
-		MTL_THROW_IF (diag[j] == lambda[i], 
-			      logic_error("Can't compute eigenvector, probably due to double eigenvalue."));
-	    Vector    li(nrows, lambda[i]), lambda_i(ele_quot(v1, diag - li));
-	    Q_tilde[iall][i]= lambda_i / two_norm(lambda_i); // normalized eigenvector in Matrix Q 
-	}
 
-	Q= Q0 * P * Q_tilde;
-
-#if 0
-	for (size_type i = 0; i < nrows; i++) {
-	    // Vector    qi(Q[iall][i]); // Todo: find out valgrind complains about the memory of qi for reasons inexplicable
-	    Vector qi(nrows);
-	    for (size_type j= 0; j < nrows; j++) 
-		qi[j]= Q[j][i];
-
-	    std::cout << "q[" << i << "] = " << qi << ", lambda[i] = " << lambda[i] 
-		      << ", diff = " << two_norm(Vector(A*qi - lambda[i]*qi)) << ", A*qi = " << Vector(A*qi) << ", li*qi = " << Vector(lambda[i]*qi) << '\n';
-	    itl::basic_iteration<double>   iter(1.0, 20, 1e-5, 1e-5);
-	    fsm(A, qi, lambda[i], 0.1, iter);
-	    std::cout << "q[" << i << "] = " << qi << ", diff = " << two_norm(Vector(A*qi - lambda[i]*qi)) << '\n';
-	    Q[iall][i]= qi;
-	}
-#endif
-    }     
+    vector_type      d(nrows), e(nrows, math::zero(value_type()));
+    for (size_type i= 0; i < nrows; i++) {
+	d[i]= A[i][i];
+	if (i + 1 < nrows)
+	    e[i]= A[i+1][i];
+    }
+
+    dense2D<value_type, mat::parameters<col_major> > QQ(nrows, nrows);
+    cuppen_tridiagonal(d, e, QQ);
+    Q= QQ;
+    for (size_type i= 0; i < nrows; i++)
+	lambda[i]= d[i];
 }
 
 /// Eigenvalues of triangle matrix A with Cuppen's divide and conquer algorithm
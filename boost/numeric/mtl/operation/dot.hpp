@@ -14,6 +14,7 @@
 #define MTL_DOT_INCLUDE
 
 
+#include <boost/mpl/bool.hpp>
 #include <boost/numeric/mtl/concept/std_concept.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/operation/conj.hpp>
@@ -21,8 +22,14 @@
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 #include <boost/numeric/mtl/utility/omp_size_type.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
 #include <boost/numeric/mtl/utility/static_assert.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
+#include <boost/numeric/mtl/vector/blocked_reduction.hpp>
+#include <boost/numeric/mtl/vector/reduction_functors.hpp>
+#include <boost/numeric/mtl/operation/accumulation.hpp>
 
 namespace mtl { 
 
@@ -95,6 +102,31 @@ namespace mtl {
 	    };
 
 
+	    // Unrolled dot product of the entries [from, to), blocks of vec::blocked_reduction
+	    template <unsigned long Unroll, typename Vector1, typename Vector2, typename ConjOpt, typename Value>
+	    struct dot_block
+	    {
+		dot_block(const Vector1& v1, const Vector2& v2, ConjOpt conj_opt) : v1(v1), v2(v2), conj_opt(conj_opt) {}
+
+		Value operator()(std::size_t from, std::size_t to) const
+		{
+		    ConjOpt    conj(conj_opt); // the functors' operator() is not const
+		    Value      dummy, z= math::zero(dummy), tmp00= z, tmp01= z, tmp02= z, tmp03= z, tmp04= z,
+			       tmp05= z, tmp06= z, tmp07= z;
+		    const std::size_t i_block= from + Unroll * ((to - from) / Unroll);
+
+		    for (std::size_t i= from; i < i_block; i+= Unroll)
+			dot_aux<1, Unroll>::apply(tmp00, tmp01, tmp02, tmp03, tmp04, tmp05, tmp06, tmp07, v1, v2, i, conj);
+		    for (std::size_t i= i_block; i < to; i++) 
+			tmp00+= conj(v1[i]) * v2[i];
+		    return ((tmp00 + tmp01) + (tmp02 + tmp03)) + ((tmp04 + tmp05) + (tmp06 + tmp07));
+		}
+
+		const Vector1& v1;
+		const Vector2& v2;
+		ConjOpt        conj_opt;
+	    };
+
 	    template <unsigned long Unroll>
 	    struct dot
 	    {
@@ -107,9 +139,32 @@ namespace mtl {
 
 		    vampir_trace<2003> tracer;
 		    MTL_THROW_IF(mtl::size(v1) != mtl::size(v2), incompatible_size());
+		    roofline<2003> roof(mtl::traits::roofline_vector_flops(v1) + mtl::traits::roofline_vector_flops(v2) + 2.0 * mtl::size(v1),
+					mtl::traits::roofline_vector_bytes(v1) + mtl::traits::roofline_vector_bytes(v2));
+		    typedef typename detail::dot_result<Vector1, Vector2>::type  value_type;
+		    return apply(v1, v2, conj_opt, simd::dot_computable<Vector1, Vector2, value_type>());
+		}
+
+	      private:
+		// Contiguous real vectors with SIMD packs
+		template <typename Vector1, typename Vector2, typename ConjOpt>
+		typename detail::dot_result<Vector1, Vector2>::type
+		static inline apply(const Vector1& v1, const Vector2& v2, ConjOpt, boost::mpl::true_)
+		{
+		    return simd::dot(v1, v2);
+		}
+
+		template <typename Vector1, typename Vector2, typename ConjOpt>
+		typename detail::dot_result<Vector1, Vector2>::type
+		static inline apply(const Vector1& v1, const Vector2& v2, ConjOpt conj_opt, boost::mpl::false_)
+		{
 		    typedef typename detail::dot_result<Vector1, Vector2>::type  value_type;
 		    		    
-#                 ifdef MTL_WITH_OPENMP 
+#                 if defined(MTL_DETERMINISTIC_REDUCTION)
+		    value_type dummy;
+		    return blocked_reduction(std::size_t(mtl::size(v1)), dot_block<Unroll, Vector1, Vector2, ConjOpt, value_type>(v1, v2, conj_opt), 
+					     finish_join<sum_functor>(), math::zero(dummy));
+#                 elif defined(MTL_WITH_OPENMP) 
 		    value_type dummy, z= math::zero(dummy), result= z;
 		    typedef typename mtl::traits::omp_size_type<typename Collection<Vector1>::size_type>::type size_type;
 		    size_type  i_max= mtl::size(v1), i_block= Unroll * (i_max / Unroll);
@@ -157,6 +212,8 @@ namespace mtl {
 	inline dot_simple(const Vector1& v1, const Vector2& v2, ConjOpt conj_opt)
 	{
 	    vampir_trace<2040> tracer;
+	    roofline<2040> roof(mtl::traits::roofline_vector_flops(v1) + mtl::traits::roofline_vector_flops(v2) + 2.0 * mtl::size(v1),
+				mtl::traits::roofline_vector_bytes(v1) + mtl::traits::roofline_vector_bytes(v2));
 	    typedef typename Collection<Vector1>::size_type              size_type;
 	    typedef typename detail::dot_result<Vector1, Vector2>::type  value_type;
 
@@ -238,6 +295,16 @@ namespace mtl {
 	{
 	    return sfunctor::dot<Unroll>::apply(v1, v2, detail::with_conj());
 	}
+	/// Dot product defined as hermitian(v) * w with accumulation \p policy, e.g. dot(v, w, accumulation::dot2())
+	/** See namespace accumulation for the policies. **/
+	template <typename Vector1, typename Vector2, typename Policy>
+	typename boost::enable_if<accumulation::is_policy<Policy>, typename detail::dot_result<Vector1, Vector2>::type>::type
+	inline dot(const Vector1& v1, const Vector2& v2, Policy policy)
+	{
+	    MTL_THROW_IF(mtl::size(v1) != mtl::size(v2), incompatible_size());
+	    return accumulation::reduce_dot<typename detail::dot_result<Vector1, Vector2>::type>(v1, v2, policy);
+	}
+
 	/// Dot product without conjugate defined as trans(v) * w
 	/** Unrolled four times by default **/
 	template <typename Vector1, typename Vector2>
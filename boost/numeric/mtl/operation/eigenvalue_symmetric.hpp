@@ -23,6 +23,7 @@
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/concept/magnitude.hpp>
 #include <boost/numeric/mtl/operation/conj.hpp>
+#include <boost/numeric/mtl/operation/cuppen.hpp>
 #include <boost/numeric/mtl/operation/diagonal.hpp>
 #include <boost/numeric/mtl/operation/givens.hpp>
 #include <boost/numeric/mtl/operation/hessenberg.hpp>
@@ -30,7 +31,9 @@
 #include <boost/numeric/mtl/operation/qr.hpp>
 #include <boost/numeric/mtl/operation/rank_one_update.hpp>
 #include <boost/numeric/mtl/operation/signum.hpp>
+#include <boost/numeric/mtl/operation/sub_matrix.hpp>
 #include <boost/numeric/mtl/operation/trans.hpp>
+#include <boost/numeric/mtl/operation/tridiagonal.hpp>
 
 #include <boost/numeric/mtl/vector/dense_vector.hpp>
 #include <boost/numeric/mtl/vector/parameter.hpp>
@@ -170,6 +173,106 @@ inline eigenvalue_symmetric(const Matrix& A)
 } 
 
 
+
+namespace impl {
+
+    template <typename Matrix>
+    struct eigen_symmetric_work
+    {
+	typedef typename Collection<Matrix>::value_type                      value_type;
+	typedef dense2D<value_type, mat::parameters<col_major> >             matrix_type;
+	typedef mtl::vec::dense_vector<value_type, mtl::vec::parameters<> >  vector_type;
+    };
+
+    /// Copy A into column-major work matrix W and reduce it to tridiagonal form
+    template <typename Matrix, typename Work, typename Vector>
+    void eigen_symmetric_reduce(const Matrix& A, Work& W, Vector& d, Vector& e, Vector& tau)
+    {
+	MTL_THROW_IF(num_rows(A) != num_cols(A), matrix_not_square());
+	W.change_dim(num_rows(A), num_cols(A));
+	W= A;
+	tridiagonalize(W, d, e, tau);
+    }
+
+} // namespace impl
+
+/// All eigenvalues of the symmetric matrix A in ascending order
+/** A is reduced to tridiagonal form by blocked Householder reflections whose
+    eigenvalues are computed with the implicit QL algorithm. **/
+template <typename Matrix, typename Vector>
+void eigen_symmetric(const Matrix& A, Vector& lambda)
+{
+    vampir_trace<5068> tracer;
+    typedef impl::eigen_symmetric_work<Matrix>       work;
+    typename work::matrix_type                       W(0, 0);
+    typename work::vector_type                       d(0), e(0), tau(0);
+
+    impl::eigen_symmetric_reduce(A, W, d, e, tau);
+    tridiagonal_ql(d, e, W, false);
+    lambda.change_dim(size(d));
+    lambda= d;
+}
+
+/// All eigenvalues of the symmetric matrix A in ascending order and the eigenvectors as columns of Q
+/** Blocked Householder tridiagonalization, Cuppen's divide and conquer on the tridiagonal matrix
+    (sub-problems in parallel with OpenMP) and back-transformation of the eigenvectors with matrix products. **/
+template <typename Matrix, typename Vector, typename MatrixQ>
+void eigen_symmetric(const Matrix& A, Vector& lambda, MatrixQ& Q)
+{
+    vampir_trace<5068> tracer;
+    typedef impl::eigen_symmetric_work<Matrix>       work;
+    typename work::matrix_type                       W(0, 0), Z(0, 0);
+    typename work::vector_type                       d(0), e(0), tau(0);
+
+    impl::eigen_symmetric_reduce(A, W, d, e, tau);
+    cuppen_tridiagonal(d, e, Z);
+    tridiagonal_back_transform(W, tau, Z);
+    lambda.change_dim(size(d));
+    lambda= d;
+    Q.change_dim(num_rows(Z), num_cols(Z));
+    Q= Z;
+}
+
+/// The eigenvalues of the symmetric matrix A with indices in [first, last) in ascending order
+/** Computed by bisection on the tridiagonal form, i.e. the cost for the eigenvalues is proportional to their number. **/
+template <typename Matrix, typename Vector>
+void eigen_symmetric_range(const Matrix& A, std::size_t first, std::size_t last, Vector& lambda)
+{
+    vampir_trace<5068> tracer;
+    typedef impl::eigen_symmetric_work<Matrix>       work;
+    typename work::matrix_type                       W(0, 0);
+    typename work::vector_type                       d(0), e(0), tau(0), l(0);
+
+    impl::eigen_symmetric_reduce(A, W, d, e, tau);
+    tridiagonal_bisection(d, e, first, last, l);
+    lambda.change_dim(size(l));
+    lambda= l;
+}
+
+/// The eigenpairs of the symmetric matrix A with indices in [first, last) in ascending order
+/** Only the selected eigenvectors are transformed back, Q has last - first columns. **/
+template <typename Matrix, typename Vector, typename MatrixQ>
+void eigen_symmetric_range(const Matrix& A, std::size_t first, std::size_t last, Vector& lambda, MatrixQ& Q)
+{
+    vampir_trace<5068> tracer;
+    typedef impl::eigen_symmetric_work<Matrix>       work;
+    typename work::matrix_type                       W(0, 0), Z(0, 0);
+    typename work::vector_type                       d(0), e(0), tau(0);
+
+    impl::eigen_symmetric_reduce(A, W, d, e, tau);
+    MTL_THROW_IF(first > last || last > size(d), index_out_of_range());
+    cuppen_tridiagonal(d, e, Z);
+
+    typename work::matrix_type                       Zs(num_rows(Z), last - first);
+    Zs= sub_matrix(Z, 0, num_rows(Z), first, last);
+    tridiagonal_back_transform(W, tau, Zs);
+    lambda.change_dim(last - first);
+    for (std::size_t i= first; i < last; i++)
+	lambda[i - first]= d[i];
+    Q.change_dim(num_rows(Zs), num_cols(Zs));
+    Q= Zs;
+}
+
 }} // namespace mtl::matrix
 
 
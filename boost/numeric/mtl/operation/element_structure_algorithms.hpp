@@ -37,9 +37,9 @@ void greedy_extract_element_structure(Element_struct& es,  Matrix& M , std::stri
 	typename sparse_structure::index_array_type& col_idx =		glas::index_array( M );
 	typename sparse_type::value_array_type& values = glas::value_array(M);
 #endif
-	std::vector<size_type> row_start(M.ref_major());
-	std::vector<size_type> col_idx(M.ref_minor());
-	std::vector<value_type> values(M.data);
+	std::vector<size_type> row_start(M.ref_major().begin(), M.ref_major().end());
+	std::vector<size_type> col_idx(M.ref_minor().begin(), M.ref_minor().end());
+	std::vector<value_type> values(M.data.begin(), M.data.end());
 	
 	const value_type ZERO = value_type(0);
 	const usint nb_rows = num_rows( M );
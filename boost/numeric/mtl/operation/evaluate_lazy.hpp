@@ -16,6 +16,7 @@
 #include <boost/numeric/mtl/mtl_fwd.hpp>
 #include <boost/numeric/mtl/operation/lazy_assign.hpp>
 #include <boost/numeric/mtl/vector/lazy_reduction.hpp>
+#include <boost/numeric/mtl/vector/reduction.hpp>
 
 
 namespace mtl {
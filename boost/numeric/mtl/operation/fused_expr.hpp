@@ -13,13 +13,22 @@
 #ifndef MTL_FUSED_EXPR_INCLUDE
 #define MTL_FUSED_EXPR_INCLUDE
 
+#include <cstddef>
+#include <algorithm>
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/and.hpp>
 #include <boost/numeric/mtl/operation/index_evaluator.hpp>
 #include <boost/numeric/mtl/utility/index_evaluatable.hpp>
 #include <boost/numeric/mtl/utility/assert.hpp>
+#include <boost/numeric/mtl/utility/tag.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
+#include <boost/numeric/mtl/vector/blocked_reduction.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
+
 namespace mtl {
 
 /// Expression template for fusing other expression 
@@ -39,6 +48,124 @@ struct fused_expr
 
     void delay_assign() const { delayed_assign= true; }    
 
+    template <typename TT, typename UU>
+    void forward_eval_range(TT& first_eval, UU& second_eval, std::size_t from, std::size_t to, boost::mpl::false_)
+    {	
+	for (std::size_t i= from; i < to; i++) {
+	    first_eval(i); second_eval(i);
+	}	
+    }
+
+    template <typename TT, typename UU>
+    void forward_eval_range(TT& first_eval, UU& second_eval, std::size_t from, std::size_t to, boost::mpl::true_)
+    {	
+	forward_eval_unrolled(first_eval, second_eval, from, to, simd::pack_evaluatable<vec::fused_index_evaluator<T, U> >());
+    }
+
+    template <typename TT, typename UU>
+    void forward_eval_unrolled(TT& first_eval, UU& second_eval, std::size_t from, std::size_t to, boost::mpl::false_)
+    {	
+	const std::size_t sb= from + ((to - from) >> 2 << 2);
+
+	for (std::size_t i= from; i < sb; i+= 4) {
+	    first_eval.template at<0>(i); second_eval.template at<0>(i);
+	    first_eval.template at<1>(i); second_eval.template at<1>(i);
+	    first_eval.template at<2>(i); second_eval.template at<2>(i);
+	    first_eval.template at<3>(i); second_eval.template at<3>(i);
+	}
+
+	for (std::size_t i= sb; i < to; i++) {
+	    first_eval(i); second_eval(i);
+	}
+    }
+
+    // Contiguous vectors of the same value type are evaluated with SIMD packs
+    template <typename TT, typename UU>
+    void forward_eval_unrolled(TT& first_eval, UU& second_eval, std::size_t from, std::size_t to, boost::mpl::true_)
+    {	
+	typedef typename simd::pack_evaluatable<vec::fused_index_evaluator<T, U> >::value_type value_type;
+	const std::size_t P= simd::pack<value_type>::size, sb= from + (to - from) / (4 * P) * (4 * P);
+
+	for (std::size_t i= from; i < sb; i+= 4 * P) {
+	    first_eval.template pack_at<0>(i); second_eval.template pack_at<0>(i);
+	    first_eval.template pack_at<1>(i); second_eval.template pack_at<1>(i);
+	    first_eval.template pack_at<2>(i); second_eval.template pack_at<2>(i);
+	    first_eval.template pack_at<3>(i); second_eval.template pack_at<3>(i);
+	}
+
+	for (std::size_t i= sb; i < to; i++) {
+	    first_eval(i); second_eval(i);
+	}
+    }
+
+#if defined(MTL_DETERMINISTIC_REDUCTION)
+    // Fixed blocks of indices are evaluated with their own parts of the evaluators (in parallel with OpenMP);
+    // the partial results are joined in a tree that only depends on the size (see vec::blocked_reduction)
+    template <typename TT, typename UU, typename Unroll>
+    void forward_eval_loop(const TT& const_first_eval, const UU& const_second_eval, Unroll)
+    {	
+	vampir_trace<6006> tracer;
+	// hope there is a more elegant way; copying the arguments causes errors due to double destructor evaluation
+	TT& first_eval= const_cast<TT&>(const_first_eval);  
+	UU& second_eval= const_cast<UU&>(const_second_eval);
+	MTL_CRASH_IF(mtl::vec::size(first_eval) != mtl::vec::size(second_eval), "Incompatible size!");	
+
+	const std::size_t s= size(first_eval), nb= vec::reduction_blocks(s), bs= vec::reduction_block_size;
+	if (nb <= 1) {
+	    forward_eval_range(first_eval, second_eval, 0, s, Unroll());
+	    return;
+	}
+
+	vec::part_array<TT> first_parts(nb, TT(first_eval, tag::split()));
+	vec::part_array<UU> second_parts(nb, UU(second_eval, tag::split()));
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel for schedule(static)
+#     endif
+	for (long b= 0; b < long(nb); b++)
+	    forward_eval_range(first_parts[b], second_parts[b], b * bs, std::min(s, (b + 1) * bs), Unroll());
+
+	vec::tree_join(first_parts, vec::evaluator_join());
+	vec::tree_join(second_parts, vec::evaluator_join());
+	first_eval.join(first_parts[0]);
+	second_eval.join(second_parts[0]);
+    }
+#elif defined(MTL_WITH_OPENMP)
+    // Each thread evaluates a contiguous block of indices with its own part of the evaluators;
+    // the partial results (of reductions) are joined in thread order afterwards
+    template <typename TT, typename UU, typename Unroll>
+    void forward_eval_loop(const TT& const_first_eval, const UU& const_second_eval, Unroll)
+    {	
+	vampir_trace<6005> tracer;
+	// hope there is a more elegant way; copying the arguments causes errors due to double destructor evaluation
+	TT& first_eval= const_cast<TT&>(const_first_eval);  
+	UU& second_eval= const_cast<UU&>(const_second_eval);
+	MTL_CRASH_IF(mtl::vec::size(first_eval) != mtl::vec::size(second_eval), "Incompatible size!");	
+
+	const std::size_t s= size(first_eval);
+	if (s < vec::fused_omp_min_size) {
+	    forward_eval_range(first_eval, second_eval, 0, s, Unroll());
+	    return;
+	}
+
+#       pragma omp parallel
+	{
+	    TT        first_part(first_eval, tag::split());
+	    UU        second_part(second_eval, tag::split());
+	    const int nt= omp_get_num_threads(), t= omp_get_thread_num();
+	    forward_eval_range(first_part, second_part, s / nt * t + std::min(std::size_t(t), s % nt),
+			       s / nt * (t+1) + std::min(std::size_t(t+1), s % nt), Unroll());
+
+#           pragma omp for ordered schedule(static, 1)
+	    for (int p= 0; p < nt; p++) {
+#               pragma omp ordered
+		{
+		    first_eval.join(first_part); 
+		    second_eval.join(second_part);
+		}
+	    }
+	}
+    }
+#else
     template <typename TT, typename UU>
     void forward_eval_loop(const TT& const_first_eval, const UU& const_second_eval, boost::mpl::false_)
     {	
@@ -48,9 +175,7 @@ struct fused_expr
 	UU& second_eval= const_cast<UU&>(const_second_eval);
 	MTL_CRASH_IF(mtl::size(first_eval) != mtl::size(second_eval), "Incompatible size!");	
 
-	for (std::size_t i= 0, s= size(first_eval); i < s; i++) {
-	    first_eval(i); second_eval(i);
-	}	
+	forward_eval_range(first_eval, second_eval, 0, size(first_eval), boost::mpl::false_());
     }
 
     template <typename TT, typename UU>
@@ -62,19 +187,9 @@ struct fused_expr
 	UU& second_eval= const_cast<UU&>(const_second_eval);
 	MTL_CRASH_IF(mtl::vec::size(first_eval) != mtl::vec::size(second_eval), "Incompatible size!");	
 
-	const std::size_t s= size(first_eval), sb= s >> 2 << 2;
-
-	for (std::size_t i= 0; i < sb; i+= 4) {
-	    first_eval.template at<0>(i); second_eval.template at<0>(i);
-	    first_eval.template at<1>(i); second_eval.template at<1>(i);
-	    first_eval.template at<2>(i); second_eval.template at<2>(i);
-	    first_eval.template at<3>(i); second_eval.template at<3>(i);
-	}
-
-	for (std::size_t i= sb; i < s; i++) {
-	    first_eval(i); second_eval(i);
-	}
+	forward_eval_range(first_eval, second_eval, 0, size(first_eval), boost::mpl::true_());
     }
+#endif
 
     // Forward evaluation dominates backward
     template <bool B2>
@@ -13,6 +13,7 @@
 #ifndef MTL_FUSED_INDEX_EVALUATOR_INCLUDE
 #define MTL_FUSED_INDEX_EVALUATOR_INCLUDE
 
+#include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/index_evaluator.hpp>
 
 namespace mtl { namespace vec {
@@ -20,9 +21,16 @@ namespace mtl { namespace vec {
 template <typename T, typename U>
 struct fused_index_evaluator
 {
+    typedef typename traits::index_evaluator<T>::type first_type;
+    typedef typename traits::index_evaluator<U>::type second_type;
+
     fused_index_evaluator(T& first, U& second) 
       : first(index_evaluator(first)), second(index_evaluator(second)) {}
 
+    /// Evaluator for a part of the indices in parallel evaluation
+    fused_index_evaluator(const fused_index_evaluator& src, tag::split)
+      : first(src.first, tag::split()), second(src.second, tag::split()) {}
+
     template <unsigned Offset>
     void at(std::size_t i) 
     {
@@ -33,8 +41,23 @@ struct fused_index_evaluator
     void operator() (std::size_t i) { at<0>(i); }
     void operator[] (std::size_t i) { at<0>(i); }
 
-    typename traits::index_evaluator<T>::type first;
-    typename traits::index_evaluator<U>::type second;
+    /// Evaluate the SIMD pack of entries starting at i + Offset * pack size (only if simd::pack_evaluatable)
+    template <unsigned Offset>
+    void pack_at(std::size_t i)
+    {
+	first.template pack_at<Offset>(i);
+	second.template pack_at<Offset>(i);
+    }
+
+    /// Combine with partial results of \p part
+    void join(const fused_index_evaluator& part)
+    {
+	first.join(part.first);
+	second.join(part.second);
+    }
+
+    first_type  first;
+    second_type second;
 };
 
 template <typename T, typename U>
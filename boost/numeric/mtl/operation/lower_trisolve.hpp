@@ -13,19 +13,25 @@
 #ifndef MTL_LOWER_TRISOLVE_INCLUDE
 #define MTL_LOWER_TRISOLVE_INCLUDE
 
+#include <algorithm>
 #include <boost/mpl/int.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_base_of.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
 #include <boost/numeric/mtl/utility/property_map.hpp>
 #include <boost/numeric/mtl/utility/range_generator.hpp>
 #include <boost/numeric/mtl/utility/category.hpp>
 #include <boost/numeric/mtl/utility/static_assert.hpp>
+#include <boost/numeric/mtl/utility/is_what.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/operation/trisolve_multi_rhs.hpp>
 
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/linear_algebra/inverse.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
 
 namespace mtl { namespace mat {
 
@@ -74,13 +80,38 @@ namespace detail {
 			    generic_version<compressed2D<Value, Para>, D, true>
 	                   >::type {};
 
+	template <typename M, typename D, bool C, typename MatrixOut>
+	struct multi_version
+	  : boost::mpl::if_<trisolve_blocked<M, MatrixOut>,
+			    boost::mpl::int_<0>,
+			    version<M, D, C>
+	                   >::type {};
+
 	/// Solve \p w = A * \p v
+	/** \p v and \p w can also be matrices (e.g. dense2D or multi_vector) with one right-hand side per column.
+	    Then A is traversed only once for all right-hand sides and \p w and \p v may be the same object. **/
 	template <typename VectorIn, typename VectorOut>
 	void operator()(const VectorIn& v, VectorOut& w) const
-	{   vampir_trace<5022> tracer; apply(v, w, version<Matrix, DiaTag, CompactStorage>()); }
+	{   vampir_trace<5022> tracer; solve(v, w, mtl::traits::is_matrix<VectorOut>()); }
 	
 
       private:
+	template <typename VectorIn, typename VectorOut>
+	void solve(const VectorIn& v, VectorOut& w, boost::mpl::false_) const
+	{
+	    roofline<5022> roof(mtl::traits::roofline_triangle_flops(A), mtl::traits::roofline_triangle_bytes(A)
+				+ mtl::traits::roofline_vector_bytes(v) + mtl::traits::roofline_target_bytes(w, false));
+	    apply(v, w, version<Matrix, DiaTag, CompactStorage>());
+	}
+
+	template <typename MatrixIn, typename MatrixOut>
+	void solve(const MatrixIn& B, MatrixOut& X, boost::mpl::true_) const
+	{
+	    vampir_trace<5070> tracer;
+	    trisolve_multi_init(B, X, num_rows(A));
+	    multi_apply(X, multi_version<Matrix, DiaTag, CompactStorage, MatrixOut>());
+	}
+
 	template <typename Value>
 	Value inline lower_trisolve_diavalue(const Value& v, tag::regular_diagonal) const
 	{   using math::reciprocal; return reciprocal(v); }
@@ -208,6 +239,122 @@ namespace detail {
 	    }
 	}	
 
+	template <typename MatrixOut>
+	void multi_dia(MatrixOut&, size_type, const value_type&, tag::unit_diagonal) const {}
+
+	template <typename MatrixOut, typename Tag>
+	void multi_dia(MatrixOut& X, size_type r, const value_type& dia, Tag) const
+	{   trisolve_row_scale(X, r, lower_trisolve_diavalue(dia, Tag()));    }
+
+	// Multiple right-hand sides in place: dense matrix blocked, off-diagonal blocks are eliminated by matrix products
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<0>) const
+	{
+	    const size_type n= num_rows(A), nk= num_cols(X), nb= trisolve_block_size;
+	    for (size_type r0= 0; r0 < n; r0+= nb) {
+		const size_type r1= std::min(r0 + nb, n);
+		if (r0 > 0) {
+		    MatrixOut Xr(sub_matrix(X, r0, r1, 0, nk));
+		    Xr-= sub_matrix(A, r0, r1, 0, r0) * sub_matrix(X, 0, r0, 0, nk);
+		}
+		for (size_type r= r0; r < r1; ++r) {
+		    for (size_type c= r0; c < r; ++c)
+			trisolve_row_update(X, r, c, A[r][c]);
+		    multi_dia(X, r, A[r][r], DiaTag());
+		}
+	    }
+	}
+
+	// Multiple right-hand sides in place: generic row-major unit_diagonal
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<1>) const
+	{
+	    using namespace tag; 
+	    a_cur_type ac= begin<row>(A), aend= end<row>(A); 
+	    for (size_type r= 0; ac != aend; ++r, ++ac)
+		for (a_icur_type aic= begin<nz>(ac), aiend= CompactStorage ? end<nz>(ac) : lower_bound<nz>(ac, r); aic != aiend; ++aic) {
+		    MTL_DEBUG_THROW_IF(col_a(*aic) >= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, r, col_a(*aic), value_a(*aic));
+		}
+	}
+
+	// Multiple right-hand sides in place: generic row-major not unit_diagonal
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<2>) const
+	{
+	    using namespace tag; 
+	    a_cur_type ac= begin<row>(A), aend= end<row>(A); 
+	    for (size_type r= 0; ac != aend; ++r, ++ac) {
+		a_icur_type aic= begin<nz>(ac), aiend= CompactStorage ? end<nz>(ac) : lower_bound<nz>(ac, r+1);
+		MTL_THROW_IF(aic == aiend, missing_diagonal());
+		--aiend;
+		MTL_THROW_IF(col_a(*aiend) != r, missing_diagonal());
+		for (; aic != aiend; ++aic) {
+		    MTL_DEBUG_THROW_IF(col_a(*aic) >= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, r, col_a(*aic), value_a(*aic));
+		}
+		multi_dia(X, r, value_a(*aiend), DiaTag());
+	    }
+	}
+
+	// Multiple right-hand sides in place: generic column-major unit_diagonal
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<3>) const
+	{
+	    using namespace tag; 
+	    a_cur_type ac= begin<col>(A), aend= end<col>(A); 
+	    for (size_type r= 0; ac != aend; ++r, ++ac)
+		for (a_icur_type aic= CompactStorage ? begin<nz>(ac) : lower_bound<nz>(ac, r+1), aiend= end<nz>(ac); aic != aiend; ++aic) {
+		    MTL_DEBUG_THROW_IF(row_a(*aic) <= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, row_a(*aic), r, value_a(*aic));
+		}
+	}
+
+	// Multiple right-hand sides in place: generic column-major not unit_diagonal
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<4>) const
+	{
+	    using namespace tag; 
+	    a_cur_type ac= begin<col>(A), aend= end<col>(A); 
+	    for (size_type r= 0; ac != aend; ++r, ++ac) {
+		a_icur_type aic= CompactStorage ? begin<nz>(ac) : lower_bound<nz>(ac, r), aiend= end<nz>(ac);
+		MTL_DEBUG_THROW_IF(aic == aiend || row_a(*aic) != r, missing_diagonal());
+		multi_dia(X, r, value_a(*aic), DiaTag());
+		for (++aic; aic != aiend; ++aic) {
+		    MTL_DEBUG_THROW_IF(row_a(*aic) <= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, row_a(*aic), r, value_a(*aic));
+		}
+	    }
+	}
+
+	// Multiple right-hand sides in place: compressed2D row-major compact with implicit unit diagonal, each row of A is read once
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<5>) const
+	{
+	    for (size_type r= 0, rend= num_rows(A); r != rend; ++r)
+		for (size_type j0= A.ref_major()[r], j1= A.ref_major()[r+1]; j0 != j1; ++j0) {
+		    MTL_DEBUG_THROW_IF(A.ref_minor()[j0] >= r, logic_error("Matrix entries from U in lower triangular."));
+		    trisolve_row_update(X, r, A.ref_minor()[j0], A.data[j0]);
+		}
+	}
+
+	// Multiple right-hand sides in place: compressed2D row-major compact with explicitly stored diagonal (possibly already inverted)
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<6>) const
+	{
+	    for (size_type r= 0, rend= num_rows(A); r != rend; ++r) {
+		size_type j0= A.ref_major()[r], j1= A.ref_major()[r+1];
+		MTL_THROW_IF(j0 == j1, missing_diagonal());
+		--j1;
+		MTL_THROW_IF(A.ref_minor()[j1] != r, missing_diagonal());
+		for (; j0 != j1; ++j0) {
+		    MTL_DEBUG_THROW_IF(A.ref_minor()[j0] > r, logic_error("Matrix entries from U in lower triangular."));
+		    trisolve_row_update(X, r, A.ref_minor()[j0], A.data[j0]);
+		}
+		multi_dia(X, r, A.data[j1], DiaTag());
+	    }
+	}
+
 	const Matrix&                                    A;
 	typename mtl::traits::const_value<Matrix>::type  value_a; 
 	typename mtl::traits::col<Matrix>::type          col_a; 
@@ -272,7 +419,8 @@ inline void inverse_lower_trisolve(const Matrix& A, const VectorIn& v, VectorOut
 }
 
 template <typename Matrix, typename Vector, typename DiaTag>
-Vector inline lower_trisolve(const Matrix& A, const Vector& v, DiaTag)
+typename boost::enable_if<boost::is_base_of<tag::universe_diagonal, DiaTag>, Vector>::type
+inline lower_trisolve(const Matrix& A, const Vector& v, DiaTag)
 {
     Vector w(resource(v));
     detail::lower_trisolve_t<Matrix, DiaTag> solver(A); 
@@ -16,10 +16,12 @@
 #define MTL_MATRIX_LU_INCLUDE
 
 #include <cmath>
+#include <boost/mpl/bool.hpp>
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/mtl/utility/enable_if.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
 #include <boost/numeric/mtl/utility/irange.hpp>
+#include <boost/numeric/mtl/utility/is_what.hpp>
 #include <boost/numeric/mtl/utility/lu_matrix_type.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/concept/magnitude.hpp>
@@ -118,12 +120,43 @@ Vector inline lu_solve_apply(const Matrix& LU, const Vector& b)
     return upper_trisolve(upper(LU), unit_lower_trisolve(strict_lower(LU), b));
 }
 
+namespace detail {
+
+    template <typename Matrix, typename PermVector, typename Vector>
+    Vector inline lu_apply(const Matrix& LU, const PermVector& P, const Vector& b, boost::mpl::false_)
+    {
+	return upper_trisolve(upper(LU), unit_lower_trisolve(strict_lower(LU), Vector(reverse_permute(P, b))));
+    }
+
+    // Multiple right-hand sides: the triangles are solved in place on LU so that the factors are read once for all columns
+    template <typename Matrix, typename PermVector, typename MatrixRhs>
+    MatrixRhs inline lu_apply(const Matrix& LU, const PermVector& P, const MatrixRhs& B, boost::mpl::true_)
+    {
+	typedef typename Collection<MatrixRhs>::size_type size_type;
+	const size_type n= num_rows(B), nk= num_cols(B);
+	MTL_THROW_IF(n != num_rows(LU), incompatible_size());
+
+	MatrixRhs X(n, nk);
+	for (size_type i= 0; i < n; i++) {
+	    size_type j= P[i];
+	    MTL_THROW_IF(j >= n, index_out_of_range("Index in permutation vector out of range (w.r.t. permuted vector)."));
+	    for (size_type k= 0; k < nk; k++)
+		X(i, k)= B(j, k);
+	}
+	lower_trisolve(LU, X, X, tag::unit_diagonal());
+	upper_trisolve(LU, X, X, tag::regular_diagonal());
+	return X;
+    }
+}
+
 /// Apply the factorization L*U with permutation P on vector b to solve Ax = b
+/** \p b can also be a matrix (dense2D or multi_vector) whose columns are the right-hand sides; 
+    then the solutions are returned column-wise in a matrix of the same type. **/
 template <typename Matrix, typename PermVector, typename Vector>
 Vector inline lu_apply(const Matrix& LU, const PermVector& P, const Vector& b)
 {
     vampir_trace<5027> tracer;
-    return upper_trisolve(upper(LU), unit_lower_trisolve(strict_lower(LU), Vector(permute(P, b))));
+    return detail::lu_apply(LU, P, b, mtl::traits::is_matrix<Vector>());
 }
 
 
@@ -146,7 +179,7 @@ template <typename Matrix, typename PermVector, typename Vector>
 Vector inline lu_adjoint_apply(const Matrix& LU, const PermVector& P, const Vector& b)
 {
     vampir_trace<5029> tracer;
-    return Vector(reverse_permute(P, unit_upper_trisolve(adjoint(LU), lower_trisolve(adjoint(LU), b))));
+    return Vector(permute(P, unit_upper_trisolve(adjoint(LU), lower_trisolve(adjoint(LU), b))));
 }
 
 
@@ -180,13 +213,13 @@ class lu_solver
     template <typename VectorIn, typename VectorOut>
     void solve(const VectorIn& b, VectorOut& x) const
     {
-	x= upper_trisolve(upper(LU), unit_lower_trisolve(strict_lower(LU), VectorIn(permute(P, b))));
+	x= lu_apply(LU, P, b);
     }
     /// Solve \f$adjoint(A)x = b\f$ using LU factorization
     template <typename VectorIn, typename VectorOut>
     void adjoint_solve(const VectorIn& b, VectorOut& x) const
     {
-	x= reverse_permute(P, unit_upper_trisolve(adjoint(LU), lower_trisolve(adjoint(LU), b)));
+	x= permute(P, unit_upper_trisolve(adjoint(LU), lower_trisolve(adjoint(LU), b)));
     }
 
   private:
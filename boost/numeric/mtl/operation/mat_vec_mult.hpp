@@ -24,15 +24,19 @@
 #include <boost/numeric/mtl/utility/range_generator.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/is_static.hpp>
+#include <boost/numeric/mtl/utility/is_row_major.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/enable_if.hpp>
 #include <boost/numeric/mtl/utility/multi_tmp.hpp>
 #include <boost/numeric/mtl/utility/static_assert.hpp>
 #include <boost/numeric/mtl/vector/parameter.hpp>
 #include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
 #include <boost/numeric/mtl/utility/omp_size_type.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
 #include <boost/numeric/mtl/operation/set_to_zero.hpp>
 #include <boost/numeric/mtl/operation/update.hpp>
+#include <boost/numeric/mtl/operation/accumulation.hpp>
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/meta_math/loop.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
@@ -442,7 +446,7 @@ inline void vsmat_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn
     }
 }
 
-#ifdef MTL_CRS_CVEC_MULT_TUNING
+// Blocks of BSize rows; used by default with MTL_CRS_CVEC_MULT_TUNING and otherwise available for run-time tuning
 template <unsigned Index, unsigned BSize, typename SizeType>
 struct crs_cvec_mult_block
 {
@@ -488,6 +492,7 @@ template <unsigned BSize, typename MValue, typename MPara, typename VectorIn, ty
 inline void smat_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign as, tag::row_major)
 {
     vampir_trace<3049> tracer;
+    roofline<3049> roof(2.0 * A.nnz(), mtl::traits::roofline_mat_vec_bytes(A, v, w, !Assign::init_to_zero));
     using math::zero;
 
     if (A.nnz() < num_rows(A)) {
@@ -531,6 +536,7 @@ inline void smat_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn&
     }
 }
 
+#ifdef MTL_CRS_CVEC_MULT_TUNING
 template <typename MValue, typename MPara, typename VectorIn, typename VectorOut, typename Assign>
 typename mtl::traits::enable_if_scalar<typename Collection<VectorOut>::value_type>::type
 inline smat_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign, tag::row_major)
@@ -610,12 +616,49 @@ inline adapt_crs_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn&
     }
 }
 
+// Without kernels for the types, the generic implementation is used
+template <typename MValue, typename MPara, typename VectorIn, typename VectorOut, typename Assign>
+inline bool simd_crs_cvec_mult(const compressed2D<MValue, MPara>&, const VectorIn&, VectorOut&, Assign, boost::mpl::false_)
+{
+    return false;
+}
+
+// Row-major compressed2D vector multiplication with the kernel of the instruction set selected at run time
+// Returns false for the native instruction set and for rows shorter than a pack on average,
+// which are handled by the generic implementation
+template <typename MValue, typename MPara, typename VectorIn, typename VectorOut, typename Assign>
+inline bool simd_crs_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign, boost::mpl::true_)
+{
+    if (!simd::dispatched() || A.nnz() == 0 || A.nnz() < num_rows(A) * simd::selected_pack_size<MValue>())
+	return false;
+    vampir_trace<3076> tracer;
+
+    typedef typename MPara::size_type        size_type;
+    typedef typename MPara::minor_index_type minor_index_type;
+    const MValue           *data= A.address_data(), *x= v.address_data();
+    const size_type        *starts= A.address_major();
+    const minor_index_type *indices= A.address_minor();
+    MValue           *y= w.address_data();
+#ifdef MTL_WITH_OPENMP
+#   pragma omp parallel
+    {
+	std::size_t from, to;
+	simd::thread_block(num_rows(A), from, to);
+	simd::crs_rows<Assign>(data, starts, indices, x, y, size_type(from), size_type(to));
+    }
+#else
+    simd::crs_rows<Assign>(data, starts, indices, x, y, size_type(0), size_type(num_rows(A)));
+#endif
+    return true;
+}
+
 // Row-major compressed2D vector multiplication
 template <typename MValue, typename MPara, typename VectorIn, typename VectorOut, typename Assign>
 typename mtl::traits::enable_if_scalar<typename Collection<VectorOut>::value_type>::type
 inline smat_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign as, tag::row_major)
 {
     vampir_trace<3049> tracer;
+    roofline<3049> roof(2.0 * A.nnz(), mtl::traits::roofline_mat_vec_bytes(A, v, w, !Assign::init_to_zero));
     // vampir_trace<5056> tttracer;
     using math::zero;
 
@@ -644,6 +687,8 @@ inline smat_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn& v, V
 	    return;
 	}
     }
+    if (simd_crs_cvec_mult(A, v, w, as, simd::crs_computable<Matrix, VectorIn, VectorOut>()))
+	return;
 
     #ifdef MTL_WITH_OPENMP
     #   pragma omp parallel
@@ -688,6 +733,8 @@ template <typename MValue, typename MPara, typename VectorIn, typename VectorOut
 typename mtl::traits::enable_if_scalar<typename Collection<VectorOut>::value_type>::type
 inline smat_cvec_mult(const ell_matrix<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign, tag::row_major)
 {
+    vampir_trace<3078> tracer;
+    roofline<3078> roof(2.0 * mtl::traits::roofline_entries(A), mtl::traits::roofline_mat_vec_bytes(A, v, w, !Assign::init_to_zero));
     typedef typename MPara::size_type size_type;
 
     const size_type stride= A.stride(), slots= A.slots();
@@ -706,6 +753,8 @@ typename mtl::traits::enable_if_scalar<typename Collection<VectorOut>::value_typ
 inline smat_cvec_mult(const sparse_banded<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign, tag::row_major)
 {
     vampir_trace<3069> tracer;
+    roofline<3069> roof(2.0 * A.nnz(), mtl::traits::roofline_mat_vec_bytes(A, v, w, !Assign::init_to_zero)
+			+ A.ref_bands().size() * sizeof(typename sparse_banded<MValue, MPara>::band_size_type));
     typedef sparse_banded<MValue, MPara>                      Matrix;
     typedef typename Collection<VectorOut>::value_type        value_type;
     typedef typename Matrix::band_size_type                   band_size_type;
@@ -833,6 +882,31 @@ inline void mat_cvec_mult(const Matrix& A, const VectorIn& v, VectorOut& w, Assi
     smat_cvec_mult(A, v, w, Assign(), typename OrientedCollection<Matrix>::orientation());
 }
 
+/// Row-major compressed2D vector multiplication where each row is summed with accumulation \p Policy
+/** Used by mult(A, v, w, policy), see namespace accumulation. **/
+template <typename MValue, typename MPara, typename VectorIn, typename VectorOut, typename Assign, typename Policy>
+inline void accumulated_crs_cvec_mult(const compressed2D<MValue, MPara>& A, const VectorIn& v, VectorOut& w, Assign, Policy)
+{
+    vampir_trace<3077> tracer;
+    roofline<3077> roof(2.0 * A.nnz(), mtl::traits::roofline_mat_vec_bytes(A, v, w, !Assign::init_to_zero));
+    MTL_STATIC_ASSERT((mtl::traits::is_row_major<MPara>::value), "Accumulation policies require row-major matrices.");
+
+    typedef compressed2D<MValue, MPara>                       Matrix;
+    typedef typename Collection<VectorOut>::value_type        value_type;
+    typedef typename mtl::traits::omp_size_type<typename Collection<Matrix>::size_type>::type size_type;
+
+    const size_type nr= num_rows(A);
+    #ifdef MTL_WITH_OPENMP
+    #   pragma omp parallel for
+    #endif
+    for (size_type i= 0; i < nr; i++) {
+	accumulation::accumulator<Policy, value_type> acc;
+	for (size_type j= A.ref_major()[i], cj1= A.ref_major()[i+1]; j != cj1; ++j)
+	    acc.add_product(A.data[j], v[A.ref_minor()[j]]);
+	Assign::first_update(w[i], acc.value());
+    }
+}
+
 
 
 }} // namespace mtl::matrix
@@ -29,9 +29,11 @@
 #include <boost/numeric/mtl/operation/assign_mode.hpp>
 #include <boost/numeric/mtl/operation/mult_assign_mode.hpp>
 #include <boost/numeric/mtl/utility/enable_if.hpp>
+#include <boost/numeric/mtl/operation/accumulation.hpp>
 
 #include <boost/mpl/if.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
 
 
 namespace mtl { namespace mat {
@@ -75,7 +77,8 @@ inline mult_add(const A& a, const B& b, C& c)
 /** The 4 types must be compatible, i.e. a*x must be assignable to z and z must be incrementable by y.
     Right now, it is not more efficient than z= a * x; z+= y. For compatibility with MTL2. **/
 template <typename A, typename X, typename Y, typename Z>
-inline void mult(const A& a, const X& x, const Y& y, Z& z)
+typename boost::disable_if<accumulation::is_policy<Z> >::type
+inline mult(const A& a, const X& x, const Y& y, Z& z)
 {
     vampir_trace<4010> tracer;
     mult(a, x, z);
@@ -83,6 +86,33 @@ inline void mult(const A& a, const X& x, const Y& y, Z& z)
 }
 
 
+/// Matrix vector multiplication w= A * v where the rows are summed with accumulation \p policy
+/** For instance mult(A, v, w, accumulation::dot2()) computes each entry of w as accurately as in 
+    twice the working precision.  Only available for row-major compressed2D and real values. **/
+template <typename Matrix, typename VectorIn, typename VectorOut, typename Policy>
+typename boost::enable_if<accumulation::is_policy<Policy> >::type
+inline mult(const Matrix& A, const VectorIn& v, VectorOut& w, Policy policy)
+{
+    vampir_trace<4010> tracer;
+    MTL_DEBUG_THROW_IF((const void*)&v == (const void*)&w, argument_result_conflict());
+    MTL_DEBUG_THROW_IF(num_rows(A) != mtl::size(w), incompatible_size());
+    MTL_DEBUG_THROW_IF(num_cols(A) != mtl::size(v), incompatible_size());
+    accumulated_crs_cvec_mult(A, v, w, assign::assign_sum(), policy);
+}
+
+/// Matrix vector multiplication w+= A * v where the rows are summed with accumulation \p policy
+template <typename Matrix, typename VectorIn, typename VectorOut, typename Policy>
+typename boost::enable_if<accumulation::is_policy<Policy> >::type
+inline mult_add(const Matrix& A, const VectorIn& v, VectorOut& w, Policy policy)
+{
+    vampir_trace<4010> tracer;
+    MTL_DEBUG_THROW_IF((const void*)&v == (const void*)&w, argument_result_conflict());
+    MTL_DEBUG_THROW_IF(num_rows(A) != mtl::size(w), incompatible_size());
+    MTL_DEBUG_THROW_IF(num_cols(A) != mtl::size(v), incompatible_size());
+    accumulated_crs_cvec_mult(A, v, w, assign::plus_sum(), policy);
+}
+
+
 // Matrix multiplication
 template <typename MatrixA, typename MatrixB, typename MatrixC, typename Assign>
 inline void gen_mult(const MatrixA& a, const MatrixB& b, MatrixC& c, Assign, tag::flat<tag::matrix>, tag::flat<tag::matrix>, tag::flat<tag::matrix>)
@@ -123,6 +153,8 @@ template <typename MatrixA, typename MatrixB, typename MatrixC, typename Assign>
 inline void mat_mat_mult(const MatrixA& A, const MatrixB& b, MatrixC& c, Assign, tag::flat<tag::dense>, tag::flat<tag::dense>, tag::flat<tag::dense>)
 {
     vampir_trace<4012> tracer;
+    roofline<4012> roof(2.0 * num_rows(A) * num_cols(A) * num_cols(b), mtl::traits::roofline_matrix_bytes(A) + mtl::traits::roofline_matrix_bytes(b)
+			+ mtl::traits::roofline_matrix_bytes(c) * (Assign::init_to_zero ? 1 : 2));
     using assign::plus_sum; using assign::assign_sum; 
 
     static const unsigned long tiling1= detail::dmat_dmat_mult_tiling1<MatrixA, MatrixB, MatrixC>::value;
@@ -16,12 +16,15 @@
 #define MTL_VECTOR_SECULAR_INCLUDE
 
 #include <cmath>
+#include <limits>
+#include <algorithm>
 #include <boost/utility.hpp>
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/vector/dense_vector.hpp>
 #include <boost/numeric/mtl/operation/resource.hpp>
 #include <boost/numeric/mtl/operation/minimal_increase.hpp>
+#include <boost/numeric/mtl/utility/omp_size_type.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 
@@ -110,6 +113,71 @@ inline Vector secular(const Vector& z, const Vector& d, Value sigma)
     return functor.roots();
 }
 
+/// Roots of the secular equation \f$1+\rho \sum_{i} \frac{z_i^2}{d_i-\lambda} = 0\f$ as needed in divide-and-conquer
+/** d must be strictly increasing and rho positive. The i-th root lies in (d_i, d_{i+1}), the last one
+    in (d_{k-1}, d_{k-1} + rho * z'z). Each root is computed relative to its closest pole such that
+    additionally delta(i, j) = d_i - lambda_j is returned to full relative accuracy (needed for orthogonal eigenvectors).
+    Newton steps are safeguarded by bisection. The roots are independent and computed in parallel with OpenMP;
+    the inner sums run over contiguous memory. **/
+template <typename Vector, typename Value, typename Matrix>
+void secular_dc(const Vector& d, const Vector& z, Value rho, Vector& lambda, Matrix& delta)
+{
+    vampir_trace<5069> tracer;
+    using std::abs; using std::max;
+    typedef typename Collection<Vector>::value_type                   value_type;
+    typedef typename mtl::traits::omp_size_type<std::size_t>::type   size_type;
+    const size_type  k= size_type(size(d));
+    const value_type zero= math::zero(value_type()), one= math::one(value_type()),
+	             eps= std::numeric_limits<value_type>::epsilon();
+    value_type       znorm2= zero;
+    for (size_type i= 0; i < k; i++)
+	znorm2+= z[i] * z[i];
+
+    lambda.change_dim(k);
+    delta.change_dim(k, k);
+
+#   ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for schedule(dynamic, 8)
+#   endif
+    for (size_type j= 0; j < k; j++) {
+	size_type  org= j;
+	value_type lo= zero, hi;
+	if (j + 1 < k) {
+	    const value_type mid= (d[j+1] - d[j]) / 2;
+	    value_type       f= one;
+	    for (size_type i= 0; i < k; i++)
+		f+= rho * z[i] * z[i] / ((d[i] - d[j]) - mid);
+	    if (f >= zero)
+		hi= mid;
+	    else
+		org= j + 1, lo= -mid, hi= zero;
+	} else
+	    hi= rho * znorm2;
+
+	// tau is the distance to the pole d[org]
+	value_type tau= (lo + hi) / 2;
+	for (int iter= 0; iter < 200; iter++) {
+	    value_type g= one, gp= zero, ga= one;
+	    for (size_type i= 0; i < k; i++) {
+		const value_type q= z[i] / ((d[i] - d[org]) - tau), t= rho * z[i] * q;
+		g+= t; ga+= abs(t); gp+= rho * q * q;
+	    }
+	    if (g == zero || abs(g) <= eps * value_type(k + 1) * ga)
+		break;
+	    if (g > zero) hi= tau; else lo= tau;
+	    value_type tn= tau - g / gp;
+	    if (!(tn > lo && tn < hi))
+		tn= lo + (hi - lo) / 2;
+	    if (tn == tau || hi - lo <= 2 * eps * max(abs(lo), abs(hi)))
+		break;
+	    tau= tn;
+	}
+	lambda[j]= d[org] + tau;
+	for (size_type i= 0; i < k; i++)
+	    delta(i, j)= (d[i] - d[org]) - tau;
+    }
+}
+
 }}// namespace vector
 
 
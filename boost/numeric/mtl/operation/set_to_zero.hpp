@@ -20,6 +20,7 @@
 #include <boost/numeric/mtl/utility/ashape.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/category.hpp>
+#include <boost/numeric/mtl/utility/numa.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/linear_algebra/identity.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
@@ -55,7 +56,11 @@ namespace mtl {
 	    using math::zero;
 	    typename Collection<Coll>::value_type  ref, my_zero(zero(ref));
 
+#         ifdef MTL_NUMA_FIRST_TOUCH
+	    numa::fill(collection.elements(), collection.used_memory(), my_zero);
+#         else
 	    std::fill(collection.elements(), collection.elements()+collection.used_memory(), my_zero);
+#         endif
 	}
 
 	template <typename Coll>
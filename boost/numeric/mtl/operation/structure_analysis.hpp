@@ -0,0 +1,587 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_MATRIX_STRUCTURE_ANALYSIS_INCLUDE
+#define MTL_MATRIX_STRUCTURE_ANALYSIS_INCLUDE
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/utility/tag.hpp>
+#include <boost/numeric/mtl/utility/category.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/is_row_major.hpp>
+#include <boost/numeric/mtl/matrix/compressed2D.hpp>
+#include <boost/numeric/mtl/matrix/ell_matrix.hpp>
+#include <boost/numeric/mtl/matrix/sparse_banded.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/block_diagonal2D.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
+#include <boost/numeric/mtl/operation/set_to_zero.hpp>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#  include <chrono>
+#  include <boost/numeric/mtl/vector/dense_vector.hpp>
+#  include <boost/numeric/mtl/operation/mat_vec_mult.hpp>
+#  include <boost/numeric/mtl/operation/assign_mode.hpp>
+#endif
+
+namespace mtl { namespace mat {
+
+/// Storage formats that can be recommended by \ref analyze_structure
+namespace storage_format {
+    enum type { compressed, ell, banded, block_diagonal };
+
+    /// Number of formats
+    const int number= 4;
+
+    /// Name of the matrix type of format \p f
+    inline const char* name(type f)
+    {
+	static const char* names[]= { "compressed2D", "ell_matrix", "sparse_banded", "block_diagonal2D" };
+	return names[f];
+    }
+}
+
+/// Structural properties of a sparse matrix and the recommended storage format for matrix-vector products
+/** Computed by \ref analyze_structure. Bytes are estimated from the value and index types of the analyzed matrix
+    and comprise the matrix data only (the vectors are the same for all formats). **/
+struct structure_analysis
+{
+    std::size_t rows, cols, nnz;
+
+    /// \name Row lengths
+    //@{
+    std::size_t              min_row_length, max_row_length, empty_rows;
+    double                   mean_row_length, row_length_deviation;
+    /// Entry 0 counts the empty rows, entry k > 0 the rows with length in [2^(k-1), 2^k)
+    std::vector<std::size_t> row_length_histogram;
+    //@}
+
+    /// \name Band structure
+    //@{
+    std::size_t lower_bandwidth, upper_bandwidth; ///< Maximal distance of an entry below and above the diagonal
+    std::size_t diagonals;                        ///< Number of (partially) populated diagonals
+    std::size_t profile;                          ///< Sum over all rows of the distance from the first entry to the diagonal
+    //@}
+
+    /// \name Diagonal
+    //@{
+    std::size_t missing_diagonal;          ///< Rows without diagonal entry (or with zero on the diagonal)
+    std::size_t dominant_rows;             ///< Rows with |a_ii| >= sum_{j!=i} |a_ij|
+    std::size_t strictly_dominant_rows;    ///< Rows with |a_ii| > sum_{j!=i} |a_ij|
+    double      min_dominance_ratio;       ///< Minimum over all rows of |a_ii| / sum_{j!=i} |a_ij|
+    //@}
+
+    /// \name Symmetry (only computed for square matrices)
+    //@{
+    double structural_symmetry;            ///< Fraction of off-diagonal entries a_ij for which a_ji is stored
+    double numerical_symmetry;             ///< Fraction of off-diagonal entries with a_ij == a_ji
+    //@}
+
+    /// \name Block structure
+    //@{
+    std::vector<std::size_t> diagonal_blocks; ///< Starts of the independent diagonal blocks followed by the number of rows
+    std::size_t              max_diagonal_block; ///< Size of the largest diagonal block
+    double                   diagonal_block_fill; ///< nnz divided by the number of entries in the dense diagonal blocks
+    unsigned                 block_size;   ///< Largest square block size (of 2, 3, 4, 6, 8) with block_fill >= 0.8, 1 otherwise
+    double                   block_fill;   ///< nnz divided by the number of entries in aligned blocks of block_size with non-zeros
+    //@}
+
+    /// \name Locality of the column accesses
+    //@{
+    double mean_diagonal_distance; ///< Mean of |i - j| over all entries
+    double mean_row_span;          ///< Mean distance between first and last column of the non-empty rows
+    double contiguous_accesses;    ///< Fraction of accesses to x in the same cache line as the previous one in the row
+    //@}
+
+    /// \name Recommendation
+    //@{
+    double                bytes[storage_format::number]; ///< Estimated memory traffic of the matrix in a product per format
+    storage_format::type  format;           ///< Format with the least memory traffic (compressed unless another saves 10%)
+    unsigned              crs_block_size;   ///< Recommended row unrolling MTL_CRS_CVEC_MULT_BLOCK_SIZE for compressed2D
+    bool                  simd_kernel;      ///< Whether the rows are long enough for the SIMD kernel of compressed2D
+    std::string           reason;           ///< Explanation of the recommendation
+    //@}
+
+    /// Ratio of non-zeros to stored entries in ELLPACK
+    double ell_efficiency() const { return rows * max_row_length > 0 ? double(nnz) / double(rows * max_row_length) : 1.0; }
+
+    /// Ratio of non-zeros to stored entries in sparse_banded
+    double banded_efficiency() const { return rows * diagonals > 0 ? double(nnz) / double(rows * diagonals) : 1.0; }
+
+    /// Whether the matrix consists of at least two independent diagonal blocks
+    bool is_block_diagonal() const { return diagonal_blocks.size() > 2; }
+
+    /// Number of independent diagonal blocks
+    std::size_t num_diagonal_blocks() const { return diagonal_blocks.empty() ? 0 : diagonal_blocks.size() - 1; }
+
+    /// Whether the matrix is (numerically) symmetric
+    bool is_symmetric() const { return rows == cols && numerical_symmetry == 1.0; }
+
+    /// Whether all rows are diagonally dominant
+    bool is_diagonally_dominant() const { return dominant_rows == rows; }
+};
+
+namespace detail {
+
+    // Minimal ratio of bytes to those of compressed2D for recommending another format
+    const double structure_format_gain= 0.9;
+    // Minimal fill of dense blocks for block_size
+    const double structure_block_fill= 0.8;
+
+    template <typename Value>
+    double structure_abs(const Value& v) { using std::abs; return double(abs(v)); }
+
+    template <typename Value>
+    bool structure_simd_rows(double mean_row_length, boost::mpl::true_)
+    {
+	return mean_row_length >= double(simd::selected_pack_size<Value>());
+    }
+
+    template <typename Value>
+    bool structure_simd_rows(double, boost::mpl::false_) { return false; }
+
+    // Fraction of non-zeros in the aligned b x b blocks that contain non-zeros
+    template <typename Size, typename Index>
+    double structure_block_fill_ratio(std::size_t nr, std::size_t nc, const Size* starts, const Index* indices, unsigned b)
+    {
+	std::vector<std::size_t> stamp(nc / b + 1, std::size_t(-1));
+	std::size_t              blocks= 0;
+	for (std::size_t i0= 0; i0 < nr; i0+= b)
+	    for (std::size_t i= i0, iend= std::min<std::size_t>(i0 + b, nr); i < iend; i++)
+		for (Size j= starts[i]; j < starts[i+1]; j++) {
+		    std::size_t& s= stamp[std::size_t(indices[j]) / b];
+		    if (s != i0)
+			s= i0, blocks++;
+		}
+	return blocks ? double(starts[nr]) / (double(blocks) * b * b) : 1.0;
+    }
+
+    // Whether row \p i contains column \p j and, if so, its position
+    template <typename Size, typename Index>
+    bool structure_find(const Size* starts, const Index* indices, std::size_t i, std::size_t j, Size& pos)
+    {
+	const Index *first= indices + starts[i], *last= indices + starts[i+1], *it= std::lower_bound(first, last, Index(j));
+	if (it == last || std::size_t(*it) != j)
+	    return false;
+	pos= Size(it - indices);
+	return true;
+    }
+
+    template <typename Value, typename Size, typename Index>
+    void analyze_crs(structure_analysis& a, std::size_t nr, std::size_t nc, const Size* starts, const Index* indices, const Value* values)
+    {
+	a.rows= nr; a.cols= nc; a.nnz= nr ? std::size_t(starts[nr]) : 0;
+
+	// Row lengths, band structure, diagonal, locality
+	const std::size_t line= std::max<std::size_t>(64 / sizeof(Value), 1);
+	std::vector<char> diags(nr + nc, 0);
+	double            sum_sq= 0.0, distance= 0.0, span= 0.0, contiguous= 0.0, following= 0.0;
+	a.min_row_length= nr ? std::numeric_limits<std::size_t>::max() : 0;
+	a.max_row_length= a.empty_rows= a.lower_bandwidth= a.upper_bandwidth= a.diagonals= a.profile= 0;
+	a.missing_diagonal= a.dominant_rows= a.strictly_dominant_rows= 0;
+	a.min_dominance_ratio= std::numeric_limits<double>::infinity();
+	a.row_length_histogram.assign(1, 0);
+
+	for (std::size_t i= 0; i < nr; i++) {
+	    const std::size_t len= std::size_t(starts[i+1] - starts[i]);
+	    a.min_row_length= std::min(a.min_row_length, len);
+	    a.max_row_length= std::max(a.max_row_length, len);
+	    sum_sq+= double(len) * double(len);
+	    std::size_t bucket= 0;
+	    for (std::size_t l= len; l > 0; l>>= 1)
+		bucket++;
+	    if (bucket >= a.row_length_histogram.size())
+		a.row_length_histogram.resize(bucket + 1, 0);
+	    a.row_length_histogram[bucket]++;
+	    if (len == 0) {
+		a.empty_rows++; a.missing_diagonal+= i < nc;
+		continue;
+	    }
+
+	    double diag= 0.0, off= 0.0;
+	    bool   has_diag= false;
+	    for (Size k= starts[i]; k < starts[i+1]; k++) {
+		const std::size_t j= std::size_t(indices[k]);
+		if (j < i)
+		    a.lower_bandwidth= std::max(a.lower_bandwidth, i - j);
+		else
+		    a.upper_bandwidth= std::max(a.upper_bandwidth, j - i);
+		char& d= diags[j + nr - i];
+		if (!d)
+		    d= 1, a.diagonals++;
+		distance+= j < i ? double(i - j) : double(j - i);
+		if (k > starts[i]) {
+		    following++;
+		    contiguous+= std::size_t(indices[k-1]) / line == j / line;
+		}
+		if (j == i)
+		    diag= structure_abs(values[k]), has_diag= diag != 0.0;
+		else
+		    off+= structure_abs(values[k]);
+	    }
+	    const std::size_t first= std::size_t(indices[starts[i]]), last= std::size_t(indices[starts[i+1]-1]);
+	    span+= double(last - first);
+	    if (first < i)
+		a.profile+= i - first;
+
+	    if (i < nc) {
+		a.missing_diagonal+= !has_diag;
+		a.dominant_rows+= diag >= off;
+		a.strictly_dominant_rows+= diag > off;
+		a.min_dominance_ratio= std::min(a.min_dominance_ratio, off > 0.0 ? diag / off : std::numeric_limits<double>::infinity());
+	    }
+	}
+	const double rows_with_entries= double(nr - a.empty_rows);
+	a.mean_row_length= nr ? double(a.nnz) / double(nr) : 0.0;
+	a.row_length_deviation= nr ? std::sqrt(std::max(sum_sq / double(nr) - a.mean_row_length * a.mean_row_length, 0.0)) : 0.0;
+	a.mean_diagonal_distance= a.nnz ? distance / double(a.nnz) : 0.0;
+	a.mean_row_span= rows_with_entries > 0.0 ? span / rows_with_entries : 0.0;
+	a.contiguous_accesses= following > 0.0 ? contiguous / following : 1.0;
+
+	// Symmetry: look up the transposed entry in the sorted rows
+	a.structural_symmetry= a.numerical_symmetry= 0.0;
+	if (nr == nc) {
+	    std::size_t off_diagonal= 0, structural= 0, numerical= 0;
+	    for (std::size_t i= 0; i < nr; i++)
+		for (Size k= starts[i]; k < starts[i+1]; k++) {
+		    const std::size_t j= std::size_t(indices[k]);
+		    Size              pos;
+		    if (j == i)
+			continue;
+		    off_diagonal++;
+		    if (structure_find(starts, indices, j, i, pos)) {
+			structural++;
+			numerical+= values[pos] == values[k];
+		    }
+		}
+	    a.structural_symmetry= off_diagonal ? double(structural) / double(off_diagonal) : 1.0;
+	    a.numerical_symmetry= off_diagonal ? double(numerical) / double(off_diagonal) : 1.0;
+	}
+
+	// Independent diagonal blocks: no entry of the rows before b in columns >= b and vice versa
+	a.diagonal_blocks.assign(1, 0);
+	a.max_diagonal_block= 0;
+	a.diagonal_block_fill= 0.0;
+	if (nr == nc && nr > 0) {
+	    std::vector<std::size_t> suffix_min(nr + 1, nr);
+	    for (std::size_t i= nr; i-- > 0; )
+		suffix_min[i]= std::min(suffix_min[i+1], starts[i] < starts[i+1] ? std::min(i, std::size_t(indices[starts[i]])) : i);
+	    std::size_t prefix_max= 0;
+	    for (std::size_t i= 0; i < nr; i++) {
+		prefix_max= std::max(prefix_max, starts[i] < starts[i+1] ? std::max(i, std::size_t(indices[starts[i+1]-1])) : i);
+		if (prefix_max <= i && suffix_min[i+1] > i)
+		    a.diagonal_blocks.push_back(i + 1);
+	    }
+	    double entries= 0.0;
+	    for (std::size_t b= 1; b < a.diagonal_blocks.size(); b++) {
+		const std::size_t s= a.diagonal_blocks[b] - a.diagonal_blocks[b-1];
+		a.max_diagonal_block= std::max(a.max_diagonal_block, s);
+		entries+= double(s) * double(s);
+	    }
+	    a.diagonal_block_fill= double(a.nnz) / entries;
+	} else
+	    a.diagonal_blocks.push_back(nr);
+
+	// Dense sub-blocks as in blocked CRS
+	static const unsigned sizes[]= { 2, 3, 4, 6, 8 };
+	a.block_size= 1; a.block_fill= 1.0;
+	for (int s= 0; s < 5; s++) {
+	    const double fill= structure_block_fill_ratio(nr, nc, starts, indices, sizes[s]);
+	    if (fill >= structure_block_fill && nr % sizes[s] == 0)
+		a.block_size= sizes[s], a.block_fill= fill;
+	}
+    }
+
+    // Bytes of the matrix data in a product for each format and the recommendation
+    template <typename Value, typename Size, typename Index>
+    void recommend_format(structure_analysis& a)
+    {
+	const double nnz= double(a.nnz), nr= double(a.rows), sv= sizeof(Value), ss= sizeof(Size);
+	const double stride= double((a.rows + 31) / 32 * 32); // ELL stores padded columns
+	a.bytes[storage_format::compressed]= nnz * (sv + sizeof(Index)) + (nr + 1) * ss;
+	a.bytes[storage_format::ell]= stride * double(a.max_row_length) * (sv + ss);
+	a.bytes[storage_format::banded]= double(a.diagonals) * (nr * sv + ss);
+	a.bytes[storage_format::block_diagonal]= std::numeric_limits<double>::infinity();
+	if (a.is_block_diagonal())
+	    a.bytes[storage_format::block_diagonal]= nnz / a.diagonal_block_fill * sv + double(a.num_diagonal_blocks()) * 2 * sizeof(unsigned);
+
+	a.format= storage_format::compressed;
+	for (int f= 1; f < storage_format::number; f++)
+	    if (a.bytes[f] <= structure_format_gain * a.bytes[storage_format::compressed] && a.bytes[f] < a.bytes[a.format])
+		a.format= storage_format::type(f);
+
+	// Short rows profit from unrolling more rows
+	a.crs_block_size= a.mean_row_length < 4.0 ? 8 : a.mean_row_length < 8.0 ? 4 : a.mean_row_length < 32.0 ? 2 : 1;
+	a.simd_kernel= structure_simd_rows<Value>(a.mean_row_length, boost::mpl::or_<boost::is_same<Value, float>, boost::is_same<Value, double> >());
+
+	std::ostringstream os;
+	if (a.format != storage_format::compressed)
+	    os << storage_format::name(a.format) << " needs " << int(100.0 * a.bytes[a.format] / a.bytes[storage_format::compressed] + 0.5)
+	       << "% of the memory traffic of compressed2D";
+	else if (a.simd_kernel)
+	    os << "no format with less memory traffic, rows long enough for the SIMD kernel";
+	else
+	    os << "no format with less memory traffic, unrolled kernel with MTL_CRS_CVEC_MULT_BLOCK_SIZE=" << a.crs_block_size;
+	a.reason= os.str();
+    }
+
+    template <typename Value, typename Parameters>
+    structure_analysis analyze_structure(const compressed2D<Value, Parameters>& A, boost::mpl::true_)
+    {
+	typedef typename Parameters::size_type        size_type;
+	typedef typename Parameters::minor_index_type minor_index_type;
+	structure_analysis a;
+	if (A.nnz() == 0) {
+	    std::vector<size_type> starts(num_rows(A) + 1, 0);
+	    analyze_crs(a, num_rows(A), num_cols(A), &starts[0], (const minor_index_type*)0, (const Value*)0);
+	} else
+	    analyze_crs(a, num_rows(A), num_cols(A), A.address_major(), A.address_minor(), A.address_data());
+	recommend_format<Value, size_type, minor_index_type>(a);
+	return a;
+    }
+
+    template <typename Value, typename Parameters>
+    structure_analysis analyze_structure(const compressed2D<Value, Parameters>& A, boost::mpl::false_)
+    {
+	compressed2D<Value> B(A);
+	return analyze_structure(B, boost::mpl::true_());
+    }
+
+    template <typename Matrix>
+    structure_analysis analyze_structure(const Matrix& A)
+    {
+	compressed2D<typename Collection<Matrix>::value_type> B(A);
+	return analyze_structure(B, boost::mpl::true_());
+    }
+
+    template <typename Value, typename Parameters>
+    structure_analysis analyze_structure(const compressed2D<Value, Parameters>& A)
+    {
+	return analyze_structure(A, mtl::traits::is_row_major<Parameters>());
+    }
+} // namespace detail
+
+/// Analyze the sparsity structure of \p A and recommend the storage format with the least memory traffic in matrix-vector products
+/** Computes row-length statistics, bandwidth, profile, diagonal dominance, symmetry, block structure
+    and the locality of the column accesses. Matrices other than row-major compressed2D are copied into one;
+    all stored entries count as non-zeros, i.e. dense matrices are analyzed as full.
+    The recommendation only considers the data volume; \ref time_formats confirms it on the actual machine. **/
+template <typename Matrix>
+structure_analysis analyze_structure(const Matrix& A)
+{
+    return detail::analyze_structure(A);
+}
+
+/// Print the analysis \p a in human-readable form
+template <typename OStream>
+OStream& print_structure(OStream& os, const structure_analysis& a)
+{
+    os << "Matrix " << a.rows << " x " << a.cols << ", " << a.nnz << " non-zeros\n"
+       << "Row lengths: min " << a.min_row_length << ", max " << a.max_row_length << ", mean " << a.mean_row_length
+       << ", deviation " << a.row_length_deviation << ", empty rows " << a.empty_rows << '\n'
+       << "Row length histogram:";
+    for (std::size_t k= 0; k < a.row_length_histogram.size(); k++)
+	if (a.row_length_histogram[k] > 0) {
+	    os << ' ';
+	    if (k == 0)
+		os << "0";
+	    else if (k == 1)
+		os << "1";
+	    else
+		os << (std::size_t(1) << (k - 1)) << '-' << (std::size_t(1) << k) - 1;
+	    os << ':' << a.row_length_histogram[k];
+	}
+    os << "\nBandwidth: lower " << a.lower_bandwidth << ", upper " << a.upper_bandwidth << ", " << a.diagonals
+       << " diagonals, profile " << a.profile << '\n'
+       << "Diagonal: " << a.missing_diagonal << " rows without diagonal, " << a.dominant_rows << " dominant rows ("
+       << a.strictly_dominant_rows << " strictly), min ratio " << a.min_dominance_ratio << '\n';
+    if (a.rows == a.cols)
+	os << "Symmetry: structural " << a.structural_symmetry << ", numerical " << a.numerical_symmetry << '\n';
+    os << "Diagonal blocks: " << a.num_diagonal_blocks() << ", largest " << a.max_diagonal_block << ", fill " << a.diagonal_block_fill << '\n'
+       << "Dense blocks: size " << a.block_size << ", fill " << a.block_fill << '\n'
+       << "Locality: mean distance to diagonal " << a.mean_diagonal_distance << ", mean row span " << a.mean_row_span
+       << ", contiguous accesses " << a.contiguous_accesses << '\n'
+       << "Efficiency: ELL " << a.ell_efficiency() << ", banded " << a.banded_efficiency() << '\n'
+       << "Estimated bytes:";
+    for (int f= 0; f < storage_format::number; f++)
+	if (a.bytes[f] < std::numeric_limits<double>::infinity())
+	    os << ' ' << storage_format::name(storage_format::type(f)) << ' ' << a.bytes[f];
+    os << "\nRecommendation: " << storage_format::name(a.format) << " (" << a.reason << ")\n";
+    return os;
+}
+
+/// Call \p f with \p A converted to the recommended format of the analysis \p a
+/** \p f must accept all formats, e.g. a generic lambda or a functor with a templated operator(). **/
+template <typename Value, typename Parameters, typename Functor>
+void with_recommended_format(const compressed2D<Value, Parameters>& A, const structure_analysis& a, Functor f)
+{
+    typedef typename Collection<compressed2D<Value, Parameters> >::size_type size_type;
+    MTL_THROW_IF(a.rows != std::size_t(num_rows(A)) || a.cols != std::size_t(num_cols(A)) || a.nnz != std::size_t(A.nnz()),
+		 incompatible_size("Analysis was computed for another matrix"));
+
+    switch (a.format) {
+      case storage_format::ell: {
+	  ell_matrix<Value> B(num_rows(A), num_cols(A));
+	  B= A;
+	  f(B);
+	  break; }
+      case storage_format::banded: {
+	  sparse_banded<Value> B(A);
+	  f(B);
+	  break; }
+      case storage_format::block_diagonal: {
+	  compressed2D<Value> C(A);
+	  block_diagonal2D<dense2D<Value> > B(num_rows(A), num_cols(A), a.num_diagonal_blocks());
+	  for (std::size_t b= 1; b < a.diagonal_blocks.size(); b++) {
+	      const size_type s= a.diagonal_blocks[b-1], e= a.diagonal_blocks[b];
+	      dense2D<Value>  block(e - s, e - s);
+	      set_to_zero(block);
+	      for (size_type i= s; i < e; i++)
+		  for (size_type k= C.ref_major()[i]; k < C.ref_major()[i+1]; k++)
+		      block[i - s][C.ref_minor()[k] - s]= C.data[k];
+	      B.insert(s, e, block);
+	  }
+	  f(B);
+	  break; }
+      default:
+	  f(A);
+    }
+}
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+
+/// Measured time of a matrix-vector product in a storage format
+struct format_timing
+{
+    storage_format::type format;
+    unsigned             block_size; ///< Row unrolling of compressed2D, 0 for the default kernel and other formats
+    double               seconds;    ///< Minimum over the repetitions
+};
+
+namespace detail {
+
+    template <typename Vector>
+    struct product_timer
+    {
+	typedef std::chrono::steady_clock clock;
+
+	product_timer(const Vector& x, Vector& y, int repetitions, double& seconds)
+	  : x(x), y(y), repetitions(repetitions), seconds(seconds) {}
+
+	template <typename Matrix>
+	void operator()(Matrix& A) const
+	{
+	    y= A * x; // warm-up
+	    seconds= std::numeric_limits<double>::infinity();
+	    for (int r= 0; r < repetitions; r++) {
+		clock::time_point start= clock::now();
+		y= A * x;
+		seconds= std::min(seconds, std::chrono::duration<double>(clock::now() - start).count());
+	    }
+	}
+
+	const Vector& x;
+	Vector&       y;
+	int           repetitions;
+	double&       seconds;
+    };
+
+    template <typename Value, typename Parameters, typename Vector>
+    void time_crs_block_sizes(const compressed2D<Value, Parameters>&, const Vector&, Vector&, int, std::vector<format_timing>&, boost::mpl::false_) {}
+
+    template <unsigned BSize, typename Value, typename Parameters, typename Vector>
+    void time_crs_block_size(const compressed2D<Value, Parameters>& A, const Vector& x, Vector& y, int repetitions, 
+			     std::vector<format_timing>& timings)
+    {
+	typedef std::chrono::steady_clock clock;
+	format_timing t= { storage_format::compressed, BSize, std::numeric_limits<double>::infinity() };
+	smat_cvec_mult<BSize>(A, x, y, assign::assign_sum(), tag::row_major()); // warm-up
+	for (int r= 0; r < repetitions; r++) {
+	    clock::time_point start= clock::now();
+	    smat_cvec_mult<BSize>(A, x, y, assign::assign_sum(), tag::row_major());
+	    t.seconds= std::min(t.seconds, std::chrono::duration<double>(clock::now() - start).count());
+	}
+	timings.push_back(t);
+    }
+
+    template <typename Value, typename Parameters, typename Vector>
+    void time_crs_block_sizes(const compressed2D<Value, Parameters>& A, const Vector& x, Vector& y, int repetitions, 
+			      std::vector<format_timing>& timings, boost::mpl::true_)
+    {
+	time_crs_block_size<1>(A, x, y, repetitions, timings);
+	time_crs_block_size<2>(A, x, y, repetitions, timings);
+	time_crs_block_size<4>(A, x, y, repetitions, timings);
+	time_crs_block_size<8>(A, x, y, repetitions, timings);
+    }
+}
+
+/// Time the matrix-vector product of \p A in the applicable formats and set the recommendation of \p a to the fastest
+/** Formats whose estimated memory traffic exceeds that of compressed2D more than twice are skipped.
+    For row-major matrices, the row unrollings 1, 2, 4 and 8 of compressed2D are timed as well
+    and the fastest one is stored in crs_block_size.
+    Returns the timings in the order of measurement. **/
+template <typename Value, typename Parameters>
+std::vector<format_timing> time_formats(const compressed2D<Value, Parameters>& A, structure_analysis& a, int repetitions= 10)
+{
+    MTL_THROW_IF(repetitions < 1, logic_error("At least one repetition needed"));
+    typedef vec::dense_vector<Value> vector_type;
+    std::vector<format_timing> timings;
+    vector_type                x(num_cols(A), Value(1)), y(num_rows(A));
+
+    const storage_format::type recommended= a.format;
+    for (int f= 0; f < storage_format::number; f++) {
+	const storage_format::type format= storage_format::type(f);
+	if (format != storage_format::compressed && !(a.bytes[f] <= 2.0 * a.bytes[storage_format::compressed]))
+	    continue;
+	a.format= format;
+	format_timing t= { format, 0, 0.0 };
+	with_recommended_format(A, a, detail::product_timer<vector_type>(x, y, repetitions, t.seconds));
+	timings.push_back(t);
+    }
+    const std::size_t formats= timings.size();
+    detail::time_crs_block_sizes(A, x, y, repetitions, timings, mtl::traits::is_row_major<Parameters>());
+
+    a.format= recommended;
+    double best= std::numeric_limits<double>::infinity();
+    for (std::size_t i= 0; i < formats; i++)
+	if (timings[i].seconds < best)
+	    best= timings[i].seconds, a.format= timings[i].format;
+    if (a.format != recommended) {
+	std::ostringstream os;
+	os << "measured fastest, " << storage_format::name(recommended) << " was estimated";
+	a.reason= os.str();
+    }
+    best= std::numeric_limits<double>::infinity();
+    for (std::size_t i= formats; i < timings.size(); i++)
+	if (timings[i].seconds < best)
+	    best= timings[i].seconds, a.crs_block_size= timings[i].block_size;
+    return timings;
+}
+
+#endif
+
+}} // namespace mtl::mat
+
+#endif // MTL_MATRIX_STRUCTURE_ANALYSIS_INCLUDE
@@ -16,12 +16,14 @@
 #include <iostream>
 #include <cmath>
 
+#include <boost/utility/enable_if.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/category.hpp>
 #include <boost/numeric/mtl/vector/lazy_reduction.hpp>
 #include <boost/numeric/mtl/vector/reduction.hpp>
 #include <boost/numeric/mtl/vector/reduction_functors.hpp>
+#include <boost/numeric/mtl/operation/accumulation.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 
@@ -57,6 +59,15 @@ inline sum(const Value& value)
     return sum<8>(value);
 }
 
+/// Sum of all %vector-entries with accumulation \p policy, e.g. sum(v, accumulation::kahan())
+template <typename Value, typename Policy>
+typename boost::enable_if<accumulation::is_policy<Policy>, typename Collection<Value>::value_type>::type
+inline sum(const Value& value, Policy policy)
+{
+    vampir_trace<2035> tracer;
+    return accumulation::reduce_sum<typename Collection<Value>::value_type>(value, policy);
+}
+
 namespace vec {
 	template <typename Vector>
 	lazy_reduction<Vector, sum_functor> inline lazy_sum(const Vector& v)
@@ -18,83 +18,433 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
-#include <boost/numeric/mtl/matrix/strict_upper.hpp>
-#include <boost/numeric/mtl/operation/diagonal.hpp>
-#include <boost/numeric/mtl/operation/one_norm.hpp>
-#include <boost/numeric/mtl/operation/sub_matrix.hpp>
+#include <boost/numeric/linear_algebra/identity.hpp>
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/concept/magnitude.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/parameter.hpp>
+#include <boost/numeric/mtl/matrix/inserter.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/vector/parameter.hpp>
 #include <boost/numeric/mtl/operation/trans.hpp>
-#include <boost/numeric/mtl/operation/two_norm.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 namespace mtl { namespace mat {
 
+namespace impl {
+
+    /// sqrt(a^2 + b^2) without destructive over- or underflow
+    template <typename Value>
+    inline Value svd_hypot(Value a, Value b)
+    {
+	using std::abs; using std::sqrt;
+	a= abs(a); b= abs(b);
+	if (a > b) {
+	    Value r= b / a;
+	    return a * sqrt(Value(1) + r * r);
+	} else if (b != Value(0)) {
+	    Value r= a / b;
+	    return b * sqrt(Value(1) + r * r);
+	}
+	return Value(0);
+    }
+
+    /// Golub-Kahan SVD of a matrix with at least as many rows as columns
+    /** W (m x n, m >= n) is overwritten by the Householder vectors of the bidiagonalization.
+	Afterwards the bidiagonal matrix is diagonalized by implicitly shifted QR sweeps (Golub-Reinsch).
+	The singular values are returned in descending order in s.
+	If \p want_u is set, U receives the left singular vectors (m x m if \p full_u, m x n otherwise).
+	If \p want_v is set, V receives the right singular vectors (n x n).
+	Work matrices are column-major such that all reflections and rotations access contiguous memory. **/
+    template <typename Work, typename Vector>
+    void svd_golub_kahan(Work& W, Vector& s, Work& U, Work& V, bool want_u, bool want_v, bool full_u)
+    {
+	vampir_trace<3071> tracer;
+	using std::abs; using std::sqrt; using std::max; using std::min;
+	typedef typename Collection<Work>::value_type   value_type;
+	typedef int                                     index_type; // loops run down to -1
+
+	const index_type m= num_rows(W), n= num_cols(W), nu= full_u ? m : n,
+	                 nct= min(m-1, n), nrt= max(0, min(n-2, m)), p_init= min(n, m+1);
+	const value_type zero= math::zero(value_type()), one= math::one(value_type());
+
+	s.change_dim(p_init);
+	if (want_u) U.change_dim(m, nu);
+	if (want_v) V.change_dim(n, n);
+	Vector e(n, zero), work(m, zero);
+
+	// Reduce W to bidiagonal form, storing the diagonal in s and the super-diagonal in e
+	for (index_type k= 0; k < max(nct, nrt); k++) {
+	    if (k < nct) {
+		// Column transformation for the k-th column
+		s[k]= zero;
+		for (index_type i= k; i < m; i++)
+		    s[k]= svd_hypot(s[k], W(i, k));
+		if (s[k] != zero) {
+		    if (W(k, k) < zero)
+			s[k]= -s[k];
+		    for (index_type i= k; i < m; i++)
+			W(i, k)/= s[k];
+		    W(k, k)+= one;
+		}
+		s[k]= -s[k];
+	    }
+	    for (index_type j= k+1; j < n; j++) {
+		if (k < nct && s[k] != zero) {
+		    value_type t= zero;
+		    for (index_type i= k; i < m; i++)
+			t+= W(i, k) * W(i, j);
+		    t= -t / W(k, k);
+		    for (index_type i= k; i < m; i++)
+			W(i, j)+= t * W(i, k);
+		}
+		e[j]= W(k, j); // k-th row for the subsequent row transformation
+	    }
+	    if (want_u && k < nct)
+		for (index_type i= k; i < m; i++)
+		    U(i, k)= W(i, k);
+	    if (k < nrt) {
+		// Row transformation for the k-th row
+		e[k]= zero;
+		for (index_type i= k+1; i < n; i++)
+		    e[k]= svd_hypot(e[k], e[i]);
+		if (e[k] != zero) {
+		    if (e[k+1] < zero)
+			e[k]= -e[k];
+		    for (index_type i= k+1; i < n; i++)
+			e[i]/= e[k];
+		    e[k+1]+= one;
+		}
+		e[k]= -e[k];
+		if (k+1 < m && e[k] != zero) {
+		    for (index_type i= k+1; i < m; i++)
+			work[i]= zero;
+		    for (index_type j= k+1; j < n; j++)
+			for (index_type i= k+1; i < m; i++)
+			    work[i]+= e[j] * W(i, j);
+		    for (index_type j= k+1; j < n; j++) {
+			value_type t= -e[j] / e[k+1];
+			for (index_type i= k+1; i < m; i++)
+			    W(i, j)+= t * work[i];
+		    }
+		}
+		if (want_v)
+		    for (index_type i= k+1; i < n; i++)
+			V(i, k)= e[i];
+	    }
+	}
+
+	// Bidiagonal matrix of order p
+	index_type p= p_init;
+	if (nct < n) s[nct]= W(nct, nct);
+	if (m < p) s[p-1]= zero;
+	if (nrt+1 < p) e[nrt]= W(nrt, p-1);
+	e[p-1]= zero;
+
+	// Accumulate the left reflections backwards
+	if (want_u) {
+	    for (index_type j= nct; j < nu; j++) {
+		for (index_type i= 0; i < m; i++)
+		    U(i, j)= zero;
+		U(j, j)= one;
+	    }
+	    for (index_type k= nct-1; k >= 0; k--) {
+		if (s[k] != zero) {
+		    for (index_type j= k+1; j < nu; j++) {
+			value_type t= zero;
+			for (index_type i= k; i < m; i++)
+			    t+= U(i, k) * U(i, j);
+			t= -t / U(k, k);
+			for (index_type i= k; i < m; i++)
+			    U(i, j)+= t * U(i, k);
+		    }
+		    for (index_type i= k; i < m; i++)
+			U(i, k)= -U(i, k);
+		    U(k, k)+= one;
+		    for (index_type i= 0; i < k; i++)
+			U(i, k)= zero;
+		} else {
+		    for (index_type i= 0; i < m; i++)
+			U(i, k)= zero;
+		    U(k, k)= one;
+		}
+	    }
+	}
+
+	// Accumulate the right reflections backwards
+	if (want_v)
+	    for (index_type k= n-1; k >= 0; k--) {
+		if (k < nrt && e[k] != zero)
+		    for (index_type j= k+1; j < n; j++) {
+			value_type t= zero;
+			for (index_type i= k+1; i < n; i++)
+			    t+= V(i, k) * V(i, j);
+			t= -t / V(k+1, k);
+			for (index_type i= k+1; i < n; i++)
+			    V(i, j)+= t * V(i, k);
+		    }
+		for (index_type i= 0; i < n; i++)
+		    V(i, k)= zero;
+		V(k, k)= one;
+	    }
+
+	// Implicitly shifted QR on the bidiagonal matrix
+	vampir_trace<3072> qr_tracer;
+	const index_type pp= p-1;
+	const value_type eps= std::numeric_limits<value_type>::epsilon(),
+	                 tiny= std::numeric_limits<value_type>::min() / eps;
+	while (p > 0) {
+	    index_type k, kase;
+	    // kase = 1: s(p) and e[k-1] are negligible and k < p
+	    // kase = 2: s(k) is negligible and k < p
+	    // kase = 3: e[k-1] is negligible, k < p, and s(k), ..., s(p) are not negligible (QR step)
+	    // kase = 4: e(p-1) is negligible (convergence)
+	    for (k= p-2; k >= 0; k--)
+		if (abs(e[k]) <= tiny + eps * (abs(s[k]) + abs(s[k+1]))) {
+		    e[k]= zero;
+		    break;
+		}
+	    if (k == p-2)
+		kase= 4;
+	    else {
+		index_type ks;
+		for (ks= p-1; ks > k; ks--) {
+		    value_type t= (ks != p ? abs(e[ks]) : zero) + (ks != k+1 ? abs(e[ks-1]) : zero);
+		    if (abs(s[ks]) <= tiny + eps * t) {
+			s[ks]= zero;
+			break;
+		    }
+		}
+		if (ks == k)
+		    kase= 3;
+		else if (ks == p-1)
+		    kase= 1;
+		else {
+		    kase= 2;
+		    k= ks;
+		}
+	    }
+	    k++;
+
+	    switch (kase) {
+	      case 1: { // Deflate negligible s(p)
+		value_type f= e[p-2];
+		e[p-2]= zero;
+		for (index_type j= p-2; j >= k; j--) {
+		    value_type t= svd_hypot(s[j], f), cs= s[j] / t, sn= f / t;
+		    s[j]= t;
+		    if (j != k) {
+			f= -sn * e[j-1];
+			e[j-1]*= cs;
+		    }
+		    if (want_v)
+			for (index_type i= 0; i < n; i++) {
+			    t= cs * V(i, j) + sn * V(i, p-1);
+			    V(i, p-1)= -sn * V(i, j) + cs * V(i, p-1);
+			    V(i, j)= t;
+			}
+		}
+		break;
+	      }
+	      case 2: { // Split at negligible s(k)
+		value_type f= e[k-1];
+		e[k-1]= zero;
+		for (index_type j= k; j < p; j++) {
+		    value_type t= svd_hypot(s[j], f), cs= s[j] / t, sn= f / t;
+		    s[j]= t;
+		    f= -sn * e[j];
+		    e[j]*= cs;
+		    if (want_u)
+			for (index_type i= 0; i < m; i++) {
+			    t= cs * U(i, j) + sn * U(i, k-1);
+			    U(i, k-1)= -sn * U(i, j) + cs * U(i, k-1);
+			    U(i, j)= t;
+			}
+		}
+		break;
+	      }
+	      case 3: { // One QR step with the shift from the trailing 2 x 2 block
+		value_type scale= max(max(max(max(abs(s[p-1]), abs(s[p-2])), abs(e[p-2])), abs(s[k])), abs(e[k])),
+		           sp= s[p-1] / scale, spm1= s[p-2] / scale, epm1= e[p-2] / scale,
+		           sk= s[k] / scale, ek= e[k] / scale,
+		           b= ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / value_type(2),
+		           c= (sp * epm1) * (sp * epm1), shift= zero;
+		if (b != zero || c != zero) {
+		    shift= sqrt(b * b + c);
+		    if (b < zero)
+			shift= -shift;
+		    shift= c / (b + shift);
+		}
+		value_type f= (sk + sp) * (sk - sp) + shift, g= sk * ek;
+
+		// Chase the bulge down the bidiagonal
+		for (index_type j= k; j < p-1; j++) {
+		    value_type t= svd_hypot(f, g), cs= f / t, sn= g / t;
+		    if (j != k)
+			e[j-1]= t;
+		    f= cs * s[j] + sn * e[j];
+		    e[j]= cs * e[j] - sn * s[j];
+		    g= sn * s[j+1];
+		    s[j+1]*= cs;
+		    if (want_v)
+			for (index_type i= 0; i < n; i++) {
+			    t= cs * V(i, j) + sn * V(i, j+1);
+			    V(i, j+1)= -sn * V(i, j) + cs * V(i, j+1);
+			    V(i, j)= t;
+			}
+		    t= svd_hypot(f, g); cs= f / t; sn= g / t;
+		    s[j]= t;
+		    f= cs * e[j] + sn * s[j+1];
+		    s[j+1]= -sn * e[j] + cs * s[j+1];
+		    g= sn * e[j+1];
+		    e[j+1]*= cs;
+		    if (want_u && j < m-1)
+			for (index_type i= 0; i < m; i++) {
+			    t= cs * U(i, j) + sn * U(i, j+1);
+			    U(i, j+1)= -sn * U(i, j) + cs * U(i, j+1);
+			    U(i, j)= t;
+			}
+		}
+		e[p-2]= f;
+		break;
+	      }
+	      case 4: { // Convergence: make singular value non-negative and sort it in
+		if (s[k] <= zero) {
+		    s[k]= s[k] < zero ? value_type(-s[k]) : zero;
+		    if (want_v)
+			for (index_type i= 0; i <= pp; i++)
+			    V(i, k)= -V(i, k);
+		}
+		for (; k < pp && s[k] < s[k+1]; k++) {
+		    std::swap(s[k], s[k+1]);
+		    if (want_v && k < n-1)
+			for (index_type i= 0; i < n; i++)
+			    std::swap(V(i, k), V(i, k+1));
+		    if (want_u && k < m-1)
+			for (index_type i= 0; i < m; i++)
+			    std::swap(U(i, k), U(i, k+1));
+		}
+		p--;
+		break;
+	      }
+	    }
+	}
+    }
+
+    /// Common driver: copies A (or its transposed if it is wide) into a column-major work matrix
+    template <typename Matrix, typename Work, typename Vector>
+    void svd_driver(const Matrix& A, Vector& s, Work& U, Work& V, bool want_u, bool want_v, bool full_u)
+    {
+	typedef typename Collection<Matrix>::size_type    size_type;
+	size_type nrows= num_rows(A), ncols= num_cols(A);
+
+	if (nrows >= ncols) {
+	    Work W(nrows, ncols);
+	    W= A;
+	    svd_golub_kahan(W, s, U, V, want_u, want_v, full_u);
+	} else {
+	    // A' = U' S V'^T  =>  A = V' S U'^T
+	    Work W(ncols, nrows);
+	    W= trans(A);
+	    svd_golub_kahan(W, s, V, U, want_v, want_u, full_u);
+	}
+    }
+
+    template <typename Matrix>
+    struct svd_work
+    {
+	typedef typename Collection<Matrix>::value_type                   value_type;
+	typedef dense2D<value_type, mat::parameters<col_major> >          matrix_type;
+	typedef mtl::vec::dense_vector<value_type, mtl::vec::parameters<> > vector_type;
+    };
+
+    template <typename Matrix, typename Vector>
+    inline void svd_set_diagonal(Matrix& V, const Vector& s)
+    {
+	V= 0;
+	mtl::mat::inserter<Matrix>  ins_V(V);
+	for (std::size_t i= 0; i < size(s); i++)
+	    ins_V[i][i] << s[i];
+    }
+
+} // namespace impl
+
+
 /// Returns A=S*V*D' for matrix A as references
+/** The decomposition is computed by Householder bidiagonalization followed by implicitly
+    shifted QR sweeps on the bidiagonal matrix (Golub-Kahan-Reinsch).
+    S (m x m) and D (n x n) are orthogonal, V (m x n) holds the singular values in descending order on its diagonal.
+    The iteration converges to machine precision; \p tol is only kept for backward compatibility.
+    Like the previous QR-iteration, this function works only for real matrices. **/
 template <typename Matrix>
 inline void svd(const Matrix& A, Matrix& S, Matrix& V, Matrix& D, double tol= 10e-10)
 {
-	vampir_trace<3037> tracer;
-    typedef typename Collection<Matrix>::value_type   value_type;
-    typedef typename Collection<Matrix>::size_type    size_type;
-    size_type        ncols= num_cols(A), nrows= num_rows(A), loops, col= ncols, row= nrows;
-    value_type       ref, zero= math::zero(ref), one= math::one(ref); 
-    double 	     err(std::numeric_limits<double>::max()), e, f;
-
-    if (nrows != ncols) // important for right dimension
-	std::swap(row, col);
-    
-     //init
-    Matrix Q(row,row),  R(row,col),  VT(row,col), E(row,col), 
- 	   QT(col,col), RT(col,row);
-
-    loops= 100 * std::max(nrows,ncols);
-    S= one; D= one; E= zero;
-    for (size_type i= 0; err > tol && i < loops; ++i) {
-	boost::tie(QT, RT)= qr(V);
- 	S*= QT;
-	VT= trans(RT);
-	boost::tie(Q, R)= qr(VT);
-	D*= Q;
-	E= triu(R,1);
-	V= trans(R);
-
-	//ready for exit when upper(R)=0
-	f= two_norm(diagonal(R));
-	e= one_norm(E);
-	if ( f== zero ) f= 1;
-	err= e/f;
-    } //end for
-    
-    {
-	V= 0;  
-	mtl::mat::inserter<Matrix>  ins_V(V);
-	mtl::mat::inserter<Matrix,  mtl::operations::update_times<value_type> > ins_S(S);
+    vampir_trace<3037> tracer;
+    typedef impl::svd_work<Matrix>                  work_type;
+    typename work_type::matrix_type                 U(0, 0), DD(0, 0);
+    typename work_type::vector_type                 s(0);
 
-	for (size_type i= 0, end= std::min(nrows, ncols); i < end; i++) {
-	    ins_V[i][i] << std::abs(R[i][i]);
-	    if (R[i][i] < zero) 	
-		for (size_type j= 0; j < nrows; j++) 
-		    ins_S[j][i] << -1;  //carefull changing: multiplication with minus one
-	}
-    }
+    (void) tol; // deflation criterion is relative to the machine precision
+    impl::svd_driver(A, s, U, DD, true, true, true);
+    S= U; D= DD;
+    impl::svd_set_diagonal(V, s);
 }
 
 /// Returns A=S*V*D' for matrix A as triplet
+/** S is m x m, V is m x n and D is n x n, see svd(A, S, V, D, tol). **/
 template <typename Matrix>
 boost::tuple<Matrix, Matrix, Matrix >
 inline svd(const Matrix& A, double tol= 10e-10)
 {
-	vampir_trace<3038> tracer;
+    vampir_trace<3038> tracer;
     typedef typename Collection<Matrix>::size_type    size_type;
-    size_type    ncols= num_cols(A), nrows= num_rows(A), col= ncols, row= nrows;
-    if (nrows != ncols) // important for right dimension
-	std::swap(row, col);
+    size_type    ncols= num_cols(A), nrows= num_rows(A);
 
-    Matrix       ST(col,col), V(A), D(row,row);
+    Matrix       ST(nrows, nrows), V(nrows, ncols), D(ncols, ncols);
     svd(A, ST, V, D, tol);
     return boost::make_tuple(ST, V, D);
 }
 
+/// Returns the thin singular value decomposition A=U*V*D' as triplet
+/** With k= min(num_rows(A), num_cols(A)), U is m x k, V is k x k (diagonal) and D is n x k.
+    Cheaper than the full decomposition when A is far from square. **/
+template <typename Matrix>
+boost::tuple<Matrix, Matrix, Matrix >
+inline svd_thin(const Matrix& A)
+{
+    vampir_trace<3074> tracer;
+    typedef impl::svd_work<Matrix>                  work_type;
+    typedef typename Collection<Matrix>::size_type  size_type;
+    size_type                                       k= std::min(num_rows(A), num_cols(A));
+    typename work_type::matrix_type                 UU(0, 0), DD(0, 0);
+    typename work_type::vector_type                 s(0);
+
+    impl::svd_driver(A, s, UU, DD, true, true, false); // UU is m x k and DD is n x k
+
+    Matrix       U(num_rows(A), k), V(k, k), D(num_cols(A), k);
+    U= UU; D= DD;
+    impl::svd_set_diagonal(V, s);
+    return boost::make_tuple(U, V, D);
+}
+
+/// Returns the singular values of A in descending order
+/** Only the bidiagonalization and the QR sweeps on the bidiagonal matrix are performed,
+    no singular vectors are accumulated. **/
+template <typename Matrix>
+typename impl::svd_work<Matrix>::vector_type
+inline singular_values(const Matrix& A)
+{
+    vampir_trace<3073> tracer;
+    typedef impl::svd_work<Matrix>                  work_type;
+    typename work_type::matrix_type                 U(0, 0), D(0, 0);
+    typename work_type::vector_type                 s(0);
+
+    impl::svd_driver(A, s, U, D, false, false, false);
+    return s;
+}
+
 
 }} // namespace mtl::matrix
 
@@ -0,0 +1,388 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_MATRIX_TRIDIAGONAL_INCLUDE
+#define MTL_MATRIX_TRIDIAGONAL_INCLUDE
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <boost/numeric/linear_algebra/identity.hpp>
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/irange.hpp>
+#include <boost/numeric/mtl/utility/omp_size_type.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/matrix/dense2D.hpp>
+#include <boost/numeric/mtl/matrix/parameter.hpp>
+#include <boost/numeric/mtl/vector/dense_vector.hpp>
+#include <boost/numeric/mtl/vector/parameter.hpp>
+#include <boost/numeric/mtl/operation/sub_matrix.hpp>
+#include <boost/numeric/mtl/operation/trans.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+
+namespace mtl { namespace mat {
+
+/// Default number of columns reduced at once in tridiagonalize
+const std::size_t tridiagonal_block_size= 32;
+
+/// Matrices smaller than this are reduced column by column in tridiagonalize
+const std::size_t tridiagonal_crossover= 128;
+
+namespace impl {
+
+    /// Generates a Householder reflection H= I - tau*v*v' with v[0] == 1 such that H*[alpha; x] = [beta; 0]
+    /** On exit alpha holds beta and x the tail of v. x is the column \p c of \p A from row \p r0 to \p r1. **/
+    template <typename Matrix, typename Value>
+    Value householder_reflection(Matrix& A, std::size_t r0, std::size_t r1, std::size_t c, Value& alpha)
+    {
+	using std::abs; using std::sqrt;
+	const Value zero= math::zero(alpha), one= math::one(alpha);
+	Value xnorm= zero, scale= zero;
+	for (std::size_t i= r0; i < r1; i++)
+	    scale= std::max(scale, Value(abs(A(i, c))));
+	if (scale == zero)
+	    return zero;
+	for (std::size_t i= r0; i < r1; i++) {
+	    Value t= A(i, c) / scale;
+	    xnorm+= t * t;
+	}
+	xnorm= scale * sqrt(xnorm);
+
+	Value s= std::max(Value(abs(alpha)), xnorm), a= alpha / s, x= xnorm / s,
+	      beta= s * sqrt(a * a + x * x);
+	if (alpha >= zero)
+	    beta= -beta;
+	Value tau= (beta - alpha) / beta, f= one / (alpha - beta);
+	for (std::size_t i= r0; i < r1; i++)
+	    A(i, c)*= f;
+	alpha= beta;
+	return tau;
+    }
+
+    /// Reduces the first nb columns of the symmetric matrix A to tridiagonal form (LAPACK's latrd, lower case)
+    /** The reflections are not applied to the trailing matrix but W is returned such that
+	the trailing update is A-= V*W' + W*V' with V the reflection vectors in A. **/
+    template <typename Matrix, typename Vector>
+    void tridiagonal_panel(Matrix& A, std::size_t nb, Vector& e, Vector& tau, Matrix& W)
+    {
+	typedef typename Collection<Matrix>::value_type   value_type;
+	const std::size_t n= num_rows(A);
+	const value_type  zero= math::zero(value_type()), one= math::one(value_type()), half= one / value_type(2);
+
+	for (std::size_t j= 0; j < nb; j++) {
+	    for (std::size_t k= 0; k < j; k++) {                 // update A(j:n, j) with the previous reflections
+		value_type wjk= W(j, k), ajk= A(j, k);
+		for (std::size_t i= j; i < n; i++)
+		    A(i, j)-= A(i, k) * wjk + W(i, k) * ajk;
+	    }
+	    if (j+1 >= n) {
+		tau[j]= zero;
+		continue;
+	    }
+	    value_type alpha= A(j+1, j);
+	    tau[j]= householder_reflection(A, j+2, n, j, alpha);
+	    e[j]= alpha;
+	    A(j+1, j)= one;
+
+	    // W(j+1:n, j) = tau * (A22 * v - V * (W' * v) - W * (V' * v)), A22 the not yet updated trailing matrix
+	    for (std::size_t i= j+1; i < n; i++)
+		W(i, j)= zero;
+	    for (std::size_t c= j+1; c < n; c++) {
+		const value_type vc= A(c, j);
+		for (std::size_t i= j+1; i < n; i++)
+		    W(i, j)+= A(i, c) * vc;
+	    }
+	    for (std::size_t k= 0; k < j; k++) {
+		value_type tw= zero, tv= zero;
+		for (std::size_t i= j+1; i < n; i++)
+		    tw+= W(i, k) * A(i, j), tv+= A(i, k) * A(i, j);
+		for (std::size_t i= j+1; i < n; i++)
+		    W(i, j)-= A(i, k) * tw + W(i, k) * tv;
+	    }
+	    value_type dt= zero;
+	    for (std::size_t i= j+1; i < n; i++) {
+		W(i, j)*= tau[j];
+		dt+= W(i, j) * A(i, j);
+	    }
+	    const value_type a2= -half * tau[j] * dt;
+	    for (std::size_t i= j+1; i < n; i++)
+		W(i, j)+= a2 * A(i, j);
+	}
+    }
+
+} // namespace impl
+
+
+/// Householder reduction of the symmetric matrix A to tridiagonal form Q'*A*Q = T
+/** A must be a column-major dense2D matrix; only the reflection vectors are kept on exit:
+    below the sub-diagonal of A with the scaling factors in \p tau (Q = H(0)*H(1)*...*H(n-2)).
+    The diagonal of T is returned in \p d and the sub-diagonal in \p e (e[n-1] is set to zero).
+    Panels of \p nb columns are reduced at once such that the trailing matrix is updated by a
+    rank-2nb update with two matrix products. **/
+template <typename Value, typename Parameters, typename Vector>
+void tridiagonalize(dense2D<Value, Parameters>& A, Vector& d, Vector& e, Vector& tau,
+		    std::size_t nb= tridiagonal_block_size)
+{
+    vampir_trace<5063> tracer;
+    typedef dense2D<Value, Parameters>                Matrix;
+    const std::size_t n= num_rows(A);
+    const Value       zero= math::zero(Value()), one= math::one(Value()), half= one / Value(2);
+    MTL_THROW_IF(num_cols(A) != n, matrix_not_square());
+
+    d.change_dim(n); e.change_dim(n); tau.change_dim(n);
+    d= zero; e= zero; tau= zero;
+    if (n == 0) return;
+
+    std::size_t i= 0;
+    if (nb > 1 && n > std::max(tridiagonal_crossover, nb))
+	for (; i + std::max(tridiagonal_crossover, nb) < n; i+= nb) {
+	    Matrix     Ap(sub_matrix(A, i, n, i, n)), W(n-i, nb);
+	    Vector     ep(nb), taup(nb);
+	    impl::tridiagonal_panel(Ap, nb, ep, taup, W);
+
+	    // A22-= V * W' + W * V'
+	    Matrix     A22(sub_matrix(Ap, nb, n-i, nb, n-i)), V(sub_matrix(Ap, nb, n-i, 0, nb)),
+		       W2(sub_matrix(W, nb, n-i, 0, nb));
+	    A22-= V * trans(W2);
+	    A22-= W2 * trans(V);
+
+	    for (std::size_t j= 0; j < nb; j++) {
+		Ap(j+1, j)= e[i+j]= ep[j];
+		d[i+j]= Ap(j, j);
+		tau[i+j]= taup[j];
+	    }
+	}
+
+    // Unblocked reduction of the remaining matrix
+    Vector w(n, zero);
+    for (; i + 1 < n; i++) {
+	Value alpha= A(i+1, i), taui= impl::householder_reflection(A, i+2, n, i, alpha);
+	e[i]= alpha;
+	if (taui != zero) {
+	    A(i+1, i)= one;
+	    Value dt= zero;
+	    for (std::size_t r= i+1; r < n; r++)
+		w[r]= zero;
+	    for (std::size_t c= i+1; c < n; c++) {
+		const Value vc= A(c, i);
+		for (std::size_t r= i+1; r < n; r++)
+		    w[r]+= A(r, c) * vc;
+	    }
+	    for (std::size_t r= i+1; r < n; r++) {
+		w[r]*= taui;
+		dt+= w[r] * A(r, i);
+	    }
+	    const Value a2= -half * taui * dt;
+	    for (std::size_t r= i+1; r < n; r++)
+		w[r]+= a2 * A(r, i);
+	    for (std::size_t c= i+1; c < n; c++) {         // A22-= v*w' + w*v'
+		const Value vc= A(c, i), wc= w[c];
+		for (std::size_t r= i+1; r < n; r++)
+		    A(r, c)-= A(r, i) * wc + w[r] * vc;
+	    }
+	    A(i+1, i)= e[i];
+	}
+	d[i]= A(i, i);
+	tau[i]= taui;
+    }
+    d[n-1]= A(n-1, n-1);
+    e[n-1]= zero;
+}
+
+/// Multiplies Z from the left with the orthogonal matrix Q of tridiagonalize: Z= Q * Z
+/** Blocks of \p nb reflections are combined to I - V*T*V' (compact WY form) and applied with matrix products. **/
+template <typename Value, typename Parameters, typename Vector, typename MatrixZ>
+void tridiagonal_back_transform(const dense2D<Value, Parameters>& A, const Vector& tau, MatrixZ& Z,
+				std::size_t nb= tridiagonal_block_size)
+{
+    vampir_trace<5064> tracer;
+    typedef dense2D<Value, Parameters>                Matrix;
+    const std::size_t n= num_rows(A), nr= n < 2 ? 0 : n - 1, nz= num_cols(Z); // nr reflections
+    const Value       zero= math::zero(Value());
+    MTL_THROW_IF(num_rows(Z) != n, incompatible_size());
+    if (nr == 0 || nz == 0) return;
+    if (nb == 0) nb= 1;
+
+    for (std::size_t j1= nr; j1 > 0; ) {
+	const std::size_t j0= j1 > nb ? j1 - nb : 0, b= j1 - j0, m= n - j0 - 1;
+
+	// V holds the reflection vectors j0..j1-1 starting at row j0+1 (unit lower trapezoidal)
+	Matrix V(m, b), T(b, b);
+	V= zero; T= zero;
+	for (std::size_t c= 0; c < b; c++) {
+	    V(c, c)= math::one(Value());
+	    for (std::size_t r= c+1; r < m; r++)
+		V(r, c)= A(j0 + 1 + r, j0 + c);
+	}
+	for (std::size_t c= 0; c < b; c++) {
+	    const Value tc= tau[j0 + c];
+	    if (tc == zero)
+		continue;
+	    for (std::size_t k= 0; k < c; k++) {        // T(0:c, c)= -tau * V(:, 0:c)' * V(:, c)
+		Value s= zero;
+		for (std::size_t r= c; r < m; r++)
+		    s+= V(r, k) * V(r, c);
+		T(k, c)= -tc * s;
+	    }
+	    for (std::size_t k= 0; k < c; k++) {        // T(0:c, c)= T(0:c, 0:c) * T(0:c, c), T upper triangular
+		Value s= zero;
+		for (std::size_t l= k; l < c; l++)
+		    s+= T(k, l) * T(l, c);
+		T(k, c)= s;
+	    }
+	    T(c, c)= tc;
+	}
+
+	dense2D<typename Collection<MatrixZ>::value_type, Parameters> Zs(m, nz), Y(b, nz), Y2(b, nz);
+	Zs= sub_matrix(Z, j0 + 1, n, 0, nz);
+	Y= trans(V) * Zs;
+	Y2= T * Y;
+	Zs-= V * Y2;
+	sub_matrix(Z, j0 + 1, n, 0, nz)= Zs;
+	j1= j0;
+    }
+}
+
+/// Eigenvalues (and optionally eigenvectors) of the symmetric tridiagonal matrix with diagonal d and sub-diagonal e
+/** Implicit QL algorithm with Wilkinson shifts. On exit d contains the eigenvalues in ascending order
+    and e is destroyed. If \p want_z is set, the rotations are accumulated in Z (which must be initialized,
+    typically with the identity) and its columns are sorted along with the eigenvalues. **/
+template <typename Vector, typename MatrixZ>
+void tridiagonal_ql(Vector& d, Vector& e, MatrixZ& Z, bool want_z)
+{
+    vampir_trace<5065> tracer;
+    using std::abs; using std::sqrt;
+    typedef typename Collection<Vector>::value_type   value_type;
+    const std::size_t n= size(d);
+    const value_type  zero= math::zero(value_type()), one= math::one(value_type()),
+	              eps= std::numeric_limits<value_type>::epsilon();
+    const std::size_t nz= want_z ? num_rows(Z) : 0;
+    if (n == 0) return;
+    e[n-1]= zero;
+
+    for (std::size_t l= 0; l < n; l++) {
+	std::size_t iter= 0, m;
+	do {
+	    for (m= l; m + 1 < n; m++) {
+		value_type dd= abs(d[m]) + abs(d[m+1]);
+		if (abs(e[m]) <= eps * dd)
+		    break;
+	    }
+	    if (m != l) {
+		MTL_THROW_IF(iter++ == 60, runtime_error("tridiagonal_ql: no convergence"));
+		value_type g= (d[l+1] - d[l]) / (value_type(2) * e[l]), r= sqrt(g * g + one);
+		g= d[m] - d[l] + e[l] / (g + (g >= zero ? r : value_type(-r)));
+		value_type s= one, c= one, p= zero;
+		std::size_t i= m;
+		bool        underflow= false;
+		for (; i-- > l; ) {
+		    value_type f= s * e[i], b= c * e[i];
+		    r= sqrt(f * f + g * g);
+		    e[i+1]= r;
+		    if (r == zero) {
+			d[i+1]-= p;
+			e[m]= zero;
+			underflow= true;
+			break;
+		    }
+		    s= f / r; c= g / r;
+		    g= d[i+1] - p;
+		    r= (d[i] - g) * s + value_type(2) * c * b;
+		    p= s * r;
+		    d[i+1]= g + p;
+		    g= c * r - b;
+		    for (std::size_t k= 0; k < nz; k++) {
+			value_type zk= Z(k, i+1);
+			Z(k, i+1)= s * Z(k, i) + c * zk;
+			Z(k, i)= c * Z(k, i) - s * zk;
+		    }
+		}
+		if (underflow)
+		    continue;
+		d[l]-= p;
+		e[l]= g;
+		e[m]= zero;
+	    }
+	} while (m != l);
+    }
+
+    // Selection sort, moves each eigenvector at most once
+    for (std::size_t i= 0; i + 1 < n; i++) {
+	std::size_t k= i;
+	for (std::size_t j= i+1; j < n; j++)
+	    if (d[j] < d[k])
+		k= j;
+	if (k != i) {
+	    std::swap(d[i], d[k]);
+	    for (std::size_t r= 0; r < nz; r++)
+		std::swap(Z(r, i), Z(r, k));
+	}
+    }
+}
+
+/// Eigenvalues of the symmetric tridiagonal matrix (diagonal d, sub-diagonal e) with indices in [first, last)
+/** Bisection with Sturm sequences; the eigenvalues are counted in ascending order.
+    Each eigenvalue is computed independently (in parallel with OpenMP). **/
+template <typename Vector, typename VectorOut>
+void tridiagonal_bisection(const Vector& d, const Vector& e, std::size_t first, std::size_t last, VectorOut& lambda)
+{
+    vampir_trace<5066> tracer;
+    using std::abs;
+    typedef typename Collection<Vector>::value_type   value_type;
+    typedef typename mtl::traits::omp_size_type<std::size_t>::type size_type;
+    const std::size_t n= size(d);
+    MTL_THROW_IF(first > last || last > n, index_out_of_range());
+    const value_type  zero= math::zero(value_type()), eps= std::numeric_limits<value_type>::epsilon(),
+	              safe= std::numeric_limits<value_type>::min();
+
+    lambda.change_dim(last - first);
+    if (first == last) return;
+
+    // Gershgorin interval
+    value_type lo= d[0], hi= d[0];
+    for (std::size_t i= 0; i < n; i++) {
+	value_type r= (i > 0 ? abs(e[i-1]) : zero) + (i + 1 < n ? abs(e[i]) : zero);
+	lo= std::min(lo, value_type(d[i] - r));
+	hi= std::max(hi, value_type(d[i] + r));
+    }
+    const value_type norm= std::max(abs(lo), abs(hi)), pivmin= safe * std::max(value_type(1), norm * norm);
+    lo-= 2 * eps * norm + pivmin; hi+= 2 * eps * norm + pivmin;
+
+    const size_type nl= size_type(last - first);
+#   ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for
+#   endif
+    for (size_type k= 0; k < nl; k++) {
+	const std::size_t idx= first + k;
+	value_type a= lo, b= hi;
+	while (b - a > 2 * eps * std::max(abs(a), abs(b)) + pivmin) {
+	    const value_type x= a + (b - a) / 2;
+	    if (x == a || x == b) break;
+	    std::size_t count= 0;                       // number of eigenvalues < x
+	    value_type  q= d[0] - x;
+	    for (std::size_t i= 0; ; ) {
+		if (abs(q) < pivmin) q= -pivmin;
+		if (q < zero) ++count;
+		if (++i == n) break;
+		q= d[i] - x - e[i-1] * e[i-1] / q;
+	    }
+	    if (count > idx) b= x; else a= x;
+	}
+	lambda[k]= a + (b - a) / 2;
+    }
+}
+
+
+}} // namespace mtl::matrix
+
+#endif // MTL_MATRIX_TRIDIAGONAL_INCLUDE
@@ -0,0 +1,66 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_TRISOLVE_MULTI_RHS_INCLUDE
+#define MTL_TRISOLVE_MULTI_RHS_INCLUDE
+
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/is_static.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/operation/sub_matrix.hpp>
+
+namespace mtl { namespace mat { namespace detail {
+
+    /// Number of rows per diagonal block in the blocked triangular solves of dense matrices
+    /** The off-diagonal blocks are eliminated by a matrix product of this many rows with all right-hand sides. **/
+    const std::size_t trisolve_block_size= 64;
+
+    /// Whether triangular matrix and right-hand sides are both dense enough for the blocked solver with matrix products
+    template <typename Matrix, typename MatrixOut>
+    struct trisolve_blocked : boost::mpl::false_ {};
+
+    template <typename Value, typename Para, typename ValueOut, typename ParaOut>
+    struct trisolve_blocked<dense2D<Value, Para>, dense2D<ValueOut, ParaOut> >
+      : boost::mpl::bool_<!mtl::traits::is_static<dense2D<Value, Para> >::value
+			  && !mtl::traits::is_static<dense2D<ValueOut, ParaOut> >::value> {};
+
+    /// Copy the right-hand sides \p B into the solution \p X unless they are the same object (in-place solution)
+    template <typename MatrixIn, typename MatrixOut>
+    inline void trisolve_multi_init(const MatrixIn& B, MatrixOut& X, std::size_t n)
+    {
+	MTL_THROW_IF(num_rows(B) != n, incompatible_size());
+	if (static_cast<const void*>(&B) != static_cast<const void*>(&X))
+	    X= B;
+    }
+
+    /// Row \p r of \p X -= \p a * row \p c of \p X for all right-hand sides
+    template <typename MatrixOut, typename Size, typename Value>
+    inline void trisolve_row_update(MatrixOut& X, Size r, Size c, const Value& a)
+    {
+	for (std::size_t k= 0, nk= num_cols(X); k < nk; ++k)
+	    X(r, k)-= a * X(c, k);
+    }
+
+    /// Row \p r of \p X *= \p f for all right-hand sides
+    template <typename MatrixOut, typename Size, typename Value>
+    inline void trisolve_row_scale(MatrixOut& X, Size r, const Value& f)
+    {
+	for (std::size_t k= 0, nk= num_cols(X); k < nk; ++k)
+	    X(r, k)*= f;
+    }
+
+}}} // namespace mtl::mat::detail
+
+#endif // MTL_TRISOLVE_MULTI_RHS_INCLUDE
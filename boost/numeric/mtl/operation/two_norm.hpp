@@ -16,6 +16,7 @@
 #include <iostream>
 #include <cmath>
 
+#include <boost/utility/enable_if.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/concept/magnitude.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
@@ -23,6 +24,7 @@
 #include <boost/numeric/mtl/vector/lazy_reduction.hpp>
 #include <boost/numeric/mtl/vector/reduction.hpp>
 #include <boost/numeric/mtl/vector/reduction_functors.hpp>
+#include <boost/numeric/mtl/operation/accumulation.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 
@@ -56,6 +58,16 @@ namespace mtl {
 	    return two_norm<4>(value);
 	}
 
+	/// Two-norm of a real vector with accumulation \p policy, e.g. two_norm(v, accumulation::kahan())
+	template <typename Value, typename Policy>
+	typename boost::enable_if<accumulation::is_policy<Policy>, typename RealMagnitude<typename Collection<Value>::value_type>::type>::type
+	inline two_norm(const Value& value, Policy policy)
+	{
+	    using std::sqrt;
+	    vampir_trace<2039> tracer;
+	    return sqrt(accumulation::reduce_dot<typename RealMagnitude<typename Collection<Value>::value_type>::type>(value, value, policy));
+	}
+
 	template <typename Vector>
 	lazy_reduction<Vector, two_norm_functor> inline lazy_two_norm(const Vector& v)
 	{  return lazy_reduction<Vector, two_norm_functor>(v); 	}
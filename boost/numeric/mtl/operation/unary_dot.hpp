@@ -13,12 +13,14 @@
 #ifndef MTL_UNARY_DOT_INCLUDE
 #define MTL_UNARY_DOT_INCLUDE
 
+#include <boost/utility/enable_if.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/category.hpp>
 #include <boost/numeric/mtl/vector/lazy_reduction.hpp>
 #include <boost/numeric/mtl/vector/reduction.hpp>
 #include <boost/numeric/mtl/vector/reduction_functors.hpp>
+#include <boost/numeric/mtl/operation/accumulation.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 
@@ -58,6 +60,15 @@ namespace mtl {
 	inline unary_dot(const Value& value)
 	{   return unary_dot<8>(value);	}
 
+	/// Dot product of a real vector with itself with accumulation \p policy, e.g. unary_dot(v, accumulation::dot2())
+	template <typename Value, typename Policy>
+	typename boost::enable_if<accumulation::is_policy<Policy>, typename Collection<Value>::value_type>::type
+	inline unary_dot(const Value& value, Policy policy)
+	{
+	    vampir_trace<2041> tracer;
+	    return accumulation::reduce_dot<typename Collection<Value>::value_type>(value, value, policy);
+	}
+
 	/// Lazy unary dot product
 	/** Used for source-to-source transformations. **/
 	template <typename Vector>
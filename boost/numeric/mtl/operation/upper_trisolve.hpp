@@ -13,8 +13,11 @@
 #ifndef MTL_UPPER_TRISOLVE_INCLUDE
 #define MTL_UPPER_TRISOLVE_INCLUDE
 
+#include <algorithm>
 #include <boost/mpl/int.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_base_of.hpp>
 #include <boost/numeric/mtl/mtl_fwd.hpp>
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/utility/exception.hpp>
@@ -22,10 +25,14 @@
 #include <boost/numeric/mtl/utility/range_generator.hpp>
 #include <boost/numeric/mtl/utility/category.hpp>
 #include <boost/numeric/mtl/utility/static_assert.hpp>
+#include <boost/numeric/mtl/utility/is_what.hpp>
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/operation/resource.hpp>
+#include <boost/numeric/mtl/operation/trisolve_multi_rhs.hpp>
 #include <boost/numeric/linear_algebra/identity.hpp>
+#include <boost/numeric/linear_algebra/inverse.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
 
 
 namespace mtl { namespace mat {
@@ -70,11 +77,20 @@ namespace detail {
 			    generic_version<compressed2D<Value, Para>, D, true>
 	                   >::type {};
 
+	template <typename M, typename D, bool C, typename MatrixOut>
+	struct multi_version
+	  : boost::mpl::if_<trisolve_blocked<M, MatrixOut>,
+			    boost::mpl::int_<0>,
+			    version<M, D, C>
+	                   >::type {};
+
 	/// Solve \p w = A * \p v
+	/** \p v and \p w can also be matrices (e.g. dense2D or multi_vector) with one right-hand side per column.
+	    Then A is traversed only once for all right-hand sides and \p w and \p v may be the same object. **/
 	template <typename VectorIn, typename VectorOut>
 	void operator()(const VectorIn& v, VectorOut& w) const
 	{
-	    apply(v, w, version<Matrix, DiaTag, CompactStorage>());
+	    solve(v, w, mtl::traits::is_matrix<VectorOut>());
 	}
 
 	/// Solves the upper triangular matrix A  with the rhs v returns the solution
@@ -87,6 +103,23 @@ namespace detail {
 	}
 
     private:
+	template <typename VectorIn, typename VectorOut>
+	void solve(const VectorIn& v, VectorOut& w, boost::mpl::false_) const
+	{
+	    vampir_trace<5072> tracer;
+	    roofline<5072> roof(mtl::traits::roofline_triangle_flops(A), mtl::traits::roofline_triangle_bytes(A)
+				+ mtl::traits::roofline_vector_bytes(v) + mtl::traits::roofline_target_bytes(w, false));
+	    apply(v, w, version<Matrix, DiaTag, CompactStorage>());
+	}
+
+	template <typename MatrixIn, typename MatrixOut>
+	void solve(const MatrixIn& B, MatrixOut& X, boost::mpl::true_) const
+	{
+	    vampir_trace<5071> tracer;
+	    trisolve_multi_init(B, X, num_rows(A));
+	    multi_apply(X, multi_version<Matrix, DiaTag, CompactStorage, MatrixOut>());
+	}
+
 	// Initialization for regular and inverse diagonal is the same
 	template <typename Cursor, typename Value>
 	void row_init(size_type MTL_DEBUG_ARG(r), Cursor& aic, Cursor& MTL_DEBUG_ARG(aiend), Value& dia, tag::universe_diagonal) const
@@ -199,6 +232,101 @@ namespace detail {
 	    rr= res;
 	}
 
+	template <typename MatrixOut>
+	void multi_dia(MatrixOut& X, size_type r, const value_type& dia, tag::regular_diagonal) const
+	{   using math::reciprocal; trisolve_row_scale(X, r, reciprocal(dia));    }
+
+	template <typename MatrixOut>
+	void multi_dia(MatrixOut& X, size_type r, const value_type& dia, tag::inverse_diagonal) const
+	{   trisolve_row_scale(X, r, dia);    }
+
+	template <typename MatrixOut>
+	void multi_dia(MatrixOut&, size_type, const value_type&, tag::unit_diagonal) const {}
+
+	template <typename Cursor, typename MatrixOut, typename Tag>
+	void multi_col_init(size_type r, Cursor& MTL_DEBUG_ARG(aic), Cursor& aiend, MatrixOut& X, Tag) const
+	{
+	    MTL_DEBUG_THROW_IF(aic == aiend, missing_diagonal());
+	    --aiend;
+	    MTL_DEBUG_THROW_IF(row_a(*aiend) != r, missing_diagonal());
+	    multi_dia(X, r, value_a(*aiend), Tag());
+	}
+
+	template <typename Cursor, typename MatrixOut>
+	void multi_col_init(size_type, Cursor&, Cursor&, MatrixOut&, tag::unit_diagonal) const {}
+
+	// Multiple right-hand sides in place: dense matrix blocked, off-diagonal blocks are eliminated by matrix products
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<0>) const
+	{
+	    const size_type n= num_rows(A), nk= num_cols(X), nb= trisolve_block_size;
+	    for (size_type r1= n; r1 > 0; ) {
+		const size_type r0= r1 > nb ? r1 - nb : 0;
+		if (r1 < n) {
+		    MatrixOut Xr(sub_matrix(X, r0, r1, 0, nk));
+		    Xr-= sub_matrix(A, r0, r1, r1, n) * sub_matrix(X, r1, n, 0, nk);
+		}
+		for (size_type r= r1; r-- > r0; ) {
+		    for (size_type c= r + 1; c < r1; ++c)
+			trisolve_row_update(X, r, c, A[r][c]);
+		    multi_dia(X, r, A[r][r], DiaTag());
+		}
+		r1= r0;
+	    }
+	}
+
+	// Multiple right-hand sides in place: generic row-major
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<1>) const
+	{
+	    using namespace tag; 
+	    a_cur_type ac= begin<row>(A), aend= end<row>(A); 
+	    for (size_type r= num_rows(A) - 1; ac != aend--; --r) {
+		a_icur_type aic= CompactStorage ? begin<nz>(aend) : lower_bound<nz>(aend, r + dia_inc(DiaTag())), 
+		            aiend= end<nz>(aend);
+		value_type dia;
+		row_init(r, aic, aiend, dia, DiaTag()); 
+		for (; aic != aiend; ++aic) {
+		    MTL_DEBUG_THROW_IF(col_a(*aic) <= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, r, col_a(*aic), value_a(*aic));
+		}
+		multi_dia(X, r, dia, DiaTag());
+	    }
+	}
+
+	// Multiple right-hand sides in place: generic column-major
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<2>) const
+	{
+	    using namespace tag; 
+	    a_cur_type ac= begin<col>(A), aend= end<col>(A); 
+	    for (size_type r= num_rows(A) - 1; ac != aend--; --r) {
+		a_icur_type aic= begin<nz>(aend), 
+		            aiend= CompactStorage ? end<nz>(aend) : lower_bound<nz>(aend, r + 1 - dia_inc(DiaTag()));
+		multi_col_init(r, aic, aiend, X, DiaTag());
+		for (; aic != aiend; ++aic) {
+		    MTL_DEBUG_THROW_IF(row_a(*aic) >= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, row_a(*aic), r, value_a(*aic));
+		}
+	    }
+	}
+
+	// Multiple right-hand sides in place: compressed2D row-major compact, each row of A is read once
+	template <typename MatrixOut>
+	void multi_apply(MatrixOut& X, boost::mpl::int_<3>) const
+	{
+	    for (size_type r= num_rows(A); r-- > 0; ) {
+		size_type j0= A.ref_major()[r];
+		const size_type cj1= A.ref_major()[r+1];
+		value_type dia;
+		crs_row_init(r, j0, cj1, dia, DiaTag()); 
+		for (; j0 != cj1; ++j0) {
+		    MTL_DEBUG_THROW_IF(A.ref_minor()[j0] <= r, logic_error("Matrix entries must be sorted for this."));
+		    trisolve_row_update(X, r, A.ref_minor()[j0], A.data[j0]);
+		}
+		multi_dia(X, r, dia, DiaTag());
+	    }
+	}
 
 	const Matrix& A;
 	typename mtl::traits::const_value<Matrix>::type  value_a; 
@@ -261,7 +389,8 @@ void inline inverse_upper_trisolve(const Matrix& A, const VectorIn& v, VectorOut
 
 /// Solves the upper triangular matrix A  with the rhs v and returns the solution vector
 template <typename Matrix, typename Vector, typename DiaTag>
-Vector inline upper_trisolve(const Matrix& A, const Vector& v, DiaTag)
+typename boost::enable_if<boost::is_base_of<tag::universe_diagonal, DiaTag>, Vector>::type
+inline upper_trisolve(const Matrix& A, const Vector& v, DiaTag)
 {
     // vampir_trace<3046> tracer;
     return detail::upper_trisolve_t<Matrix, DiaTag>(A)(v);
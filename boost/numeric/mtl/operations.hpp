@@ -97,6 +97,7 @@
 #include <boost/numeric/mtl/operation/swap_row.hpp>
 #include <boost/numeric/mtl/operation/trace.hpp>
 #include <boost/numeric/mtl/operation/trans.hpp>
+#include <boost/numeric/mtl/operation/tridiagonal.hpp>
 #include <boost/numeric/mtl/operation/trigonometric.hpp>
 #include <boost/numeric/mtl/operation/unary_dot.hpp>
 #include <boost/numeric/mtl/operation/unroll.hpp>
@@ -24,6 +24,7 @@
 #include <boost/numeric/mtl/utility/range_generator.hpp>
 #include <boost/numeric/mtl/utility/range_wrapper.hpp>
 
+#include <boost/numeric/mtl/io/binary_format.hpp>
 #include <boost/numeric/mtl/io/matrix_market.hpp>
 #include <boost/numeric/mtl/io/read_el_matrix.hpp>
 #include <boost/numeric/mtl/io/test_ostream.hpp>
@@ -0,0 +1,441 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_ALLOCATION_INCLUDE
+#define MTL_ALLOCATION_INCLUDE
+
+#include <cstddef>
+#include <new>
+#include <map>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/utility/numa.hpp>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+// Minimal size of memory allocation using alignment
+#ifndef MTL_ALIGNMENT_LIMIT
+#  define MTL_ALIGNMENT_LIMIT 1024
+#endif
+
+// Alignment in memory
+#ifndef MTL_ALIGNMENT
+#  define MTL_ALIGNMENT 128
+#endif
+
+// Minimal size of memory allocation using huge pages
+#ifndef MTL_HUGE_PAGE_LIMIT
+#  define MTL_HUGE_PAGE_LIMIT (std::size_t(2) << 20)
+#endif
+
+// Size of huge pages
+#ifndef MTL_HUGE_PAGE_SIZE
+#  define MTL_HUGE_PAGE_SIZE (std::size_t(2) << 20)
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#  define MTL_THREAD_LOCAL thread_local
+#elif defined(__GNUC__)
+#  define MTL_THREAD_LOCAL __thread
+#else
+#  define MTL_THREAD_LOCAL
+#endif
+
+namespace mtl {
+
+/// Allocation policies for the memory of dense vectors, dense matrices and the arrays of compressed2D
+/** A policy is selected per type with the last template argument of vec::parameters and mat::parameters,
+    e.g. dense_vector<double, vec::parameters<col_major, non_fixed::dimension, false, std::size_t, allocation::pooled> >.
+    The default is given by the macro MTL_DEFAULT_ALLOCATION if defined, otherwise first_touch
+    with MTL_NUMA_FIRST_TOUCH, aligned with MTL_ENABLE_ALIGNMENT, and heap else.
+
+    A policy provides static functions allocate(bytes) and deallocate(p, bytes) for raw memory,
+    construct(p, n) that default-initializes n objects at p, and the constant padding
+    (in bytes, see padded). **/
+namespace allocation {
+
+    namespace detail {
+
+	template <typename Value>
+	inline void default_construct(Value* p, std::size_t n)
+	{
+	    std::size_t i= 0;
+	    try {
+		for (; i < n; i++)
+		    ::new (static_cast<void*>(p + i)) Value;
+	    } catch (...) {
+		for (; i > 0; i--)
+		    p[i-1].~Value();
+		throw;
+	    }
+	}
+    }
+
+    /// Memory from operator new, objects are default-initialized (like new Value[n])
+    struct heap
+    {
+	static const std::size_t padding= 0;
+
+	static void* allocate(std::size_t bytes) { return ::operator new(bytes); }
+	static void deallocate(void* p, std::size_t) { ::operator delete(p); }
+
+	template <typename Value>
+	static void construct(Value* p, std::size_t n) { detail::default_construct(p, n); }
+    };
+
+    /// Blocks of at least MTL_ALIGNMENT_LIMIT bytes are aligned to MTL_ALIGNMENT
+    struct aligned
+    {
+	static const std::size_t padding= 0;
+
+	static void* allocate(std::size_t bytes)
+	{
+	    if (bytes < MTL_ALIGNMENT_LIMIT)
+		return ::operator new(bytes);
+	    char *raw= static_cast<char*>(::operator new(bytes + MTL_ALIGNMENT + sizeof(void*))), *p= raw + sizeof(void*);
+	    p+= (MTL_ALIGNMENT - reinterpret_cast<std::size_t>(p) % MTL_ALIGNMENT) % MTL_ALIGNMENT;
+	    reinterpret_cast<void**>(p)[-1]= raw; // address for delete in front of the block
+	    return p;
+	}
+
+	static void deallocate(void* p, std::size_t bytes)
+	{
+	    ::operator delete(bytes < MTL_ALIGNMENT_LIMIT ? p : static_cast<void**>(p)[-1]);
+	}
+
+	template <typename Value>
+	static void construct(Value* p, std::size_t n) { detail::default_construct(p, n); }
+    };
+
+    /// Memory is not touched at allocation and value-initialized in parallel with the thread partition of the kernels
+    /** Thus the pages are placed on the NUMA nodes of the threads using them, see numa.hpp. **/
+    struct first_touch
+    {
+	static const std::size_t padding= 0;
+
+	static void* allocate(std::size_t bytes) { return numa::allocate(bytes); }
+	static void deallocate(void* p, std::size_t) { numa::deallocate(p); }
+
+	template <typename Value>
+	static void construct(Value* p, std::size_t n) { numa::construct(p, n); }
+    };
+
+    /// Scoped pool for memory of containers with policy pooled
+    /** While an arena exists, memory released by pooled containers in the same thread is kept in the arena
+	and reused for later allocations of the same size.  Thus the temporaries of solvers and expressions
+	are recycled without calls to the system allocator, e.g.:
+	\code
+	   {
+	       allocation::arena a;
+	       cg(A, x, b, P, iter); // vector type with allocation::pooled
+	   } // cached memory is released here
+	\endcode
+	Arenas are nested in the order of the scopes; each thread uses its own innermost arena.
+	Memory allocated in an arena can safely outlive it. **/
+    class arena
+    {
+	typedef std::map<std::size_t, std::vector<void*> > block_map;
+	arena(const arena&);                // not copyable
+	arena& operator=(const arena&);
+
+	static arena*& current_ref() { static MTL_THREAD_LOCAL arena* a= 0; return a; }
+
+      public:
+	/// Arena that caches at most \p max_cached bytes of released memory
+	explicit arena(std::size_t max_cached= std::size_t(1) << 30)
+	  : max_cached(max_cached), cached(0), reused(0), previous(current_ref())
+	{
+	    current_ref()= this;
+	}
+
+	~arena()
+	{
+	    release();
+	    current_ref()= previous;
+	}
+
+	/// Innermost arena of this thread (0 if none)
+	static arena* current() { return current_ref(); }
+
+	/// Size of the blocks in which \p bytes are allocated and cached
+	static std::size_t block_bytes(std::size_t bytes) { return (bytes + 63) / 64 * 64; }
+
+	/// Memory block of \p bytes, recycled if possible
+	void* allocate(std::size_t bytes)
+	{
+	    bytes= block_bytes(bytes);
+	    block_map::iterator it= blocks.find(bytes);
+	    if (it == blocks.end() || it->second.empty())
+		return ::operator new(bytes);
+	    void* p= it->second.back();
+	    it->second.pop_back();
+	    cached-= bytes;
+	    reused++;
+	    return p;
+	}
+
+	/// Keep block \p p of \p bytes for reuse (or free it when the arena is full)
+	void deallocate(void* p, std::size_t bytes)
+	{
+	    bytes= block_bytes(bytes);
+	    if (cached + bytes > max_cached) {
+		::operator delete(p);
+		return;
+	    }
+	    blocks[bytes].push_back(p);
+	    cached+= bytes;
+	}
+
+	/// Free all cached memory
+	void release()
+	{
+	    for (block_map::iterator it= blocks.begin(); it != blocks.end(); ++it)
+		for (std::size_t i= 0; i < it->second.size(); i++)
+		    ::operator delete(it->second[i]);
+	    blocks.clear();
+	    cached= 0;
+	}
+
+	/// Number of bytes currently cached
+	std::size_t cached_bytes() const { return cached; }
+
+	/// Number of allocations served from the cache
+	std::size_t reuses() const { return reused; }
+
+      private:
+	block_map   blocks;
+	std::size_t max_cached, cached, reused;
+	arena*      previous;
+    };
+
+    /// Memory from the innermost arena of the thread if there is one, otherwise from operator new
+    struct pooled
+    {
+	static const std::size_t padding= 0;
+
+	static void* allocate(std::size_t bytes)
+	{
+	    arena* a= arena::current();
+	    // Blocks allocated outside an arena may be cached in one later and must have the same rounded size
+	    return a ? a->allocate(bytes) : ::operator new(arena::block_bytes(bytes));
+	}
+
+	static void deallocate(void* p, std::size_t bytes)
+	{
+	    arena* a= arena::current();
+	    if (a)
+		a->deallocate(p, bytes);
+	    else
+		::operator delete(p);
+	}
+
+	template <typename Value>
+	static void construct(Value* p, std::size_t n) { detail::default_construct(p, n); }
+    };
+
+    /// Blocks of at least MTL_HUGE_PAGE_LIMIT bytes are placed on huge pages of MTL_HUGE_PAGE_SIZE (Linux only)
+    /** Such blocks are mapped aligned to the huge page size and advised as transparent huge pages
+	(madvise with MADV_HUGEPAGE), which reduces TLB misses in random accesses like the gathers of SpMV.
+	With MTL_EXPLICIT_HUGE_PAGES, pages from the hugetlbfs pool (MAP_HUGETLB) are tried first.
+	Smaller blocks and other systems use aligned.  Memory is not touched at allocation. **/
+    struct huge_pages
+    {
+	static const std::size_t padding= 0;
+
+	static std::size_t mapped_bytes(std::size_t bytes)
+	{
+	    return (bytes + MTL_HUGE_PAGE_SIZE - 1) / MTL_HUGE_PAGE_SIZE * MTL_HUGE_PAGE_SIZE;
+	}
+
+	static void* allocate(std::size_t bytes)
+	{
+#         if defined(__linux__) && defined(MAP_ANONYMOUS)
+	    if (bytes < MTL_HUGE_PAGE_LIMIT)
+		return aligned::allocate(bytes);
+	    const std::size_t mapped= mapped_bytes(bytes);
+#           if defined(MTL_EXPLICIT_HUGE_PAGES) && defined(MAP_HUGETLB)
+	    void* hp= mmap(0, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	    if (hp != MAP_FAILED)
+		return hp;
+#           endif
+	    // Map one huge page more and unmap the parts before and after the aligned block
+	    void* raw= mmap(0, mapped + MTL_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	    if (raw == MAP_FAILED)
+		throw std::bad_alloc();
+	    char *first= static_cast<char*>(raw), 
+		 *p= first + (MTL_HUGE_PAGE_SIZE - reinterpret_cast<std::size_t>(first) % MTL_HUGE_PAGE_SIZE) % MTL_HUGE_PAGE_SIZE;
+	    if (p != first)
+		munmap(first, p - first);
+	    munmap(p + mapped, first + MTL_HUGE_PAGE_SIZE - p); // p < first + MTL_HUGE_PAGE_SIZE
+#           ifdef MADV_HUGEPAGE
+	    madvise(p, mapped, MADV_HUGEPAGE); // only a hint
+#           endif
+	    return p;
+#         else
+	    return aligned::allocate(bytes);
+#         endif
+	}
+
+	static void deallocate(void* p, std::size_t bytes)
+	{
+#         if defined(__linux__) && defined(MAP_ANONYMOUS)
+	    if (bytes >= MTL_HUGE_PAGE_LIMIT) {
+		munmap(p, mapped_bytes(bytes));
+		return;
+	    }
+#         endif
+	    aligned::deallocate(p, bytes);
+	}
+
+	template <typename Value>
+	static void construct(Value* p, std::size_t n) { detail::default_construct(p, n); }
+    };
+
+    /// Policy \p Base where dense containers round up their memory to a multiple of \p Bytes and set the padding to zero
+    /** With a padding of at least the SIMD width, the reductions and dot products of dense vectors process
+	whole packs of the padding instead of scalar remainder loops.  The padding only applies to memory
+	owned by the container, not to views or external memory. **/
+    template <typename Base= aligned, std::size_t Bytes= 64>
+    struct padded : Base
+    {
+	static const std::size_t padding= Bytes;
+    };
+
+    /// Number of entries of type \p Value allocated for \p n entries with the padding of \p Policy
+    template <typename Policy, typename Value>
+    inline std::size_t padded_size(std::size_t n)
+    {
+	const std::size_t entries= Policy::padding / sizeof(Value);
+	return entries > 1 ? (n + entries - 1) / entries * entries : n;
+    }
+
+    /// Default policy, see above
+#if defined(MTL_DEFAULT_ALLOCATION)
+    struct default_policy : MTL_DEFAULT_ALLOCATION {};
+#elif defined(MTL_NUMA_FIRST_TOUCH)
+    struct default_policy : first_touch {};
+#elif defined(MTL_ENABLE_ALIGNMENT)
+    struct default_policy : aligned {};
+#else
+    struct default_policy : heap {};
+#endif
+
+    /// Array of \p n objects allocated with \p Policy and constructed (0 if n == 0)
+    template <typename Policy, typename Value>
+    inline Value* create(std::size_t n)
+    {
+	if (n == 0)
+	    return 0;
+	Value* p= static_cast<Value*>(Policy::allocate(n * sizeof(Value)));
+	try {
+	    Policy::construct(p, n);
+	} catch (...) {
+	    Policy::deallocate(p, n * sizeof(Value));
+	    throw;
+	}
+	return p;
+    }
+
+    /// Destroy and release array \p p of \p n objects from create
+    template <typename Policy, typename Value>
+    inline void destroy(Value* p, std::size_t n)
+    {
+	if (p == 0)
+	    return;
+	for (std::size_t i= 0; i < n; i++)
+	    p[i].~Value();
+	Policy::deallocate(p, n * sizeof(Value));
+    }
+
+    /// Allocator for std::vector with policy \p Policy whose resize does not initialize
+    /** Thus the entries of a resized vector can be first touched in parallel.
+	Requires C++11; with older standards, resize still initializes the entries. **/
+    template <typename T, typename Policy>
+    class allocator
+    {
+      public:
+	typedef T              value_type;
+	typedef T*             pointer;
+	typedef const T*       const_pointer;
+	typedef T&             reference;
+	typedef const T&       const_reference;
+	typedef std::size_t    size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <typename U> struct rebind { typedef allocator<U, Policy> other; };
+
+	allocator() {}
+	template <typename U> allocator(const allocator<U, Policy>&) {}
+
+	pointer allocate(size_type n, const void* = 0) { return static_cast<pointer>(Policy::allocate(n * sizeof(T))); }
+	void deallocate(pointer p, size_type n) { Policy::deallocate(p, n * sizeof(T)); }
+	size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+	pointer address(reference x) const { return &x; }
+	const_pointer address(const_reference x) const { return &x; }
+
+#     if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+	/// Default initialization, i.e. no memory access for trivial types
+	template <typename U>
+	void construct(U* p) { ::new (static_cast<void*>(p)) U; }
+
+	template <typename U, typename Arg, typename ...Args>
+	void construct(U* p, Arg&& arg, Args&& ...args)
+	{ ::new (static_cast<void*>(p)) U(std::forward<Arg>(arg), std::forward<Args>(args)...); }
+
+	template <typename U>
+	void destroy(U* p) { p->~U(); }
+#     else
+	void construct(pointer p, const T& x) { ::new (static_cast<void*>(p)) T(x); }
+	void destroy(pointer p) { p->~T(); }
+#     endif
+    };
+
+    template <typename T, typename U, typename Policy>
+    inline bool operator==(const allocator<T, Policy>&, const allocator<U, Policy>&) { return true; }
+    template <typename T, typename U, typename Policy>
+    inline bool operator!=(const allocator<T, Policy>&, const allocator<U, Policy>&) { return false; }
+
+    /// Type of std::vector with \p Policy; heap-based policies use std::allocator
+    template <typename T, typename Policy>
+    struct vector
+      : boost::mpl::if_<boost::is_base_of<heap, Policy>, std::vector<T>, std::vector<T, allocator<T, Policy> > >
+    {};
+
+    /// Resize \p v to \p n entries where new entries are value-initialized
+    template <typename T, typename Allocator>
+    inline void resize(std::vector<T, Allocator>& v, std::size_t n)
+    {
+	v.resize(n);
+    }
+
+    /// Resize \p v to \p n entries where new entries are value-initialized in parallel
+    template <typename T, typename Policy>
+    inline void resize(std::vector<T, allocator<T, Policy> >& v, std::size_t n)
+    {
+	const std::size_t old= v.size();
+	v.resize(n);
+	if (n > old)
+	    numa::fill(&v[0] + old, n - old, T());
+    }
+
+} // namespace allocation
+
+} // namespace mtl
+
+#endif // MTL_ALLOCATION_INCLUDE
@@ -0,0 +1,427 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_UTILITY_BENCHMARK_INCLUDE
+#define MTL_UTILITY_BENCHMARK_INCLUDE
+
+// Benchmark harness: repeated timing with warm-up and statistics, derived GFLOP/s and GB/s,
+// output as table, JSON and CSV, and comparison with a baseline from a former run.
+
+#if __cplusplus < 201103L && !(defined(_MSC_VER) && _MSC_VER >= 1900)
+#  error "The benchmark harness needs C++11."
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
+
+#include <boost/numeric/mtl/utility/exception.hpp>
+
+namespace mtl { namespace utility {
+
+/// Prevent the compiler from optimizing away the computation of \p x
+template <typename T>
+inline void benchmark_keep(const T& x)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&x) : "memory");
+#else
+    static const T* volatile sink;
+    sink= &x;
+#endif
+}
+
+/// Timing statistics of one benchmark case; times in seconds per call
+struct benchmark_result
+{
+    std::string name;
+    std::size_t samples, batch;  ///< Number of samples and calls per sample
+    double      min, p10, median, mean, p90, max;
+    double      flops, bytes;    ///< Per call, 0 if not given
+
+    double gflops() const { return median > 0.0 ? 1e-9 * flops / median : 0.0; }
+    double gbytes_per_second() const { return median > 0.0 ? 1e-9 * bytes / median : 0.0; }
+
+    /// Parameters of the case from name segments "key=value" separated by '/'
+    std::vector<std::pair<std::string, std::string> > parameters() const
+    {
+	std::vector<std::pair<std::string, std::string> > v;
+	std::istringstream is(name);
+	for (std::string segment; std::getline(is, segment, '/'); ) {
+	    const std::size_t eq= segment.find('=');
+	    if (eq != std::string::npos)
+		v.push_back(std::make_pair(segment.substr(0, eq), segment.substr(eq + 1)));
+	}
+	return v;
+    }
+};
+
+/// Benchmark harness configured by command-line arguments
+/** Options:
+    - --filter <text>: only run cases whose name contains text
+    - --samples <n>: number of timed samples (default 15)
+    - --warmup <n>: calls before timing (default 2)
+    - --min-sample-time <seconds>: calls are batched per sample up to this time (default 0.001)
+    - --threads <n1,n2,...>: thread counts for run_parallel (default: maximal number of threads)
+    - --json <file>, --csv <file>: write results
+    - --baseline <file>: compare with JSON or CSV results of a former run
+    - --tolerance <r>: median slower by more than factor 1+r is a regression (default 0.1)
+    - --list: only print the case names
+    - --quiet: no output on the console
+    - --quick: flag for the benchmark program to use small problem sizes (see quick())
+
+    Names of cases consist of segments separated by '/', where segments "key=value" are parameters
+    (e.g. "spmv/crs/double/n=1000000"). **/
+class benchmark
+{
+  public:
+    benchmark(int argc, char* argv[])
+      : samples(15), warmup(2), min_sample_time(0.001), tolerance(0.1), list_only(false), quick_mode(false), quiet(false)
+    {
+	for (int i= 1; i < argc; i++) {
+	    const std::string arg(argv[i]);
+	    const bool has_value= i + 1 < argc;
+	    if (arg == "--list")
+		list_only= true;
+	    else if (arg == "--quick")
+		quick_mode= true;
+	    else if (arg == "--quiet")
+		quiet= true;
+	    else if (arg == "--filter" && has_value)
+		filter= argv[++i];
+	    else if (arg == "--samples" && has_value)
+		samples= std::max(1, std::atoi(argv[++i]));
+	    else if (arg == "--warmup" && has_value)
+		warmup= std::max(0, std::atoi(argv[++i]));
+	    else if (arg == "--min-sample-time" && has_value)
+		min_sample_time= std::atof(argv[++i]);
+	    else if (arg == "--json" && has_value)
+		json_file= argv[++i];
+	    else if (arg == "--csv" && has_value)
+		csv_file= argv[++i];
+	    else if (arg == "--baseline" && has_value)
+		baseline_file= argv[++i];
+	    else if (arg == "--tolerance" && has_value)
+		tolerance= std::atof(argv[++i]);
+	    else if (arg == "--threads" && has_value) {
+		std::istringstream is(argv[++i]);
+		for (std::string t; std::getline(is, t, ','); )
+		    if (std::atoi(t.c_str()) > 0)
+			threads.push_back(std::atoi(t.c_str()));
+	    } else
+		MTL_THROW(logic_error(("Unknown or incomplete benchmark option " + arg).c_str()));
+	}
+	if (threads.empty())
+	    threads.push_back(max_threads());
+	if (!baseline_file.empty())
+	    read_baseline(baseline_file);
+    }
+
+    /// Whether the program should use small problem sizes
+    bool quick() const { return quick_mode; }
+
+    /// Whether case \p name is selected by the filter
+    bool selected(const std::string& name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+
+    /// Time \p f; \p flops and \p bytes are the operations and the memory traffic of one call
+    template <typename Function>
+    void run(const std::string& name, Function f, double flops= 0.0, double bytes= 0.0)
+    {
+	if (!selected(name))
+	    return;
+	if (list_only) {
+	    std::cout << name << '\n';
+	    return;
+	}
+	for (int i= 0; i < warmup; i++)
+	    f();
+
+	// Batch size such that a sample takes at least min_sample_time
+	std::size_t batch= 1;
+	for (double t= time_batch(f, batch); t < min_sample_time && batch < (std::size_t(1) << 30); t= time_batch(f, batch))
+	    batch*= t > 0.0 ? std::min<std::size_t>(std::size_t(min_sample_time / t * 1.2) + 1, 1000) : 1000;
+
+	std::vector<double> times;
+	for (int i= 0; i < samples; i++)
+	    times.push_back(time_batch(f, batch) / double(batch));
+	std::sort(times.begin(), times.end());
+
+	benchmark_result r;
+	r.name= name;
+	r.samples= times.size();
+	r.batch= batch;
+	r.min= times.front();
+	r.max= times.back();
+	r.p10= percentile(times, 0.1);
+	r.median= percentile(times, 0.5);
+	r.p90= percentile(times, 0.9);
+	r.mean= 0.0;
+	for (std::size_t i= 0; i < times.size(); i++)
+	    r.mean+= times[i] / double(times.size());
+	r.flops= flops;
+	r.bytes= bytes;
+	my_results.push_back(r);
+	print(r);
+    }
+
+    /// Run \p f with all thread counts from --threads; "/threads=n" is appended to the name
+    template <typename Function>
+    void run_parallel(const std::string& name, Function f, double flops= 0.0, double bytes= 0.0)
+    {
+	const int old_threads= max_threads();
+	for (std::size_t i= 0; i < threads.size(); i++) {
+	    set_threads(threads[i]);
+	    std::ostringstream os;
+	    os << name << "/threads=" << threads[i];
+	    run(os.str(), f, flops, bytes);
+	}
+	set_threads(old_threads);
+    }
+
+    /// Results so far
+    const std::vector<benchmark_result>& results() const { return my_results; }
+
+    /// Median of \p name in the baseline, 0 if not contained
+    double baseline_median(const std::string& name) const
+    {
+	std::map<std::string, double>::const_iterator it= baseline.find(name);
+	return it == baseline.end() ? 0.0 : it->second;
+    }
+
+    /// Whether \p r is slower than the baseline by more than the tolerance
+    bool is_regression(const benchmark_result& r) const
+    {
+	const double b= baseline_median(r.name);
+	return b > 0.0 && r.median > b * (1.0 + tolerance);
+    }
+
+    /// Write the requested files and report regressions; returns the number of regressions
+    int finish()
+    {
+	if (!json_file.empty()) {
+	    std::ofstream os(json_file.c_str());
+	    MTL_THROW_IF(!os, io_error(("Cannot create file " + json_file).c_str()));
+	    write_json(os);
+	}
+	if (!csv_file.empty()) {
+	    std::ofstream os(csv_file.c_str());
+	    MTL_THROW_IF(!os, io_error(("Cannot create file " + csv_file).c_str()));
+	    write_csv(os);
+	}
+	int regressions= 0;
+	for (std::size_t i= 0; i < my_results.size(); i++) {
+	    if (!is_regression(my_results[i]))
+		continue;
+	    if (!quiet && regressions == 0)
+		std::cout << "\nRegressions against " << baseline_file << ":\n";
+	    if (!quiet)
+		std::cout << "  " << my_results[i].name << ": " << ratio(my_results[i]) << " times the baseline time\n";
+	    regressions++;
+	}
+	return regressions;
+    }
+
+    /// Write results as JSON
+    void write_json(std::ostream& os) const
+    {
+	os << "{\"mtl_benchmark\":1,\"context\":{\"date\":\"" << date() << "\",\"compiler\":";
+	write_string(os, compiler());
+	os << ",\"max_threads\":" << max_threads() << "},\n\"results\":[";
+	for (std::size_t i= 0; i < my_results.size(); i++) {
+	    const benchmark_result& r= my_results[i];
+	    os << (i ? ",\n" : "\n") << "{\"name\":";
+	    write_string(os, r.name);
+	    os << ",\"parameters\":{";
+	    std::vector<std::pair<std::string, std::string> > p(r.parameters());
+	    for (std::size_t j= 0; j < p.size(); j++) {
+		os << (j ? "," : "");
+		write_string(os, p[j].first);
+		os << ':';
+		write_string(os, p[j].second);
+	    }
+	    os << "},\"samples\":" << r.samples << ",\"batch\":" << r.batch << ",\"min_s\":" << number(r.min)
+	       << ",\"p10_s\":" << number(r.p10) << ",\"median_s\":" << number(r.median) << ",\"mean_s\":" << number(r.mean)
+	       << ",\"p90_s\":" << number(r.p90) << ",\"max_s\":" << number(r.max) << ",\"flops\":" << number(r.flops)
+	       << ",\"bytes\":" << number(r.bytes) << ",\"gflops\":" << number(r.gflops())
+	       << ",\"gbytes_per_s\":" << number(r.gbytes_per_second()) << '}';
+	}
+	os << "\n]}\n";
+    }
+
+    /// Write results as CSV (one line per case)
+    void write_csv(std::ostream& os) const
+    {
+	os << "name,samples,batch,min_s,p10_s,median_s,mean_s,p90_s,max_s,flops,bytes,gflops,gbytes_per_s\n";
+	for (std::size_t i= 0; i < my_results.size(); i++) {
+	    const benchmark_result& r= my_results[i];
+	    os << r.name << ',' << r.samples << ',' << r.batch << ',' << number(r.min) << ',' << number(r.p10) << ','
+	       << number(r.median) << ',' << number(r.mean) << ',' << number(r.p90) << ',' << number(r.max) << ','
+	       << number(r.flops) << ',' << number(r.bytes) << ',' << number(r.gflops()) << ','
+	       << number(r.gbytes_per_second()) << '\n';
+	}
+    }
+
+    /// Maximal number of threads (1 without OpenMP)
+    static int max_threads()
+    {
+#     ifdef MTL_WITH_OPENMP
+	return omp_get_max_threads();
+#     else
+	return 1;
+#     endif
+    }
+
+  private:
+    template <typename Function>
+    static double time_batch(Function& f, std::size_t batch)
+    {
+	const std::chrono::steady_clock::time_point start= std::chrono::steady_clock::now();
+	for (std::size_t i= 0; i < batch; i++)
+	    f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static double percentile(const std::vector<double>& sorted, double p)
+    {
+	const double pos= p * double(sorted.size() - 1);
+	const std::size_t i= std::size_t(pos);
+	return i + 1 < sorted.size() ? sorted[i] + (pos - double(i)) * (sorted[i+1] - sorted[i]) : sorted[i];
+    }
+
+    static void set_threads(int t)
+    {
+#     ifdef MTL_WITH_OPENMP
+	omp_set_num_threads(t);
+#     else
+	(void)t;
+#     endif
+    }
+
+    static std::string number(double x)
+    {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%.6g", x);
+	return buffer;
+    }
+
+    static void write_string(std::ostream& os, const std::string& s)
+    {
+	os << '"';
+	for (std::size_t i= 0; i < s.size(); i++)
+	    if (s[i] == '"' || s[i] == '\\')
+		os << '\\' << s[i];
+	    else if ((unsigned char)(s[i]) >= 0x20)
+		os << s[i];
+	os << '"';
+    }
+
+    static std::string date()
+    {
+	char buffer[32];
+	const std::time_t t= std::time(0);
+	std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&t));
+	return buffer;
+    }
+
+    static std::string compiler()
+    {
+#     if defined(__VERSION__)
+	return __VERSION__;
+#     elif defined(_MSC_FULL_VER)
+	std::ostringstream os;
+	os << "MSVC " << _MSC_FULL_VER;
+	return os.str();
+#     else
+	return "unknown";
+#     endif
+    }
+
+    double ratio(const benchmark_result& r) const
+    {
+	const double b= baseline_median(r.name);
+	return b > 0.0 ? r.median / b : 0.0;
+    }
+
+    void print(const benchmark_result& r)
+    {
+	if (quiet)
+	    return;
+	if (my_results.size() == 1) {
+	    std::printf("%-52s %12s %12s %12s %9s %9s", "case", "median [ms]", "p10 [ms]", "p90 [ms]", "GFLOP/s", "GB/s");
+	    std::printf(baseline.empty() ? "\n" : " %9s\n", "baseline");
+	}
+	std::printf("%-52s %12.5g %12.5g %12.5g %9.3f %9.3f", r.name.c_str(), 1e3 * r.median, 1e3 * r.p10, 1e3 * r.p90,
+		    r.gflops(), r.gbytes_per_second());
+	if (!baseline.empty()) {
+	    if (baseline_median(r.name) > 0.0)
+		std::printf(" %8.3fx%s\n", ratio(r), is_regression(r) ? "  REGRESSION" : "");
+	    else
+		std::printf(" %9s\n", "new");
+	}
+	else
+	    std::printf("\n");
+	std::fflush(stdout);
+    }
+
+    // Medians from our JSON or CSV output
+    void read_baseline(const std::string& file_name)
+    {
+	std::ifstream is(file_name.c_str());
+	MTL_THROW_IF(!is, io_error(("Cannot open baseline " + file_name).c_str()));
+	std::string line;
+	if (file_name.size() > 4 && file_name.compare(file_name.size() - 4, 4, ".csv") == 0) {
+	    std::getline(is, line); // header
+	    while (std::getline(is, line)) {
+		std::vector<std::string> fields;
+		std::istringstream ls(line);
+		for (std::string f; std::getline(ls, f, ','); )
+		    fields.push_back(f);
+		if (fields.size() > 5)
+		    baseline[fields[0]]= std::atof(fields[5].c_str());
+	    }
+	} else
+	    while (std::getline(is, line)) {
+		const std::size_t n= line.find("{\"name\":\""), m= line.find("\"median_s\":");
+		if (n == std::string::npos || m == std::string::npos)
+		    continue;
+		std::string name;
+		for (std::size_t i= n + 9; i < line.size() && line[i] != '"'; i++)
+		    name+= line[i] == '\\' && i + 1 < line.size() ? line[++i] : line[i];
+		baseline[name]= std::atof(line.c_str() + m + 11);
+	    }
+    }
+
+    int                           samples, warmup;
+    double                        min_sample_time, tolerance;
+    bool                          list_only, quick_mode, quiet;
+    std::string                   filter, json_file, csv_file, baseline_file;
+    std::vector<int>              threads;
+    std::vector<benchmark_result> my_results;
+    std::map<std::string, double> baseline;
+};
+
+}} // namespace mtl::utility
+
+#endif // MTL_UTILITY_BENCHMARK_INCLUDE
@@ -29,11 +29,11 @@
 namespace mtl { namespace traits {
 
 /// Type trait to check whether \p T can be evaluated index-wise (usually in lazy evaluation)
+/** With OpenMP, the fused evaluation is split into contiguous index blocks per thread
+    (see fused_expr) so that all these expressions must be evaluatable in arbitrary blocks. **/
 template <typename T>
 struct index_evaluatable : boost::mpl::false_ {};
 
-#ifndef MTL_WITH_OPENMP
-
 template <typename T, typename U, typename Assign>
 struct index_evaluatable<lazy_assign<T, U, Assign> >
   : boost::mpl::or_<
@@ -43,9 +43,21 @@ struct index_evaluatable<lazy_assign<T, U, Assign> >
     >
 {};
 
+/// Matrices whose products with column vectors can be evaluated row-wise by row_mat_cvec_index_evaluator
+template <typename Matrix>
+struct row_mat_cvec_index_evaluatable : boost::mpl::false_ {};
+
+template <typename Value, typename Parameters>
+struct row_mat_cvec_index_evaluatable<mtl::mat::compressed2D<Value, Parameters> >
+  : is_row_major<Parameters> {};
+
+template <typename Value, typename Parameters>
+struct row_mat_cvec_index_evaluatable<mtl::mat::dense2D<Value, Parameters> >
+  : is_row_major<Parameters> {};
+
 template <typename V1, typename Matrix, typename V2, typename Assign>
 struct index_evaluatable<lazy_assign<V1, mtl::mat_cvec_times_expr<Matrix, V2>, Assign> >
-  : is_row_major<Matrix> {};
+  : row_mat_cvec_index_evaluatable<Matrix> {};
 
 template <typename V1, typename Matrix, typename V2, typename Assign>
 struct index_evaluatable<lazy_assign<V1, mtl::vec::mat_cvec_multiplier<Matrix, V2>, Assign> >
@@ -57,14 +69,10 @@ struct index_evaluatable<fused_expr<T, U> >
   : boost::mpl::and_<index_evaluatable<T>, index_evaluatable<U> > 
 {};
 
-#endif // not MTL_WITH_OPENMP
-
 /// Type trait to control whether evaluation should be unrolled
 template <typename T>
 struct unrolled_index_evaluatable : boost::mpl::false_ {};
 
-#ifndef MTL_WITH_OPENMP
-
 template <typename T, typename U, typename Assign>
 struct unrolled_index_evaluatable<lazy_assign<T, U, Assign> >
   : boost::mpl::or_<
@@ -79,8 +87,6 @@ struct unrolled_index_evaluatable<fused_expr<T, U> >
   : boost::mpl::and_<unrolled_index_evaluatable<T>, unrolled_index_evaluatable<U> > 
 {};
 
-#endif // not MTL_WITH_OPENMP
-
 /// Typetrait for forward evaluation
 /** All index_evaluatable types are implicitly forward-evaluatable **/
 template <typename T>
@@ -95,6 +101,7 @@ struct backward_index_evaluatable
   : index_evaluatable<T>
 {};
 
+// Triangular solutions are inherently sequential, thus not fused in parallel evaluation
 #ifndef MTL_WITH_OPENMP
 
 template <typename V1, typename Matrix, typename Value, typename V2>
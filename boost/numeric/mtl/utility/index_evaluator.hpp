@@ -35,8 +35,25 @@ struct index_evaluator<lazy_assign<T, U, Assign> >
 			  >
 {};
 
-// ... more
+template <typename Scalar, typename Vector, typename Functor, typename Assign>
+struct index_evaluator<lazy_assign<Scalar, mtl::vec::lazy_reduction<Vector, Functor>, Assign> >
+{
+    typedef mtl::vec::reduction_index_evaluator<Scalar, Vector, Functor, Assign> type;
+};
+
+template <typename Scalar, unsigned long Unroll, typename Vector1, typename Vector2, typename ConjOpt, typename Assign>
+struct index_evaluator<lazy_assign<Scalar, mtl::vec::dot_class<Unroll, Vector1, Vector2, ConjOpt>, Assign> >
+{
+    typedef mtl::vec::dot_index_evaluator<Scalar, Vector1, Vector2, ConjOpt, Assign> type;
+};
+
+template <typename VectorOut, typename Matrix, typename VectorIn, typename Assign>
+struct index_evaluator<lazy_assign<VectorOut, mtl::mat_cvec_times_expr<Matrix, VectorIn>, Assign> >
+{
+    typedef mtl::vec::row_mat_cvec_index_evaluator<VectorOut, Matrix, VectorIn, Assign> type;
+};
 
+/// Fused expressions are evaluated by nesting the evaluators so that chains of any length are evaluated in one loop
 template <typename T, typename U>
 struct index_evaluator<fused_expr<T, U> >
 {
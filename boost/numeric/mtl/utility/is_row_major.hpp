@@ -37,24 +37,24 @@ namespace mtl { namespace traits {
     struct is_row_major<col_major>
       : boost::mpl::false_ {};
 
-    template <typename Dimension, bool OnStack, typename SizeType>
-    struct is_row_major<vec::parameters<row_major, Dimension, OnStack, SizeType> >
+    template <typename Dimension, bool OnStack, typename SizeType, typename Allocator>
+    struct is_row_major<vec::parameters<row_major, Dimension, OnStack, SizeType, Allocator> >
       : boost::mpl::true_ {};
 
     template <typename T>
     struct is_row_major<const T>
       : is_row_major<T> {};
 
-    template <typename Dimension, bool OnStack, typename SizeType>
-    struct is_row_major<vec::parameters<col_major, Dimension, OnStack, SizeType> >
+    template <typename Dimension, bool OnStack, typename SizeType, typename Allocator>
+    struct is_row_major<vec::parameters<col_major, Dimension, OnStack, SizeType, Allocator> >
       : boost::mpl::false_ {};
 
-    template <typename Index, typename Dimension, bool OnStack, typename SizeType>
-    struct is_row_major<mat::parameters<row_major, Index, Dimension, OnStack, SizeType> >
+    template <typename Index, typename Dimension, bool OnStack, typename SizeType, typename Allocator, typename MinorIndex>
+    struct is_row_major<mat::parameters<row_major, Index, Dimension, OnStack, SizeType, Allocator, MinorIndex> >
       : boost::mpl::true_ {};
 
-    template <typename Index, typename Dimension, bool OnStack, typename SizeType>
-    struct is_row_major<mat::parameters<col_major, Index, Dimension, OnStack, SizeType> >
+    template <typename Index, typename Dimension, bool OnStack, typename SizeType, typename Allocator, typename MinorIndex>
+    struct is_row_major<mat::parameters<col_major, Index, Dimension, OnStack, SizeType, Allocator, MinorIndex> >
       : boost::mpl::false_ {};
 
     template <typename Value, typename Parameters>
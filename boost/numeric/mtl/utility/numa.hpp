@@ -0,0 +1,199 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_NUMA_INCLUDE
+#define MTL_NUMA_INCLUDE
+
+// With the macro MTL_NUMA_FIRST_TOUCH (or the allocation policy first_touch), the memory of dense vectors,
+// dense matrices and compressed2D is allocated without touching it and is then initialized (and thus mapped)
+// in parallel with the static thread partition of the OpenMP kernels (see thread_block.hpp).  Thus each
+// thread works on memory of its own NUMA node.  Without MTL_WITH_OPENMP, the initialization is sequential.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <boost/numeric/mtl/utility/thread_block.hpp>
+
+#if defined(_WIN32)
+#  include <malloc.h>
+#else
+#  include <unistd.h>
+#endif
+#if defined(__linux__)
+#  include <sys/syscall.h>
+#endif
+
+namespace mtl { namespace numa {
+
+    /// Placement of newly allocated memory
+    enum placement_policy {
+	first_touch,   ///< Pages are placed on the node of the thread that writes them first (default of the OS)
+	interleave,    ///< Pages are distributed round-robin over all allowed nodes
+	bind           ///< Pages are placed on one node
+    };
+
+    namespace detail {
+
+	struct placement_setting
+	{
+	    placement_policy policy;
+	    int              node;
+	};
+
+	inline placement_setting& setting()
+	{
+	    static placement_setting s= {first_touch, 0};
+	    return s;
+	}
+
+	inline std::size_t page_size()
+	{
+#         if defined(_WIN32)
+	    return 4096;
+#         else
+	    static const std::size_t size= std::size_t(sysconf(_SC_PAGESIZE));
+	    return size;
+#         endif
+	}
+
+	// Apply the explicit placement policy to the pages of [p, p+bytes) with mbind (Linux only, otherwise ignored)
+	inline void apply_placement(void* p, std::size_t bytes)
+	{
+#         if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+	    const placement_setting& s= setting();
+	    if (s.policy == first_touch || bytes < page_size())
+		return;
+	    const unsigned long   max_node= 1024, bits= 8 * sizeof(unsigned long);
+	    unsigned long         mask[max_node / bits];
+	    std::fill(mask, mask + max_node / bits, 0ul);
+	    if (s.policy == interleave) {
+		if (syscall(SYS_get_mempolicy, 0, mask, max_node, 0, 4ul /* MPOL_F_MEMS_ALLOWED */) != 0)
+		    return;
+	    } else if (s.node >= 0 && (unsigned long)(s.node) < max_node)
+		mask[s.node / bits]= 1ul << (s.node % bits);
+	    // Placement is only a hint: failures are ignored
+	    syscall(SYS_mbind, p, bytes, s.policy == interleave ? 3 /* MPOL_INTERLEAVE */ : 2 /* MPOL_BIND */,
+		    mask, max_node, 0u);
+#         else
+	    (void) p; (void) bytes;
+#         endif
+	}
+    }
+
+    /// Use \p policy for memory allocated from now on; \p node is only used for bind
+    /** Not synchronized: call it before allocating in multiple threads. **/
+    inline void set_placement(placement_policy policy, int node= 0)
+    {
+	detail::setting().policy= policy;
+	detail::setting().node= node;
+    }
+
+    /// Current placement policy
+    inline placement_policy placement() { return detail::setting().policy; }
+
+    /// Allocate \p bytes page-aligned (for large blocks) without touching them and apply the placement policy
+    inline void* allocate(std::size_t bytes)
+    {
+	if (bytes == 0)
+	    return 0;
+	const std::size_t alignment= bytes >= detail::page_size() ? detail::page_size() : 64;
+	void* p= 0;
+#     if defined(_WIN32)
+	p= _aligned_malloc(bytes, alignment);
+#     else
+	if (posix_memalign(&p, alignment, bytes) != 0)
+	    p= 0;
+#     endif
+	if (!p)
+	    throw std::bad_alloc();
+	detail::apply_placement(p, bytes);
+	return p;
+    }
+
+    /// Release memory from allocate
+    inline void deallocate(void* p)
+    {
+#     if defined(_WIN32)
+	_aligned_free(p);
+#     else
+	std::free(p);
+#     endif
+    }
+
+    /// Value-initialize [p, p+n) in parallel with the static thread partition
+    template <typename Value>
+    inline void construct(Value* p, std::size_t n)
+    {
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+	{
+	    std::size_t from, to;
+	    thread_block(n, from, to);
+	    for (std::size_t i= from; i < to; i++)
+		::new (static_cast<void*>(p + i)) Value();
+	}
+#     else
+	for (std::size_t i= 0; i < n; i++)
+	    ::new (static_cast<void*>(p + i)) Value();
+#     endif
+    }
+
+    /// Destroy [p, p+n)
+    template <typename Value>
+    inline void destroy(Value* p, std::size_t n)
+    {
+	for (std::size_t i= 0; i < n; i++)
+	    p[i].~Value();
+    }
+
+    /// Set [p, p+n) to \p value in parallel with the static thread partition
+    template <typename Value>
+    inline void fill(Value* p, std::size_t n, const Value& value)
+    {
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+	{
+	    std::size_t from, to;
+	    thread_block(n, from, to);
+	    std::fill(p + from, p + to, value);
+	}
+#     else
+	std::fill(p, p + n, value);
+#     endif
+    }
+
+    /// Copy the CRS arrays of \p nrows rows such that each thread copies (and first touches) the rows of its static block
+    template <typename Size, typename Index, typename Value>
+    inline void copy_rows(std::size_t nrows, const Size* starts, const Index* indices, const Value* data,
+			  Size* new_starts, Index* new_indices, Value* new_data)
+    {
+#     ifdef MTL_WITH_OPENMP
+#       pragma omp parallel
+#     endif
+	{
+	    std::size_t from= 0, to= nrows;
+#         ifdef MTL_WITH_OPENMP
+	    thread_block(nrows, from, to);
+#         endif
+	    for (std::size_t i= from; i < to; i++) {
+		new_starts[i]= starts[i];
+		std::copy(indices + starts[i], indices + starts[i+1], new_indices + starts[i]);
+		std::copy(data + starts[i], data + starts[i+1], new_data + starts[i]);
+	    }
+	}
+	new_starts[nrows]= starts[nrows];
+    }
+
+}} // namespace mtl::numa
+
+#endif // MTL_NUMA_INCLUDE
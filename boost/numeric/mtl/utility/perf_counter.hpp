@@ -0,0 +1,408 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_PERF_COUNTER_INCLUDE
+#define MTL_PERF_COUNTER_INCLUDE
+
+// Hardware and software event counters with Linux' perf_event_open, same interface as papi_t.
+// Enabled on Linux unless MTL_NO_PERF_EVENT is defined.
+
+#if defined(__linux__) && !defined(MTL_NO_PERF_EVENT)
+#  define MTL_HAS_PERF_EVENT
+#endif
+
+#include <string>
+#include <vector>
+#include <boost/numeric/mtl/utility/exception.hpp>
+
+#ifdef MTL_HAS_PERF_EVENT
+#  include <cstring>
+#  include <cstdlib>
+#  include <fstream>
+#  include <sstream>
+#  include <dirent.h>
+#  include <unistd.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <linux/perf_event.h>
+#endif
+
+namespace mtl { namespace utility {
+
+/// Exception for errors with perf events, is sub-divided further
+struct perf_error : public runtime_error
+{
+    explicit perf_error(const char *s= "perf event error") : runtime_error(s) {}
+};
+
+struct perf_unknown_event_error : public perf_error
+{
+    explicit perf_unknown_event_error(const char *s= "perf event: unknown event name") : perf_error(s) {}
+};
+
+struct perf_add_event_error : public perf_error
+{
+    explicit perf_add_event_error(const char *s= "perf event: event not supported or not permitted") : perf_error(s) {}
+};
+
+struct perf_start_error : public perf_error
+{
+    explicit perf_start_error(const char *s= "perf event: start error") : perf_error(s) {}
+};
+
+struct perf_read_error : public perf_error
+{
+    explicit perf_read_error(const char *s= "perf event: read error") : perf_error(s) {}
+};
+
+struct perf_index_range_error : public perf_error
+{
+    explicit perf_index_range_error(const char *s= "perf event: index range error") : perf_error(s) {}
+};
+
+
+#ifdef MTL_HAS_PERF_EVENT
+
+/// Event counters of the calling thread with perf_event_open
+/** The events are counted for the thread that adds them (memory-read-bytes and memory-write-bytes
+    are measured for the entire system by the memory controllers).
+    Supported event names (the PAPI names in parentheses are accepted as well):
+    - cycles (PAPI_TOT_CYC), ref-cycles (PAPI_REF_CYC), instructions (PAPI_TOT_INS),
+    - cache-references, cache-misses/LLC-misses (PAPI_L3_TCM), LLC-loads, LLC-load-misses, LLC-store-misses,
+    - L1-dcache-loads, L1-dcache-load-misses (PAPI_L1_DCM),
+    - branch-instructions (PAPI_BR_INS), branch-misses (PAPI_BR_MSP),
+    - task-clock (nanoseconds), cpu-clock, page-faults, context-switches, cpu-migrations,
+    - memory-read-bytes and memory-write-bytes (Intel uncore memory controllers).
+
+    Hardware events are not available in most virtual machines, and user permissions depend
+    on /proc/sys/kernel/perf_event_paranoid (system-wide memory events usually need it at most 0).
+    Multiplexed events are scaled to the full measurement time.
+**/
+class perf_counter_t
+{
+    perf_counter_t(const perf_counter_t&);
+    perf_counter_t& operator=(const perf_counter_t&);
+
+    struct event_code
+    {
+	unsigned      type;
+	unsigned long config;
+    };
+
+    struct event_t
+    {
+	std::string      name;
+	std::vector<int> fds;      // only for system-wide events, thread events are in the group
+	int              position; // in the group
+	double           scale;
+    };
+
+  public:
+    const static bool true_perf = true;
+
+    perf_counter_t() : leader(-1), grouped(0) {}
+
+    ~perf_counter_t()
+    {
+	for (std::size_t i= 0; i < events.size(); i++)
+	    for (std::size_t j= 0; j < events[i].fds.size(); j++)
+		close(events[i].fds[j]);
+	for (std::size_t i= 0; i < group_fds.size(); i++)
+	    close(group_fds[i]);
+    }
+
+    /// Add event \p name; returns its index
+    int add_event(const char* name)
+    {
+	event_t e;
+	e.name= name;
+	e.position= -1;
+	e.scale= 1.0;
+	event_code code;
+	if (thread_event(name, code)) {
+	    const int fd= open_event(code, 0, -1, leader, false);
+	    MTL_THROW_IF(fd < 0, perf_add_event_error());
+	    if (leader < 0)
+		leader= fd;
+	    group_fds.push_back(fd);
+	    e.position= grouped++;
+	} else {
+	    MTL_THROW_IF(!memory_event(name, e), perf_unknown_event_error());
+	    MTL_THROW_IF(e.fds.empty(), perf_add_event_error());
+	}
+	events.push_back(e);
+	values.push_back(0);
+	return int(events.size()) - 1;
+    }
+
+    /// Whether event \p name can be counted on this machine with the user's permissions
+    bool is_event_supported(const char* name) const
+    {
+	event_code code;
+	if (thread_event(name, code)) {
+	    const int fd= open_event(code, 0, -1, -1, false);
+	    if (fd >= 0)
+		close(fd);
+	    return fd >= 0;
+	}
+	event_t e;
+	const bool supported= memory_event(name, e) && !e.fds.empty();
+	for (std::size_t j= 0; j < e.fds.size(); j++)
+	    close(e.fds[j]);
+	return supported;
+    }
+
+    /// Start counting (from zero)
+    void start()
+    {
+	reset();
+	bool ok= leader < 0 || ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0;
+	for (std::size_t i= 0; i < events.size(); i++)
+	    for (std::size_t j= 0; j < events[i].fds.size(); j++)
+		ok= ok && ioctl(events[i].fds[j], PERF_EVENT_IOC_ENABLE, 0) == 0;
+	MTL_THROW_IF(!ok, perf_start_error());
+    }
+
+    /// Stop counting; read() still returns the counts until the stop
+    void stop()
+    {
+	if (leader >= 0)
+	    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	for (std::size_t i= 0; i < events.size(); i++)
+	    for (std::size_t j= 0; j < events[i].fds.size(); j++)
+		ioctl(events[i].fds[j], PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    /// Set counters to zero
+    void reset()
+    {
+	if (leader >= 0)
+	    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	for (std::size_t i= 0; i < events.size(); i++)
+	    for (std::size_t j= 0; j < events[i].fds.size(); j++)
+		ioctl(events[i].fds[j], PERF_EVENT_IOC_RESET, 0);
+    }
+
+    /// Read the counters, accessible afterwards with operator[]
+    void read() { MTL_THROW_IF(!try_read(), perf_read_error()); }
+
+    /// Read the counters without throwing; returns false on errors
+    bool try_read()
+    {
+	if (leader >= 0) {
+	    // Group format: number of events, time enabled, time running, values
+	    std::vector<unsigned long long> buffer(3 + grouped);
+	    const std::size_t bytes= buffer.size() * sizeof(unsigned long long);
+	    if (::read(leader, &buffer[0], bytes) != ssize_t(bytes))
+		return false;
+	    for (std::size_t i= 0; i < events.size(); i++)
+		if (events[i].position >= 0)
+		    values[i]= scaled(buffer[3 + events[i].position], buffer[1], buffer[2], 1.0);
+	}
+	for (std::size_t i= 0; i < events.size(); i++)
+	    if (events[i].position < 0) {
+		values[i]= 0;
+		for (std::size_t j= 0; j < events[i].fds.size(); j++) {
+		    unsigned long long buffer[3]; // value, time enabled, time running
+		    if (::read(events[i].fds[j], buffer, sizeof(buffer)) != ssize_t(sizeof(buffer)))
+			return false;
+		    values[i]+= scaled(buffer[0], buffer[1], buffer[2], events[i].scale);
+		}
+	    }
+	return true;
+    }
+
+    /// Value of event \p index from the last read()
+    long long operator[](int index) const
+    {
+	MTL_THROW_IF(index < 0 || index >= int(values.size()), perf_index_range_error());
+	return values[index];
+    }
+
+    /// Number of added events
+    int num_events() const { return int(events.size()); }
+
+    /// Name of event \p index
+    const std::string& event_name(int index) const
+    {
+	MTL_THROW_IF(index < 0 || index >= int(events.size()), perf_index_range_error());
+	return events[index].name;
+    }
+
+  private:
+    static long long scaled(unsigned long long value, unsigned long long enabled, unsigned long long running, double scale)
+    {
+	if (running > 0 && running < enabled)
+	    scale*= double(enabled) / double(running);
+	return scale == 1.0 ? (long long)(value) : (long long)(double(value) * scale + 0.5);
+    }
+
+    static int open_event(const event_code& code, int pid, int cpu, int group, bool system_wide)
+    {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size= sizeof(attr);
+	attr.type= code.type;
+	attr.config= code.config;
+	attr.disabled= group < 0;
+	attr.read_format= PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING | (system_wide ? 0 : PERF_FORMAT_GROUP);
+	if (!system_wide) {
+	    attr.exclude_kernel= 1;
+	    attr.exclude_hv= 1;
+	}
+	return int(syscall(__NR_perf_event_open, &attr, pid, cpu, group, 0));
+    }
+
+    static bool thread_event(const std::string& name, event_code& code)
+    {
+	const unsigned hw= PERF_TYPE_HARDWARE, sw= PERF_TYPE_SOFTWARE, cache= PERF_TYPE_HW_CACHE;
+	const unsigned long read= PERF_COUNT_HW_CACHE_OP_READ << 8, write= PERF_COUNT_HW_CACHE_OP_WRITE << 8,
+	                    access= PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16, miss= PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+	static const struct { const char *name, *papi; unsigned type; unsigned long config; } table[]= {
+	    {"cycles",                "PAPI_TOT_CYC", hw,    PERF_COUNT_HW_CPU_CYCLES},
+	    {"ref-cycles",            "PAPI_REF_CYC", hw,    PERF_COUNT_HW_REF_CPU_CYCLES},
+	    {"instructions",          "PAPI_TOT_INS", hw,    PERF_COUNT_HW_INSTRUCTIONS},
+	    {"cache-references",      "",             hw,    PERF_COUNT_HW_CACHE_REFERENCES},
+	    {"cache-misses",          "PAPI_L3_TCM",  hw,    PERF_COUNT_HW_CACHE_MISSES},
+	    {"LLC-misses",            "",             hw,    PERF_COUNT_HW_CACHE_MISSES},
+	    {"LLC-loads",             "",             cache, PERF_COUNT_HW_CACHE_LL | read | access},
+	    {"LLC-load-misses",       "",             cache, PERF_COUNT_HW_CACHE_LL | read | miss},
+	    {"LLC-store-misses",      "",             cache, PERF_COUNT_HW_CACHE_LL | write | miss},
+	    {"L1-dcache-loads",       "",             cache, PERF_COUNT_HW_CACHE_L1D | read | access},
+	    {"L1-dcache-load-misses", "PAPI_L1_DCM",  cache, PERF_COUNT_HW_CACHE_L1D | read | miss},
+	    {"branch-instructions",   "PAPI_BR_INS",  hw,    PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+	    {"branch-misses",         "PAPI_BR_MSP",  hw,    PERF_COUNT_HW_BRANCH_MISSES},
+	    {"task-clock",            "",             sw,    PERF_COUNT_SW_TASK_CLOCK},
+	    {"cpu-clock",             "",             sw,    PERF_COUNT_SW_CPU_CLOCK},
+	    {"page-faults",           "",             sw,    PERF_COUNT_SW_PAGE_FAULTS},
+	    {"context-switches",      "",             sw,    PERF_COUNT_SW_CONTEXT_SWITCHES},
+	    {"cpu-migrations",        "",             sw,    PERF_COUNT_SW_CPU_MIGRATIONS}};
+	for (std::size_t i= 0; i < sizeof(table) / sizeof(table[0]); i++)
+	    if (name == table[i].name || name == table[i].papi) {
+		code.type= table[i].type;
+		code.config= table[i].config;
+		return true;
+	    }
+	return false;
+    }
+
+    static std::string read_sysfs(const std::string& file)
+    {
+	std::ifstream is(file.c_str());
+	std::string s;
+	std::getline(is, s);
+	return s;
+    }
+
+    // Set the bits of "event=0x04,umask=0x03" in config according to format files like "config:8-15"
+    static bool parse_sysfs_event(const std::string& device, const std::string& spec, unsigned long& config)
+    {
+	config= 0;
+	std::istringstream terms(spec);
+	for (std::string term; std::getline(terms, term, ','); ) {
+	    const std::size_t eq= term.find('=');
+	    const std::string key(term.substr(0, eq)), format(read_sysfs(device + "/format/" + key));
+	    const unsigned long value= eq == std::string::npos ? 1 : std::strtoul(term.c_str() + eq + 1, 0, 0);
+	    if (format.compare(0, 7, "config:") != 0)
+		return false;
+	    const unsigned first= unsigned(std::strtoul(format.c_str() + 7, 0, 10));
+	    config|= value << first;
+	}
+	return true;
+    }
+
+    // System-wide events of all memory controllers and sockets
+    static bool memory_event(const std::string& name, event_t& e)
+    {
+	const char* event= name == "memory-read-bytes" ? "cas_count_read" : name == "memory-write-bytes" ? "cas_count_write" : 0;
+	if (!event)
+	    return false;
+	const std::string root("/sys/bus/event_source/devices/");
+	if (DIR* dir= opendir(root.c_str())) {
+	    while (dirent* entry= readdir(dir)) {
+		const std::string device(root + entry->d_name);
+		event_code code;
+		if (std::strncmp(entry->d_name, "uncore_imc", 10) != 0
+		    || !parse_sysfs_event(device, read_sysfs(device + "/events/" + event), code.config))
+		    continue;
+		code.type= unsigned(std::strtoul(read_sysfs(device + "/type").c_str(), 0, 10));
+		const double scale= std::strtod(read_sysfs(device + "/events/" + event + ".scale").c_str(), 0);
+		if (scale > 0.0)
+		    e.scale= read_sysfs(device + "/events/" + event + ".unit") == "MiB" ? scale * 1048576.0 : scale;
+		std::istringstream cpus(read_sysfs(device + "/cpumask"));
+		for (std::string cpu; std::getline(cpus, cpu, ','); ) { // one CPU per socket
+		    const int fd= open_event(code, -1, std::atoi(cpu.c_str()), -1, true);
+		    if (fd >= 0)
+			e.fds.push_back(fd);
+		}
+	    }
+	    closedir(dir);
+	}
+	return true;
+    }
+
+    int                    leader, grouped;
+    std::vector<int>       group_fds;
+    std::vector<event_t>   events;
+    std::vector<long long> values;
+};
+
+#else // no perf events
+
+// Faked counter type:
+
+struct perf_counter_t
+{
+    const static bool true_perf = false;
+    int add_event(const char*) { return 0; }
+    bool is_event_supported(const char*) const { return false; }
+    void start() {}
+    void stop() {}
+    void reset() {}
+    void read() {}
+    bool try_read() { return true; }
+    long long operator[](int) const { return 0; }
+    int num_events() const { return 0; }
+    std::string event_name(int) const { return std::string(); }
+};
+
+#endif
+
+/// Adds the increments of all events of a started counter during the lifetime of the object to \p sums
+class perf_scope
+{
+  public:
+    perf_scope(perf_counter_t& counter, std::vector<long long>& sums) : counter(counter), sums(sums)
+    {
+	counter.read();
+	for (int i= 0; i < counter.num_events(); i++)
+	    begin.push_back(counter[i]);
+    }
+
+    ~perf_scope()
+    {
+	counter.read();
+	if (sums.size() < begin.size())
+	    sums.resize(begin.size());
+	for (std::size_t i= 0; i < begin.size(); i++)
+	    sums[i]+= counter[int(i)] - begin[i];
+    }
+
+  private:
+    perf_counter_t&         counter;
+    std::vector<long long>& sums;
+    std::vector<long long>  begin;
+};
+
+}} // namespace mtl::utility
+
+#endif // MTL_PERF_COUNTER_INCLUDE
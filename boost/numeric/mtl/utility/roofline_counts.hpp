@@ -0,0 +1,189 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_TRAITS_ROOFLINE_COUNTS_INCLUDE
+#define MTL_TRAITS_ROOFLINE_COUNTS_INCLUDE
+
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+
+namespace mtl { 
+
+namespace mat {
+
+    // Here num_rows and num_cols are found for all matrices, in mtl::traits they are class templates
+    template <typename Matrix>
+    inline double roofline_num_rows(const Matrix& A) { return double(num_rows(A)); }
+
+    template <typename Matrix>
+    inline double roofline_num_cols(const Matrix& A) { return double(num_cols(A)); }
+}
+
+namespace traits {
+
+/// Number of vectors read and operations per entry in the evaluation of vector expression \p E (for the roofline instrumentation)
+/** Vectors and unknown expressions count as one vector without operations. **/
+template <typename E>
+struct roofline_vector
+{
+    static const int vectors= 1, operations= 0;
+};
+
+template <typename Functor, typename Vector>
+struct roofline_vector<vec::map_view<Functor, Vector> >
+{
+    static const int vectors= roofline_vector<Vector>::vectors, operations= roofline_vector<Vector>::operations + 1;
+};
+
+template <typename Scaling, typename Vector>
+struct roofline_vector<vec::scaled_view<Scaling, Vector> >
+  : roofline_vector<typename vec::scaled_view<Scaling, Vector>::base> {};
+
+template <typename Vector, typename RScaling>
+struct roofline_vector<vec::rscaled_view<Vector, RScaling> >
+  : roofline_vector<typename vec::rscaled_view<Vector, RScaling>::base> {};
+
+template <typename E1, typename E2, typename SFunctor>
+struct roofline_vector<vec::vec_vec_op_expr<E1, E2, SFunctor> >
+{
+    static const int vectors= roofline_vector<E1>::vectors + roofline_vector<E2>::vectors,
+	             operations= roofline_vector<E1>::operations + roofline_vector<E2>::operations + 1;
+};
+
+template <typename E1, typename E2, typename SFunctor>
+struct roofline_vector<vec::vec_vec_pmop_expr<E1, E2, SFunctor> >
+  : roofline_vector<vec::vec_vec_op_expr<E1, E2, SFunctor> > {};
+
+
+/// Whether the assign functor \p SFunctor reads the target, i.e. all but plain assignment
+template <typename SFunctor>
+struct roofline_update : boost::mpl::true_ {};
+
+template <typename Value1, typename Value2>
+struct roofline_update<sfunctor::assign<Value1, Value2> > : boost::mpl::false_ {};
+
+
+/// Bytes read by evaluating vector expression \p v with entries of \p value_size bytes
+/** For expressions whose value type cannot be deduced, e.g. products with matrix-free operators. **/
+template <typename Vector>
+inline double roofline_vector_bytes(const Vector& v, std::size_t value_size)
+{
+    return double(mtl::size(v)) * roofline_vector<Vector>::vectors * value_size;
+}
+
+/// Bytes read by evaluating vector expression \p v
+template <typename Vector>
+inline double roofline_vector_bytes(const Vector& v)
+{
+    return roofline_vector_bytes(v, sizeof(typename Collection<Vector>::value_type));
+}
+
+/// Floating point operations in evaluating vector expression \p v
+template <typename Vector>
+inline double roofline_vector_flops(const Vector& v)
+{
+    return double(mtl::size(v)) * roofline_vector<Vector>::operations;
+}
+
+/// Bytes of target vector \p w: written and additionally read if \p update
+template <typename Vector>
+inline double roofline_target_bytes(const Vector& w, bool update)
+{
+    return double(mtl::size(w)) * (update ? 2 : 1) * sizeof(typename Collection<Vector>::value_type);
+}
+
+
+/// Stored entries of matrix \p A that are used in computations (for the roofline instrumentation)
+template <typename Matrix>
+inline double roofline_entries(const Matrix& A)
+{
+    return mtl::mat::roofline_num_rows(A) * mtl::mat::roofline_num_cols(A);
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_entries(const mat::compressed2D<Value, Parameters>& A)
+{
+    return double(A.nnz());
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_entries(const mat::ell_matrix<Value, Parameters>& A)
+{
+    return double(A.slots()) * double(A.dim1());
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_entries(const mat::sparse_banded<Value, Parameters>& A)
+{
+    return double(A.nnz());
+}
+
+/// Bytes of the matrix \p A read by a complete traversal: values, indices and row starts
+template <typename Matrix>
+inline double roofline_matrix_bytes(const Matrix& A)
+{
+    return roofline_entries(A) * sizeof(typename Collection<Matrix>::value_type);
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_matrix_bytes(const mat::compressed2D<Value, Parameters>& A)
+{
+    return roofline_entries(A) * (sizeof(Value) + sizeof(typename Parameters::minor_index_type))
+	   + (double(A.dim1()) + 1) * sizeof(typename Parameters::size_type);
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_matrix_bytes(const mat::ell_matrix<Value, Parameters>& A)
+{
+    return roofline_entries(A) * (sizeof(Value) + sizeof(typename Parameters::size_type));
+}
+
+/// Bytes moved by the sparse matrix vector product w= A * v (or w+= A * v if \p update), each vector moved once
+template <typename Matrix, typename VectorIn, typename VectorOut>
+inline double roofline_mat_vec_bytes(const Matrix& A, const VectorIn& v, const VectorOut& w, bool update)
+{
+    return roofline_matrix_bytes(A) + roofline_vector_bytes(v) + roofline_target_bytes(w, update);
+}
+
+/// Bytes of the triangle of \p A read by a triangular solver (entire sparse matrix)
+template <typename Matrix>
+inline double roofline_triangle_bytes(const Matrix& A)
+{
+    return 0.5 * (roofline_matrix_bytes(A) + mtl::mat::roofline_num_rows(A) * sizeof(typename Collection<Matrix>::value_type));
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_triangle_bytes(const mat::compressed2D<Value, Parameters>& A)
+{
+    return roofline_matrix_bytes(A);
+}
+
+/// Floating point operations of a triangular solver with \p A
+template <typename Matrix>
+inline double roofline_triangle_flops(const Matrix& A)
+{
+    return mtl::mat::roofline_num_rows(A) * mtl::mat::roofline_num_rows(A);
+}
+
+template <typename Value, typename Parameters>
+inline double roofline_triangle_flops(const mat::compressed2D<Value, Parameters>& A)
+{
+    return 2.0 * roofline_entries(A);
+}
+
+} // namespace traits
+
+} // namespace mtl
+
+#endif // MTL_TRAITS_ROOFLINE_COUNTS_INCLUDE
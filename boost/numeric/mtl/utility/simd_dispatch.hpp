@@ -0,0 +1,122 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_SIMD_DISPATCH_INCLUDE
+#define MTL_SIMD_DISPATCH_INCLUDE
+
+#include <cstdlib>
+#include <string>
+#include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/string_to_enum.hpp>
+#include <boost/numeric/mtl/utility/simd_pack.hpp>
+
+namespace mtl { namespace simd {
+
+    /// Identifiers of the instruction sets, x86 sets in ascending order
+    enum isa_id { isa_scalar, isa_sse2, isa_avx2, isa_avx512, isa_neon };
+
+    namespace detail {
+	const char* const isa_names[]= {"scalar", "sse2", "avx2", "avx512", "neon"};
+    }
+
+    /// Identifier of instruction set tag \p Isa
+    template <typename Isa> struct isa_of {};
+    template <> struct isa_of<scalar> { static const isa_id value= isa_scalar; };
+    template <> struct isa_of<sse2>   { static const isa_id value= isa_sse2; };
+    template <> struct isa_of<avx2>   { static const isa_id value= isa_avx2; };
+    template <> struct isa_of<avx512> { static const isa_id value= isa_avx512; };
+    template <> struct isa_of<neon>   { static const isa_id value= isa_neon; };
+
+    /// Instruction set the library is compiled for
+    inline isa_id native_isa() { return isa_of<native>::value; }
+
+    /// Name of instruction set \p isa as used in select_isa and the environment variable MTL_SIMD_ISA
+    inline const char* isa_name(isa_id isa)
+    {
+	return detail::isa_names[isa];
+    }
+
+    /// Instruction set with name \p name; throws runtime_error for unknown names
+    inline isa_id isa_from_name(const std::string& name)
+    {
+	return string_to_enum(name, detail::isa_names, isa_id());
+    }
+
+    /// Whether kernels for \p isa are compiled in and the processor can execute them
+    /** Without run-time dispatch (see MTL_SIMD_DISPATCH in simd_pack.hpp) only the native instruction set is available. **/
+    inline bool isa_available(isa_id isa)
+    {
+	if (isa == native_isa())
+	    return true;
+#     ifdef MTL_SIMD_DISPATCH
+	__builtin_cpu_init();
+#       ifdef MTL_SIMD_DISPATCH_AVX2
+	if (isa == isa_avx2)
+	    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#       endif
+#       ifdef MTL_SIMD_DISPATCH_AVX512
+	if (isa == isa_avx512)
+	    return __builtin_cpu_supports("avx512f");
+#       endif
+#     endif
+	return false;
+    }
+
+    /// Widest available instruction set on this processor
+    inline isa_id detected_isa()
+    {
+	if (native_isa() < isa_avx512 && isa_available(isa_avx512))
+	    return isa_avx512;
+	if (native_isa() < isa_avx2 && isa_available(isa_avx2))
+	    return isa_avx2;
+	return native_isa();
+    }
+
+    namespace detail {
+	// Instruction set named by the environment variable MTL_SIMD_ISA if available, otherwise the detected one
+	inline isa_id initial_isa()
+	{
+	    const char* env= std::getenv("MTL_SIMD_ISA");
+	    if (env)
+		for (std::size_t i= 0; i < sizeof(isa_names) / sizeof(isa_names[0]); i++)
+		    if (std::string(env) == isa_names[i] && isa_available(isa_id(i)))
+			return isa_id(i);
+	    return detected_isa();
+	}
+
+	inline isa_id& selected_isa_ref()
+	{
+	    static isa_id isa= initial_isa();
+	    return isa;
+	}
+    }
+
+    /// Instruction set used by the dispatched kernels
+    /** Determined once at first use from the processor's capabilities (cpuid) unless
+	the environment variable MTL_SIMD_ISA names another available instruction set
+	or it is overridden with select_isa. **/
+    inline isa_id selected_isa() { return detail::selected_isa_ref(); }
+
+    /// Use the kernels of instruction set \p isa from now on; throws runtime_error if it is not available
+    /** Not synchronized: call it before running MTL operations in multiple threads. **/
+    inline void select_isa(isa_id isa)
+    {
+	MTL_THROW_IF(!isa_available(isa), runtime_error("Instruction set not available on this processor or not compiled in"));
+	detail::selected_isa_ref()= isa;
+    }
+
+    /// Use the kernels of the instruction set named \p name from now on
+    inline void select_isa(const std::string& name) { select_isa(isa_from_name(name)); }
+
+}} // namespace mtl::simd
+
+#endif // MTL_SIMD_DISPATCH_INCLUDE
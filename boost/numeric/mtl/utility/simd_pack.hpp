@@ -0,0 +1,315 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_SIMD_PACK_INCLUDE
+#define MTL_SIMD_PACK_INCLUDE
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <boost/mpl/bool.hpp>
+
+// With GCC on x86, packs and kernels for AVX2 and AVX-512 are additionally compiled for target-specific
+// code regions and selected at run time (see simd_dispatch.hpp) unless MTL_WITHOUT_SIMD_DISPATCH is defined
+#if !defined(MTL_WITHOUT_SIMD) && !defined(MTL_WITHOUT_SIMD_DISPATCH) && (defined(__x86_64__) || defined(__i386__)) \
+    && defined(__GNUC__) && __GNUC__ >= 5 && !defined(__clang__) && !defined(__INTEL_COMPILER)
+#  define MTL_SIMD_DISPATCH
+#  if !defined(__AVX2__) || !defined(__FMA__)
+#    define MTL_SIMD_DISPATCH_AVX2
+#  endif
+#  if !defined(__AVX512F__)
+#    define MTL_SIMD_DISPATCH_AVX512
+#  endif
+#endif
+
+#ifndef MTL_WITHOUT_SIMD
+#  if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__) || defined(MTL_SIMD_DISPATCH)
+#    include <immintrin.h>
+#  endif
+#  if defined(__ARM_NEON) && defined(__aarch64__)
+#    include <arm_neon.h>
+#  endif
+#endif
+
+namespace mtl {
+
+/// Portable packs of floating point values that are processed by a single SIMD instruction
+/** The native instruction set is selected at compile time (-mavx2, -march=native, ...);
+    without SIMD support or with MTL_WITHOUT_SIMD defined, packs hold one value.
+    Packs of wider instruction sets can exist in addition for kernels dispatched at run time. **/
+namespace simd {
+
+    /// Instruction set without vector operations
+    struct scalar { static const char* name() { return "scalar"; } };
+    /// 128 bit vector operations on x86
+    struct sse2 { static const char* name() { return "sse2"; } };
+    /// 256 bit vector operations on x86 with fused multiply-add
+    struct avx2 { static const char* name() { return "avx2"; } };
+    /// 512 bit vector operations on x86
+    struct avx512 { static const char* name() { return "avx512"; } };
+    /// 128 bit vector operations on 64 bit ARM
+    struct neon { static const char* name() { return "neon"; } };
+
+#if defined(MTL_WITHOUT_SIMD)
+    typedef scalar native;
+#elif defined(__AVX512F__)
+    typedef avx512 native;
+#elif defined(__AVX2__) && defined(__FMA__)
+    typedef avx2   native;
+#elif defined(__SSE2__)
+    typedef sse2   native;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    typedef neon   native;
+#else
+    typedef scalar native;
+#endif
+
+    /// Number of entries in a pack, defined out of class so that size can be bound to references
+    template <std::size_t Size>
+    struct pack_size
+    {
+	static const std::size_t        size= Size;
+    };
+
+    template <std::size_t Size>
+    const std::size_t pack_size<Size>::size;
+
+    /// Pack of Value with the instruction set Isa; the general case contains a single value
+    template <typename Value, typename Isa= native>
+    struct pack
+      : pack_size<1>
+    {
+	typedef Value                   value_type;
+
+	pack() {}
+	explicit pack(const Value& x) : v(x) {}  ///< Broadcast \p x
+
+	static pack load(const Value* p) { return pack(*p); }
+	void store(Value* p) const { *p= v; }
+
+	pack operator+(const pack& y) const { return pack(v + y.v); }
+	pack operator-(const pack& y) const { return pack(v - y.v); }
+	pack operator*(const pack& y) const { return pack(v * y.v); }
+	pack operator/(const pack& y) const { return pack(v / y.v); }
+
+	Value v;
+    };
+
+    /// Whether packs of Value with instruction set Isa contain more than one entry
+    template <typename Value, typename Isa= native>
+    struct is_vectorized
+      : boost::mpl::bool_<(pack<Value, Isa>::size > 1)>
+    {};
+
+    /// Element-wise absolute value
+    template <typename Value, typename Isa>
+    inline pack<Value, Isa> abs(const pack<Value, Isa>& x)
+    {
+	using std::abs;
+	return pack<Value, Isa>(abs(x.v));
+    }
+
+    /// Element-wise maximum
+    template <typename Value, typename Isa>
+    inline pack<Value, Isa> max(const pack<Value, Isa>& x, const pack<Value, Isa>& y)
+    {
+	return pack<Value, Isa>(std::max(x.v, y.v));
+    }
+
+    /// Element-wise x * y + z, fused where the instruction set allows
+    template <typename Value, typename Isa>
+    inline pack<Value, Isa> fma(const pack<Value, Isa>& x, const pack<Value, Isa>& y, const pack<Value, Isa>& z)
+    {
+	return x * y + z;
+    }
+
+    /// Sum of the entries
+    template <typename Value, typename Isa>
+    inline Value reduce_add(const pack<Value, Isa>& x)
+    {
+	Value buffer[pack<Value, Isa>::size];
+	x.store(buffer);
+	Value s= buffer[0];
+	for (std::size_t k= 1; k < pack<Value, Isa>::size; k++)
+	    s+= buffer[k];
+	return s;
+    }
+
+    /// Maximal entry
+    template <typename Value, typename Isa>
+    inline Value reduce_max(const pack<Value, Isa>& x)
+    {
+	Value buffer[pack<Value, Isa>::size];
+	x.store(buffer);
+	Value s= buffer[0];
+	for (std::size_t k= 1; k < pack<Value, Isa>::size; k++)
+	    s= std::max(s, buffer[k]);
+	return s;
+    }
+
+
+#ifndef MTL_WITHOUT_SIMD
+
+// The x86 intrinsics only differ in prefix and suffix
+#define MTL_SIMD_X86_PACK(VALUE, ISA, TYPE, PRE, SUF)						\
+    template <>											\
+    struct pack<VALUE, ISA>									\
+      : pack_size<sizeof(TYPE) / sizeof(VALUE)>							\
+    {												\
+	typedef VALUE                   value_type;						\
+												\
+	pack() {}										\
+	explicit pack(VALUE x) : v(PRE ## _set1_ ## SUF(x)) {}					\
+	explicit pack(TYPE v) : v(v) {}								\
+												\
+	static pack load(const VALUE* p) { return pack(PRE ## _loadu_ ## SUF(p)); }		\
+	void store(VALUE* p) const { PRE ## _storeu_ ## SUF(p, v); }				\
+												\
+	pack operator+(const pack& y) const { return pack(PRE ## _add_ ## SUF(v, y.v)); }	\
+	pack operator-(const pack& y) const { return pack(PRE ## _sub_ ## SUF(v, y.v)); }	\
+	pack operator*(const pack& y) const { return pack(PRE ## _mul_ ## SUF(v, y.v)); }	\
+	pack operator/(const pack& y) const { return pack(PRE ## _div_ ## SUF(v, y.v)); }	\
+												\
+	TYPE v;											\
+    };												\
+												\
+    inline pack<VALUE, ISA> max(const pack<VALUE, ISA>& x, const pack<VALUE, ISA>& y)		\
+    {	return pack<VALUE, ISA>(PRE ## _max_ ## SUF(x.v, y.v));	}
+
+#if defined(__SSE2__)
+    MTL_SIMD_X86_PACK(double, sse2, __m128d, _mm, pd)
+    MTL_SIMD_X86_PACK(float,  sse2, __m128,  _mm, ps)
+
+    inline pack<double, sse2> abs(const pack<double, sse2>& x)
+    { return pack<double, sse2>(_mm_andnot_pd(_mm_set1_pd(-0.0), x.v)); }
+    inline pack<float, sse2> abs(const pack<float, sse2>& x)
+    { return pack<float, sse2>(_mm_andnot_ps(_mm_set1_ps(-0.0f), x.v)); }
+#endif
+
+#if (defined(__AVX2__) && defined(__FMA__)) || defined(MTL_SIMD_DISPATCH_AVX2)
+#  ifdef MTL_SIMD_DISPATCH_AVX2
+#    pragma GCC push_options
+#    pragma GCC target("avx2,fma")
+#  endif
+    MTL_SIMD_X86_PACK(double, avx2, __m256d, _mm256, pd)
+    MTL_SIMD_X86_PACK(float,  avx2, __m256,  _mm256, ps)
+
+    inline pack<double, avx2> abs(const pack<double, avx2>& x)
+    { return pack<double, avx2>(_mm256_andnot_pd(_mm256_set1_pd(-0.0), x.v)); }
+    inline pack<float, avx2> abs(const pack<float, avx2>& x)
+    { return pack<float, avx2>(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), x.v)); }
+
+    inline pack<double, avx2> fma(const pack<double, avx2>& x, const pack<double, avx2>& y, const pack<double, avx2>& z)
+    { return pack<double, avx2>(_mm256_fmadd_pd(x.v, y.v, z.v)); }
+    inline pack<float, avx2> fma(const pack<float, avx2>& x, const pack<float, avx2>& y, const pack<float, avx2>& z)
+    { return pack<float, avx2>(_mm256_fmadd_ps(x.v, y.v, z.v)); }
+
+    /// Pack of x[idx[0]], ..., x[idx[size-1]]; other value and index types are gathered in the kernels (simd_isa_kernels.hpp)
+#  ifdef __x86_64__
+    inline pack<double, avx2> gather(const double* x, const std::size_t* idx, avx2)
+    { return pack<double, avx2>(_mm256_i64gather_pd(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 8)); }
+#  endif
+    // 32-bit indices: unsigned ones are zero-extended since the 32-bit gathers interpret indices as signed
+    inline pack<double, avx2> gather(const double* x, const unsigned* idx, avx2)
+    {
+	const __m256i i64= _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)));
+	return pack<double, avx2>(_mm256_i64gather_pd(x, i64, 8));
+    }
+    inline pack<double, avx2> gather(const double* x, const int* idx, avx2)
+    { return pack<double, avx2>(_mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), 8)); }
+    inline pack<float, avx2> gather(const float* x, const int* idx, avx2)
+    { return pack<float, avx2>(_mm256_i32gather_ps(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4)); }
+#  ifdef MTL_SIMD_DISPATCH_AVX2
+#    pragma GCC pop_options
+#  endif
+#endif
+
+#if defined(__AVX512F__) || defined(MTL_SIMD_DISPATCH_AVX512)
+#  ifdef MTL_SIMD_DISPATCH_AVX512
+#    pragma GCC push_options
+#    pragma GCC target("avx512f")
+#  endif
+    MTL_SIMD_X86_PACK(double, avx512, __m512d, _mm512, pd)
+    MTL_SIMD_X86_PACK(float,  avx512, __m512,  _mm512, ps)
+
+    inline pack<double, avx512> abs(const pack<double, avx512>& x) { return pack<double, avx512>(_mm512_abs_pd(x.v)); }
+    inline pack<float, avx512> abs(const pack<float, avx512>& x) { return pack<float, avx512>(_mm512_abs_ps(x.v)); }
+
+    inline pack<double, avx512> fma(const pack<double, avx512>& x, const pack<double, avx512>& y, const pack<double, avx512>& z)
+    { return pack<double, avx512>(_mm512_fmadd_pd(x.v, y.v, z.v)); }
+    inline pack<float, avx512> fma(const pack<float, avx512>& x, const pack<float, avx512>& y, const pack<float, avx512>& z)
+    { return pack<float, avx512>(_mm512_fmadd_ps(x.v, y.v, z.v)); }
+
+#  ifdef __x86_64__
+    inline pack<double, avx512> gather(const double* x, const std::size_t* idx, avx512)
+    { return pack<double, avx512>(_mm512_i64gather_pd(_mm512_loadu_si512(idx), x, 8)); }
+#  endif
+    inline pack<double, avx512> gather(const double* x, const unsigned* idx, avx512)
+    {
+	const __m512i i64= _mm512_cvtepu32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)));
+	return pack<double, avx512>(_mm512_i64gather_pd(i64, x, 8));
+    }
+    inline pack<double, avx512> gather(const double* x, const int* idx, avx512)
+    { return pack<double, avx512>(_mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), x, 8)); }
+    inline pack<float, avx512> gather(const float* x, const int* idx, avx512)
+    { return pack<float, avx512>(_mm512_i32gather_ps(_mm512_loadu_si512(idx), x, 4)); }
+#  ifdef MTL_SIMD_DISPATCH_AVX512
+#    pragma GCC pop_options
+#  endif
+#endif
+
+#undef MTL_SIMD_X86_PACK
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+#define MTL_SIMD_NEON_PACK(VALUE, TYPE, SUF)							\
+    template <>											\
+    struct pack<VALUE, neon>									\
+      : pack_size<sizeof(TYPE) / sizeof(VALUE)>							\
+    {												\
+	typedef VALUE                   value_type;						\
+												\
+	pack() {}										\
+	explicit pack(VALUE x) : v(vdupq_n_ ## SUF(x)) {}					\
+	explicit pack(TYPE v) : v(v) {}								\
+												\
+	static pack load(const VALUE* p) { return pack(vld1q_ ## SUF(p)); }			\
+	void store(VALUE* p) const { vst1q_ ## SUF(p, v); }					\
+												\
+	pack operator+(const pack& y) const { return pack(vaddq_ ## SUF(v, y.v)); }		\
+	pack operator-(const pack& y) const { return pack(vsubq_ ## SUF(v, y.v)); }		\
+	pack operator*(const pack& y) const { return pack(vmulq_ ## SUF(v, y.v)); }		\
+	pack operator/(const pack& y) const { return pack(vdivq_ ## SUF(v, y.v)); }		\
+												\
+	TYPE v;											\
+    };												\
+												\
+    inline pack<VALUE, neon> max(const pack<VALUE, neon>& x, const pack<VALUE, neon>& y)	\
+    {	return pack<VALUE, neon>(vmaxq_ ## SUF(x.v, y.v)); }					\
+    inline pack<VALUE, neon> abs(const pack<VALUE, neon>& x)					\
+    {	return pack<VALUE, neon>(vabsq_ ## SUF(x.v)); }						\
+    inline pack<VALUE, neon> fma(const pack<VALUE, neon>& x, const pack<VALUE, neon>& y,	\
+				 const pack<VALUE, neon>& z)					\
+    {	return pack<VALUE, neon>(vfmaq_ ## SUF(z.v, x.v, y.v)); }
+
+    MTL_SIMD_NEON_PACK(double, float64x2_t, f64)
+    MTL_SIMD_NEON_PACK(float,  float32x4_t, f32)
+
+#undef MTL_SIMD_NEON_PACK
+
+#endif
+
+#endif // MTL_WITHOUT_SIMD
+
+}} // namespace mtl::simd
+
+#endif // MTL_SIMD_PACK_INCLUDE
@@ -289,6 +289,11 @@ struct unit_diagonal : universe_diagonal {};
     in upper_trisolve and lower_trisolve. **/
 struct inverse_diagonal : universe_diagonal {};
 
+/// Tag for constructing an index evaluator on a part of the indices in parallel evaluation
+/** The part shares the vectors with the evaluator it is split from and keeps its own partial results,
+    e.g. of reductions, which are combined with join. **/
+struct split {};
+
 
 
 
@@ -0,0 +1,44 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_THREAD_BLOCK_INCLUDE
+#define MTL_THREAD_BLOCK_INCLUDE
+
+#include <cstddef>
+#include <algorithm>
+
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
+
+namespace mtl {
+
+/// Contiguous block [from, to) of [0, n) for thread \p t out of \p nt
+/** This static partition is used by the OpenMP kernels on dense vectors and row-major CRS matrices
+    and for the first-touch placement of their memory (see numa.hpp). **/
+inline void thread_block(std::size_t n, std::size_t t, std::size_t nt, std::size_t& from, std::size_t& to)
+{
+    from= n / nt * t + std::min(t, n % nt);
+    to= n / nt * (t+1) + std::min(t+1, n % nt);
+}
+
+#ifdef MTL_WITH_OPENMP
+/// Contiguous block of [0, n) for the calling thread
+inline void thread_block(std::size_t n, std::size_t& from, std::size_t& to)
+{
+    thread_block(n, omp_get_thread_num(), omp_get_num_threads(), from, to);
+}
+#endif
+
+} // namespace mtl
+
+#endif // MTL_THREAD_BLOCK_INCLUDE
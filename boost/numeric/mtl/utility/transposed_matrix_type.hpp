@@ -20,10 +20,10 @@ namespace mtl { namespace traits {
 
 template <class T> struct transposed_matrix_parameter {};
 
-template <typename O, typename I, typename D, bool S, typename ST>
-struct transposed_matrix_parameter<mat::parameters<O, I, D, S, ST> >
+template <typename O, typename I, typename D, bool S, typename ST, typename A, typename MI>
+struct transposed_matrix_parameter<mat::parameters<O, I, D, S, ST, A, MI> >
 {
-    typedef mat::parameters<typename transposed_orientation<O>::type, I, D, S, ST>  type;
+    typedef mat::parameters<typename transposed_orientation<O>::type, I, D, S, ST, A, MI>  type;
 };
 
 template <class T> struct transposed_matrix_type {};
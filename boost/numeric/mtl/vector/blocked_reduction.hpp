@@ -0,0 +1,121 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_VECTOR_BLOCKED_REDUCTION_INCLUDE
+#define MTL_VECTOR_BLOCKED_REDUCTION_INCLUDE
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/numeric/mtl/config.hpp>
+#include <boost/numeric/mtl/interface/vpt.hpp>
+
+namespace mtl { namespace vec {
+
+/// Number of blocks in a deterministic reduction of \p n entries
+inline std::size_t reduction_blocks(std::size_t n)
+{
+    return (n + reduction_block_size - 1) / reduction_block_size;
+}
+
+/// Combines \p parts pairwise in a tree whose shape only depends on the number of parts; the result is in parts[0]
+/** \p join(a, b) combines \p b into \p a. \p parts is a std::vector or a part_array. **/
+template <typename Parts, typename Join>
+inline void tree_join(Parts& parts, Join join)
+{
+    for (std::size_t s= 1; s < parts.size(); s*= 2)
+	for (std::size_t b= 0; b + s < parts.size(); b+= 2 * s)
+	    join(parts[b], parts[b + s]);
+}
+
+/// Array of \p n copies of \p part, aligned for the SIMD packs that evaluators may contain
+/** std::vector does not guarantee alignments beyond the one of malloc before C++17. **/
+template <typename Part>
+class part_array
+{
+    static const std::size_t alignment= boost::alignment_of<Part>::value;
+    part_array(const part_array&);            // not copyable
+    part_array& operator=(const part_array&);
+  public:
+    part_array(std::size_t n, const Part& part) : n(n), buffer(n * sizeof(Part) + alignment)
+    {
+	char* p= &buffer[0];
+	data= reinterpret_cast<Part*>(p + (alignment - reinterpret_cast<std::size_t>(p) % alignment) % alignment);
+	for (std::size_t i= 0; i < n; i++)
+	    new (data + i) Part(part);
+    }
+
+    ~part_array()
+    {
+	for (std::size_t i= 0; i < n; i++)
+	    data[i].~Part();
+    }
+
+    std::size_t size() const { return n; }
+    Part& operator[](std::size_t i) { return data[i]; }
+    const Part& operator[](std::size_t i) const { return data[i]; }
+
+  private:
+    std::size_t       n;
+    std::vector<char> buffer;
+    Part*             data;
+};
+
+/// Join functor that combines scalar partial results with Functor::finish
+template <typename Functor>
+struct finish_join
+{
+    template <typename Value>
+    void operator()(Value& value, const Value& value2) const { Functor::finish(value, value2); }
+};
+
+/// Join functor that combines partial evaluators (e.g. of fused expressions) with their join method
+struct evaluator_join
+{
+    template <typename Evaluator>
+    void operator()(Evaluator& eval, const Evaluator& part) const { eval.join(part); }
+};
+
+/// Reproducible reduction of [0, n) independent of the number of threads
+/** The range is divided into blocks of reduction_block_size entries that are reduced by
+    \p block(from, to), in parallel with OpenMP. The block results are combined by tree_join
+    with \p join.  Thus the order of all operations is only determined by \p n and the results
+    are bitwise identical for all thread counts (and without OpenMP).  The tree also limits
+    the round-off accumulation between blocks as in pairwise summation. **/
+template <typename Result, typename Block, typename Join>
+inline Result blocked_reduction(std::size_t n, const Block& block, Join join, const Result& neutral)
+{
+    vampir_trace<2044> tracer;
+    const std::size_t nb= reduction_blocks(n);
+    if (nb == 0)
+	return neutral;
+    if (nb == 1)
+	return block(0, n);
+
+    std::vector<Result> parts(nb, neutral);
+#ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for schedule(static)
+    for (long b= 0; b < long(nb); b++)
+	parts[b]= block(b * reduction_block_size, std::min(n, (b + 1) * reduction_block_size));
+#else
+    for (std::size_t b= 0; b < nb; b++)
+	parts[b]= block(b * reduction_block_size, std::min(n, (b + 1) * reduction_block_size));
+#endif
+    tree_join(parts, join);
+    return parts[0];
+}
+
+}} // namespace mtl::vec
+
+#endif // MTL_VECTOR_BLOCKED_REDUCTION_INCLUDE
@@ -51,13 +51,15 @@ namespace mtl { namespace vec {
 template <class Value, typename Parameters = parameters<> >
 class dense_vector
   : public vec_expr<dense_vector<Value, Parameters> >,
-    public ::mtl::detail::contiguous_memory_block< Value, Parameters::on_stack, Parameters::dimension::value >,
+    public ::mtl::detail::contiguous_memory_block< Value, Parameters::on_stack, Parameters::dimension::value,
+						   typename Parameters::allocator >,
     public crtp_base_vector< dense_vector<Value, Parameters>, Value, std::size_t >
 {
   public:
     typedef dense_vector<Value, Parameters>                                          self;
     typedef ::mtl::detail::contiguous_memory_block< Value, Parameters::on_stack, 
-                                                    Parameters::dimension::value >   memory_base;
+                                                    Parameters::dimension::value,
+						    typename Parameters::allocator > memory_base;
     typedef crtp_base_vector< self, Value, std::size_t >                             crtp_base;
     typedef crtp_vector_assign< self, Value, std::size_t >                           assign_base;
     typedef vec_expr<dense_vector<Value, Parameters> >                               expr_base;
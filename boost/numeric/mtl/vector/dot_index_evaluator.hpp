@@ -13,6 +13,9 @@
 #ifndef MTL_VECTOR_DOT_INDEX_EVALUATOR_INCLUDE
 #define MTL_VECTOR_DOT_INDEX_EVALUATOR_INCLUDE
 
+#include <boost/numeric/mtl/utility/tag.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
+
 namespace mtl { namespace vec {
 
 /// Class for index-wise computation of dot product
@@ -20,13 +23,27 @@ template <typename Scalar, typename Vector1, typename Vector2, typename ConjOpt,
 struct dot_index_evaluator
 {
     dot_index_evaluator(Scalar& scalar, const Vector1& v1, const Vector2& v2) 
-      : scalar(scalar), v1(v1), v2(v2) 
+      : scalar(scalar), v1(v1), v2(v2), partial(false)
+    { 
+	tmp[0]= tmp[1]= tmp[2]= tmp[3]= Scalar(0); 
+	for (int k= 0; k < 4; k++)
+	    simd::init<sum_functor>(acc[k]);
+    }
+
+    /// Evaluator for a part of the indices in parallel evaluation, result is combined by join
+    dot_index_evaluator(const dot_index_evaluator& src, tag::split) 
+      : scalar(src.scalar), v1(src.v1), v2(src.v2), partial(true)
     { 
 	tmp[0]= tmp[1]= tmp[2]= tmp[3]= Scalar(0); 
+	for (int k= 0; k < 4; k++)
+	    simd::init<sum_functor>(acc[k]);
     }
 
     ~dot_index_evaluator() 
     { 
+	if (partial) return;
+	for (int k= 0; k < 4; k++)
+	    simd::fold<sum_functor>(tmp[k], acc[k]);
 	Scalar s(tmp[0] + tmp[1] + tmp[2] + tmp[3]);
 	Assign::apply(scalar, s); 
     }
@@ -38,10 +55,30 @@ struct dot_index_evaluator
     void at(std::size_t i) 
     { tmp[Offset]+= ConjOpt()(v1[i+Offset]) * v2[i+Offset]; }
 
+    /// SIMD pack of entries starting at i + Offset * simd::pack<Scalar>::size (only if simd::pack_evaluatable, i.e. for real values)
+    template <unsigned Offset>
+    void pack_at(std::size_t i)
+    {
+	typedef simd::pack<Scalar> pack_type;
+	const std::size_t j= i + Offset * pack_type::size;
+	acc[Offset]= fma(simd::load<pack_type>(v1, j), simd::load<pack_type>(v2, j), acc[Offset]);
+    }
+
+    /// Combine with partial results of \p part
+    void join(const dot_index_evaluator& part)
+    {
+	for (int k= 0; k < 4; k++)
+	    tmp[k]+= part.tmp[k];
+	for (int k= 0; k < 4; k++)
+	    simd::join<sum_functor>(acc[k], part.acc[k]);
+    }
+
     Scalar&        scalar;
     Scalar         tmp[4];
+    typename simd::accumulator<Scalar, sum_functor>::type acc[4];
     const Vector1& v1;
     const Vector2& v2;
+    bool           partial;
 };
 
 template <typename Scalar, typename Vector1, typename Vector2, typename ConjOpt, typename Assign>
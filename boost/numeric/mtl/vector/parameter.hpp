@@ -18,23 +18,27 @@
 #include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/vector/dimension.hpp>
 #include <boost/numeric/mtl/utility/is_static.hpp>
+#include <boost/numeric/mtl/utility/allocation.hpp>
 
 namespace mtl { namespace vec {
 
 /// This type exist only for bundling template parameters (to reduce typing)
 /** OnStack = true can only be used with fixed::dimension.
     \sa \ref tuning_fsize
-    \sa \ref tuning_sizetype **/
+    \sa \ref tuning_sizetype
+    Allocator is the allocation policy of the heap memory, see mtl::allocation. **/
 template <typename Orientation= col_major, 
 	  typename Dimension= non_fixed::dimension,
 	  bool OnStack= mtl::traits::is_static<Dimension>::value,
-	  typename SizeType= std::size_t>
+	  typename SizeType= std::size_t,
+	  typename Allocator= mtl::allocation::default_policy>
 struct parameters 
 {
     typedef Orientation orientation;
     typedef Dimension   dimension;
     static const bool   on_stack= OnStack;
     typedef SizeType    size_type;
+    typedef Allocator   allocator;
 
     // Vector dimension must be known at compile time to be on the stack
     MTL_STATIC_ASSERT(( !on_stack || dimension::is_static ), "Types to be stored on stack must provide static size.");
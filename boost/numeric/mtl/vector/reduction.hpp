@@ -20,7 +20,10 @@
 #include <boost/numeric/mtl/utility/category.hpp>
 #include <boost/numeric/mtl/utility/range_generator.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
 #include <boost/numeric/mtl/utility/static_assert.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
+#include <boost/numeric/mtl/vector/blocked_reduction.hpp>
 
 namespace mtl { namespace vec {
 
@@ -77,6 +80,30 @@ namespace mtl { namespace vec {
 	    static inline void finish(Value&, Value&, Value&, Value&, Value&, Value&, Value&, Value&) {}
 	};
 
+	// Unrolled reduction of the entries [from, to) of v, blocks of vec::blocked_reduction
+	template <unsigned long Unroll, typename Functor, typename Result, typename Vector>
+	struct reduction_block
+	{
+	    explicit reduction_block(const Vector& v) : v(v) {}
+
+	    Result operator()(std::size_t from, std::size_t to) const
+	    {
+		Result tmp00, tmp01, tmp02, tmp03, tmp04, tmp05, tmp06, tmp07;
+		reduction<1, Unroll, Functor>::init(tmp00, tmp01, tmp02, tmp03, tmp04, tmp05, tmp06, tmp07);
+
+		const std::size_t i_block= from + Unroll * ((to - from) / Unroll);
+		for (std::size_t i= from; i < i_block; i+= Unroll)
+		    reduction<1, Unroll, Functor>::update(tmp00, tmp01, tmp02, tmp03, tmp04, tmp05, tmp06, tmp07, v, i);
+		for (std::size_t i= i_block; i < to; i++) 
+		    Functor::update(tmp00, v[i]);
+
+		reduction<1, Unroll, Functor>::finish(tmp00, tmp01, tmp02, tmp03, tmp04, tmp05, tmp06, tmp07);
+		return tmp00;
+	    }
+
+	    const Vector& v;
+	};
+
     } // namespace impl
 
 
@@ -112,10 +139,39 @@ struct reduction
 	return tmp00;
     }
 
-# ifdef MTL_WITH_OPENMP   
-
     template <typename Vector>
     Result static inline apply(const Vector& v, boost::mpl::false_)
+    {
+	roofline<2009> roof(mtl::traits::roofline_vector_flops(v) + mtl::vec::size(v), mtl::traits::roofline_vector_bytes(v));
+	return dense_apply(v, simd::reducible<Vector, Functor, Result>());
+    }
+
+    // Contiguous vectors with SIMD packs
+    template <typename Vector>
+    Result static inline dense_apply(const Vector& v, boost::mpl::true_)
+    {
+	return simd::reduce<Functor>(v);
+    }
+
+# if defined(MTL_DETERMINISTIC_REDUCTION)
+
+    // Reproducible: fixed blocks combined in a tree, independent of the number of threads
+    template <typename Vector>
+    Result static inline dense_apply(const Vector& v, boost::mpl::false_)
+    {
+	MTL_STATIC_ASSERT((Unroll >= 1), "Unroll size must be at least 1.");
+	MTL_STATIC_ASSERT((Unroll <= 8), "Maximal unrolling is 8."); // Might be relaxed in future versions
+
+	Result neutral;
+	Functor::init(neutral);
+	return blocked_reduction(std::size_t(mtl::vec::size(v)), impl::reduction_block<Unroll, Functor, Result, Vector>(v),
+				 finish_join<Functor>(), neutral);
+    }
+
+# elif defined(MTL_WITH_OPENMP)
+
+    template <typename Vector>
+    Result static inline dense_apply(const Vector& v, boost::mpl::false_)
     {
 	MTL_STATIC_ASSERT((Unroll >= 1), "Unroll size must be at least 1.");
 	MTL_STATIC_ASSERT((Unroll <= 8), "Maximal unrolling is 8."); // Might be relaxed in future versions
@@ -152,7 +208,7 @@ struct reduction
 # else
 
     template <typename Vector>
-    Result static inline apply(const Vector& v, boost::mpl::false_)
+    Result static inline dense_apply(const Vector& v, boost::mpl::false_)
     {
 	MTL_STATIC_ASSERT((Unroll >= 1), "Unroll size must be at least 1.");
 	MTL_STATIC_ASSERT((Unroll <= 8), "Maximal unrolling is 8."); // Might be relaxed in future versions
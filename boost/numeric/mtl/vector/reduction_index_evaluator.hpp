@@ -13,6 +13,9 @@
 #ifndef MTL_VECTOR_REDUCTION_INDEX_EVALUATOR_INCLUDE
 #define MTL_VECTOR_REDUCTION_INDEX_EVALUATOR_INCLUDE
 
+#include <boost/numeric/mtl/utility/tag.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
+
 namespace mtl { namespace vec {
 
 /// Class for index-wise vector reductions
@@ -20,14 +23,29 @@ template <typename Scalar, typename Vector, typename Functor, typename Assign>
 struct reduction_index_evaluator
 {
     reduction_index_evaluator(Scalar& scalar, const Vector& v) 
-      : scalar(scalar), v(v) 
+      : scalar(scalar), v(v), partial(false)
     {
 	Functor::init(tmp[0]);
 	tmp[1]= tmp[2]= tmp[3]= tmp[0];
+	for (int k= 0; k < 4; k++)
+	    simd::init<Functor>(acc[k]);
+    }
+
+    /// Evaluator for a part of the indices in parallel evaluation, result is combined by join
+    reduction_index_evaluator(const reduction_index_evaluator& src, tag::split) 
+      : scalar(src.scalar), v(src.v), partial(true)
+    {
+	Functor::init(tmp[0]);
+	tmp[1]= tmp[2]= tmp[3]= tmp[0];
+	for (int k= 0; k < 4; k++)
+	    simd::init<Functor>(acc[k]);
     }
 
     ~reduction_index_evaluator() 
     { 
+	if (partial) return;
+	for (int k= 0; k < 4; k++)
+	    simd::fold<Functor>(tmp[k], acc[k]);
 	Functor::finish(tmp[0], tmp[1]);
 	Functor::finish(tmp[2], tmp[3]);
 	Functor::finish(tmp[0], tmp[2]);
@@ -43,9 +61,28 @@ struct reduction_index_evaluator
     void operator[] (std::size_t i) { at<0>(i); }
     void operator() (std::size_t i) { at<0>(i); }    
 
+    /// Reduce the SIMD pack of entries starting at i + Offset * simd::pack<Scalar>::size (only if simd::pack_evaluatable)
+    template <unsigned Offset>
+    void pack_at(std::size_t i)
+    {
+	typedef simd::pack<Scalar> pack_type;
+	acc[Offset]= simd::reduction_op<Functor>::update(acc[Offset], simd::load<pack_type>(v, i + Offset * pack_type::size));
+    }
+
+    /// Combine with partial results of \p part
+    void join(const reduction_index_evaluator& part)
+    {
+	for (int k= 0; k < 4; k++)
+	    Functor::finish(tmp[k], part.tmp[k]);
+	for (int k= 0; k < 4; k++)
+	    simd::join<Functor>(acc[k], part.acc[k]);
+    }
+
     Scalar&        scalar;
     Scalar         tmp[4];
+    typename simd::accumulator<Scalar, Functor>::type acc[4];
     const Vector&  v;
+    bool           partial;
 };
 
 template <typename Scalar, typename Vector, typename Functor, typename Assign>
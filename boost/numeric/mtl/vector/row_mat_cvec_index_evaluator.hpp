@@ -32,6 +32,9 @@ struct row_mat_cvec_index_evaluator
 
     row_mat_cvec_index_evaluator(VectorOut& w, const Matrix& A, const VectorIn& v) : w(w), A(A), v(v) {}
 
+    /// Evaluator for a part of the rows in parallel evaluation
+    row_mat_cvec_index_evaluator(const row_mat_cvec_index_evaluator& src, tag::split) : w(src.w), A(src.A), v(src.v) {}
+
     template <unsigned Offset>
     void at(size_type i, boost::mpl::true_)
     {
@@ -61,6 +64,8 @@ struct row_mat_cvec_index_evaluator
     void operator()(size_type i) { at<0>(i); }
     void operator[](size_type i) { at<0>(i); }
 
+    void join(const row_mat_cvec_index_evaluator&) {} ///< Nothing to combine
+
     VectorOut&      w;
     const Matrix&   A;
     const VectorIn& v;
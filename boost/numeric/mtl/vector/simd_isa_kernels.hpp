@@ -0,0 +1,165 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+// No include guard: simd_kernels.hpp includes this file once per instruction set with
+// MTL_SIMD_KERNEL_ISA defined as the instruction set tag and MTL_SIMD_KERNEL_NAMESPACE as the namespace name.
+// For dispatched instruction sets, the inclusion is surrounded by a target pragma.  Pack operations
+// are only inlined into functions with the same target; therefore, all pack-wise code of the kernels
+// is defined here and not in generic templates.
+
+namespace mtl { namespace simd { namespace MTL_SIMD_KERNEL_NAMESPACE {
+
+    typedef MTL_SIMD_KERNEL_ISA isa;
+
+    template <typename Value>
+    inline Value sum_entries(const pack<Value, isa>& x)
+    {
+	Value buffer[pack<Value, isa>::size];
+	x.store(buffer);
+	Value s= buffer[0];
+	for (std::size_t k= 1; k < pack<Value, isa>::size; k++)
+	    s+= buffer[k];
+	return s;
+    }
+
+    template <typename Value>
+    inline Value max_entry(const pack<Value, isa>& x)
+    {
+	Value buffer[pack<Value, isa>::size];
+	x.store(buffer);
+	Value s= buffer[0];
+	for (std::size_t k= 1; k < pack<Value, isa>::size; k++)
+	    s= std::max(s, buffer[k]);
+	return s;
+    }
+
+    // Pack-wise update, join and final reduction for each vectorized reduction functor
+    template <typename Value>
+    inline pack<Value, isa> update(vec::sum_functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return acc + x; }
+    template <typename Value>
+    inline pack<Value, isa> update(vec::one_norm_functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return acc + abs(x); }
+    template <typename Value>
+    inline pack<Value, isa> update(vec::two_norm_functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return fma(x, x, acc); }
+    template <typename Value>
+    inline pack<Value, isa> update(vec::unary_dot_functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return fma(x, x, acc); }
+    template <typename Value>
+    inline pack<Value, isa> update(vec::infinity_norm_functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return max(acc, abs(x)); }
+
+    template <typename Functor, typename Value>
+    inline pack<Value, isa> join(Functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return acc + x; }
+    template <typename Value>
+    inline pack<Value, isa> join(vec::infinity_norm_functor, const pack<Value, isa>& acc, const pack<Value, isa>& x) { return max(acc, x); }
+
+    template <typename Functor, typename Value>
+    inline Value reduce(Functor, const pack<Value, isa>& acc) { return sum_entries(acc); }
+    template <typename Value>
+    inline Value reduce(vec::infinity_norm_functor, const pack<Value, isa>& acc) { return max_entry(acc); }
+
+    /// Reduce [0, n) of \p x sequentially without post_reduction (i.e. square root for two_norm)
+    template <typename Functor, typename Value>
+    inline Value reduce_range(const Value* x, std::size_t n)
+    {
+	typedef pack<Value, isa>    pack_type;
+	const Functor               f= Functor();
+	const std::size_t P= pack_type::size, sb= n / (4 * P) * (4 * P);
+	pack_type acc0(Value(0)), acc1(acc0), acc2(acc0), acc3(acc0);
+
+	for (std::size_t i= 0; i < sb; i+= 4 * P) {
+	    acc0= update(f, acc0, pack_type::load(x + i));
+	    acc1= update(f, acc1, pack_type::load(x + i + P));
+	    acc2= update(f, acc2, pack_type::load(x + i + 2 * P));
+	    acc3= update(f, acc3, pack_type::load(x + i + 3 * P));
+	}
+	const std::size_t pb= n / P * P;
+	for (std::size_t i= sb; i < pb; i+= P)
+	    acc0= update(f, acc0, pack_type::load(x + i));
+	Value result= reduce(f, join(f, join(f, acc0, acc1), join(f, acc2, acc3)));
+	for (std::size_t i= pb; i < n; i++)
+	    Functor::update(result, x[i]);
+	return result;
+    }
+
+    /// Dot product of [0, n) of \p x and \p y for real values
+    template <typename Value>
+    inline Value dot_range(const Value* x, const Value* y, std::size_t n)
+    {
+	typedef pack<Value, isa>    pack_type;
+	const std::size_t P= pack_type::size, sb= n / (4 * P) * (4 * P);
+	pack_type acc0(Value(0)), acc1(acc0), acc2(acc0), acc3(acc0);
+
+	for (std::size_t i= 0; i < sb; i+= 4 * P) {
+	    acc0= fma(pack_type::load(x + i), pack_type::load(y + i), acc0);
+	    acc1= fma(pack_type::load(x + i + P), pack_type::load(y + i + P), acc1);
+	    acc2= fma(pack_type::load(x + i + 2 * P), pack_type::load(y + i + 2 * P), acc2);
+	    acc3= fma(pack_type::load(x + i + 3 * P), pack_type::load(y + i + 3 * P), acc3);
+	}
+	const std::size_t pb= n / P * P;
+	for (std::size_t i= sb; i < pb; i+= P)
+	    acc0= fma(pack_type::load(x + i), pack_type::load(y + i), acc0);
+	Value result= sum_entries((acc0 + acc1) + (acc2 + acc3));
+	for (std::size_t i= pb; i < n; i++)
+	    result+= x[i] * y[i];
+	return result;
+    }
+
+    /// Pack of x[idx[0]], ..., x[idx[size-1]] unless the instruction set provides a gather for the types (in simd_pack.hpp)
+    template <typename Value, typename Index>
+    inline pack<Value, isa> gather(const Value* x, const Index* idx, isa)
+    {
+	Value buffer[pack<Value, isa>::size];
+	for (std::size_t k= 0; k < pack<Value, isa>::size; k++)
+	    buffer[k]= x[idx[k]];
+	return pack<Value, isa>::load(buffer);
+    }
+
+    /// Product of the entries [j, cj1) of \p data with the corresponding entries of \p x, pack-wise for long enough rows
+    template <typename Value, typename Index, typename Size>
+    inline Value crs_row(const Value* data, const Index* indices, const Value* x, Size j, Size cj1)
+    {
+	typedef pack<Value, isa>    pack_type;
+	const std::size_t P= pack_type::size;
+
+	Value tmp(0);
+	if (std::size_t(cj1 - j) >= P) {
+	    pack_type acc(Value(0));
+	    for (; std::size_t(cj1 - j) >= P; j+= P)
+		acc= fma(pack_type::load(data + j), gather(x, indices + j, isa()), acc);
+	    tmp= sum_entries(acc);
+	}
+	for (; j != cj1; ++j)
+	    tmp+= data[j] * x[indices[j]];
+	return tmp;
+    }
+
+    /// Rows [from, to) of the product of a CRS matrix and a dense vector: Assign::first_update(y[i], A[i][:] * x)
+    /** \p starts, \p indices and \p data are the row starts, column indices and values of the matrix.
+	The column indices can have a smaller type than the starts. **/
+    template <typename Assign, typename Value, typename Size, typename Index>
+    inline void crs_rows(const Value* data, const Size* starts, const Index* indices, const Value* x, Value* y,
+			 Size from, Size to)
+    {
+	const Size tb= from + (to - from) / 4 * 4;
+	for (Size i= from; i < tb; i+= 4) {
+	    const Value tmp0= crs_row(data, indices, x, starts[i], starts[i+1]),
+		        tmp1= crs_row(data, indices, x, starts[i+1], starts[i+2]),
+		        tmp2= crs_row(data, indices, x, starts[i+2], starts[i+3]),
+		        tmp3= crs_row(data, indices, x, starts[i+3], starts[i+4]);
+	    Assign::first_update(y[i], tmp0);
+	    Assign::first_update(y[i+1], tmp1);
+	    Assign::first_update(y[i+2], tmp2);
+	    Assign::first_update(y[i+3], tmp3);
+	}
+	for (Size i= tb; i < to; ++i)
+	    Assign::first_update(y[i], crs_row(data, indices, x, starts[i], starts[i+1]));
+    }
+
+}}} // namespace mtl::simd::MTL_SIMD_KERNEL_NAMESPACE
@@ -0,0 +1,537 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#ifndef MTL_VECTOR_SIMD_KERNELS_INCLUDE
+#define MTL_VECTOR_SIMD_KERNELS_INCLUDE
+
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/numeric/mtl/mtl_fwd.hpp>
+#include <boost/numeric/mtl/utility/simd_pack.hpp>
+#include <boost/numeric/mtl/utility/simd_dispatch.hpp>
+#include <boost/numeric/mtl/concept/collection.hpp>
+#include <boost/numeric/mtl/utility/is_row_major.hpp>
+#include <boost/numeric/mtl/operation/sfunctor.hpp>
+#include <boost/numeric/mtl/operation/assign_mode.hpp>
+#include <boost/numeric/mtl/vector/reduction_functors.hpp>
+#include <boost/numeric/mtl/vector/blocked_reduction.hpp>
+#include <boost/numeric/mtl/utility/thread_block.hpp>
+
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
+
+namespace mtl { namespace simd {
+
+    /// Whether the vector expression \p E can be evaluated pack-wise with entries of type \p Value
+    /** True for contiguous dense vectors of Value and for scalings, sums and differences thereof. **/
+    template <typename E, typename Value>
+    struct packable : boost::mpl::false_ {};
+
+    template <typename Value, typename Parameters>
+    struct packable<vec::dense_vector<Value, Parameters>, Value>
+      : is_vectorized<Value> {};
+
+    template <typename Scaling, typename Vector, typename Value>
+    struct packable<vec::map_view<tfunctor::scale<Scaling, Value, tag::scalar>, Vector>, Value>
+      : boost::mpl::and_<boost::is_arithmetic<Scaling>, packable<Vector, Value>,
+			 boost::is_same<typename tfunctor::scale<Scaling, Value, tag::scalar>::result_type, Value> > {};
+
+    template <typename RScaling, typename Vector, typename Value>
+    struct packable<vec::map_view<tfunctor::rscale<Value, RScaling, tag::scalar>, Vector>, Value>
+      : boost::mpl::and_<boost::is_arithmetic<RScaling>, packable<Vector, Value>,
+			 boost::is_same<typename tfunctor::rscale<Value, RScaling, tag::scalar>::result_type, Value> > {};
+
+    template <typename Scaling, typename Vector, typename Value>
+    struct packable<vec::scaled_view<Scaling, Vector>, Value>
+      : packable<typename vec::scaled_view<Scaling, Vector>::base, Value> {};
+
+    template <typename Vector, typename RScaling, typename Value>
+    struct packable<vec::rscaled_view<Vector, RScaling>, Value>
+      : packable<typename vec::rscaled_view<Vector, RScaling>::base, Value> {};
+
+    template <typename E1, typename E2, typename V1, typename V2, typename Value>
+    struct packable<vec::vec_vec_pmop_expr<E1, E2, sfunctor::plus<V1, V2> >, Value>
+      : boost::mpl::and_<packable<E1, Value>, packable<E2, Value> > {};
+
+    template <typename E1, typename E2, typename V1, typename V2, typename Value>
+    struct packable<vec::vec_vec_pmop_expr<E1, E2, sfunctor::minus<V1, V2> >, Value>
+      : boost::mpl::and_<packable<E1, Value>, packable<E2, Value> > {};
+
+
+    /// Load the entries [i, i + Pack::size) of a packable expression
+    template <typename Pack, typename E>
+    struct loader {};
+
+    template <typename Pack, typename Value, typename Parameters>
+    struct loader<Pack, vec::dense_vector<Value, Parameters> >
+    {
+	static Pack apply(const vec::dense_vector<Value, Parameters>& v, std::size_t i)
+	{ return Pack::load(v.address_data() + i); }
+    };
+
+    template <typename Pack, typename Scaling, typename Value, typename Vector>
+    struct loader<Pack, vec::map_view<tfunctor::scale<Scaling, Value, tag::scalar>, Vector> >
+    {
+	static Pack apply(const vec::map_view<tfunctor::scale<Scaling, Value, tag::scalar>, Vector>& v, std::size_t i)
+	{
+	    return Pack(Value(v.functor.value())) * loader<Pack, Vector>::apply(v.ref, i);
+	}
+    };
+
+    template <typename Pack, typename Value, typename RScaling, typename Vector>
+    struct loader<Pack, vec::map_view<tfunctor::rscale<Value, RScaling, tag::scalar>, Vector> >
+    {
+	static Pack apply(const vec::map_view<tfunctor::rscale<Value, RScaling, tag::scalar>, Vector>& v, std::size_t i)
+	{
+	    return loader<Pack, Vector>::apply(v.ref, i) * Pack(Value(v.functor.value()));
+	}
+    };
+
+    template <typename Pack, typename Scaling, typename Vector>
+    struct loader<Pack, vec::scaled_view<Scaling, Vector> >
+      : loader<Pack, typename vec::scaled_view<Scaling, Vector>::base> {};
+
+    template <typename Pack, typename Vector, typename RScaling>
+    struct loader<Pack, vec::rscaled_view<Vector, RScaling> >
+      : loader<Pack, typename vec::rscaled_view<Vector, RScaling>::base> {};
+
+    template <typename Pack, typename E1, typename E2, typename V1, typename V2>
+    struct loader<Pack, vec::vec_vec_pmop_expr<E1, E2, sfunctor::plus<V1, V2> > >
+    {
+	static Pack apply(const vec::vec_vec_pmop_expr<E1, E2, sfunctor::plus<V1, V2> >& v, std::size_t i)
+	{
+	    return loader<Pack, E1>::apply(v.first_argument().value, i) + loader<Pack, E2>::apply(v.second_argument().value, i);
+	}
+    };
+
+    template <typename Pack, typename E1, typename E2, typename V1, typename V2>
+    struct loader<Pack, vec::vec_vec_pmop_expr<E1, E2, sfunctor::minus<V1, V2> > >
+    {
+	static Pack apply(const vec::vec_vec_pmop_expr<E1, E2, sfunctor::minus<V1, V2> >& v, std::size_t i)
+	{
+	    return loader<Pack, E1>::apply(v.first_argument().value, i) - loader<Pack, E2>::apply(v.second_argument().value, i);
+	}
+    };
+
+    template <typename Pack, typename E>
+    inline Pack load(const E& e, std::size_t i) { return loader<Pack, E>::apply(e, i); }
+
+
+    /// Pack-wise version of the assign functor SFunctor from mtl::sfunctor or mtl::assign (if available)
+    template <typename SFunctor>
+    struct assign_op : boost::mpl::false_ {};
+
+    template <>
+    struct assign_op<assign::assign_sum> : boost::mpl::true_
+    {
+	template <typename Pack>
+	static void apply(typename Pack::value_type* p, const Pack& y) { y.store(p); }
+    };
+
+    template <>
+    struct assign_op<assign::plus_sum> : boost::mpl::true_
+    {
+	template <typename Pack>
+	static void apply(typename Pack::value_type* p, const Pack& y) { (Pack::load(p) + y).store(p); }
+    };
+
+    template <>
+    struct assign_op<assign::minus_sum> : boost::mpl::true_
+    {
+	template <typename Pack>
+	static void apply(typename Pack::value_type* p, const Pack& y) { (Pack::load(p) - y).store(p); }
+    };
+
+    template <typename V1, typename V2>
+    struct assign_op<sfunctor::assign<V1, V2> > : assign_op<assign::assign_sum> {};
+
+    template <typename V1, typename V2>
+    struct assign_op<sfunctor::plus_assign<V1, V2> > : assign_op<assign::plus_sum> {};
+
+    template <typename V1, typename V2>
+    struct assign_op<sfunctor::minus_assign<V1, V2> > : assign_op<assign::minus_sum> {};
+
+    template <typename V1, typename V2>
+    struct assign_op<sfunctor::times_assign<V1, V2> > : boost::mpl::true_
+    {
+	template <typename Pack>
+	static void apply(typename Pack::value_type* p, const Pack& y) { (Pack::load(p) * y).store(p); }
+    };
+
+    template <typename V1, typename V2>
+    struct assign_op<sfunctor::divide_assign<V1, V2> > : boost::mpl::true_
+    {
+	template <typename Pack>
+	static void apply(typename Pack::value_type* p, const Pack& y) { (Pack::load(p) / y).store(p); }
+    };
+
+
+    /// Whether vector assignment first SFunctor= second can be performed pack-wise
+    template <typename E1, typename E2, typename SFunctor>
+    struct vec_assignable : boost::mpl::false_ {};
+
+    template <typename Value, typename Parameters, typename E2, typename SFunctor>
+    struct vec_assignable<vec::dense_vector<Value, Parameters>, E2, SFunctor>
+      : boost::mpl::and_<packable<vec::dense_vector<Value, Parameters>, Value>, packable<E2, Value>, assign_op<SFunctor> > {};
+
+    /// Whether vector-scalar assignment first SFunctor= second can be performed pack-wise
+    template <typename E1, typename E2, typename SFunctor>
+    struct scal_assignable : boost::mpl::false_ {};
+
+    template <typename Value, typename Parameters, typename E2, typename SFunctor>
+    struct scal_assignable<vec::dense_vector<Value, Parameters>, E2, SFunctor>
+      : boost::mpl::and_<packable<vec::dense_vector<Value, Parameters>, Value>, boost::is_arithmetic<E2>, assign_op<SFunctor> > {};
+
+
+    /// Pack-wise first[i] SFunctor= second[i] for i in [from, to), remainder is computed element-wise
+    template <typename SFunctor, typename E1, typename E2>
+    inline void assign(E1& first, const E2& second, std::size_t from, std::size_t to)
+    {
+	typedef pack<typename Collection<E1>::value_type> pack_type;
+	const std::size_t sb= from + (to - from) / pack_type::size * pack_type::size;
+	typename Collection<E1>::value_type* p= first.address_data();
+
+	for (std::size_t i= from; i < sb; i+= pack_type::size)
+	    assign_op<SFunctor>::apply(p + i, load<pack_type>(second, i));
+	for (std::size_t i= sb; i < to; i++)
+	    SFunctor::apply(first[i], second[i]);
+    }
+
+    /// Pack-wise first[i] SFunctor= scalar for i in [from, to)
+    template <typename SFunctor, typename E1, typename Scalar>
+    inline void assign_scalar(E1& first, const Scalar& scalar, std::size_t from, std::size_t to)
+    {
+	typedef typename Collection<E1>::value_type value_type;
+	typedef pack<value_type>                    pack_type;
+	const std::size_t sb= from + (to - from) / pack_type::size * pack_type::size;
+	const pack_type   y= pack_type(value_type(scalar));
+	value_type*       p= first.address_data();
+
+	for (std::size_t i= from; i < sb; i+= pack_type::size)
+	    assign_op<SFunctor>::apply(p + i, y);
+	for (std::size_t i= sb; i < to; i++)
+	    SFunctor::apply(first[i], scalar);
+    }
+
+
+    /// Pack-wise version of a reduction functor from reduction_functors.hpp (if available)
+    template <typename Functor>
+    struct reduction_op : boost::mpl::false_ {};
+
+    template <>
+    struct reduction_op<vec::sum_functor> : boost::mpl::true_
+    {
+	template <typename Pack> static Pack update(const Pack& acc, const Pack& x) { return acc + x; }
+	template <typename Pack> static Pack join(const Pack& acc, const Pack& x) { return acc + x; }
+	template <typename Pack> static typename Pack::value_type reduce(const Pack& acc) { return reduce_add(acc); }
+    };
+
+    template <>
+    struct reduction_op<vec::one_norm_functor> : reduction_op<vec::sum_functor>
+    {
+	template <typename Pack> static Pack update(const Pack& acc, const Pack& x) { return acc + abs(x); }
+    };
+
+    template <>
+    struct reduction_op<vec::two_norm_functor> : reduction_op<vec::sum_functor>
+    {
+	template <typename Pack> static Pack update(const Pack& acc, const Pack& x) { return fma(x, x, acc); }
+    };
+
+    template <>
+    struct reduction_op<vec::unary_dot_functor> : reduction_op<vec::two_norm_functor> {};
+
+    template <>
+    struct reduction_op<vec::infinity_norm_functor> : boost::mpl::true_
+    {
+	template <typename Pack> static Pack update(const Pack& acc, const Pack& x) { return max(acc, abs(x)); }
+	template <typename Pack> static Pack join(const Pack& acc, const Pack& x) { return max(acc, x); }
+	template <typename Pack> static typename Pack::value_type reduce(const Pack& acc) { return reduce_max(acc); }
+    };
+
+    /// Whether reducing a vector of type \p Vector with \p Functor to \p Result can be performed pack-wise
+    template <typename Vector, typename Functor, typename Result>
+    struct reducible : boost::mpl::false_ {};
+
+    template <typename Value, typename Parameters, typename Functor>
+    struct reducible<vec::dense_vector<Value, Parameters>, Functor, Value>
+      : boost::mpl::and_<is_vectorized<Value>, reduction_op<Functor> > {};
+
+    /// Whether the dot product of \p Vector1 and \p Vector2 yielding \p Result can be performed pack-wise
+    template <typename Vector1, typename Vector2, typename Result>
+    struct dot_computable : boost::mpl::false_ {};
+
+    template <typename Value, typename Parameters1, typename Parameters2>
+    struct dot_computable<vec::dense_vector<Value, Parameters1>, vec::dense_vector<Value, Parameters2>, Value>
+      : is_vectorized<Value> {};
+
+
+    /// Placeholder for accumulators in evaluators that are not performed pack-wise
+    struct no_pack {};
+
+    /// Type of the pack accumulator used in reductions with Functor over Value
+    template <typename Value, typename Functor>
+    struct accumulator
+      : boost::mpl::if_<boost::mpl::and_<is_vectorized<Value>, reduction_op<Functor> >, pack<Value>, no_pack>
+    {};
+
+    template <typename Functor> inline void init(no_pack&) {}
+    template <typename Functor> inline void join(no_pack&, const no_pack&) {}
+    template <typename Functor, typename Value> inline void fold(Value&, const no_pack&) {}
+
+    /// Initialize accumulator with neutral element (zero for all vectorized reductions)
+    template <typename Functor, typename Value, typename Isa>
+    inline void init(pack<Value, Isa>& acc) { acc= pack<Value, Isa>(Value(0)); }
+
+    /// Combine accumulator with the accumulator of a partial evaluation
+    template <typename Functor, typename Value, typename Isa>
+    inline void join(pack<Value, Isa>& acc, const pack<Value, Isa>& part) { acc= reduction_op<Functor>::join(acc, part); }
+
+    /// Reduce the accumulator and combine it into the scalar \p tmp
+    template <typename Functor, typename Value, typename Isa>
+    inline void fold(Value& tmp, const pack<Value, Isa>& acc) { Functor::finish(tmp, reduction_op<Functor>::reduce(acc)); }
+
+
+}} // namespace mtl::simd
+
+// Kernels for the native instruction set and, with run-time dispatch, for wider ones
+#define MTL_SIMD_KERNEL_ISA native
+#define MTL_SIMD_KERNEL_NAMESPACE native_kernels
+#include <boost/numeric/mtl/vector/simd_isa_kernels.hpp>
+#undef MTL_SIMD_KERNEL_ISA
+#undef MTL_SIMD_KERNEL_NAMESPACE
+
+#ifdef MTL_SIMD_DISPATCH_AVX2
+#  pragma GCC push_options
+#  pragma GCC target("avx2,fma")
+#  define MTL_SIMD_KERNEL_ISA avx2
+#  define MTL_SIMD_KERNEL_NAMESPACE avx2_kernels
+#  include <boost/numeric/mtl/vector/simd_isa_kernels.hpp>
+#  undef MTL_SIMD_KERNEL_ISA
+#  undef MTL_SIMD_KERNEL_NAMESPACE
+#  pragma GCC pop_options
+#endif
+
+#ifdef MTL_SIMD_DISPATCH_AVX512
+#  pragma GCC push_options
+#  pragma GCC target("avx512f")
+#  define MTL_SIMD_KERNEL_ISA avx512
+#  define MTL_SIMD_KERNEL_NAMESPACE avx512_kernels
+#  include <boost/numeric/mtl/vector/simd_isa_kernels.hpp>
+#  undef MTL_SIMD_KERNEL_ISA
+#  undef MTL_SIMD_KERNEL_NAMESPACE
+#  pragma GCC pop_options
+#endif
+
+namespace mtl { namespace simd {
+
+    /// Reduce [0, n) of \p x sequentially without post_reduction with the kernel of the selected instruction set
+    template <typename Functor, typename Value>
+    inline Value reduce_range(const Value* x, std::size_t n)
+    {
+#     ifdef MTL_SIMD_DISPATCH_AVX512
+	if (selected_isa() == isa_avx512)
+	    return avx512_kernels::reduce_range<Functor>(x, n);
+#     endif
+#     ifdef MTL_SIMD_DISPATCH_AVX2
+	if (selected_isa() == isa_avx2)
+	    return avx2_kernels::reduce_range<Functor>(x, n);
+#     endif
+	return native_kernels::reduce_range<Functor>(x, n);
+    }
+
+    /// Dot product of [0, n) of \p x and \p y for real values with the kernel of the selected instruction set
+    template <typename Value>
+    inline Value dot_range(const Value* x, const Value* y, std::size_t n)
+    {
+#     ifdef MTL_SIMD_DISPATCH_AVX512
+	if (selected_isa() == isa_avx512)
+	    return avx512_kernels::dot_range(x, y, n);
+#     endif
+#     ifdef MTL_SIMD_DISPATCH_AVX2
+	if (selected_isa() == isa_avx2)
+	    return avx2_kernels::dot_range(x, y, n);
+#     endif
+	return native_kernels::dot_range(x, y, n);
+    }
+
+    /// Whether the product of \p Matrix and \p VectorIn stored in \p VectorOut can be computed by crs_rows
+    template <typename Matrix, typename VectorIn, typename VectorOut>
+    struct crs_computable : boost::mpl::false_ {};
+
+    template <typename Value, typename MParameters, typename Parameters1, typename Parameters2>
+    struct crs_computable<mat::compressed2D<Value, MParameters>, vec::dense_vector<Value, Parameters1>, vec::dense_vector<Value, Parameters2> >
+      : boost::mpl::and_<boost::mpl::or_<boost::is_same<Value, double>, boost::is_same<Value, float> >,
+			 traits::is_row_major<MParameters> > {};
+
+    /// Whether another instruction set than the native one is selected
+    inline bool dispatched() { return selected_isa() != native_isa(); }
+
+    /// Number of entries in packs of \p Value with the selected instruction set
+    template <typename Value>
+    inline std::size_t selected_pack_size()
+    {
+#     ifdef MTL_SIMD_DISPATCH_AVX512
+	if (selected_isa() == isa_avx512)
+	    return pack<Value, avx512>::size;
+#     endif
+#     ifdef MTL_SIMD_DISPATCH_AVX2
+	if (selected_isa() == isa_avx2)
+	    return pack<Value, avx2>::size;
+#     endif
+	return pack<Value>::size;
+    }
+
+    /// Rows [from, to) of a CRS matrix times dense vector with the kernel of the selected instruction set
+    template <typename Assign, typename Value, typename Size, typename Index>
+    inline void crs_rows(const Value* data, const Size* starts, const Index* indices, const Value* x, Value* y,
+			 Size from, Size to)
+    {
+#     ifdef MTL_SIMD_DISPATCH_AVX512
+	if (selected_isa() == isa_avx512)
+	    return avx512_kernels::crs_rows<Assign>(data, starts, indices, x, y, from, to);
+#     endif
+#     ifdef MTL_SIMD_DISPATCH_AVX2
+	if (selected_isa() == isa_avx2)
+	    return avx2_kernels::crs_rows<Assign>(data, starts, indices, x, y, from, to);
+#     endif
+	native_kernels::crs_rows<Assign>(data, starts, indices, x, y, from, to);
+    }
+
+    /// Reduction of the blocks [from, to) of \p x in vec::blocked_reduction
+    template <typename Functor, typename Value>
+    struct reduce_block
+    {
+	explicit reduce_block(const Value* x) : x(x) {}
+	Value operator()(std::size_t from, std::size_t to) const { return reduce_range<Functor>(x + from, to - from); }
+	const Value* x;
+    };
+
+    /// Dot product of the blocks [from, to) of \p x and \p y in vec::blocked_reduction
+    template <typename Value>
+    struct dot_block
+    {
+	dot_block(const Value* x, const Value* y) : x(x), y(y) {}
+	Value operator()(std::size_t from, std::size_t to) const { return dot_range(x + from, y + from, to - from); }
+	const Value *x, *y;
+    };
+
+    using mtl::thread_block;
+
+    /// Reduce \p v with \p Functor (without post_reduction), in parallel with OpenMP
+    template <typename Functor, typename Vector>
+    inline typename Collection<Vector>::value_type reduce(const Vector& v)
+    {
+	typedef typename Collection<Vector>::value_type value_type;
+	const value_type* x= v.address_data();
+	const std::size_t n= v.padded_memory(); // zero padding is neutral in all vectorized reductions
+#     if defined(MTL_DETERMINISTIC_REDUCTION)
+	value_type neutral;
+	Functor::init(neutral);
+	return vec::blocked_reduction(n, reduce_block<Functor, value_type>(x), vec::finish_join<Functor>(), neutral);
+#     elif defined(MTL_WITH_OPENMP)
+	value_type result;
+	Functor::init(result);
+#       pragma omp parallel
+	{
+	    std::size_t from, to;
+	    thread_block(n, from, to);
+	    value_type part= reduce_range<Functor>(x + from, to - from);
+#           pragma omp critical
+	    Functor::finish(result, part);
+	}
+	return result;
+#     else
+	return reduce_range<Functor>(x, n);
+#     endif
+    }
+
+    /// Dot product of real vectors \p v1 and \p v2, in parallel with OpenMP
+    template <typename Vector1, typename Vector2>
+    inline typename Collection<Vector1>::value_type dot(const Vector1& v1, const Vector2& v2)
+    {
+	typedef typename Collection<Vector1>::value_type value_type;
+	const value_type *x= v1.address_data(), *y= v2.address_data();
+	const std::size_t n= std::min(v1.padded_memory(), v2.padded_memory());
+#     if defined(MTL_DETERMINISTIC_REDUCTION)
+	return vec::blocked_reduction(n, dot_block<value_type>(x, y), vec::finish_join<vec::sum_functor>(), value_type(0));
+#     elif defined(MTL_WITH_OPENMP)
+	value_type result(0);
+#       pragma omp parallel
+	{
+	    std::size_t from, to;
+	    thread_block(n, from, to);
+	    value_type part= dot_range(x + from, y + from, to - from);
+#           pragma omp critical
+	    result+= part;
+	}
+	return result;
+#     else
+	return dot_range(x, y, n);
+#     endif
+    }
+
+
+    /// Whether the index evaluator \p Evaluator provides pack_at(i); value_type is the type of the packs' entries
+    template <typename Evaluator>
+    struct pack_evaluatable : boost::mpl::false_
+    {
+	typedef void value_type;
+    };
+
+    template <typename E1, typename E2, typename SFunctor>
+    struct pack_evaluatable<vec::vec_vec_aop_expr<E1, E2, SFunctor> >
+      : vec_assignable<E1, E2, SFunctor>
+    {
+	typedef typename Collection<E1>::value_type value_type;
+    };
+
+    template <typename E1, typename E2, typename SFunctor>
+    struct pack_evaluatable<vec::vec_scal_aop_expr<E1, E2, SFunctor> >
+      : scal_assignable<E1, E2, SFunctor>
+    {
+	typedef typename Collection<E1>::value_type value_type;
+    };
+
+    template <typename Scalar, typename Vector, typename Functor, typename Assign>
+    struct pack_evaluatable<vec::reduction_index_evaluator<Scalar, Vector, Functor, Assign> >
+      : reducible<Vector, Functor, Scalar>
+    {
+	typedef Scalar value_type;
+    };
+
+    template <typename Scalar, typename Vector1, typename Vector2, typename ConjOpt, typename Assign>
+    struct pack_evaluatable<vec::dot_index_evaluator<Scalar, Vector1, Vector2, ConjOpt, Assign> >
+      : dot_computable<Vector1, Vector2, Scalar>
+    {
+	typedef Scalar value_type;
+    };
+
+    template <typename T, typename U>
+    struct pack_evaluatable<vec::fused_index_evaluator<T, U> >
+      : boost::mpl::and_<pack_evaluatable<typename vec::fused_index_evaluator<T, U>::first_type>,
+			 pack_evaluatable<typename vec::fused_index_evaluator<T, U>::second_type>,
+			 boost::is_same<typename pack_evaluatable<typename vec::fused_index_evaluator<T, U>::first_type>::value_type,
+					typename pack_evaluatable<typename vec::fused_index_evaluator<T, U>::second_type>::value_type> >
+    {
+	typedef typename pack_evaluatable<typename vec::fused_index_evaluator<T, U>::first_type>::value_type value_type;
+    };
+
+}} // namespace mtl::simd
+
+#endif // MTL_VECTOR_SIMD_KERNELS_INCLUDE
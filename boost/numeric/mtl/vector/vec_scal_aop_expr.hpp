@@ -14,8 +14,10 @@
 #define MTL_VEC_SCAL_AOP_EXPR_INCLUDE
 
 #include <boost/numeric/mtl/utility/exception.hpp>
+#include <boost/numeric/mtl/utility/tag.hpp>
 #include <boost/numeric/mtl/vector/vec_expr.hpp>
 #include <boost/numeric/mtl/operation/sfunctor.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 
@@ -44,6 +46,11 @@ struct vec_scal_aop_expr
       : first( v1 ), second( v2 ), delayed_assign( delay ), with_comma( false ), index(0)
     {}
 
+    /// Evaluator for a part of the indices in parallel evaluation
+    vec_scal_aop_expr(const self& src, tag::split)
+      : first(src.first), second(src.second), delayed_assign(true), with_comma(false), index(0)
+    {}
+
     ~vec_scal_aop_expr()
     {
 	if (!delayed_assign) {
@@ -51,10 +58,23 @@ struct vec_scal_aop_expr
 	    if (with_comma) {
 		MTL_DEBUG_THROW_IF(index != mtl::vec::size(first), incompatible_size("Not all vector entries initialized!"));
 	    } else
-		for (size_type i= 0; i < mtl::vec::size(first); ++i)
-		    SFunctor::apply( first(i), second );
+		assign(simd::scal_assignable<E1, E2, SFunctor>());
 	}
     }
+
+  private:
+    void assign(boost::mpl::false_)
+    {
+	for (size_type i= 0; i < mtl::vec::size(first); ++i)
+	    SFunctor::apply( first(i), second );
+    }
+
+    void assign(boost::mpl::true_) // Contiguous vectors with SIMD packs
+    {
+	simd::assign_scalar<SFunctor>(first, second, 0, mtl::vec::size(first));
+    }
+
+  public:
     
     void delay_assign() const 
     { 
@@ -84,6 +104,17 @@ struct vec_scal_aop_expr
 	return SFunctor::apply(first(i+Offset), second);
     }
 
+    /// Evaluate the SIMD pack of entries starting at i + Offset * simd::pack<value_type>::size (only if simd::pack_evaluatable)
+    template <unsigned Offset>
+    void pack_at(size_type i) const
+    {
+	assert(delayed_assign);
+	i+= Offset * simd::pack<value_type>::size;
+	simd::assign_op<SFunctor>::apply(first.address_data() + i, simd::pack<value_type>(value_type(second)));
+    }
+
+    void join(const self&) const {} ///< Nothing to combine in parallel evaluation
+
     template <typename Source>
     self& operator, (Source val)
     {
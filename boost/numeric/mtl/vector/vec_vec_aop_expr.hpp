@@ -26,6 +26,8 @@
 #include <boost/numeric/mtl/concept/collection.hpp>
 #include <boost/numeric/mtl/utility/unroll_size1.hpp>
 #include <boost/numeric/mtl/utility/with_unroll1.hpp>
+#include <boost/numeric/mtl/utility/roofline_counts.hpp>
+#include <boost/numeric/mtl/vector/simd_kernels.hpp>
 #include <boost/numeric/mtl/interface/vpt.hpp>
 
 namespace mtl { namespace vec {
@@ -79,6 +81,9 @@ struct vec_vec_aop_expr
         MTL_DEBUG_THROW_IF(!compatible,  incompatible_size());
 	second.delay_assign();
     }
+
+    /// Evaluator for a part of the indices in parallel evaluation
+    vec_vec_aop_expr(const self& src, tag::split) : first(src.first), second(src.second), delayed_assign(true) {}
     
   private:
     void dynamic_assign(boost::mpl::false_) // Without unrolling
@@ -132,11 +137,36 @@ struct vec_vec_aop_expr
 	//int b= second;
 	if (mtl::vec::size(first) == 0) 
             first.change_dim(mtl::size(second));
+	const bool update= mtl::traits::roofline_update<SFunctor>::value;
+	roofline<2017> roof(mtl::traits::roofline_vector_flops(second) + (update ? mtl::size(second) : 0),
+			    mtl::traits::roofline_vector_bytes(second, sizeof(value_type))
+			    + mtl::traits::roofline_target_bytes(first, update));
+
+	packed_assign(simd::vec_assignable<E1, E2, SFunctor>());
+    }
 
+    void packed_assign(boost::mpl::false_)
+    {
 	// need to do more benchmarking before making unrolling default
 	dynamic_assign(traits::with_unroll1<E1>());
     }
 
+    void packed_assign(boost::mpl::true_) // Contiguous vectors with SIMD packs
+    {
+	const std::size_t s= mtl::vec::size(first);
+      #ifdef MTL_WITH_OPENMP
+	# pragma omp parallel
+	{
+	    vampir_trace<8003> tracer;
+	    std::size_t from, to;
+	    simd::thread_block(s, from, to);
+	    simd::assign<SFunctor>(first, second, from, to);
+	}
+      #else
+	simd::assign<SFunctor>(first, second, 0, s);
+      #endif
+    }
+
     void assign(boost::mpl::true_)
     {
 	vampir_trace<1001> tracer;	
@@ -164,6 +194,17 @@ struct vec_vec_aop_expr
 
     value_type& operator[] (size_type i) const { return (*this)(i); }
 
+    /// Evaluate the SIMD pack of entries starting at i + Offset * simd::pack<value_type>::size (only if simd::pack_evaluatable)
+    template <unsigned Offset>
+    void pack_at(size_type i) const
+    {
+	assert(delayed_assign);
+	i+= Offset * simd::pack<value_type>::size;
+	simd::assign_op<SFunctor>::apply(first.address_data() + i, simd::load<simd::pack<value_type> >(second, i));
+    }
+
+    void join(const self&) const {} ///< Nothing to combine in parallel evaluation
+
     template <unsigned Offset>
     value_type& at(size_type i) const { 
 	assert(delayed_assign);
@@ -0,0 +1,139 @@
+// Software License for MTL
+// 
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+// 
+// This file is part of the Matrix Template Library
+// 
+// See also license.mtl.txt in the distribution.
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+typedef mtl::dense_vector<double>                  vector_type;
+typedef mtl::dense_vector<std::complex<double> >   cvector_type;
+typedef mtl::mat::multi_vector<vector_type>        multi_vector_type;
+
+bool greater_magnitude(const std::complex<double>& x, const std::complex<double>& y)
+{   return std::abs(x) > std::abs(y); }
+
+// Q orthonormal and A Q = Q H up to the residual in the last column
+template <typename Matrix>
+void check_subspace(const Matrix& A, const multi_vector_type& Q, const mtl::dense2D<double>& H, double tol)
+{
+    const std::size_t k= num_cols(Q);
+    for (std::size_t j= 0; j < k; j++) {
+	vector_type r(A * Q.vector(j));
+	for (std::size_t i= 0; i < k; i++) {
+	    r-= H[i][j] * Q.vector(i);
+	    MTL_THROW_IF(std::abs(dot(Q.vector(i), Q.vector(j)) - (i == j ? 1.0 : 0.0)) > 1e-8, mtl::unexpected_result());
+	}
+	mtl::io::tout << "|A q_" << j << " - Q h_" << j << "| = " << two_norm(r) << '\n';
+	MTL_THROW_IF(two_norm(r) > tol, mtl::unexpected_result());
+    }
+}
+
+int main(int, char**)
+{
+    // Block upper triangular matrix with known eigenvalues: 2 x 2 diagonal blocks
+    // [a b; -b a] with eigenvalues a +/- ib or diag(a, a/2), coupled by entries above the blocks
+    const int N= 300, nev= 7;
+    mtl::compressed2D<double> A(N, N);
+    std::vector<std::complex<double> > ev;
+    {
+	mtl::mat::inserter<mtl::compressed2D<double> > ins(A, 6);
+	for (int p= 0; p < N / 2; p++) {
+	    int i= 2 * p;
+	    double a= 0.5 + 0.05 * p, b= 0.2 + 0.002 * p;
+	    if (p % 3 == 0) {
+		ins[i][i] << a; ins[i+1][i+1] << a / 2;
+		ev.push_back(a); ev.push_back(a / 2);
+	    } else {
+		ins[i][i] << a; ins[i][i+1] << b; ins[i+1][i] << -b; ins[i+1][i+1] << a;
+		ev.push_back(std::complex<double>(a, b)); ev.push_back(std::complex<double>(a, -b));
+	    }
+	    if (i + 3 < N) {
+		ins[i][i+2] << 0.1; ins[i+1][i+3] << 0.05;
+	    }
+	}
+    }
+    std::stable_sort(ev.begin(), ev.end(), greater_magnitude);
+
+    vector_type                 v0(N, 1.0);
+    cvector_type                lambda;
+    multi_vector_type           Q;
+    mtl::dense2D<double>        H(0, 0);
+    for (int i= 0; i < N; i++)
+	v0[i]+= 0.01 * (i % 5);
+
+    mtl::io::tout << "Eigenvalues of largest magnitude:\n";
+    itl::basic_iteration<double> iter(1.0, 500, 1e-10);
+    arnoldi(A, v0, nev, lambda, Q, H, iter, itl::largest_magnitude, 30);
+    MTL_THROW_IF(!iter.is_converged(), mtl::unexpected_result());
+    mtl::io::tout << "lambda = " << lambda << ", after " << iter.iterations() << " restarts\n";
+    for (int i= 0; i < nev; i++) {
+	// conjugate pairs are ordered positive imaginary part first in both lists
+	std::complex<double> e= ev[i];
+	if (i + 1 < nev && std::abs(ev[i]) == std::abs(ev[i+1]) && ev[i].imag() < ev[i+1].imag())
+	    e= ev[i+1];
+	else if (i > 0 && std::abs(ev[i]) == std::abs(ev[i-1]) && ev[i].imag() > ev[i-1].imag())
+	    e= ev[i-1];
+	MTL_THROW_IF(std::abs(lambda[i] - e) > 1e-7, mtl::unexpected_result());
+    }
+    check_subspace(A, Q, H, 1e-7 * num_cols(Q));
+
+    mtl::io::tout << "Symmetric case compared with lanczos:\n";
+    mtl::compressed2D<double> L(N, N);
+    laplacian_setup(L, 15, 20);
+    vector_type               mu;
+    itl::basic_iteration<double> iter2(1.0, 500, 1e-10), iter3(1.0, 500, 1e-10);
+    lanczos(L, v0, 4, mu, iter2, itl::smallest_real);
+    arnoldi(L, v0, 4, lambda, iter3, itl::smallest_real);
+    MTL_THROW_IF(!iter2.is_converged() || !iter3.is_converged(), mtl::unexpected_result());
+    mtl::io::tout << "lanczos: " << mu << "\narnoldi: " << lambda << '\n';
+    for (int i= 0; i < 4; i++)
+	MTL_THROW_IF(std::abs(lambda[i] - mu[i]) > 1e-7, mtl::unexpected_result());
+
+    mtl::io::tout << "One eigenvalue of a rotation, the conjugate pair fills the basis:\n";
+    mtl::dense2D<double> R(2, 2);
+    R= 0.0;
+    R[0][1]= -1.0; R[1][0]= 1.0;
+    vector_type r0(2, 1.0);
+    itl::basic_iteration<double> iter4(1.0, 10, 1e-10);
+    arnoldi(R, r0, 1, lambda, Q, H, iter4, itl::largest_magnitude, 2);
+    mtl::io::tout << "lambda = " << lambda << ", " << num_cols(Q) << " basis vectors\n";
+    MTL_THROW_IF(!iter4.is_converged() || num_cols(Q) != 2, mtl::unexpected_result());
+    MTL_THROW_IF(std::abs(std::abs(lambda[0]) - 1.0) > 1e-10 || std::abs(lambda[0].real()) > 1e-10, mtl::unexpected_result());
+    check_subspace(R, Q, H, 1e-10);
+
+    mtl::io::tout << "Basis of nev + 1 vectors where the last wanted value is half of a conjugate pair:\n";
+    mtl::dense2D<double> C(8, 8);
+    C= 0.0;
+    C[0][0]= 4.0; C[0][1]= 1.0; C[1][0]= -1.0; C[1][1]= 4.0;
+    C[2][2]= 3.0; C[2][3]= 1.0; C[3][2]= -1.0; C[3][3]= 3.0;
+    C[4][4]= 1.0; C[4][5]= 0.5; C[5][4]= -0.5; C[5][5]= 1.0;
+    C[6][6]= 0.5; C[7][7]= 0.2;
+    for (int i= 0; i + 2 < 8; i++)
+	C[i][i+2]= 0.1;
+    vector_type c0(8, 1.0);
+    for (int i= 0; i < 8; i++)
+	c0[i]+= 0.1 * i;
+    itl::basic_iteration<double> iter5(1.0, 500, 1e-10);
+    arnoldi(C, c0, 3, lambda, Q, H, iter5, itl::largest_magnitude, 4);
+    mtl::io::tout << "lambda = " << lambda << ", " << num_cols(Q) << " basis vectors\n";
+    MTL_THROW_IF(!iter5.is_converged() || size(lambda) != 3 || num_cols(Q) != 4, mtl::unexpected_result());
+    MTL_THROW_IF(std::abs(lambda[0] - std::complex<double>(4.0, 1.0)) > 1e-7
+		 || std::abs(lambda[1] - std::complex<double>(4.0, -1.0)) > 1e-7
+		 || std::abs(lambda[2] - std::complex<double>(3.0, 1.0)) > 1e-7, mtl::unexpected_result());
+    check_subspace(C, Q, H, 1e-7);
+
+    return 0;
+}
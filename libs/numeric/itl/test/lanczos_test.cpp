@@ -0,0 +1,89 @@
+// Software License for MTL
+// 
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+// 
+// This file is part of the Matrix Template Library
+// 
+// See also license.mtl.txt in the distribution.
+
+#include <cmath>
+#include <iostream>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+typedef mtl::dense_vector<double>           vector_type;
+typedef mtl::mat::multi_vector<vector_type> multi_vector_type;
+
+// |A x_i - lambda_i x_i| <= tol |lambda_i| and orthonormal eigenvectors
+template <typename Matrix>
+void check_pairs(const Matrix& A, const vector_type& lambda, const multi_vector_type& X, double tol)
+{
+    for (std::size_t i= 0; i < size(lambda); i++) {
+	vector_type r(A * X.vector(i));
+	r-= lambda[i] * X.vector(i);
+	mtl::io::tout << "lambda[" << i << "] = " << lambda[i] << ", residual = " << two_norm(r) << '\n';
+	MTL_THROW_IF(two_norm(r) > tol * std::max(std::abs(lambda[i]), 1.0), mtl::unexpected_result());
+	for (std::size_t j= 0; j <= i; j++)
+	    MTL_THROW_IF(std::abs(dot(X.vector(i), X.vector(j)) - (i == j ? 1.0 : 0.0)) > 1e-8, mtl::unexpected_result());
+    }
+}
+
+// compare with the dense eigenvalues from first on (ascending) or from last downwards
+void check_values(const vector_type& lambda, const vector_type& ref, bool ascending, double tol)
+{
+    for (std::size_t i= 0, n= size(ref); i < size(lambda); i++) {
+	double expected= ascending ? ref[i] : ref[n - 1 - i];
+	MTL_THROW_IF(std::abs(lambda[i] - expected) > tol * std::max(std::abs(expected), 1.0), mtl::unexpected_result());
+    }
+}
+
+int main(int, char**)
+{
+    const int                   m= 15, n= 20, N= m * n, nev= 6;
+    typedef mtl::compressed2D<double> matrix_type;
+    matrix_type                 A(N, N);
+    laplacian_setup(A, m, n);
+
+    mtl::dense2D<double>        D(N, N);
+    vector_type                 ref(N), lambda, v0(N, 1.0);
+    multi_vector_type           X;
+    D= A;
+    mtl::mat::eigen_symmetric(D, ref);
+    for (int i= 0; i < N; i++)
+	v0[i]+= 0.01 * (i % 7);
+
+    mtl::io::tout << "Largest eigenvalues of the Laplacian:\n";
+    itl::basic_iteration<double> iter(1.0, 300, 1e-10);
+    lanczos(A, v0, nev, lambda, X, iter, itl::largest_real);
+    MTL_THROW_IF(!iter.is_converged(), mtl::unexpected_result());
+    check_values(lambda, ref, false, 1e-8);
+    check_pairs(A, lambda, X, 1e-7);
+
+    mtl::io::tout << "Smallest eigenvalues by shift-invert around 0:\n";
+    itl::cg_solver<matrix_type, itl::pc::ic_0<matrix_type> > solver(A);
+    solver.iteration_ref().set_max_iterations(1000);
+    solver.set_log_level(0);
+    itl::shift_invert<itl::cg_solver<matrix_type, itl::pc::ic_0<matrix_type> > > op(solver, N, 0.0);
+    itl::basic_iteration<double> iter2(1.0, 50, 1e-10);
+    vector_type theta;
+    lanczos(op, v0, nev, theta, X, iter2, itl::largest_magnitude);
+    MTL_THROW_IF(!iter2.is_converged(), mtl::unexpected_result());
+    mtl::io::tout << "shift-invert needed " << iter2.iterations() << " restarts\n";
+    for (int i= 0; i < nev; i++)
+	theta[i]= op.eigenvalue(theta[i]);
+    check_values(theta, ref, true, 1e-7);
+    check_pairs(A, theta, X, 1e-6);
+
+    mtl::io::tout << "Matrix-free operator without eigenvectors:\n";
+    mtl::mat::poisson2D_dirichlet P(m, n);
+    itl::basic_iteration<double> iter3(1.0, 300, 1e-10);
+    lanczos(P, v0, nev, lambda, iter3, itl::largest_real, 30);
+    MTL_THROW_IF(!iter3.is_converged(), mtl::unexpected_result());
+    check_values(lambda, ref, false, 1e-8);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Software License for MTL
+// 
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+// 
+// This file is part of the Matrix Template Library
+// 
+// See also license.mtl.txt in the distribution.
+
+#include <cmath>
+#include <iostream>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+typedef mtl::dense_vector<double>           vector_type;
+typedef mtl::mat::multi_vector<vector_type> multi_vector_type;
+typedef mtl::compressed2D<double>           matrix_type;
+
+void start_block(multi_vector_type& X)
+{
+    for (std::size_t j= 0; j < num_cols(X); j++)
+	for (std::size_t i= 0; i < num_rows(X); i++)
+	    X.vector(j)[i]= std::cos(double(i * (j + 1)) + 0.3 * j) + 0.1;
+}
+
+// residuals and B-orthonormality, eigenvalues compared with ascending reference
+template <typename MatrixA, typename MatrixB>
+void check(const MatrixA& A, const MatrixB& B, const multi_vector_type& X, const vector_type& lambda, const vector_type& ref)
+{
+    for (std::size_t j= 0; j < size(lambda); j++) {
+	vector_type r(A * X.vector(j)), bx(B * X.vector(j));
+	r-= lambda[j] * bx;
+	mtl::io::tout << "lambda[" << j << "] = " << lambda[j] << " (" << ref[j] << "), residual = " << two_norm(r) << '\n';
+	MTL_THROW_IF(std::abs(lambda[j] - ref[j]) > 1e-8 * std::abs(ref[j]), mtl::unexpected_result());
+	MTL_THROW_IF(two_norm(r) > 1e-6 * std::abs(lambda[j]), mtl::unexpected_result());
+	for (std::size_t i= 0; i <= j; i++)
+	    MTL_THROW_IF(std::abs(dot(X.vector(i), bx) - (i == j ? 1.0 : 0.0)) > 1e-8, mtl::unexpected_result());
+    }
+}
+
+int main(int, char**)
+{
+    const int                   m= 30, n= 25, N= m * n, k= 5;
+    matrix_type                 A(N, N), M(N, N), I(N, N);
+    laplacian_setup(A, m, n);
+    I= 1;
+
+    vector_type                 ref(N), lambda, mass(N);
+    multi_vector_type           X(vector_type(N), k);
+    mtl::dense2D<double>        D(N, N);
+    D= A;
+    mtl::mat::eigen_symmetric(D, ref);
+
+    mtl::io::tout << "Smallest eigenvalues of the Laplacian with IC(0):\n";
+    start_block(X);
+    itl::pc::ic_0<matrix_type>   ic(A);
+    itl::basic_iteration<double> iter(1.0, 500, 1e-9);
+    lobpcg(A, X, lambda, ic, iter);
+    mtl::io::tout << iter.iterations() << " iterations\n";
+    MTL_THROW_IF(!iter.is_converged(), mtl::unexpected_result());
+    check(A, I, X, lambda, ref);
+
+    mtl::io::tout << "Generalized problem with diagonal mass matrix:\n";
+    {
+	mtl::mat::inserter<matrix_type> ins(M, 1);
+	for (int i= 0; i < N; i++)
+	    ins[i][i] << (mass[i]= 1.0 + 0.5 * std::sin(0.1 * i));
+    }
+    for (int i= 0; i < N; i++)        // M^{-1/2} A M^{-1/2} has the same eigenvalues
+	for (int j= 0; j < N; j++)
+	    D[i][j]= A[i][j] / std::sqrt(mass[i] * mass[j]);
+    mtl::mat::eigen_symmetric(D, ref);
+
+    start_block(X);
+    itl::basic_iteration<double> iter2(1.0, 500, 1e-9);
+    lobpcg(A, M, X, lambda, ic, iter2);
+    mtl::io::tout << iter2.iterations() << " iterations\n";
+    MTL_THROW_IF(!iter2.is_converged(), mtl::unexpected_result());
+    check(A, M, X, lambda, ref);
+
+    mtl::io::tout << "Matrix-free operator without preconditioner:\n";
+    const int                      s= 12;
+    mtl::mat::poisson2D_dirichlet  P(s, s);
+    matrix_type                    L(s * s, s * s), J(s * s, s * s);
+    laplacian_setup(L, s, s);
+    J= 1;
+    mtl::dense2D<double>           E(s * s, s * s);
+    vector_type                    ref2(s * s);
+    E= L;
+    mtl::mat::eigen_symmetric(E, ref2);
+
+    multi_vector_type              Y(vector_type(s * s), 3);
+    start_block(Y);
+    itl::basic_iteration<double>   iter3(1.0, 1000, 1e-9);
+    lobpcg(P, Y, lambda, iter3);
+    mtl::io::tout << iter3.iterations() << " iterations\n";
+    MTL_THROW_IF(!iter3.is_converged(), mtl::unexpected_result());
+    check(L, J, Y, lambda, ref2);
+
+    return 0;
+}
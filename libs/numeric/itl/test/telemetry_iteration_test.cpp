@@ -0,0 +1,120 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+
+typedef mtl::compressed2D<double> matrix_type;
+const int size= 10, N= size * size;
+
+void test_cg()
+{
+    matrix_type                 A;
+    laplacian_setup(A, size, size);
+    itl::pc::ilu_0<matrix_type> P(A);
+    mtl::dense_vector<double>   x(N, 1.0), b(N);
+    b= A * x;
+    x= 0;
+
+    itl::telemetry_iteration<double> iter(b, 500, 1.e-8);
+    cg(A, x, b, P, iter);
+    const itl::solver_record& rec= iter.record();
+
+    MTL_THROW_IF(!iter.is_converged(), mtl::runtime_error("cg converged"));
+    MTL_THROW_IF(rec.phase_count(itl::phase::setup) != 1, mtl::runtime_error("one setup"));
+    MTL_THROW_IF(rec.phase_count(itl::phase::spmv) != (unsigned long)iter.iterations(), mtl::runtime_error("one spmv per iteration"));
+    MTL_THROW_IF(rec.phase_count(itl::phase::preconditioner) != (unsigned long)iter.iterations(), mtl::runtime_error("one preconditioning per iteration"));
+    MTL_THROW_IF(rec.phase_count(itl::phase::convergence_check) != (unsigned long)iter.iterations() + 1, mtl::runtime_error("one check per iteration"));
+    MTL_THROW_IF(rec.residual_history().size() != std::size_t(iter.iterations() + 1), mtl::runtime_error("residual history"));
+    MTL_THROW_IF(rec.residual_history().back().resid != iter.resid(), mtl::runtime_error("last residual"));
+    MTL_THROW_IF(rec.residual_history().front().iteration != 0, mtl::runtime_error("first residual"));
+
+    double sum= 0.0;
+    for (int p= 0; p < itl::phase::number; p++)
+	sum+= rec.phase_time(itl::phase::type(p));
+    MTL_THROW_IF(std::abs(sum - rec.time()) > 1e-9 * rec.time() + 1e-12, mtl::runtime_error("time of phases"));
+
+    std::ostringstream os;
+    iter.write_json(os);
+    mtl::io::tout << os.str();
+    MTL_THROW_IF(!(os.str().find("\"converged\":true") != std::string::npos && os.str().find("\"spmv\":{") != std::string::npos
+		   && os.str().find("\"residuals\":[[0,") != std::string::npos), mtl::runtime_error("JSON"));
+
+    iter.clear_record();
+    MTL_THROW_IF(!(iter.record().residual_history().empty() && iter.record().time() == 0.0), mtl::runtime_error("cleared record"));
+}
+
+void test_gmres()
+{
+    matrix_type                 A;
+    laplacian_setup(A, size, size);
+    itl::pc::identity<matrix_type> I(A);
+    mtl::dense_vector<double>   x(N, 1.0), b(N);
+    b= A * x;
+    x= 0;
+
+    // Inner iterations of restarted GMRES share the record
+    itl::telemetry_iteration<double, itl::cyclic_iteration<double> > iter(b, 50, 1.e-8, 0.0, 1000);
+    gmres(A, x, b, I, I, iter, 10);
+    const itl::solver_record& rec= iter.record();
+
+    MTL_THROW_IF(!(iter.iterations() > 10 && rec.phase_count(itl::phase::setup) > 1), mtl::runtime_error("setup per restart"));
+    MTL_THROW_IF(rec.phase_count(itl::phase::orthogonalization) < (unsigned long)iter.iterations(), mtl::runtime_error("orthogonalization"));
+    MTL_THROW_IF(rec.residual_history().size() <= std::size_t(iter.iterations()), mtl::runtime_error("residual estimates"));
+}
+
+void test_other_solvers()
+{
+    matrix_type                 A;
+    laplacian_setup(A, size, size);
+    itl::pc::identity<matrix_type> I(A);
+    mtl::dense_vector<double>   x(N, 1.0), b(N);
+    b= A * x;
+
+    x= 0;
+    itl::telemetry_iteration<double> iter1(b, 500, 1.e-8);
+    bicgstab(A, x, b, I, iter1);
+    MTL_THROW_IF(!(iter1.is_converged() && iter1.record().phase_count(itl::phase::spmv) > 0), mtl::runtime_error("bicgstab"));
+
+    x= 0;
+    itl::telemetry_iteration<double> iter2(b, 500, 1.e-8);
+    cgs(A, x, b, I, iter2);
+    MTL_THROW_IF(!(iter2.is_converged() && iter2.record().phase_count(itl::phase::preconditioner) > 0), mtl::runtime_error("cgs"));
+
+    x= 0;
+    itl::telemetry_iteration<double> iter3(b, 500, 1.e-8);
+    bicg(A, x, b, I, iter3);
+    MTL_THROW_IF(!(iter3.is_converged() && iter3.record().phase_count(itl::phase::orthogonalization) > 0), mtl::runtime_error("bicg"));
+
+    // Uninstrumented solver: only the termination checks are recorded
+    x= 0;
+    itl::telemetry_iteration<double> iter4(b, 500, 1.e-8);
+    tfqmr(A, x, b, I, I, iter4);
+    MTL_THROW_IF(!(iter4.record().phase_count(itl::phase::spmv) == 0 && !iter4.record().residual_history().empty()), mtl::runtime_error("tfqmr"));
+}
+
+#endif
+
+int main(int, char**)
+{
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+    test_cg();
+    test_gmres();
+    test_other_solvers();
+#endif
+    return 0;
+}
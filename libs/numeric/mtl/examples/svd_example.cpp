@@ -12,7 +12,7 @@ int main(int, char**)
     A[2][0]=9;  A[2][1]=3;  A[2][2]=2;  A[2][3]=4;       
     std::cout<<"A=\n"<< A <<"\n";
 
-    boost::tie(S, V, D)= svd(A, 1.e-10)= svd(A);  //second argument is optional (missmatch of upper R (A= Q*R))
+    boost::tie(S, V, D)= svd(A, 1.e-10)= svd(A);  // second argument is optional and only kept for backward compatibility
     std::cout<<"Matrix  S=\n"<< S <<"\n";
     std::cout<<"Matrix  V=\n"<< V <<"\n";
     std::cout<<"Matrix  D=\n"<< D <<"\n";
@@ -1242,6 +1242,21 @@ This will change when dense banded matrices are realized (then \ref banded witho
 densely banded).
 To prevent this type change, we added the \ref sparse attribute in B's declaration.
 
+Which of these formats is the fastest in matrix-vector products depends on the sparsity structure.
+The function mat::analyze_structure in boost/numeric/mtl/operation/structure_analysis.hpp computes
+row-length statistics, bandwidth, diagonal dominance, symmetry, block structure and the locality of the column accesses
+of a matrix and recommends the format with the least memory traffic.
+mat::time_formats confirms the recommendation by timing the candidates on the actual matrix
+and mat::with_recommended_format calls a functor with the matrix converted to the recommended format.
+The program analyze_matrix in libs/numeric/mtl/timing does the same for Matrix Market files.
+
+For matrices that are multiplied many times, e.g. in iterative solvers,
+mat::auto_tuned_matrix in boost/numeric/mtl/matrix/auto_tuned_matrix.hpp (C++11) goes one step further:
+it is constructed from a row-major compressed2D, times the product with CRS in different row unrollings,
+ELLPACK, sliced ELLPACK and blocked CRS -- with OpenMP also different schedules -- and keeps only the fastest layout.
+The selection mat::spmv_tuning can be passed to the constructor of the next run or stored in a file
+given as second constructor argument so that the tuning is skipped when the matrix has the same size and number of non-zeros.
+
 
 \section type_generator_morton Morton-order Matrices
 
@@ -2373,6 +2388,20 @@ the matrix in Hessenberg form for the QR-Algorithm, and this is stored as a dens
 For example:
 \include eigenvalue_symmetric_example.cpp
 
+For larger matrices and when eigenvectors are needed, the symmetric eigen-pipeline is much faster:
+\code
+  eigen_symmetric(A, lambda, Q);                      // all eigenpairs
+  eigen_symmetric(A, lambda);                         // eigenvalues only
+  eigen_symmetric_range(A, first, last, lambda, Q);   // eigenpairs with indices in [first, last)
+  eigen_symmetric_range(A, first, last, lambda);      // eigenvalues with indices in [first, last)
+\endcode
+The eigenvalues are returned in ascending order and the eigenvectors as columns of Q.
+A is first reduced to tridiagonal form by blocked Householder reflections (mat::tridiagonalize).
+The eigenpairs of the tridiagonal matrix are computed with Cuppen's divide and conquer algorithm 
+(mat::cuppen_tridiagonal) whose independent sub-problems run in parallel when OpenMP is enabled.
+Finally, the eigenvectors are transformed back with matrix products.
+Without eigenvectors, the implicit QL algorithm is used for all eigenvalues and bisection for a range of them.
+
 \subsection eigenvalue_nonsymm Non-symmetric Real Matrices
 
 Likewise, the eigenvalues of non-symmetric matrices can be computed with the mat::eigenvalue_solver:
@@ -2392,6 +2421,28 @@ Whereas mat::qr_algo bases on Householder transformation and is more appropriate
 more less dense matrices,
 mat::qr_givens is more suitable for triangular matrices.
 
+\subsection eigenvalue_sparse Few Eigenvalues of Large Sparse Matrices
+
+When only a few eigenpairs of a large (sparse or matrix-free) operator are needed,
+the implicitly restarted Lanczos (symmetric) and Arnoldi (non-symmetric) methods from ITL
+only need matrix-vector products and memory for a basis of ncv vectors:
+\code
+  itl::basic_iteration<double> iter(1.0, 300, 1e-10);  // at most 300 restarts, relative tolerance
+  itl::lanczos(A, v0, nev, lambda, X, iter, itl::largest_real);     // X is a multi_vector
+  itl::arnoldi(A, v0, nev, lambda_c, Q, H, iter);                   // complex eigenvalues, A Q = Q H
+\endcode
+Eigenvalues close to a shift sigma are found fast with the operator itl::shift_invert that applies
+a linear solver for A - sigma I, e.g. an itl::cg_solver; its eigenvalues theta are
+mapped back with its member function eigenvalue(theta).
+
+For the smallest eigenpairs of symmetric (generalized) problems A x = lambda B x with B positive definite,
+the preconditioned block method itl::lobpcg usually converges much faster:
+\code
+  mtl::multi_vector<Vector>    X(Vector(n), nev);               // start block, eigenvectors on exit
+  itl::pc::ic_0<Matrix>        P(A);
+  itl::lobpcg(A, B, X, lambda, P, iter);                        // or lobpcg(A, X, lambda, P, iter) for B = I
+\endcode
+
 \section Singular Value Decomposition
 
 A singular value decomposition of an \f$ m\times n \f$ real or complex matrix M is a factorization of the form
@@ -2410,7 +2461,18 @@ or
 \code
   boost::tie(S, V, D)= svd(A);
 \endcode
-The second argument is optional and defines the missmatch of upper R (A= Q*R).
+The second argument is optional and only kept for backward compatibility.
+The decomposition is computed by Householder bidiagonalization followed by implicitly shifted
+QR sweeps on the bidiagonal matrix (Golub-Kahan-Reinsch) and is accurate to machine precision.
+If only the singular values are needed, the singular vectors are not accumulated with
+\code
+  dense_vector<double> sigma(singular_values(A));
+\endcode
+which returns them in descending order.
+For matrices far from square the thin decomposition with \f$ k= \min(m, n) \f$ columns in U and V is cheaper:
+\code
+  boost::tie(U, S, V)= svd_thin(A);  // U: m x k, S: k x k, V: n x k
+\endcode
 At the moment all four matrices have the same type. If A is a dense2D-matrix, then also U, 
 \f$ \Sigma \f$ and V are returned as dense2D matrix.
 Furthermore, this function works only for real matrices because
@@ -2719,6 +2781,15 @@ For cyclic and noisy iterations, one can declare on which ostream the informatio
 This enables printing it into log files or for parallel computing printing only on one processor.
 By default the output is printed into std::out.
 
+For performance analysis, the iteration object can be wrapped into a telemetry_iteration (C++11):
+itl::telemetry_iteration<double, itl::cyclic_iteration<double> > iter(b, 500, 1.e-6, 0.0, 50);
+takes the constructor arguments of the wrapped iteration type (basic_iteration by default).
+The solvers cg, bicg, cgs, bicgstab and gmres mark their phases (setup, spmv, preconditioner,
+orthogonalization, vector_update and convergence_check) and the iteration object records the time
+and number of each phase as well as the residual history in iter.record().
+With iter.write_json(os) or iter.write_json("solver.json") the record is exported as JSON.
+Other iteration types ignore the phase marks at compile time so that the solvers have no overhead.
+
 General assumptions on solver iterations:
 - 0th iteration is the starting residue.
 - Once the input value (x) is changed you have made at least one iteration.
@@ -3325,6 +3396,47 @@ the application with the flag:\n\n
 <tt>-DMTL_VPT_LEVEL=1</tt>\n\n
 or sets the flag with ccmake.
 
+\section vampir_builtin Built-in Tracing
+
+Without Vampir Trace, the same events can be recorded by MTL4 itself when the macro MTL_WITH_TRACE
+is defined (<tt>cmake -DENABLE_TRACE=True</tt>); this needs C++11.
+Each thread records the entries and ends of the traced functions with time stamps into its own ring buffer,
+whose size is set by MTL_TRACE_BUFFER_SIZE (default 2<sup>18</sup> events).
+When the buffer is full the oldest events are overwritten.
+MTL_VPT_LEVEL selects the traced events as above.
+Without MTL_WITH_TRACE and MTL_HAS_VPT the tracing objects are empty and cause no overhead.
+
+After the computation, the events are written as Chrome trace with mtl::vpt::write_chrome_trace
+(the file can be viewed with chrome://tracing or <a href="https://ui.perfetto.dev">Perfetto</a>),
+and mtl::vpt::print_trace_summary prints the number of calls as well as the total and the self time
+(i.e. without nested traced functions) per event.
+Alternatively, the environment variable MTL_TRACE_FILE names a file for the Chrome trace and
+MTL_TRACE_SUMMARY prints the summary to std::cerr; both at the end of the program.
+The names of the events are listed in boost/numeric/mtl/interface/vpt_names.hpp;
+the names of own events are set with mtl::vpt::set_trace_event_name (otherwise they are shown by number).
+
+With the additional macro MTL_TRACE_COUNTERS (on Linux), each event also records the cycles, instructions,
+and last-level cache misses of its thread with perf_event_open (see mtl::utility::perf_counter_t).
+The summary then shows the instructions per cycle and the memory traffic estimated from the cache misses.
+Since the counters are read with a system call, this is only suitable for coarse-grained events
+(e.g. with MTL_VPT_LEVEL=3).
+
+\section vampir_roofline Roofline Report
+
+The macro MTL_WITH_ROOFLINE (<tt>cmake -DENABLE_ROOFLINE=True</tt>, needs C++11) instruments the main kernels:
+the sparse matrix vector products of compressed2D, ell_matrix and sparse_banded, vector assignments,
+dot products and reductions, triangular solvers, and dense matrix products.
+Each kernel counts its floating point operations and the bytes it moves analytically
+from the sizes and the number of non-zeros (every matrix and vector entry is moved once),
+and measures its run time independently of MTL_VPT_LEVEL.
+mtl::vpt::print_roofline then shows for each kernel the achieved GFLOP/s and GB/s,
+the arithmetic intensity, and the fractions of the peak bandwidth and of the attainable performance
+in the roofline model.
+The machine peak is measured on first use with a STREAM triad and independent FMAs on SIMD packs;
+it can also be set with mtl::vpt::set_roofline_peak or the environment variable MTL_ROOFLINE_PEAK
+(e.g. <tt>MTL_ROOFLINE_PEAK=20,200</tt> for 20 GB/s and 200 GFLOP/s).
+When MTL_ROOFLINE_REPORT is set, the report is printed to std::cerr at the end of the program.
+
 \section vampir_rational Rational
 
 We considered passing the function name as argument to the constructor instead
@@ -0,0 +1,96 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cmath>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+namespace acc = mtl::accumulation;
+
+template <typename Value>
+void check(Value x, Value y, const char* what)
+{
+    if (x != y) {
+	mtl::io::tout << what << ": " << x << " should be " << y << '\n';
+	throw mtl::runtime_error("Wrong result with accumulation policy");
+    }
+}
+
+// Cancellation in the summation: 1e16 + 1 - 1e16 repeated
+void test_sum(std::size_t reps)
+{
+    mtl::dense_vector<double> v(3 * reps), ones(3 * reps, 1.0);
+    for (std::size_t i= 0; i < reps; i++)
+	v[3*i]= 1e16, v[3*i+1]= 1.0, v[3*i+2]= -1e16;
+    const double exact= double(reps);
+
+    mtl::io::tout << "plain sum = " << mtl::sum(v, acc::plain()) << ", kahan sum = " << mtl::sum(v, acc::kahan()) << '\n';
+    check(mtl::sum(v, acc::kahan()), exact, "kahan sum");
+    check(mtl::sum(v, acc::dot2()), exact, "dot2 sum");
+    check(dot(v, ones, acc::kahan()), exact, "kahan dot");
+    check(dot(v, ones, acc::dot2()), exact, "dot2 dot");
+    if (reps == 1)
+	check(mtl::sum(v, acc::plain()), 0.0, "plain sum"); // documents the cancellation
+}
+
+// Rounding errors in the products, only Dot2 is exact: (1 + 2^-27) * (1 - 2^-27) - 1 == -2^-54
+void test_products()
+{
+    const double e= std::ldexp(1.0, -27);
+    mtl::dense_vector<double> x(2), y(2);
+    x[0]= 1.0 + e; x[1]= 1.0;
+    y[0]= 1.0 - e; y[1]= -1.0;
+
+    mtl::io::tout << "plain dot = " << dot(x, y, acc::plain()) << ", dot2 dot = " << dot(x, y, acc::dot2()) << '\n';
+    check(dot(x, y, acc::dot2()), -std::ldexp(1.0, -54), "dot2 with product errors");
+    check(dot(x, y, acc::plain()), double(dot(x, y)), "plain dot");
+
+    mtl::dense_vector<double> z(3);
+    z[0]= 1e7 + 1.0; z[1]= 3.0; z[2]= -1e7;
+    check(unary_dot(z, acc::dot2()), 2e14 + 2e7 + 10.0, "dot2 unary_dot");
+    check(two_norm(z, acc::kahan()), std::sqrt(2e14 + 2e7 + 10.0), "kahan two_norm");
+}
+
+// Rows of [1e16, 1, -1e16] in a CRS matrix
+void test_matrix(std::size_t n)
+{
+    mtl::compressed2D<double> A(n, n + 2);
+    {
+	mtl::mat::inserter<mtl::compressed2D<double> > ins(A, 3);
+	for (std::size_t i= 0; i < n; i++) {
+	    ins[i][i] << 1e16; ins[i][i+1] << 1.0; ins[i][i+2] << -1e16;
+	}
+    }
+    mtl::dense_vector<double> x(n + 2, 1.0), y(n), z(n, 2.0);
+    mult(A, x, y, acc::kahan());
+    mult_add(A, x, z, acc::dot2());
+    for (std::size_t i= 0; i < n; i++) {
+	check(y[i], 1.0, "kahan matrix vector product");
+	check(z[i], 3.0, "dot2 incremental matrix vector product");
+    }
+    mult(A, x, y, acc::plain());
+    check(y[0], 0.0, "plain matrix vector product");
+}
+
+int main(int, char**)
+{
+    test_sum(1);
+    test_sum(5000);   // several blocks of the reduction
+    test_products();
+    test_matrix(100);
+
+    mtl::dense_vector<float> f(1000, 0.25f);
+    check(two_norm(f, acc::dot2()), float(std::sqrt(62.5)), "float dot2 two_norm");
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+using namespace std;
+namespace al = mtl::allocation;
+
+template <typename Policy>
+struct types
+{
+    typedef mtl::vec::parameters<mtl::tag::col_major, mtl::vec::non_fixed::dimension, false, std::size_t, Policy>  vpara;
+    typedef mtl::mat::parameters<mtl::tag::row_major, mtl::index::c_index, mtl::non_fixed::dimensions, false, std::size_t, Policy> mpara;
+    typedef mtl::dense_vector<double, vpara>  vector_type;
+    typedef mtl::dense2D<double, mpara>       dense_type;
+    typedef mtl::compressed2D<double, mpara>  sparse_type;
+};
+
+template <typename Policy>
+void test_policy(const char* name)
+{
+    mtl::io::tout << "Policy " << name << '\n';
+    typedef types<Policy> tt;
+    const std::size_t n= 1000;
+
+    typename tt::vector_type v(n, 2.0), w(v), u;
+    u= v + w;
+    MTL_THROW_IF(!(u[n-1] == 4.0 && size(u) == n), mtl::runtime_error("vector operations"));
+
+    mtl::dense_vector<double> d(v);   // different policy
+    MTL_THROW_IF(d[0] != 2.0, mtl::runtime_error("copy to default policy"));
+
+    typename tt::dense_type D(10, 10);
+    D= 3.0;
+    MTL_THROW_IF(!(D[4][4] == 3.0 && D[4][5] == 0.0), mtl::runtime_error("dense matrix"));
+
+    typename tt::sparse_type A(n, n);
+    A= 2.0;
+    typename tt::sparse_type B(A);
+    typename tt::vector_type y(B * v);
+    MTL_THROW_IF(!(y[n-1] == 4.0 && B.nnz() == n), mtl::runtime_error("sparse matrix"));
+}
+
+void test_aligned()
+{
+    typedef types<al::aligned>::vector_type vector_type;
+    vector_type v(1000, 1.0);
+    MTL_THROW_IF(reinterpret_cast<std::size_t>(&v[0]) % MTL_ALIGNMENT != 0, mtl::runtime_error("alignment of large vectors"));
+}
+
+// Temporaries of the loop body are recycled after the first iteration
+void test_arena()
+{
+    typedef types<al::pooled>::vector_type vector_type;
+    MTL_THROW_IF(al::arena::current() != 0, mtl::runtime_error("no arena outside scope"));
+
+    vector_type outlive;
+    {
+	al::arena a;
+	MTL_THROW_IF(al::arena::current() != &a, mtl::runtime_error("current arena"));
+	vector_type x(5000, 1.0);
+	for (int i= 0; i < 10; i++) {
+	    vector_type t1(x), t2(2.0 * x);
+	    x= t1 + t2;
+	}
+	MTL_THROW_IF(a.reuses() < 18, mtl::runtime_error("reuse of temporaries"));
+	MTL_THROW_IF(x[0] != 59049.0, mtl::runtime_error("values of recycled vectors"));
+
+	{
+	    al::arena inner(0); // caches nothing
+	    MTL_THROW_IF(al::arena::current() != &inner, mtl::runtime_error("nested arena"));
+	    for (int i= 0; i < 3; i++)
+		vector_type t(5000);
+	    MTL_THROW_IF(!(inner.reuses() == 0 && inner.cached_bytes() == 0), mtl::runtime_error("arena without cache"));
+	}
+	MTL_THROW_IF(al::arena::current() != &a, mtl::runtime_error("restored outer arena"));
+	outlive.change_dim(5000);
+	outlive= x;
+	MTL_THROW_IF(a.cached_bytes() <= 0, mtl::runtime_error("cached memory"));
+    }
+    MTL_THROW_IF(al::arena::current() != 0, mtl::runtime_error("arena removed"));
+    MTL_THROW_IF(outlive[0] != 59049.0, mtl::runtime_error("memory outliving arena"));
+
+    // Memory allocated before the arena and released in it is cached in its rounded size
+    vector_type* before= new vector_type(1001, 1.0);
+    {
+	al::arena a;
+	delete before;
+	vector_type larger(1008, 2.0);
+	MTL_THROW_IF(!(a.reuses() == 1 && larger[1007] == 2.0), mtl::runtime_error("reuse of memory from outside the arena"));
+    }
+}
+
+// The temporaries of CG come from the arena in the second solve
+void test_solver()
+{
+    typedef types<al::pooled>::vector_type   vector_type;
+    typedef types<al::pooled>::sparse_type   matrix_type;
+    const int size= 10, N= size * size;
+    matrix_type A(N, N);
+    laplacian_setup(A, size, size);
+    itl::pc::identity<matrix_type> P(A);
+
+    al::arena a;
+    vector_type x(N, 1.0), b(N);
+    b= A * x;
+    for (int k= 0; k < 2; k++) {
+	x= 0;
+	itl::basic_iteration<double> iter(b, 500, 1.e-10);
+	cg(A, x, b, P, iter);
+	MTL_THROW_IF(!iter.is_converged(), mtl::runtime_error("CG not converged"));
+    }
+    mtl::io::tout << "CG reused " << a.reuses() << " blocks\n";
+    MTL_THROW_IF(a.reuses() <= 0, mtl::runtime_error("reuse in solver"));
+}
+
+int main(int, char**)
+{
+    test_policy<al::heap>("heap");
+    test_policy<al::aligned>("aligned");
+    test_policy<al::first_touch>("first_touch");
+    test_policy<al::pooled>("pooled");
+    test_aligned();
+    test_arena();
+    test_solver();
+
+    return 0;
+}
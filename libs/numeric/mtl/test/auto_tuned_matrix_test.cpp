@@ -0,0 +1,194 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <boost/numeric/mtl/mtl.hpp>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <boost/numeric/mtl/matrix/auto_tuned_matrix.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+using namespace std;
+namespace spmv_kernel= mtl::mat::spmv_kernel;
+namespace spmv_schedule= mtl::mat::spmv_schedule;
+
+typedef mtl::compressed2D<double>               matrix_type;
+typedef mtl::mat::auto_tuned_matrix<double>     tuned_type;
+
+// Compare all assignment modes of T with A
+void check_products(const matrix_type& A, const tuned_type& T, const std::string& what)
+{
+    mtl::dense_vector<double> x(num_cols(A)), y(num_rows(A)), z(num_rows(A));
+    iota(x);
+    y= A * x;
+    z= T * x;
+    MTL_THROW_IF(two_norm(mtl::dense_vector<double>(z - y)) >= 1e-10 * two_norm(y), mtl::runtime_error((what + " assign").c_str()));
+    z+= T * x;
+    MTL_THROW_IF(two_norm(mtl::dense_vector<double>(z - 2.0 * y)) >= 1e-10 * two_norm(y), mtl::runtime_error((what + " plus").c_str()));
+    z-= T * x;
+    MTL_THROW_IF(two_norm(mtl::dense_vector<double>(z - y)) >= 1e-10 * two_norm(y), mtl::runtime_error((what + " minus").c_str()));
+}
+
+void test_variants(const matrix_type& A, const std::string& name)
+{
+    const mtl::mat::spmv_tuning variants[]= {
+	mtl::mat::spmv_tuning(spmv_kernel::crs), mtl::mat::spmv_tuning(spmv_kernel::crs_unrolled, 1),
+	mtl::mat::spmv_tuning(spmv_kernel::crs_unrolled, 4), mtl::mat::spmv_tuning(spmv_kernel::crs_unrolled, 8),
+	mtl::mat::spmv_tuning(spmv_kernel::ell), mtl::mat::spmv_tuning(spmv_kernel::sliced_ell, 8, spmv_schedule::serial),
+	mtl::mat::spmv_tuning(spmv_kernel::sliced_ell, 32, spmv_schedule::omp_static),
+	mtl::mat::spmv_tuning(spmv_kernel::blocked_crs, 2, spmv_schedule::serial),
+	mtl::mat::spmv_tuning(spmv_kernel::blocked_crs, 4, spmv_schedule::omp_dynamic) };
+
+    for (const mtl::mat::spmv_tuning& v0 : variants) {
+	mtl::mat::spmv_tuning v(v0);
+	v.rows= num_rows(A); v.cols= num_cols(A); v.nnz= A.nnz();
+	tuned_type T(A, v);
+	// Blocked CRS is only used when the blocks fit and are filled enough, otherwise the matrix is tuned
+	const bool blocked= v.kernel == spmv_kernel::blocked_crs,
+	           fits= !blocked || (num_rows(A) % v.parameter == 0 && num_cols(A) % v.parameter == 0);
+	MTL_THROW_IF(!((T.tuning().kernel == v.kernel && T.candidates().empty()) || (blocked && !T.candidates().empty())),
+		     mtl::runtime_error((name + " given variant used").c_str()));
+	MTL_THROW_IF(!(fits || !T.candidates().empty()), mtl::runtime_error((name + " unfit blocks rejected").c_str()));
+	check_products(A, T, name + ' ' + spmv_kernel::name(v.kernel));
+    }
+}
+
+void test_tuning(const matrix_type& A, const std::string& name)
+{
+    tuned_type T(A, 3);
+    MTL_THROW_IF(!(num_rows(T) == num_rows(A) && num_cols(T) == num_cols(A) && T.nnz() == A.nnz()), mtl::runtime_error((name + " dimensions").c_str()));
+    MTL_THROW_IF(T.candidates().size() < 5, mtl::runtime_error((name + " candidates").c_str()));
+    for (std::size_t i= 0; i < T.candidates().size(); i++) {
+	const mtl::mat::spmv_tuning& c= T.candidates()[i];
+	MTL_THROW_IF(c.seconds < T.tuning().seconds, mtl::runtime_error((name + " fastest selected").c_str()));
+	mtl::io::tout << spmv_kernel::name(c.kernel) << ' ' << c.parameter << ' ' << spmv_schedule::name(c.schedule)
+		      << ": " << c.seconds << "s\n";
+    }
+    check_products(A, T, name + " tuned");
+}
+
+void test_serialization(const matrix_type& A)
+{
+    mtl::mat::spmv_tuning t(spmv_kernel::sliced_ell, 8, spmv_schedule::omp_dynamic), u;
+    t.rows= 3; t.cols= 4; t.nnz= 5; t.seconds= 0.25;
+    std::stringstream ss;
+    t.write(ss);
+    u.read(ss);
+    MTL_THROW_IF(!(u.kernel == t.kernel && u.parameter == 8 && u.schedule == t.schedule && u.matches(3, 4, 5) && u.seconds == 0.25), mtl::runtime_error("round trip"));
+
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+    std::stringstream bad("mtl_spmv_tuning 1 3 4 5 csr 0 builtin 1.0");
+    bool thrown= false;
+    try { u.read(bad); } catch (mtl::io_error&) { thrown= true; }
+    MTL_THROW_IF(!thrown, mtl::runtime_error("unknown kernel"));
+
+    const char* unsupported[]= { "sliced_ell 16", "sliced_ell 0", "blocked_crs 3", "crs_unrolled 3" };
+    for (int i= 0; i < 4; i++) {
+	std::stringstream bad_parameter(std::string("mtl_spmv_tuning 1 3 4 5 ") + unsupported[i] + " serial 1.0");
+	thrown= false;
+	try { u.read(bad_parameter); } catch (mtl::io_error&) { thrown= true; }
+	MTL_THROW_IF(!thrown, mtl::runtime_error((std::string("unsupported parameter ") + unsupported[i]).c_str()));
+    }
+#endif
+
+    // Unsupported parameters given directly lead to tuning
+    mtl::mat::spmv_tuning v(spmv_kernel::sliced_ell, 16, spmv_schedule::serial);
+    v.rows= num_rows(A); v.cols= num_cols(A); v.nnz= A.nnz();
+    tuned_type T0(A, v, 1);
+    MTL_THROW_IF(T0.candidates().empty(), mtl::runtime_error("tuned for unsupported parameter"));
+    check_products(A, T0, "unsupported parameter");
+
+    // The first construction tunes and stores the selection, the second one takes it from the file
+    const std::string file_name("auto_tuned_matrix_test.tuning");
+    std::remove(file_name.c_str());
+    tuned_type T1(A, file_name, 2);
+    MTL_THROW_IF(T1.candidates().empty(), mtl::runtime_error("tuned without file"));
+    tuned_type T2(A, file_name, 2);
+    MTL_THROW_IF(!(T2.candidates().empty() && T2.tuning().kernel == T1.tuning().kernel
+		   && T2.tuning().parameter == T1.tuning().parameter), mtl::runtime_error("tuning from file"));
+    check_products(A, T2, "from file");
+
+    // A file for another matrix is replaced
+    matrix_type B(num_rows(A), num_cols(A));
+    B= 2.0;
+    tuned_type T3(B, file_name, 2);
+    MTL_THROW_IF(T3.candidates().empty(), mtl::runtime_error("tuned for other matrix"));
+    MTL_THROW_IF(!(t.load(file_name) && t.matches(num_rows(B), num_cols(B), B.nnz())), mtl::runtime_error("file updated"));
+    std::remove(file_name.c_str());
+}
+
+void test_solver(const matrix_type& A)
+{
+    tuned_type                         T(A, 2);
+    itl::pc::identity<tuned_type>      P(T);
+    mtl::dense_vector<double>          x(num_cols(A), 1.0), b(num_rows(A));
+
+    b= A * x;
+    x= 0;
+    itl::basic_iteration<double> iter(b, 500, 1.e-10);
+    cg(T, x, b, P, iter);
+    MTL_THROW_IF(!iter.is_converged(), mtl::runtime_error("cg converges"));
+}
+
+int main(int, char**)
+{
+    matrix_type L;
+    laplacian_setup(L, 12, 12);
+
+    // Dense 4x4 blocks on the diagonal and a coupling band
+    const std::size_t n= 64;
+    matrix_type B(n, n);
+    {
+	mtl::mat::inserter<matrix_type> ins(B);
+	for (std::size_t i= 0; i < n; i++) {
+	    for (std::size_t j= i / 4 * 4; j < i / 4 * 4 + 4; j++)
+		ins[i][j] << (i == j ? 10.0 : 1.0 + double(i % 3));
+	    if (i + 8 < n)
+		ins[i][i + 8] << -1.0;
+	}
+    }
+
+    // Irregular rectangular matrix with empty rows
+    matrix_type R(200, 70); // fewer non-zeros than rows
+    {
+	mtl::mat::inserter<matrix_type> ins(R);
+	for (std::size_t j= 0; j < 70; j++)
+	    ins[0][j] << 1.0 + double(j);
+	for (std::size_t i= 3; i < 200; i+= 3)
+	    ins[i][(i * 37) % 70] << -2.0;
+    }
+
+    test_variants(L, "Laplacian");
+    test_variants(B, "blocks");
+    test_variants(R, "irregular");
+    test_tuning(L, "Laplacian");
+    test_tuning(B, "blocks");
+    test_tuning(R, "irregular");
+    test_serialization(L);
+    test_solver(L);
+
+    return 0;
+}
+
+#else
+
+int main(int, char**)
+{
+    std::cout << "auto_tuned_matrix needs C++11.\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <boost/numeric/mtl/mtl.hpp>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#include <boost/numeric/mtl/utility/benchmark.hpp>
+
+using namespace std;
+
+struct work
+{
+    explicit work(std::size_t n) : v(n, 1.0) {}
+    void operator()() { v*= 0.5; mtl::utility::benchmark_keep(v); }
+    mtl::dense_vector<double> v;
+};
+
+void run_cases(mtl::utility::benchmark& bench, std::size_t n)
+{
+    bench.run("scale/double/n=1000", work(1000), 1000.0, 16000.0);
+    bench.run("scale/double/n=big", work(n), double(n), 16.0 * n);
+    bench.run_parallel("scale/double/n=100", work(100));
+}
+
+void test_results()
+{
+    const char* argv[]= {"benchmark_test", "--samples", "5", "--min-sample-time", "0.0001", "--quiet",
+			 "--json", "benchmark_test.json", "--csv", "benchmark_test.csv", "--threads", "1"};
+    mtl::utility::benchmark bench(12, const_cast<char**>(argv));
+    run_cases(bench, 1000);
+    MTL_THROW_IF(bench.results().size() != 3, mtl::runtime_error("number of results"));
+
+    const mtl::utility::benchmark_result& r= bench.results()[0];
+    MTL_THROW_IF(!(r.samples == 5 && r.batch >= 1), mtl::runtime_error("samples"));
+    MTL_THROW_IF(!(r.min <= r.p10 && r.p10 <= r.median && r.median <= r.p90 && r.p90 <= r.max), mtl::runtime_error("order of statistics"));
+    MTL_THROW_IF(!(r.min <= r.mean && r.mean <= r.max), mtl::runtime_error("mean"));
+    MTL_THROW_IF(std::abs(r.gflops() - 1e-9 * 1000.0 / r.median) >= 1e-9 * r.gflops(), mtl::runtime_error("GFLOP/s"));
+    MTL_THROW_IF(bench.results()[2].name != "scale/double/n=100/threads=1", mtl::runtime_error("name with threads"));
+    MTL_THROW_IF(!(bench.results()[2].parameters().size() == 2 && bench.results()[2].parameters()[1].second == "1"), mtl::runtime_error("parameters"));
+    MTL_THROW_IF(bench.finish() != 0, mtl::runtime_error("regression without baseline"));
+}
+
+// Slower cases must be reported as regressions against the former results
+void test_baseline(const char* file)
+{
+    const char* argv[]= {"benchmark_test", "--samples", "3", "--baseline", file, "--filter", "n=big", "--quiet"};
+    mtl::utility::benchmark bench(8, const_cast<char**>(argv));
+    run_cases(bench, 100000);
+    MTL_THROW_IF(bench.results().size() != 1, mtl::runtime_error("filter"));
+    MTL_THROW_IF(!(bench.baseline_median("scale/double/n=1000") > 0.0 && bench.baseline_median("unknown") == 0.0), mtl::runtime_error("read baseline"));
+    MTL_THROW_IF(!bench.is_regression(bench.results()[0]), mtl::runtime_error("regression not detected"));
+    MTL_THROW_IF(bench.finish() != 1, mtl::runtime_error("number of regressions"));
+}
+
+int main(int, char**)
+{
+    test_results();
+    test_baseline("benchmark_test.json");
+    test_baseline("benchmark_test.csv");
+    std::remove("benchmark_test.json");
+    std::remove("benchmark_test.csv");
+
+    return 0;
+}
+
+#else
+
+int main(int, char**)
+{
+    std::cout << "The benchmark harness needs C++11.\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,286 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <complex>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+std::string program_dir;
+const char* name= "binary_format_test.bin";
+
+template <typename Vector1, typename Vector2>
+bool same(const Vector1& v, const Vector2& w)
+{
+    if (size(v) != size(w))
+	return false;
+    for (std::size_t i= 0; i < size(v); i++)
+	if (std::abs(v[i] - w[i]) > 1e-6 * (1.0 + std::abs(w[i])))
+	    return false;
+    return true;
+}
+
+void test_vectors()
+{
+    mtl::dense_vector<double> v(1000);
+    for (std::size_t i= 0; i < size(v); i++)
+	v[i]= 1.0 / double(i + 1);
+    mtl::io::binary_ostream(name) << v;
+    {
+	mtl::io::binary_file f(name);
+	MTL_THROW_IF(!(f.header().kind == mtl::io::binary_dense_vector && f.header().rows == 1000), mtl::runtime_error("header of vector"));
+	MTL_THROW_IF(f.header().offset[0] % 64 != 0, mtl::runtime_error("aligned array"));
+
+	mtl::dense_vector<double> w;
+	MTL_THROW_IF(!f.load(w), mtl::runtime_error("vector not mapped"));
+	MTL_THROW_IF(!same(w, v), mtl::runtime_error("mapped vector"));
+	mtl::dense_vector<float> x;
+	MTL_THROW_IF(f.load(x), mtl::runtime_error("float vector mapped"));
+	MTL_THROW_IF(!same(x, v), mtl::runtime_error("vector converted to float"));
+	w[0]= 7.0; // private mapping
+    }
+    mtl::dense_vector<double> w;
+    mtl::io::binary_istream(name) >> w;
+    MTL_THROW_IF(!(w[0] == 1.0 && same(w, v)), mtl::runtime_error("vector copied (and file unchanged)"));
+
+    mtl::dense_vector<std::complex<double> > z(3, std::complex<double>(1.0, -2.0));
+    mtl::io::binary_ostream(name) << z;
+    mtl::dense_vector<std::complex<float> > zf;
+    mtl::io::binary_istream(name) >> zf;
+    MTL_THROW_IF(zf[2] != std::complex<float>(1.0f, -2.0f), mtl::runtime_error("complex vector"));
+}
+
+void test_dense_matrices()
+{
+    mtl::dense2D<double> A(7, 5);
+    for (std::size_t i= 0; i < 7; i++)
+	for (std::size_t j= 0; j < 5; j++)
+	    A[i][j]= double(10 * i + j);
+    mtl::dense2D<double, mtl::mat::parameters<mtl::col_major> > C(A);
+
+    mtl::io::binary file(name);
+    file= C;
+    {
+	mtl::io::binary_file f(name);
+	MTL_THROW_IF(f.header().flags != mtl::io::binary_column_major, mtl::runtime_error("column-major flag"));
+	mtl::dense2D<double, mtl::mat::parameters<mtl::col_major> > D;
+	MTL_THROW_IF(!f.load(D), mtl::runtime_error("column-major matrix not mapped"));
+	MTL_THROW_IF(!(D[6][4] == 64.0 && D[3][2] == 32.0), mtl::runtime_error("mapped column-major matrix"));
+	mtl::dense2D<double> R;
+	MTL_THROW_IF(f.load(R), mtl::runtime_error("matrix with other orientation mapped"));
+	MTL_THROW_IF(!(R[6][4] == 64.0 && R[3][2] == 32.0 && num_rows(R) == 7), mtl::runtime_error("transposed copy"));
+    }
+
+    // Sub-matrix with leading dimension larger than its number of columns
+    mtl::dense2D<double> S(sub_matrix(A, 2, 6, 1, 4)), T;
+    mtl::io::binary_ostream(name) << sub_matrix(A, 2, 6, 1, 4);
+    T= file;
+    MTL_THROW_IF(!(num_rows(T) == 4 && num_cols(T) == 3 && T[0][0] == 21.0 && T[3][2] == 53.0), mtl::runtime_error("sub-matrix"));
+}
+
+void test_sparse(std::size_t m)
+{
+    typedef mtl::mat::parameters<mtl::col_major> cpara;
+    mtl::compressed2D<double> A(m * m, m * m);
+    laplacian_setup(A, m, m);
+    A*= 1.0 / 3.0;
+    mtl::dense_vector<double> x(m * m), y, z;
+    iota(x);
+    z= A * x;
+
+    mtl::io::binary file(name);
+    file= A;
+    mtl::compressed2D<double> B;
+    B= file;
+    MTL_THROW_IF(B.nnz() != A.nnz(), mtl::runtime_error("nnz of sparse matrix"));
+    y= B * x;
+    MTL_THROW_IF(!same(y, z), mtl::runtime_error("sparse matrix"));
+
+    mtl::compressed2D<float, mtl::mat::unsigned_index_parameters> F;
+    mtl::io::binary_istream(name) >> F;
+    y= F * x;
+    MTL_THROW_IF(!same(y, z), mtl::runtime_error("sparse matrix with other types"));
+
+    mtl::compressed2D<double, cpara> C;
+    mtl::io::binary_file(name).load(C);
+    y= C * x;
+    MTL_THROW_IF(!same(y, z), mtl::runtime_error("column-major sparse matrix from row-major file"));
+
+    mtl::io::binary_ostream(name) << C;
+    mtl::io::binary_istream(name) >> B;
+    y= B * x;
+    MTL_THROW_IF(!same(y, z), mtl::runtime_error("row-major sparse matrix from column-major file"));
+
+    mtl::compressed2D<double> E;
+    file= E;
+    mtl::io::binary_istream(name) >> B;
+    MTL_THROW_IF(!(num_rows(B) == 0 && B.nnz() == 0), mtl::runtime_error("empty sparse matrix"));
+}
+
+void test_element_structure()
+{
+    typedef mtl::mat::element_structure<double> es_type;
+    es_type A;
+    std::string el_file= mtl::io::join(program_dir, "matrix_market/square3.mtx");
+    read_el_matrix(el_file, A);
+    mtl::io::binary_ostream(name) << A;
+
+    const int n= A.get_total_vars();
+    mtl::dense_vector<double> x(n), y(n), z(n);
+    iota(x);
+    z= A * x;
+    {
+	mtl::io::binary_file f(name);
+	es_type B;
+	MTL_THROW_IF(!f.load(B), mtl::runtime_error("element structure not mapped"));
+	MTL_THROW_IF(!(B.get_total_elements() == A.get_total_elements() && B.get_total_vars() == n), mtl::runtime_error("element dimensions"));
+	for (int e= 0; e < A.get_total_elements(); e++) {
+	    es_type::element_type &a= A.element_begin()[e], &b= B.element_begin()[e];
+	    MTL_THROW_IF(a.get_neighbors().size() != b.get_neighbors().size(), mtl::runtime_error("number of neighbors"));
+	    for (std::size_t k= 0; k < a.get_neighbors().size(); k++)
+		MTL_THROW_IF(a.get_neighbors()[k] - A.element_begin() != b.get_neighbors()[k] - B.element_begin(), mtl::runtime_error("neighbor"));
+	}
+	y= B * x;
+	MTL_THROW_IF(!same(y, z), mtl::runtime_error("product with mapped element structure"));
+    }
+    es_type C;
+    mtl::io::binary_istream(name) >> C;
+    y= C * x;
+    MTL_THROW_IF(!same(y, z), mtl::runtime_error("product with copied element structure"));
+}
+
+// Swap header and values as if the file was written on a machine of other endianness
+void test_byte_order()
+{
+    mtl::dense_vector<double> v(5);
+    iota(v);
+    mtl::io::binary_ostream(name) << v;
+    std::vector<char> bytes;
+    {
+	std::ifstream is(name, std::ios::binary);
+	bytes.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    mtl::io::binary_header h;
+    std::memcpy(&h, &bytes[0], sizeof(h));
+    const std::size_t swap_words[][2]= {{8, 4}, {12, 4}, {16, 4}, {24, 4}, {28, 4}, {48, 8},
+					{56, 8}, {64, 8}, {72, 8}}; // version, order, kind, value kind/size, rows, cols, entries, offset[0]
+    for (std::size_t k= 0; k < sizeof(swap_words) / sizeof(swap_words[0]); k++)
+	std::reverse(&bytes[swap_words[k][0]], &bytes[swap_words[k][0] + swap_words[k][1]]);
+    for (std::size_t i= 0; i < 5; i++)
+	std::reverse(&bytes[h.offset[0] + 8 * i], &bytes[h.offset[0] + 8 * i + 8]);
+    {
+	std::ofstream os(name, std::ios::binary);
+	os.write(&bytes[0], std::streamsize(bytes.size()));
+    }
+    mtl::io::binary_file f(name);
+    MTL_THROW_IF(!(f.is_swapped() && f.header().rows == 5), mtl::runtime_error("swapped header"));
+    mtl::dense_vector<double> w;
+    MTL_THROW_IF(f.load(w), mtl::runtime_error("swapped vector mapped"));
+    MTL_THROW_IF(!same(w, v), mtl::runtime_error("swapped vector"));
+}
+
+void test_errors()
+{
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+    mtl::dense_vector<std::complex<double> > z(3);
+    mtl::io::binary_ostream(name) << z;
+    for (int k= 0; k < 3; k++) {
+	bool caught= false;
+	try {
+	    if (k == 0) {
+		mtl::dense_vector<double> v;
+		mtl::io::binary_istream(name) >> v;  // complex into real
+	    } else if (k == 1) {
+		mtl::dense2D<std::complex<double> > A;
+		mtl::io::binary_istream(name) >> A;  // wrong kind
+	    } else {
+		std::ofstream(name, std::ios::binary) << "MTL4BIN";
+		mtl::dense_vector<std::complex<double> > v;
+		mtl::io::binary_istream(name) >> v;  // truncated
+	    }
+	} catch (const mtl::io_error&) {
+	    caught= true;
+	}
+	MTL_THROW_IF(!caught, mtl::runtime_error("no error thrown"));
+    }
+#endif
+}
+
+// Element indices beyond the variables and complex values into a real structure
+void test_element_errors()
+{
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+    std::string el_file= mtl::io::join(program_dir, "matrix_market/square3.mtx");
+    mtl::mat::element_structure<std::complex<double> > Z;
+    read_el_matrix(el_file, Z);
+    mtl::io::binary_ostream(name) << Z;
+    bool caught= false;
+    try {
+	mtl::mat::element_structure<double> A;
+	mtl::io::binary_istream(name) >> A;
+    } catch (const mtl::io_error&) {
+	caught= true;
+    }
+    MTL_THROW_IF(!caught, mtl::runtime_error("complex element structure read into real one"));
+
+    mtl::mat::element_structure<double> A;
+    read_el_matrix(el_file, A);
+    mtl::io::binary_ostream(name) << A;
+    std::vector<char> bytes;
+    {
+	std::ifstream is(name, std::ios::binary);
+	bytes.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    mtl::io::binary_header h;
+    std::memcpy(&h, &bytes[0], sizeof(h));
+    const int too_large= A.get_total_vars();
+    std::memcpy(&bytes[h.offset[1]], &too_large, sizeof(int));
+    {
+	std::ofstream os(name, std::ios::binary);
+	os.write(&bytes[0], std::streamsize(bytes.size()));
+    }
+    for (int zero_copy= 0; zero_copy < 2; zero_copy++) {
+	caught= false;
+	try {
+	    mtl::mat::element_structure<double> B;
+	    mtl::io::binary_file(name).load(B, zero_copy == 1);
+	} catch (const mtl::io_error&) {
+	    caught= true;
+	}
+	MTL_THROW_IF(!caught, mtl::runtime_error("element index out of range"));
+    }
+#endif
+}
+
+int main(int, char* argv[])
+{
+    program_dir= mtl::io::directory_name(argv[0]);
+    test_vectors();
+    test_dense_matrices();
+    test_sparse(1);
+    test_sparse(30);
+    test_element_structure();
+    test_byte_order();
+    test_errors();
+    test_element_errors();
+    std::remove(name);
+
+    return 0;
+}
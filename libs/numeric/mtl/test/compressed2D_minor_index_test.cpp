@@ -0,0 +1,200 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cmath>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+using namespace std;
+
+typedef mtl::mat::unsigned_index_parameters                     para;
+typedef mtl::compressed2D<double, para>                         matrix_type;
+typedef mtl::compressed2D<double>                               reference_type;
+typedef mtl::mat::parameters<mtl::col_major, mtl::index::c_index, mtl::non_fixed::dimensions, false,
+			     std::size_t, mtl::allocation::default_policy, unsigned> cpara;
+typedef mtl::mat::parameters<mtl::row_major, mtl::index::c_index, mtl::non_fixed::dimensions, false,
+			     std::size_t, mtl::allocation::default_policy, unsigned short> spara;
+typedef mtl::mat::parameters<mtl::col_major, mtl::index::c_index, mtl::non_fixed::dimensions, false,
+			     std::size_t, mtl::allocation::default_policy, unsigned short> cspara;
+
+template <typename Vector1, typename Vector2>
+void check(const Vector1& v, const Vector2& w, const char* what)
+{
+    mtl::dense_vector<double> d(v - w);
+    if (two_norm(d) > 1e-10 * (1.0 + two_norm(w))) {
+	mtl::io::tout << what << ": " << v << " should be " << w << '\n';
+	throw mtl::runtime_error("Wrong result with unsigned minor indices");
+    }
+}
+
+template <typename Matrix>
+void setup(Matrix& A, int size)
+{
+    laplacian_setup(A, size, size);
+    mtl::mat::inserter<Matrix, mtl::update_plus<double> > ins(A, 3);
+    for (std::size_t i= 0; i + 3 < num_rows(A); i+= 3)
+	ins[i][i+3] << 0.25;
+}
+
+void test_kernels(int size)
+{
+    const std::size_t N= size * size;
+    matrix_type    A(N, N);
+    reference_type R(N, N);
+    setup(A, size);
+    setup(R, size);
+    MTL_THROW_IF(A.nnz() != R.nnz(), mtl::runtime_error("Different number of non-zeros"));
+    MTL_THROW_IF(!(sizeof(A.ref_minor()[0]) == sizeof(unsigned) && sizeof(A.ref_major()[0]) == sizeof(std::size_t)),
+		 mtl::runtime_error("Wrong index types"));
+
+    mtl::dense_vector<double> x(N), y(N), z(N);
+    for (std::size_t i= 0; i < N; i++)
+	x[i]= double(i % 7) - 3.0;
+
+    // Products with all instruction sets available on this machine
+    z= R * x;
+    const mtl::simd::isa_id isas[]= { mtl::simd::isa_avx512, mtl::simd::isa_avx2, mtl::simd::native_isa() };
+    for (int k= 0; k < 3; k++)
+	if (mtl::simd::isa_available(isas[k])) {
+	    mtl::simd::select_isa(isas[k]);
+	    y= A * x;
+	    check(y, z, "A * x");
+	    y+= A * x;
+	    y-= 2 * z;
+	    MTL_THROW_IF(two_norm(y) >= 1e-10, mtl::runtime_error("y+= A * x"));
+	}
+    mtl::simd::select_isa(mtl::simd::native_isa());
+    y= trans(A) * x; z= trans(R) * x;
+    check(y, z, "trans(A) * x");
+
+    // Copies into other index types, orientations and bands
+    reference_type B(A);
+    y= B * x; z= R * x;
+    check(y, z, "copy to default parameters");
+    mtl::compressed2D<double, cpara> C(A);
+    y= C * x;
+    check(y, z, "column-major copy");
+    matrix_type U(triu(A)), L(tril(A, -1));
+    y= U * x + L * x;
+    check(y, z, "triu + tril");
+
+    // Triangular solvers
+    y= upper_trisolve(U, x);
+    z= upper_trisolve(reference_type(triu(R)), x);
+    check(y, z, "upper_trisolve");
+    matrix_type Ld(tril(A));
+    y= lower_trisolve(Ld, x);
+    z= lower_trisolve(reference_type(tril(R)), x);
+    check(y, z, "lower_trisolve");
+}
+
+template <typename Preconditioner>
+void test_solver(const matrix_type& A, const char* name)
+{
+    const std::size_t N= num_rows(A);
+    Preconditioner P(A);
+    mtl::dense_vector<double> x(N, 1.0), b(A * x);
+    x= 0;
+    itl::basic_iteration<double> iter(b, 500, 1.e-10);
+    bicgstab(A, x, b, P, iter);
+    mtl::io::tout << name << ": " << iter.iterations() << " iterations\n";
+    MTL_THROW_IF(!iter.is_converged(), mtl::runtime_error(name));
+}
+
+void test_preconditioners(int size)
+{
+    const std::size_t N= size * size;
+    matrix_type A(N, N);
+    laplacian_setup(A, size, size);
+    test_solver<itl::pc::ilu_0<matrix_type> >(A, "ILU(0)");
+    test_solver<itl::pc::ic_0<matrix_type> >(A, "IC(0)");
+}
+
+void test_insertion()
+{
+    matrix_type A(6, 6);
+    {
+	mtl::mat::inserter<matrix_type> ins(A, 2);
+	mtl::dense2D<double> block(2, 3);
+	block= 1.0, 2.0, 3.0,
+	       4.0, 5.0, 6.0;
+	mtl::dense_vector<std::size_t> rows(2), cols(3);
+	rows= 1, 4; cols= 0, 5, 2;
+	ins << mtl::mat::element_matrix(block, rows, cols);
+	ins[2][3] << 7.0;
+    }
+    MTL_THROW_IF(!(A.nnz() == 7 && A[1][5] == 2.0 && A[4][2] == 6.0 && A[2][3] == 7.0 && A[1][1] == 0.0),
+		 mtl::runtime_error("Wrong values after insertion"));
+    MTL_THROW_IF(A.ref_minor()[A.ref_major()[1] + 1] != 2u, mtl::runtime_error("Indices not sorted"));
+
+    std::size_t    starts[]= {0, 1, 3}, indices[]= {1, 0, 1};
+    double         values[]= {1.0, 2.0, 3.0};
+    matrix_type    P(2, 2, 3, starts, indices, values);
+    MTL_THROW_IF(!(P[0][1] == 1.0 && P[1][0] == 2.0 && P[1][1] == 3.0), mtl::runtime_error("Wrong values from pointer constructor"));
+}
+
+// Dimensions beyond the range of the minor index type are rejected
+void test_range()
+{
+    typedef mtl::compressed2D<double, spara> short_type;
+    short_type A(70000, 3);
+    MTL_THROW_IF(num_rows(A) != 70000, mtl::runtime_error("Major dimension is not limited by minor_index_type"));
+
+    // The largest column index 65535 still fits into unsigned short
+    short_type D(3, 65536);
+    {
+	mtl::mat::inserter<short_type> ins(D);
+	ins[1][65535] << 2.0;
+    }
+    MTL_THROW_IF(D[1][65535] != 2.0, mtl::runtime_error("Wrong value in last column"));
+    D.change_dim(4, 65536);
+    MTL_THROW_IF(num_cols(D) != 65536, mtl::runtime_error("Largest representable minor dimension rejected"));
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+    bool caught= false;
+    try {
+	short_type B(3, 70000);
+    } catch (mtl::range_error&) { caught= true; }
+    MTL_THROW_IF(!caught, mtl::runtime_error("Too many columns in constructor not detected"));
+
+    caught= false;
+    try {
+	short_type B(3, 65537);
+    } catch (mtl::range_error&) { caught= true; }
+    MTL_THROW_IF(!caught, mtl::runtime_error("One column too many in constructor not detected"));
+
+    caught= false;
+    try {
+	A.change_dim(3, 70000);
+    } catch (mtl::range_error&) { caught= true; }
+    MTL_THROW_IF(!(caught && num_rows(A) == 70000 && num_cols(A) == 3), mtl::runtime_error("Too many columns in change_dim not detected"));
+
+    mtl::compressed2D<double, cspara> C(3, 70000);
+    caught= false;
+    try {
+	C.change_dim(70000, 3);
+    } catch (mtl::range_error&) { caught= true; }
+    MTL_THROW_IF(!(caught && num_cols(C) == 70000), mtl::runtime_error("Too many rows of column-major matrix not detected"));
+#endif
+}
+
+int main(int, char**)
+{
+    test_range();
+    test_insertion();
+    test_kernels(1);
+    test_kernels(4);
+    test_kernels(30);
+    test_preconditioners(10);
+
+    return 0;
+}
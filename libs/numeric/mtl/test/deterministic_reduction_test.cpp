@@ -0,0 +1,152 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#define MTL_DETERMINISTIC_REDUCTION
+#define MTL_REDUCTION_BLOCK_SIZE 256
+
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+#include <boost/numeric/mtl/mtl.hpp>
+
+#ifdef MTL_WITH_OPENMP
+#  include <omp.h>
+#endif
+
+using namespace std;
+
+struct concat
+{
+    void operator()(std::string& s, const std::string& s2) const { s+= s2; }
+};
+
+// The tree must keep the order of the parts
+void test_tree_join()
+{
+    for (std::size_t n= 1; n < 20; n++) {
+	std::vector<std::string> parts(n);
+	std::string expected;
+	for (std::size_t i= 0; i < n; i++) {
+	    parts[i]= std::string(1, char('a' + i));
+	    expected+= parts[i];
+	}
+	mtl::vec::tree_join(parts, concat());
+	MTL_THROW_IF(parts[0] != expected, mtl::runtime_error("tree_join changed the order"));
+    }
+}
+
+template <typename Value>
+void check(Value x, Value y, const char* what)
+{
+    if (std::abs(x - y) > 1e-4 * (1.0 + std::abs(y))) {
+	mtl::io::tout << what << ": " << x << " should be " << y << '\n';
+	throw mtl::runtime_error("Wrong result in deterministic reduction");
+    }
+}
+
+template <typename Value>
+void check_same(Value x, Value y, const char* what)
+{
+    if (x != y) {
+	mtl::io::tout << what << ": " << x << " differs from " << y << '\n';
+	throw mtl::runtime_error("Deterministic reduction depends on the number of threads");
+    }
+}
+
+template <typename Value>
+struct results
+{
+    Value d, n1, n2, ni, s, fd, fn;
+};
+
+template <typename Value>
+results<Value> compute(const mtl::dense_vector<Value>& u, const mtl::dense_vector<Value>& v)
+{
+    using mtl::lazy;
+    results<Value> r;
+    r.d= dot(u, v); r.n1= one_norm(u); r.n2= two_norm(u); r.ni= infinity_norm(u); r.s= mtl::sum(u);
+
+    mtl::dense_vector<Value> w(size(u));
+    (lazy(w)= u + v) || (lazy(r.fd)= lazy_dot(w, u)) || (lazy(r.fn)= lazy_two_norm(w));
+    return r;
+}
+
+template <typename Value>
+void test(std::size_t n)
+{
+    mtl::dense_vector<Value> u(n), v(n);
+    for (std::size_t i= 0; i < n; i++)
+	u[i]= Value(1) / Value(1 + i % 11) - Value(0.3), v[i]= std::sin(Value(i));
+
+    Value d= 0, n1= 0, n2= 0, ni= 0, s= 0, fd= 0, fn= 0;
+    for (std::size_t i= 0; i < n; i++) {
+	d+= u[i] * v[i]; n1+= std::abs(u[i]); n2+= u[i] * u[i]; ni= std::max(ni, std::abs(u[i])); s+= u[i];
+	fd+= (u[i] + v[i]) * u[i]; fn+= (u[i] + v[i]) * (u[i] + v[i]);
+    }
+    results<Value> r= compute(u, v);
+    check(r.d, d, "dot"); check(r.n1, n1, "one_norm"); check(r.n2, std::sqrt(n2), "two_norm");
+    check(r.ni, ni, "infinity_norm"); check(r.s, s, "sum");
+    check(r.fd, fd, "fused dot"); check(r.fn, std::sqrt(fn), "fused two_norm");
+
+#ifdef MTL_WITH_OPENMP
+    const int max_threads= omp_get_max_threads();
+    for (int t= 1; t <= 5; t++) {
+	omp_set_num_threads(t);
+	results<Value> rt= compute(u, v);
+	check_same(rt.d, r.d, "dot"); check_same(rt.n1, r.n1, "one_norm"); check_same(rt.n2, r.n2, "two_norm");
+	check_same(rt.ni, r.ni, "infinity_norm"); check_same(rt.s, r.s, "sum");
+	check_same(rt.fd, r.fd, "fused dot"); check_same(rt.fn, r.fn, "fused two_norm");
+    }
+    omp_set_num_threads(max_threads);
+#endif
+}
+
+// Complex values take the generic (non-SIMD) paths
+void test_complex(std::size_t n)
+{
+    typedef std::complex<double> ct;
+    mtl::dense_vector<ct> u(n), v(n);
+    ct d= 0;
+    double n1= 0;
+    for (std::size_t i= 0; i < n; i++) {
+	u[i]= ct(double(i % 7), 1.0), v[i]= ct(1.0, -double(i % 3));
+	d+= conj(u[i]) * v[i]; n1+= std::abs(u[i]);
+    }
+    check(ct(dot(u, v)), d, "complex dot");
+    check(double(one_norm(u)), n1, "complex one_norm");
+
+#ifdef MTL_WITH_OPENMP
+    const int max_threads= omp_get_max_threads();
+    const ct ref= dot(u, v);
+    for (int t= 1; t <= 5; t++) {
+	omp_set_num_threads(t);
+	check_same(ct(dot(u, v)), ref, "complex dot");
+    }
+    omp_set_num_threads(max_threads);
+#endif
+}
+
+int main(int, char**)
+{
+    test_tree_join();
+
+    const std::size_t sizes[]= {0, 1, 17, 256, 257, 1000, 10007};
+    for (std::size_t k= 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+	test<double>(sizes[k]);
+	test<float>(sizes[k]);
+	test_complex(sizes[k]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+template <typename Matrix, typename Vector, typename MatrixQ>
+void check_pairs(const Matrix& A, const Vector& lambda, const MatrixQ& Q, double tol)
+{
+    using namespace mtl;
+    unsigned n= num_rows(A), k= num_cols(Q);
+    double   normA= one_norm(A);
+
+    dense2D<double> R(n, k), QtQ(k, k), I(k, k);
+    R= A * Q;
+    for (unsigned j= 0; j < k; j++)
+	for (unsigned i= 0; i < n; i++)
+	    R[i][j]-= lambda[j] * Q[i][j];
+    cout << "one_norm(A*Q - Q*Lambda) = " << one_norm(R) << '\n';
+    if (one_norm(R) > tol * normA) throw mtl::logic_error("wrong eigenpairs");
+
+    QtQ= trans(Q) * Q; I= 1; QtQ-= I;
+    cout << "one_norm(Q'*Q - I) = " << one_norm(QtQ) << '\n';
+    if (one_norm(QtQ) > tol) throw mtl::logic_error("eigenvectors not orthonormal");
+}
+
+template <typename Vector>
+void check_sorted(const Vector& lambda)
+{
+    for (unsigned i= 1; i < size(lambda); i++)
+	if (lambda[i] < lambda[i-1]) throw mtl::logic_error("eigenvalues not in ascending order");
+}
+
+void test(unsigned n, bool multiple)
+{
+    using namespace mtl;
+    const double tol= 1e-11 * n;
+    cout << "\nn = " << n << (multiple ? " with multiple eigenvalues\n" : "\n");
+
+    dense2D<double> A(n, n), B(n, n);
+    if (multiple) {
+	// 2D Laplacian has many multiple eigenvalues (worst case for deflation)
+	unsigned m= unsigned(sqrt(double(n)));
+	A.change_dim(m*m, m*m); B.change_dim(m*m, m*m);
+	mat::laplacian_setup(A, m, m);
+	n= m*m;
+    } else {
+	mtl::seed<double> s;
+	random(B, s);
+	B/= one_norm(B);
+	A= B + trans(B);
+    }
+
+    dense_vector<double> lambda, lambda_only, lambda_sub;
+    dense2D<double>      Q, Qsub;
+    eigen_symmetric(A, lambda, Q);
+    check_sorted(lambda);
+    check_pairs(A, lambda, Q, tol);
+
+    eigen_symmetric(A, lambda_only);
+    lambda_only-= lambda;
+    cout << "two_norm(eigenvalues only - with vectors) = " << two_norm(lambda_only) << '\n';
+    if (two_norm(lambda_only) > tol * one_norm(A)) throw mtl::logic_error("eigenvalues differ");
+
+    unsigned first= n / 4, last= n / 2 + 1;
+    eigen_symmetric_range(A, first, last, lambda_sub);
+    if (size(lambda_sub) != last - first) throw mtl::logic_error("wrong number of eigenvalues in range");
+    for (unsigned i= first; i < last; i++)
+	if (abs(lambda_sub[i-first] - lambda[i]) > tol * one_norm(A)) throw mtl::logic_error("wrong eigenvalue in range");
+
+    eigen_symmetric_range(A, first, last, lambda_sub, Qsub);
+    check_pairs(A, lambda_sub, Qsub, tol);
+}
+
+int main(int argc, char** argv)
+{
+    using namespace mtl;
+
+    double array[][4]= {{1,  1,   1,  0},
+                        {1, -1,  -2,  0},
+                        {1, -2,   1,  0},
+                        {0,  0,   0, 10}};
+    dense2D<double>      A(array), Q;
+    dense_vector<double> lambda;
+    eigen_symmetric(A, lambda, Q);
+    cout << "A =\n" << A << "eigenvalues = " << lambda << "\neigenvectors =\n" << Q;
+    check_pairs(A, lambda, Q, 1e-13);
+
+    unsigned n= argc > 1 ? atoi(argv[1]) : 200;
+    test(1, false);
+    test(7, false);
+    test(n, false);
+    test(n, true);
+
+    return 0;
+}
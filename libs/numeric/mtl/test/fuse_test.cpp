@@ -82,5 +82,44 @@ int main(int , char**)
     MTL_THROW_IF(!close(r[0], 15.6) || !close(v[0], 17.2) || !close(x[0], 4.4), 
 		 mtl::runtime_error("wrong vector scaling"));
 
+    // Larger vectors such that the evaluation is split among threads when compiled with OpenMP
+    const int n= 10007;
+    mtl::dense_vector<double> r2(n), q2(n), x2(n), r3(n);
+    mtl::compressed2D<double> C(n, n);
+    laplacian_setup(C, 1, n);
+    for (int i= 0; i < n; i++) {
+	r2[i]= r3[i]= double(i % 17) - 8.0; q2[i]= double(i % 5) + 1.0;
+    }
+
+    (lazy(r2)-= alpha * q2) || (lazy(rho)= lazy_unary_dot(r2)); 
+    r3-= alpha * q2;
+    cout << "rho = " << rho << ", unary_dot(r3) = " << unary_dot(r3) << "\n";
+    MTL_THROW_IF(std::abs(rho - unary_dot(r3)) > 1e-10 * rho, mtl::runtime_error("wrong unary_dot of large vector"));
+    MTL_THROW_IF(r2[n-1] != r3[n-1], mtl::runtime_error("wrong vector update of large vector"));
+
+    (lazy(x2)= C * q2) || (lazy(gamma)= lazy_dot(x2, q2)); 
+    (lazy(r2)= 2.0 * x2) || (lazy(beta)= lazy_infinity_norm(x2)); 
+    cout << "gamma = " << gamma << ", dot(C * q2, q2) = " << dot(mtl::dense_vector<double>(C * q2), q2) << "\n";
+    MTL_THROW_IF(std::abs(gamma - dot(mtl::dense_vector<double>(C * q2), q2)) > 1e-10 * std::abs(gamma), mtl::runtime_error("wrong dot of large vector"));
+    MTL_THROW_IF(beta != infinity_norm(x2) || r2[n/2] != 2.0 * x2[n/2], mtl::runtime_error("wrong infinity_norm of large vector"));
+
+    // Longer chains with products and reductions as in BiCGStab
+    double ts, tt;
+    (lazy(x2)= C * q2) || (lazy(ts)= lazy_dot(x2, r2)) || (lazy(tt)= lazy_unary_dot(x2));
+    r3= C * q2;
+    cout << "ts = " << ts << ", tt = " << tt << "\n";
+    MTL_THROW_IF(std::abs(ts - dot(r3, r2)) > 1e-10 * std::abs(ts), mtl::runtime_error("wrong dot in triple fusion"));
+    MTL_THROW_IF(std::abs(tt - unary_dot(r3)) > 1e-10 * tt, mtl::runtime_error("wrong unary_dot in triple fusion"));
+    MTL_THROW_IF(x2[n/3] != r3[n/3], mtl::runtime_error("wrong product in triple fusion"));
+
+    r3= r2 - 0.5 * x2;
+    (lazy(q2)+= 0.25 * x2 + 2.0 * r2) || (lazy(r2)-= 0.5 * x2) || (lazy(gamma)= lazy_dot(q2, r2))
+	|| (lazy(beta)= lazy_two_norm(r2)) || (lazy(d)= lazy_sum(q2));
+    cout << "gamma = " << gamma << ", beta = " << beta << ", d = " << d << "\n";
+    MTL_THROW_IF(std::abs(beta - two_norm(r3)) > 1e-10 * beta, mtl::runtime_error("wrong two_norm in 5-fold fusion"));
+    MTL_THROW_IF(std::abs(gamma - dot(q2, r3)) > 1e-10 * std::abs(gamma), mtl::runtime_error("wrong dot in 5-fold fusion"));
+    MTL_THROW_IF(std::abs(d - mtl::sum(q2)) > 1e-10 * std::abs(d), mtl::runtime_error("wrong sum in 5-fold fusion"));
+    MTL_THROW_IF(r2[n-2] != r3[n-2], mtl::runtime_error("wrong vector update in 5-fold fusion"));
+
     return 0;
 }
@@ -0,0 +1,94 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cmath>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+namespace al = mtl::allocation;
+
+template <typename Value, typename Policy>
+struct vector_type
+{
+    typedef mtl::vec::parameters<mtl::tag::col_major, mtl::vec::non_fixed::dimension, false, std::size_t, Policy> para;
+    typedef mtl::dense_vector<Value, para> type;
+};
+
+void test_huge_pages()
+{
+    typedef vector_type<double, al::huge_pages>::type vt;
+    const std::size_t n= 3 * MTL_HUGE_PAGE_LIMIT / sizeof(double) / 2;
+    vt v(n, 1.0), w(v);
+#if defined(__linux__)
+    MTL_THROW_IF(reinterpret_cast<std::size_t>(&v[0]) % MTL_HUGE_PAGE_SIZE != 0, mtl::runtime_error("alignment to huge pages"));
+#endif
+    w+= v;
+    MTL_THROW_IF(!(w[n-1] == 2.0 && mtl::sum(w) == 2.0 * double(n)), mtl::runtime_error("operations on huge pages"));
+
+    vt small(10, 3.0);
+    MTL_THROW_IF(small[9] != 3.0, mtl::runtime_error("small vector with huge page policy"));
+
+    typedef mtl::mat::parameters<mtl::tag::row_major, mtl::index::c_index, mtl::non_fixed::dimensions, false, std::size_t, al::huge_pages> mpara;
+    mtl::compressed2D<double, mpara> A(n, n);
+    A= 2.0;
+    mtl::dense_vector<double> y(A * v);
+    MTL_THROW_IF(y[n-1] != 2.0, mtl::runtime_error("sparse matrix on huge pages"));
+}
+
+template <typename Value>
+void test_padding(std::size_t n)
+{
+    typedef typename vector_type<Value, al::padded<> >::type vt;
+    vt u(n), v(n);
+    Value d(0), s(0), n1(0), n2(0), ni(0);
+    for (std::size_t i= 0; i < n; i++) {
+	u[i]= Value(1) + Value(i % 5), v[i]= Value(i % 3) - Value(1);
+	d+= u[i] * v[i]; s+= v[i]; n1+= std::abs(v[i]); n2+= v[i] * v[i]; ni= std::max(ni, std::abs(v[i]));
+    }
+    MTL_THROW_IF(!(u.padded_memory() % (64 / sizeof(Value)) == 0 && u.padded_memory() >= n), mtl::runtime_error("padded size"));
+    for (std::size_t i= n; i < v.padded_memory(); i++)
+	MTL_THROW_IF(v.address_data()[i] != Value(0), mtl::runtime_error("zero padding"));
+
+    MTL_THROW_IF(dot(u, v) != d, mtl::runtime_error("padded dot"));
+    MTL_THROW_IF(mtl::sum(v) != s, mtl::runtime_error("padded sum"));
+    MTL_THROW_IF(one_norm(v) != n1, mtl::runtime_error("padded one_norm"));
+    MTL_THROW_IF(std::abs(two_norm(v) - std::sqrt(n2)) > 1e-5 * std::sqrt(n2), mtl::runtime_error("padded two_norm"));
+    MTL_THROW_IF(infinity_norm(v) != ni, mtl::runtime_error("padded infinity_norm"));
+
+    // Padding stays zero after operations and copies
+    vt w(u);
+    w= 2 * u - v;
+    w= u + v;
+    for (std::size_t i= n; i < w.padded_memory(); i++)
+	MTL_THROW_IF(w.address_data()[i] != Value(0), mtl::runtime_error("zero padding after assignment"));
+
+    // Sub-vectors refer to the entries of the parent and are not padded
+    if (n > 2) {
+	vt sub(u[mtl::irange(1, n - 1)]);
+	MTL_THROW_IF(sub.padded_memory() != n - 2, mtl::runtime_error("sub-vector without padding"));
+	MTL_THROW_IF(mtl::sum(sub) != mtl::sum(u) - u[0] - u[n-1], mtl::runtime_error("sum of sub-vector"));
+    }
+}
+
+int main(int, char**)
+{
+    test_huge_pages();
+
+    const std::size_t sizes[]= {0, 1, 7, 8, 9, 33, 1001};
+    for (std::size_t k= 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+	test_padding<double>(sizes[k]);
+	test_padding<float>(sizes[k]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <string>
+#include <complex>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+std::string program_dir;
+
+// Reading by file name takes the parallel path, reading from a stream the inserter
+template <typename Matrix>
+void compare_paths(const std::string& file_name)
+{
+    Matrix A, B;
+    mtl::io::matrix_market_istream(file_name) >> A;
+    std::ifstream is(file_name.c_str());
+    mtl::io::matrix_market_istream(is) >> B;
+
+    MTL_THROW_IF(!(num_rows(A) == num_rows(B) && num_cols(A) == num_cols(B)), mtl::runtime_error((file_name + ": dimensions").c_str()));
+    MTL_THROW_IF(A.nnz() != B.nnz(), mtl::runtime_error((file_name + ": number of non-zeros").c_str()));
+    for (std::size_t i= 0; i < A.ref_major().size(); i++)
+	MTL_THROW_IF(A.ref_major()[i] != B.ref_major()[i], mtl::runtime_error((file_name + ": starts").c_str()));
+    for (std::size_t j= 0; j < A.nnz(); j++)
+	MTL_THROW_IF(!(A.ref_minor()[j] == B.ref_minor()[j] && A.data[j] == B.data[j]), mtl::runtime_error((file_name + ": entries").c_str()));
+}
+
+void test_files()
+{
+    typedef mtl::mat::parameters<mtl::col_major> cpara;
+    const char* files[]= {"bcspwr02.mtx", "bcsstk01.mtx", "jgl009.mtx", "plskz362.mtx"};
+    for (int i= 0; i < 4; i++) {
+	std::string name= mtl::io::join(program_dir, std::string("matrix_market/") + files[i]);
+	compare_paths<mtl::compressed2D<double> >(name);
+	compare_paths<mtl::compressed2D<float, mtl::mat::unsigned_index_parameters> >(name);
+	compare_paths<mtl::compressed2D<double, cpara> >(name);
+    }
+    std::string hermitian= mtl::io::join(program_dir, "matrix_market/mhd1280b.mtx");
+    compare_paths<mtl::compressed2D<std::complex<double> > >(hermitian);
+    compare_paths<mtl::compressed2D<std::complex<float>, cpara> >(hermitian);
+}
+
+std::string write_file(const char* content)
+{
+    const char* name= "matrix_market_parallel_test.mtx";
+    std::ofstream os(name, std::ios::binary);
+    os << content;
+    return name;
+}
+
+// Number formats, blank lines, CRLF line ends and duplicates
+void test_formats()
+{
+    std::string name= write_file("%%MatrixMarket matrix coordinate real general\r\n"
+				 "% comment\r\n"
+				 "3 4 7\r\n"
+				 "1 1 1.5\r\n"
+				 "\r\n"
+				 "2 4 -2.5e-3\r\n"
+				 "3 2 +12345678901234567890\r\n"
+				 "1 3 .25\r\n"
+				 "3 3 1E300  \r\n"
+				 "1 1 2.\r\n"
+				 "2 1 -0.1");
+    mtl::compressed2D<double> A;
+    mtl::io::matrix_market_istream(name) >> A;
+    MTL_THROW_IF(A.nnz() != 6, mtl::runtime_error("nnz with duplicates"));
+    MTL_THROW_IF(!(A[0][0] == 3.5 && A[1][3] == -2.5e-3 && A[2][1] == 12345678901234567890.0), mtl::runtime_error("parsed values"));
+    MTL_THROW_IF(!(A[0][2] == 0.25 && A[2][2] == 1e300 && A[1][0] == -0.1), mtl::runtime_error("parsed values"));
+
+    name= write_file("%%MatrixMarket matrix coordinate integer skew-symmetric\n3 3 2\n2 1 4\n3 2 -7\n");
+    mtl::compressed2D<int> B;
+    mtl::io::matrix_market_istream(name) >> B;
+    MTL_THROW_IF(!(B[1][0] == 4 && B[0][1] == -4 && B[2][1] == -7 && B[1][2] == 7 && B.nnz() == 4), mtl::runtime_error("skew-symmetric integers"));
+
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+    const char* bad[]= {"%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1.0\n",
+			"%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n",
+			"%%MatrixMarket matrix coordinate real general\n2 2 1\n1 1 1.0x\n"};
+    for (int i= 0; i < 3; i++) {
+	name= write_file(bad[i]);
+	bool caught= false;
+	try {
+	    mtl::io::matrix_market_istream(name) >> A;
+	} catch (const mtl::io_error&) {
+	    caught= true;
+	}
+	MTL_THROW_IF(!caught, mtl::runtime_error((std::string("error in ") + bad[i]).c_str()));
+    }
+#endif
+    std::remove(name.c_str());
+}
+
+// Larger file with values that are not exactly representable, read with all threads
+void test_large(std::size_t n)
+{
+    mtl::compressed2D<double> A(n, n);
+    laplacian_setup(A, n / 100, 100);
+    A*= 1.0 / 3.0;
+    const char* name= "matrix_market_parallel_test_large.mtx";
+    mtl::io::matrix_market_ostream(name) << A;
+    compare_paths<mtl::compressed2D<double> >(name);
+    std::remove(name);
+}
+
+int main(int, char* argv[])
+{
+    program_dir= mtl::io::directory_name(argv[0]);
+    test_files();
+    test_formats();
+    test_large(100000);
+
+    return 0;
+}
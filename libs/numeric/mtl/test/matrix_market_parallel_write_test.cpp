@@ -0,0 +1,146 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cstdio>
+#include <string>
+#include <complex>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+const char* name= "matrix_market_parallel_write_test.mtx";
+
+std::string file_content(const char* file_name)
+{
+    std::ifstream is(file_name, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+// Write A to a file and a string stream, read the file and compare bitwise
+template <typename Matrix>
+void round_trip(const Matrix& A, const std::string& what)
+{
+    mtl::io::matrix_market_ostream(name) << A;
+    std::ostringstream os;
+    mtl::io::matrix_market_ostream(os) << A;
+    MTL_THROW_IF(os.str() != file_content(name), mtl::runtime_error((what + ": stream and file differ").c_str()));
+
+    Matrix B;
+    mtl::io::matrix_market_istream(name) >> B;
+    MTL_THROW_IF(!(num_rows(A) == num_rows(B) && num_cols(A) == num_cols(B) && A.nnz() == B.nnz()), mtl::runtime_error((what + ": dimensions").c_str()));
+    for (std::size_t i= 0; i < A.ref_major().size(); i++)
+	MTL_THROW_IF(A.ref_major()[i] != B.ref_major()[i], mtl::runtime_error((what + ": starts").c_str()));
+    for (std::size_t j= 0; j < A.nnz(); j++)
+	MTL_THROW_IF(!(A.ref_minor()[j] == B.ref_minor()[j] && A.data[j] == B.data[j]), mtl::runtime_error((what + ": entries").c_str()));
+}
+
+template <typename Value, typename Parameters>
+void test(std::size_t m, const std::string& what)
+{
+    typedef mtl::compressed2D<Value, Parameters> matrix_type;
+    matrix_type A(m * m + 3, m * m);
+    {
+	mtl::mat::inserter<matrix_type> ins(A, 5);
+	for (std::size_t i= 0; i < m * m; i++) {
+	    ins[i][i] << Value(4) / Value(3);
+	    if (i + 1 < m * m)
+		ins[i][i+1] << Value(-1) / Value(7 + i % 5);
+	    if (i >= m)
+		ins[i][i-m] << Value(1e-300 * double(i));
+	}
+	// long last row, rows m*m and m*m+1 are empty
+	for (std::size_t j= 0; j < m * m; j+= 1 + j % 2)
+	    ins[m * m + 2][j] << Value(double(j) * 1e7 + 0.1);
+    }
+    round_trip(A, what);
+}
+
+template <typename Value>
+void test_other_values(const std::string& what)
+{
+    mtl::compressed2D<Value> A(4, 5);
+    {
+	mtl::mat::inserter<mtl::compressed2D<Value> > ins(A);
+	ins[0][4] << Value(-3); ins[2][0] << Value(17); ins[3][3] << Value(123456789);
+    }
+    round_trip(A, what);
+}
+
+// Leading empty rows form a block of their own before a row longer than a block
+void test_empty_block()
+{
+    mtl::compressed2D<double> A(3, 20000);
+    {
+	mtl::mat::inserter<mtl::compressed2D<double> > ins(A, 1);
+	for (std::size_t j= 0; j < 20000; j++)
+	    ins[2][j] << double(j) + 0.5;
+    }
+    round_trip(A, "empty block");
+}
+
+void test_complex()
+{
+    typedef std::complex<double> ct;
+    mtl::compressed2D<ct> A(3, 3);
+    {
+	mtl::mat::inserter<mtl::compressed2D<ct> > ins(A);
+	ins[0][0] << ct(1.0 / 3.0, -2.5); ins[1][2] << ct(0.0, 1e-17); ins[2][1] << ct(-7.0, 0.0);
+    }
+    round_trip(A, "complex");
+}
+
+void test_gzip()
+{
+#ifdef MTL_WITH_ZLIB
+    mtl::compressed2D<double> A(1000, 1000);
+    laplacian_setup(A, 10, 100);
+    A*= 1.0 / 3.0;
+    mtl::io::matrix_market_ostream(name) << A;
+    const char* gz_name= "matrix_market_parallel_write_test.mtx.gz";
+    mtl::io::matrix_market_ostream(gz_name) << A;
+
+    gzFile file= gzopen(gz_name, "rb");
+    MTL_THROW_IF(file == 0, mtl::runtime_error("open gzip file"));
+    std::string content;
+    char buffer[4096];
+    for (int n; (n= gzread(file, buffer, sizeof(buffer))) > 0; )
+	content.append(buffer, n);
+    gzclose(file);
+    MTL_THROW_IF(content != file_content(name), mtl::runtime_error("decompressed file"));
+    std::remove(gz_name);
+#endif
+}
+
+int main(int, char**)
+{
+    typedef mtl::mat::parameters<mtl::col_major> cpara;
+    test<double, mtl::mat::parameters<> >(1, "double 1");
+    test<double, mtl::mat::parameters<> >(30, "double");
+    test<double, mtl::mat::parameters<> >(130, "double with long row");
+    test<float, mtl::mat::unsigned_index_parameters>(30, "float");
+    test<double, cpara>(30, "column-major");
+    test_other_values<int>("int");
+    test_other_values<long>("long");
+    test_complex();
+    test_empty_block();
+
+    mtl::compressed2D<double> E(3, 4);
+    round_trip(E, "empty matrix");
+    test_gzip();
+    std::remove(name);
+
+    return 0;
+}
@@ -33,6 +33,11 @@ void test(const Vector&, const char* name)
     MTL_THROW_IF(A[1][2] != 0.0, mtl::runtime_error("Wrong value off diagonal"));
 
     cout << "Dimension of B is " << num_rows(B) << " x " << num_cols(B) << "\n\n";
+
+    mtl::multi_vector<Vector> C(A);
+    A[1][1]= 4.0;
+    MTL_THROW_IF(num_rows(C) != 5 || num_cols(C) != 5, mtl::runtime_error("Wrong dimension of copy"));
+    MTL_THROW_IF(C[1][1] != 3.0 || C[2][1] != 0.0, mtl::runtime_error("Copy does not have its own memory"));
 }
 
 int main(int, char**)
@@ -0,0 +1,99 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#define MTL_NUMA_FIRST_TOUCH
+
+#include <iostream>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+template <typename Value>
+void check(Value x, Value y, const char* what)
+{
+    if (x != y) {
+	mtl::io::tout << what << ": " << x << " should be " << y << '\n';
+	throw mtl::runtime_error("Wrong result with first-touch allocation");
+    }
+}
+
+void test_vector(std::size_t n)
+{
+    mtl::dense_vector<double> v(n), w(n, 2.0);
+    for (std::size_t i= 0; i < n; i++)
+	check(w[i], 2.0, "constructed vector");
+    v= 3.0;
+    w= v + w;
+    for (std::size_t i= 0; i < n; i++)
+	check(w[i], 5.0, "vector sum");
+    set_to_zero(w);
+    check(double(one_norm(w)), 0.0, "set_to_zero");
+
+    mtl::dense_vector<double> u(w);
+    check(size(u), n, "copied vector");
+}
+
+// Tridiagonal matrix, inserted in two passes to stretch the slots
+void test_matrix(std::size_t n)
+{
+    typedef mtl::compressed2D<double> matrix_type;
+    matrix_type A(n, n);
+    {
+	mtl::mat::inserter<matrix_type> ins(A, 1);
+	for (std::size_t i= 0; i < n; i++)
+	    ins[i][i] << 2.0;
+    }
+    {
+	mtl::mat::inserter<matrix_type, mtl::update_plus<double> > ins(A, 2);
+	for (std::size_t i= 0; i < n; i++) {
+	    if (i > 0) ins[i][i-1] << -1.0;
+	    if (i + 1 < n) ins[i][i+1] << -1.0;
+	}
+    }
+    check(A.nnz(), 3 * n - 2, "nnz");
+
+    matrix_type B(A), C;
+    C= B;
+    mtl::dense_vector<double> x(n, 1.0), y(n), z(n);
+    y= A * x;
+    z= C * x;
+    for (std::size_t i= 0; i < n; i++) {
+	check(y[i], 2.0 - (i > 0) - (i + 1 < n), "product");
+	check(z[i], y[i], "product with copy");
+    }
+    set_to_zero(B);
+    check(B.nnz(), std::size_t(0), "nnz after set_to_zero");
+}
+
+void test_policies()
+{
+    namespace numa = mtl::numa;
+    const numa::placement_policy policies[]= {numa::interleave, numa::bind, numa::first_touch};
+    for (int k= 0; k < 3; k++) {
+	numa::set_placement(policies[k]);
+	check(numa::placement(), policies[k], "placement policy");
+	test_vector(100000);
+	test_matrix(1000);
+    }
+}
+
+int main(int, char**)
+{
+    test_vector(0);
+    test_vector(1);
+    test_vector(100000);
+    test_matrix(1);
+    test_matrix(1000);
+    test_policies();
+
+    return 0;
+}
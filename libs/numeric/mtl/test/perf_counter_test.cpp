@@ -0,0 +1,111 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/mtl/utility/perf_counter.hpp>
+
+using namespace std;
+
+double work(mtl::dense_vector<double>& v)
+{
+    for (int k= 0; k < 20; k++)
+	v+= 0.5 * v;
+    return one_norm(v);
+}
+
+void test_software_events()
+{
+    mtl::utility::perf_counter_t counter;
+    if (!counter.is_event_supported("task-clock")) {
+	mtl::io::tout << "perf events are not available.\n";
+	return;
+    }
+    const int clock= counter.add_event("task-clock"), faults= counter.add_event("page-faults");
+    MTL_THROW_IF(!(clock == 0 && faults == 1 && counter.num_events() == 2 && counter.event_name(1) == "page-faults"), mtl::runtime_error("event indices"));
+
+    counter.start();
+    mtl::dense_vector<double> v(100000, 1.0);
+    work(v);
+    counter.read();
+    mtl::io::tout << "task-clock = " << counter[clock] << "ns, page-faults = " << counter[faults] << '\n';
+    MTL_THROW_IF(!(counter[clock] > 0 && counter[faults] > 0), mtl::runtime_error("counting"));
+
+    std::vector<long long> sums;
+    for (int i= 0; i < 3; i++) {
+	mtl::utility::perf_scope scope(counter, sums);
+	work(v);
+    }
+    MTL_THROW_IF(!(sums.size() == 2 && sums[0] > 0), mtl::runtime_error("counts of scopes"));
+
+    counter.stop();
+    counter.read();
+    const long long stopped= counter[clock];
+    work(v);
+    counter.read();
+    MTL_THROW_IF(counter[clock] != stopped, mtl::runtime_error("stopped counter"));
+
+    counter.reset();
+    counter.read();
+    MTL_THROW_IF(counter[clock] != 0, mtl::runtime_error("reset counter"));
+}
+
+void test_hardware_events()
+{
+    mtl::utility::perf_counter_t counter;
+    const char* names[]= {"PAPI_TOT_CYC", "instructions", "cache-misses", "LLC-load-misses", "memory-read-bytes", "memory-write-bytes"};
+    std::vector<int> index;
+    int instructions= -1;
+    for (int i= 0; i < 6; i++) {
+	const bool supported= counter.is_event_supported(names[i]);
+	mtl::io::tout << names[i] << " is " << (supported ? "" : "not ") << "supported\n";
+	if (supported)
+	    index.push_back(counter.add_event(names[i]));
+	if (supported && i == 1)
+	    instructions= index.back();
+    }
+    counter.start();
+    mtl::dense_vector<double> v(100000, 1.0);
+    work(v);
+    counter.read();
+    for (std::size_t i= 0; i < index.size(); i++)
+	mtl::io::tout << counter.event_name(index[i]) << " = " << counter[index[i]] << '\n';
+    if (instructions >= 0)
+	MTL_THROW_IF(counter[instructions] <= 20 * 100000, mtl::runtime_error("instructions"));
+}
+
+void test_errors()
+{
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+    mtl::utility::perf_counter_t counter;
+    MTL_THROW_IF(counter.is_event_supported("no-such-event"), mtl::runtime_error("unknown event supported"));
+    bool caught= false;
+    try {
+	counter.add_event("no-such-event");
+    } catch (const mtl::utility::perf_error&) {
+	caught= true;
+    }
+    MTL_THROW_IF(!caught, mtl::runtime_error("no error for unknown event"));
+#endif
+}
+
+int main(int, char**)
+{
+#ifdef MTL_HAS_PERF_EVENT
+    test_software_events();
+    test_hardware_events();
+    test_errors();
+#endif
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#if !defined(MTL_HAS_VPT) && (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900))
+#  define MTL_WITH_ROOFLINE
+#  define MTL_ROOFLINE_PROBE_SIZE (1 << 18)
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+#ifdef MTL_WITH_ROOFLINE
+
+mtl::vpt::roofline_statistics kernel(int id)
+{
+    std::vector<mtl::vpt::roofline_statistics> v(mtl::vpt::roofline_summary());
+    for (std::size_t i= 0; i < v.size(); i++)
+	if (v[i].id == id)
+	    return v[i];
+    return mtl::vpt::roofline_statistics();
+}
+
+bool close(double x, double y) { return std::abs(x - y) <= 1e-10 * std::abs(y); }
+
+void test_spmv()
+{
+    typedef mtl::compressed2D<double> matrix_type;
+    typedef mtl::Collection<matrix_type>::size_type size_type;
+    matrix_type A;
+    laplacian_setup(A, 20, 20);
+    const std::size_t n= num_rows(A);
+    mtl::dense_vector<double> x(n, 1.0), y(n);
+
+    mtl::vpt::clear_roofline();
+    for (int i= 0; i < 3; i++)
+	y= A * x;
+    mtl::vpt::roofline_statistics s(kernel(3049));
+    mtl::io::tout << "crs: " << s.calls << " calls, " << s.flops << " flops, " << s.bytes << " bytes\n";
+    MTL_THROW_IF(!(s.calls == 3 && s.name == "crs_cvec_mult"), mtl::runtime_error("calls of crs_cvec_mult"));
+    MTL_THROW_IF(!close(s.flops, 3 * 2.0 * A.nnz()), mtl::runtime_error("flops of crs_cvec_mult"));
+    MTL_THROW_IF(!close(s.bytes, 3 * (A.nnz() * (sizeof(double) + sizeof(size_type)) + (n + 1) * sizeof(size_type) + 2 * n * sizeof(double))),
+		 mtl::runtime_error("bytes of crs_cvec_mult"));
+    MTL_THROW_IF(!(s.time > 0.0 && s.gflops() > 0.0 && close(s.intensity(), s.flops / s.bytes)), mtl::runtime_error("time of crs_cvec_mult"));
+
+    mtl::mat::ell_matrix<double> E;
+    laplacian_setup(E, 20, 20);
+    y+= E * x;
+    MTL_THROW_IF(!(kernel(3078).calls == 1 && close(kernel(3078).flops, 2.0 * E.slots() * n)), mtl::runtime_error("flops of ell_cvec_mult"));
+}
+
+void test_vector()
+{
+    const std::size_t n= 1000;
+    mtl::dense_vector<double> u(n, 1.0), v(n, 2.0), w(n);
+
+    mtl::vpt::clear_roofline();
+    w= u + 3.0 * v;
+    MTL_THROW_IF(!(close(kernel(2017).flops, 2.0 * n) && close(kernel(2017).bytes, 3.0 * n * sizeof(double))), mtl::runtime_error("assignment"));
+    w+= u;
+    MTL_THROW_IF(!(close(kernel(2017).flops, 3.0 * n) && close(kernel(2017).bytes, 6.0 * n * sizeof(double))), mtl::runtime_error("update"));
+
+    double d= dot(u, v);
+    MTL_THROW_IF(!(d == 2.0 * n && close(kernel(2003).flops, 2.0 * n) && close(kernel(2003).bytes, 2.0 * n * sizeof(double))), mtl::runtime_error("dot"));
+}
+
+void test_dense()
+{
+    const std::size_t n= 30;
+    mtl::dense2D<double> A(n, n), B(n, n), C(n, n);
+    A= 2.0; B= 3.0;
+    mtl::dense_vector<double> b(n, 1.0), x(n);
+
+    mtl::vpt::clear_roofline();
+    C= A * B;
+    MTL_THROW_IF(!close(kernel(4012).flops, 2.0 * n * n * n), mtl::runtime_error("flops of mat_mat_mult"));
+    x= upper_trisolve(A, b);
+    MTL_THROW_IF(!(kernel(5072).calls == 1 && close(kernel(5072).flops, double(n * n))), mtl::runtime_error("flops of upper_trisolve"));
+}
+
+void test_report()
+{
+    mtl::vpt::set_roofline_peak(mtl::vpt::machine_peak(20.0, 100.0));
+    MTL_THROW_IF(!(mtl::vpt::roofline_peak().bandwidth == 20.0 && close(mtl::vpt::roofline_peak().attainable(0.5), 10.0)), mtl::runtime_error("peak"));
+    std::ostringstream os;
+    mtl::vpt::print_roofline(os);
+    mtl::io::tout << os.str();
+    MTL_THROW_IF(!(os.str().find("mat_mat_mult") != std::string::npos && os.str().find("upper_trisolve") != std::string::npos), mtl::runtime_error("report"));
+
+    mtl::vpt::machine_peak p(mtl::vpt::measure_machine_peak());
+    mtl::io::tout << "Measured peak: " << p.bandwidth << " GB/s, " << p.gflops << " GFLOP/s\n";
+    MTL_THROW_IF(!(p.bandwidth > 0.0 && p.gflops > 0.0), mtl::runtime_error("measured peak"));
+}
+
+#endif
+
+int main(int, char**)
+{
+#ifdef MTL_WITH_ROOFLINE
+    test_spmv();
+    test_vector();
+    test_dense();
+    test_report();
+#endif
+    return 0;
+}
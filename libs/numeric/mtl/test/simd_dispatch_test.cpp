@@ -0,0 +1,126 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+namespace simd = mtl::simd;
+
+template <typename Value>
+void check(Value x, Value y, const char* what)
+{
+    if (std::abs(x - y) > Value(1e-4) * (Value(1) + std::abs(y))) {
+	mtl::io::tout << what << " with " << simd::isa_name(simd::selected_isa()) << ": " << x << " should be " << y << '\n';
+	throw mtl::runtime_error("Wrong result in dispatched kernel");
+    }
+}
+
+template <typename Value>
+void test_vector(std::size_t n)
+{
+    mtl::dense_vector<Value> u(n), v(n);
+    for (std::size_t i= 0; i < n; i++)
+	u[i]= Value(i % 7) - Value(3), v[i]= Value(0.5) * Value(i % 5) - Value(1);
+
+    Value d= 0, n1= 0, n2= 0, ni= 0, s= 0;
+    for (std::size_t i= 0; i < n; i++) {
+	d+= u[i] * v[i]; n1+= std::abs(u[i]); n2+= u[i] * u[i]; ni= std::max(ni, std::abs(u[i])); s+= u[i];
+    }
+    check(Value(dot(u, v)), d, "dot");
+    check(Value(one_norm(u)), n1, "one_norm");
+    check(Value(two_norm(u)), Value(std::sqrt(n2)), "two_norm");
+    check(Value(infinity_norm(u)), ni, "infinity_norm");
+    check(Value(mtl::sum(u)), s, "sum");
+}
+
+// Band matrix with \p nb entries per row (less at the borders)
+template <typename Value>
+void test_matrix(std::size_t n, std::size_t nb)
+{
+    mtl::compressed2D<Value> A(n, n);
+    {
+	mtl::mat::inserter<mtl::compressed2D<Value> > ins(A, nb);
+	for (std::size_t i= 0; i < n; i++)
+	    for (std::size_t j= i < nb / 2 ? 0 : i - nb / 2; j < std::min(n, i + nb - nb / 2); j++)
+		ins[i][j] << Value(1) / Value(1 + (i + 2 * j) % 5);
+    }
+    mtl::dense_vector<Value> x(n), y(n), z(n, Value(2));
+    for (std::size_t i= 0; i < n; i++)
+	x[i]= Value(i % 9) - Value(4);
+
+    y= A * x;
+    z+= A * x;
+    for (std::size_t i= 0; i < n; i++) {
+	Value s= 0;
+	for (std::size_t j= i < nb / 2 ? 0 : i - nb / 2; j < std::min(n, i + nb - nb / 2); j++)
+	    s+= Value(1) / Value(1 + (i + 2 * j) % 5) * x[j];
+	check(y[i], s, "matrix vector product");
+	check(z[i], s + Value(2), "incremental matrix vector product");
+    }
+    z-= A * x;
+    for (std::size_t i= 0; i < n; i++)
+	check(z[i], Value(2), "decremental matrix vector product");
+}
+
+void test_all()
+{
+    mtl::io::tout << "Testing kernels for " << simd::isa_name(simd::selected_isa()) << '\n';
+    const std::size_t sizes[]= {0, 1, 7, 17, 64, 65, 1000, 10007};
+    for (std::size_t k= 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+	test_vector<double>(sizes[k]);
+	test_vector<float>(sizes[k]);
+    }
+    test_matrix<double>(1000, 5);
+    test_matrix<double>(1000, 27);
+    test_matrix<float>(1000, 27);
+    test_matrix<double>(50, 64);
+}
+
+int main(int, char**)
+{
+    mtl::io::tout << "Native instruction set is " << simd::isa_name(simd::native_isa())
+		  << ", detected " << simd::isa_name(simd::detected_isa())
+		  << ", selected " << simd::isa_name(simd::selected_isa()) << '\n';
+
+    MTL_THROW_IF(simd::isa_from_name("avx2") != simd::isa_avx2, mtl::runtime_error("Wrong instruction set name"));
+    MTL_THROW_IF(!simd::isa_available(simd::native_isa()), mtl::runtime_error("Native instruction set must be available"));
+    MTL_THROW_IF(!simd::isa_available(simd::detected_isa()), mtl::runtime_error("Detected instruction set must be available"));
+#if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)  // otherwise errors abort
+    try {
+	simd::select_isa("mmx");
+	throw mtl::logic_error("Unknown instruction set must be rejected");
+    } catch (const mtl::runtime_error&) {}
+#endif
+
+    const simd::isa_id initial= simd::selected_isa();
+    for (int i= simd::isa_scalar; i <= simd::isa_neon; i++) {
+	simd::isa_id isa= simd::isa_id(i);
+	if (simd::isa_available(isa)) {
+	    simd::select_isa(isa);
+	    MTL_THROW_IF(simd::selected_isa() != isa, mtl::runtime_error("Instruction set not selected"));
+	    test_all();
+	}
+#     if !defined(MTL_ASSERT_FOR_THROW) || defined(NDEBUG)
+	else
+	    try {
+		simd::select_isa(isa);
+		throw mtl::logic_error("Unavailable instruction set must be rejected");
+	    } catch (const mtl::runtime_error&) {}
+#     endif
+    }
+    simd::select_isa(simd::isa_name(initial));
+
+    return 0;
+}
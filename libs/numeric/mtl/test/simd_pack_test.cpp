@@ -0,0 +1,109 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <boost/numeric/mtl/mtl.hpp>
+
+using namespace std;
+
+template <typename Value>
+void check(Value x, Value y, const char* what)
+{
+    if (std::abs(x - y) > Value(1e-4) * (Value(1) + std::abs(y))) {
+	mtl::io::tout << what << ": " << x << " should be " << y << '\n';
+	throw mtl::runtime_error("Wrong result in SIMD computation");
+    }
+}
+
+template <typename Value>
+void test_pack()
+{
+    typedef mtl::simd::pack<Value> pack_type;
+    const std::size_t P= pack_type::size;
+    Value a[P], b[P], c[P];
+    for (std::size_t k= 0; k < P; k++)
+	a[k]= Value(k) - Value(2.5), b[k]= Value(2 * k + 1);
+
+    pack_type x= pack_type::load(a), y= pack_type::load(b);
+    fma(x, y, abs(x) - pack_type(Value(1))).store(c);
+    for (std::size_t k= 0; k < P; k++)
+	check(c[k], a[k] * b[k] + std::abs(a[k]) - Value(1), "fma");
+
+    max(x / y, pack_type(Value(0))).store(c);
+    for (std::size_t k= 0; k < P; k++)
+	check(c[k], std::max(a[k] / b[k], Value(0)), "max");
+
+    Value s= 0, m= 0;
+    for (std::size_t k= 0; k < P; k++)
+	s+= b[k], m= std::max(m, b[k]);
+    check(reduce_add(y), s, "reduce_add");
+    check(reduce_max(y), m, "reduce_max");
+}
+
+template <typename Value>
+void test(std::size_t n)
+{
+    using mtl::lazy;
+    mtl::dense_vector<Value> u(n), v(n), w(n), r(n);
+    for (std::size_t i= 0; i < n; i++)
+	u[i]= Value(i % 7) - Value(3), v[i]= Value(0.5) * Value(i % 5) - Value(1);
+
+    Value d= 0, n1= 0, n2= 0, ni= 0, s= 0;
+    for (std::size_t i= 0; i < n; i++) {
+	d+= u[i] * v[i]; n1+= std::abs(u[i]); n2+= u[i] * u[i]; ni= std::max(ni, std::abs(u[i])); s+= u[i];
+    }
+    check(Value(dot(u, v)), d, "dot");
+    check(Value(one_norm(u)), n1, "one_norm");
+    check(Value(two_norm(u)), Value(std::sqrt(n2)), "two_norm");
+    check(Value(infinity_norm(u)), ni, "infinity_norm");
+    check(Value(mtl::sum(u)), s, "sum");
+
+    w= u + Value(2) * v;
+    w-= v * Value(3);
+    w+= u - v;
+    w*= Value(2);
+    w/= Value(4);
+    w+= Value(1);
+    for (std::size_t i= 0; i < n; i++)
+	check(w[i], (u[i] + 2 * v[i] - 3 * v[i] + u[i] - v[i]) * 2 / 4 + 1, "vector assignment");
+
+    Value a, b, c;
+    (lazy(w)= u - Value(2) * v) || (lazy(r)+= w) || (lazy(a)= lazy_dot(w, u)) || (lazy(b)= lazy_two_norm(r)) || (lazy(c)= lazy_infinity_norm(v));
+    Value sa= 0, sb= 0;
+    for (std::size_t i= 0; i < n; i++) {
+	check(w[i], u[i] - 2 * v[i], "fused assignment");
+	sa+= w[i] * u[i]; sb+= r[i] * r[i];
+    }
+    check(a, sa, "fused dot");
+    check(b, Value(std::sqrt(sb)), "fused two_norm");
+    check(c, Value(infinity_norm(v)), "fused infinity_norm");
+}
+
+int main(int, char**)
+{
+    // The stream takes the sizes by reference
+    mtl::io::tout << "SIMD instruction set is " << mtl::simd::native::name() << ", " << mtl::simd::pack<double>::size
+		  << " doubles and " << mtl::simd::pack<float>::size << " floats per pack\n";
+    test_pack<double>();
+    test_pack<float>();
+
+    // sizes around multiples of the pack sizes and of the 4-fold unrolling
+    const std::size_t sizes[]= {0, 1, 3, 7, 8, 17, 31, 64, 65, 1000, 10007};
+    for (std::size_t k= 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+	test<double>(sizes[k]);
+	test<float>(sizes[k]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <string>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/mtl/operation/structure_analysis.hpp>
+
+using namespace std;
+namespace storage_format= mtl::mat::storage_format;
+
+typedef mtl::compressed2D<double> matrix_type;
+
+struct product_checker
+{
+    product_checker(const matrix_type& A) : A(A) {}
+
+    template <typename Matrix>
+    void operator()(Matrix& B) const
+    {
+	mtl::dense_vector<double> x(num_cols(A)), y(num_rows(A)), z(num_rows(A));
+	iota(x);
+	y= A * x;
+	z= B * x;
+	z-= y;
+	MTL_THROW_IF(two_norm(z) >= 1e-10 * two_norm(y), mtl::runtime_error("product in recommended format"));
+    }
+
+    const matrix_type& A;
+};
+
+void test_laplacian()
+{
+    const std::size_t m= 10, n= m * m;
+    matrix_type A;
+    laplacian_setup(A, m, m);
+
+    mtl::mat::structure_analysis a(mtl::mat::analyze_structure(A));
+    mtl::mat::print_structure(mtl::io::tout, a);
+
+    MTL_THROW_IF(!(a.rows == n && a.nnz == A.nnz()), mtl::runtime_error("size"));
+    MTL_THROW_IF(!(a.min_row_length == 3 && a.max_row_length == 5 && a.empty_rows == 0), mtl::runtime_error("row lengths"));
+    MTL_THROW_IF(!(a.row_length_histogram.size() == 4 && a.row_length_histogram[2] == 4 && a.row_length_histogram[3] == n - 4), mtl::runtime_error("histogram"));
+    MTL_THROW_IF(!(a.lower_bandwidth == m && a.upper_bandwidth == m && a.diagonals == 5), mtl::runtime_error("band"));
+    MTL_THROW_IF(!(a.missing_diagonal == 0 && a.is_diagonally_dominant() && a.strictly_dominant_rows == 4 * m - 4), mtl::runtime_error("dominance"));
+    MTL_THROW_IF(!(a.structural_symmetry == 1.0 && a.is_symmetric()), mtl::runtime_error("symmetry"));
+    MTL_THROW_IF(!(!a.is_block_diagonal() && a.max_diagonal_block == n), mtl::runtime_error("no diagonal blocks"));
+    MTL_THROW_IF(!(a.format == storage_format::banded && a.banded_efficiency() > 0.9), mtl::runtime_error("recommendation"));
+
+    mtl::mat::with_recommended_format(A, a, product_checker(A));
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+    std::vector<mtl::mat::format_timing> t(mtl::mat::time_formats(A, a, 2));
+    MTL_THROW_IF(!(t.size() >= 3 && t[1].format == storage_format::ell && t[2].format == storage_format::banded), mtl::runtime_error("timed formats"));
+    mtl::mat::with_recommended_format(A, a, product_checker(A));
+#endif
+
+    // Column-major and dense matrices are analyzed as well
+    mtl::compressed2D<double, mtl::mat::parameters<mtl::tag::col_major> > C(A);
+    MTL_THROW_IF(mtl::mat::analyze_structure(C).diagonals != 5, mtl::runtime_error("column-major"));
+    mtl::dense2D<double> D(A);
+    MTL_THROW_IF(mtl::mat::analyze_structure(D).nnz != n * n, mtl::runtime_error("dense matrices are full"));
+}
+
+void test_blocks()
+{
+    // Three dense diagonal blocks of size 4, 6 and 2
+    const std::size_t starts[]= { 0, 4, 10, 12 };
+    matrix_type A(12, 12);
+    {
+	mtl::mat::inserter<matrix_type> ins(A);
+	for (int b= 0; b < 3; b++)
+	    for (std::size_t i= starts[b]; i < starts[b+1]; i++)
+		for (std::size_t j= starts[b]; j < starts[b+1]; j++)
+		    ins[i][j] << (i == j ? 10.0 : 1.0 + double(i + 2 * j));
+    }
+    mtl::mat::structure_analysis a(mtl::mat::analyze_structure(A));
+    mtl::mat::print_structure(mtl::io::tout, a);
+
+    MTL_THROW_IF(!(a.is_block_diagonal() && a.num_diagonal_blocks() == 3 && a.max_diagonal_block == 6), mtl::runtime_error("blocks"));
+    MTL_THROW_IF(!(a.diagonal_blocks[1] == 4 && a.diagonal_blocks[2] == 10 && a.diagonal_blocks[3] == 12), mtl::runtime_error("block starts"));
+    MTL_THROW_IF(!(a.diagonal_block_fill == 1.0 && a.block_size == 2), mtl::runtime_error("block fill"));
+    MTL_THROW_IF(!(!a.is_symmetric() && a.structural_symmetry == 1.0), mtl::runtime_error("numerically unsymmetric"));
+    MTL_THROW_IF(a.format != storage_format::block_diagonal, mtl::runtime_error("block recommendation"));
+
+    mtl::mat::with_recommended_format(A, a, product_checker(A));
+}
+
+void test_irregular()
+{
+    // One long row and otherwise short rows with scattered columns
+    const std::size_t n= 200;
+    matrix_type A(n, n);
+    {
+	mtl::mat::inserter<matrix_type> ins(A);
+	for (std::size_t j= 0; j < n; j++)
+	    ins[0][j] << 1.0;
+	for (std::size_t i= 1; i < n; i++)
+	    ins[i][i] << 4.0, ins[i][(i * 37) % n] << -1.0;
+    }
+    mtl::mat::structure_analysis a(mtl::mat::analyze_structure(A));
+    mtl::mat::print_structure(mtl::io::tout, a);
+
+    MTL_THROW_IF(!(a.max_row_length == n && a.ell_efficiency() < 0.02), mtl::runtime_error("ELL efficiency"));
+    MTL_THROW_IF(!(a.structural_symmetry < 1.0 && a.contiguous_accesses < 1.0), mtl::runtime_error("irregular"));
+    MTL_THROW_IF(!(a.format == storage_format::compressed && a.crs_block_size == 8), mtl::runtime_error("compressed recommendation"));
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+    std::vector<mtl::mat::format_timing> t(mtl::mat::time_formats(A, a, 3));
+    MTL_THROW_IF(!(!t.empty() && t[0].format == storage_format::compressed && t[0].seconds >= 0.0), mtl::runtime_error("timing"));
+    for (std::size_t i= 0; i < t.size(); i++)
+	mtl::io::tout << storage_format::name(t[i].format) << ' ' << t[i].block_size << ": " << t[i].seconds << "s\n";
+#endif
+}
+
+int main(int, char**)
+{
+    test_laplacian();
+    test_blocks();
+    test_irregular();
+
+    matrix_type E(5, 5);
+    MTL_THROW_IF(mtl::mat::analyze_structure(E).empty_rows != 5, mtl::runtime_error("empty matrix"));
+
+    return 0;
+}
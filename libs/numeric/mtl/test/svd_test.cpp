@@ -16,6 +16,47 @@
 #include <boost/numeric/mtl/operation/svd.hpp>
 
 using namespace std;
+
+template <typename Matrix>
+void check_orthogonal(const Matrix& Q, double tol, const char* name)
+{
+    Matrix QtQ(num_cols(Q), num_cols(Q)), I(num_cols(Q), num_cols(Q));
+    QtQ= trans(Q) * Q; I= 1;
+    QtQ-= I;
+    std::cout << "one_norm(trans(" << name << ")*" << name << " - I) = " << one_norm(QtQ) << "\n";
+    if (one_norm(QtQ) > tol) throw mtl::logic_error("singular vectors are not orthonormal");
+}
+
+template <typename Matrix>
+void check_svd(const Matrix& A, double tol)
+{
+    using namespace mtl;
+    unsigned m= num_rows(A), n= num_cols(A), k= std::min(m, n);
+    Matrix S(m, m), V(m, n), D(n, n), A_t(m, n);
+
+    boost::tie(S, V, D)= svd(A);
+    A_t= S*V*trans(D) - A;
+    std::cout << m << "x" << n << ": one_norm(S*V*D' - A) = " << one_norm(A_t) << "\n";
+    if (one_norm(A_t) > tol * one_norm(A)) throw mtl::logic_error("wrong SVD decomposition");
+    check_orthogonal(S, tol, "S");
+    check_orthogonal(D, tol, "D");
+
+    dense_vector<double> sv(singular_values(A));
+    if (size(sv) != k) throw mtl::logic_error("wrong number of singular values");
+    for (unsigned i= 0; i < k; i++) {
+	if (std::abs(sv[i] - V[i][i]) > tol * sv[0]) throw mtl::logic_error("singular values differ from svd");
+	if (i > 0 && sv[i] > sv[i-1]) throw mtl::logic_error("singular values not sorted");
+    }
+
+    Matrix U_thin(m, k), V_thin(k, k), D_thin(n, k);
+    boost::tie(U_thin, V_thin, D_thin)= svd_thin(A);
+    A_t= U_thin*V_thin*trans(D_thin) - A;
+    std::cout << m << "x" << n << ": one_norm(U*V*D' - A) thin = " << one_norm(A_t) << "\n";
+    if (one_norm(A_t) > tol * one_norm(A)) throw mtl::logic_error("wrong thin SVD decomposition");
+    check_orthogonal(U_thin, tol, "U_thin");
+    check_orthogonal(D_thin, tol, "D_thin");
+}
+
 int main(int, char**)
 {
     using namespace mtl;
@@ -45,7 +86,7 @@ int main(int, char**)
     norm= A_t - A;
     normA= one_norm(norm);
     std::cout<< "norm(SVD-A)=" << normA << "\n";
-//     if (normA > size*size*tol) throw mtl::logic_error("wrong SVD decomposition of matrix A");
+    if (normA > size*size*tol) throw mtl::logic_error("wrong SVD decomposition of matrix A");
     std::cout<<"START--------------\n";
 #if 1
     boost::tie(ST, VT, DT)= svd(AT, tol);
@@ -58,7 +99,24 @@ int main(int, char**)
     normT= A_tT - AT;
     normA= one_norm(normT);
     std::cout<< "norm(SVD-A)=" << normA << "\n";
+    if (normA > size*size*tol) throw mtl::logic_error("wrong SVD decomposition of matrix A^T");
 #endif
+
+    check_svd(A, 1e-12);
+    check_svd(AT, 1e-12);
+
+    dense2D<double> B(40, 25), BT(25, 40), C(30, 30);
+    mtl::seed<double> s;
+    random(B, s); random(C, s);
+    BT= trans(B);
+    C[iall][29]= C[iall][3]; // rank deficient
+    check_svd(B, 1e-12);
+    check_svd(BT, 1e-12);
+    check_svd(C, 1e-12);
+    dense_vector<double> sc(singular_values(C));
+    std::cout << "smallest singular value of rank-deficient C = " << sc[29] << "\n";
+    if (sc[29] > 1e-12 * sc[0]) throw mtl::logic_error("rank deficiency not detected");
+
     return 0;
 }
 
@@ -0,0 +1,200 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+#include <iostream>
+#include <cmath>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+using namespace std;
+
+typedef mtl::dense_vector<double>  vector_type;
+
+const std::size_t n= 150, nk= 5; // more rows than block size to test blocking
+
+// Full matrix with dominant diagonal, the triangle not used must be ignored
+template <typename Matrix>
+void fill(Matrix& A)
+{
+    mtl::dense2D<double> D(n, n);
+    for (std::size_t i= 0; i < n; i++)
+	for (std::size_t j= 0; j < n; j++)
+	    D[i][j]= i == j ? 4.0 + double(i % 3) : 1.0 / (1.0 + double((3 * i + 7 * j) % 11));
+    A= D;
+}
+
+template <typename Matrix>
+void fill_rhs(Matrix& B)
+{
+    for (std::size_t i= 0; i < n; i++)
+	for (std::size_t k= 0; k < nk; k++)
+	    B(i, k)= double((i * 5 + k * 3) % 13) - 6.0;
+}
+
+template <typename MatrixX, typename Solver>
+void check(const MatrixX& X, const MatrixX& B, const Solver& solver, const char* name)
+{
+    for (std::size_t k= 0; k < nk; k++) {
+	vector_type b(n), x(n);
+	for (std::size_t i= 0; i < n; i++)
+	    b[i]= B(i, k);
+	solver(b, x);
+	for (std::size_t i= 0; i < n; i++)
+	    if (std::abs(X(i, k) - x[i]) > 1e-10 * (1.0 + std::abs(x[i]))) {
+		mtl::io::tout << name << ": X(" << i << ", " << k << ") = " << X(i, k) << " but vector solve yields " << x[i] << '\n';
+		throw mtl::runtime_error("Wrong result in multi-RHS triangular solve!");
+	    }
+    }
+}
+
+template <typename Matrix, typename DiaTag, bool Compact, typename MatrixX>
+void test_solver(const Matrix& L, const Matrix& U, const MatrixX& B, const char* name)
+{
+    using mtl::mat::detail::lower_trisolve_t; using mtl::mat::detail::upper_trisolve_t;
+    lower_trisolve_t<Matrix, DiaTag, Compact> lower(L);
+    upper_trisolve_t<Matrix, DiaTag, Compact> upper(U);
+
+    MatrixX X(n, nk);
+    lower(B, X);
+    check(X, B, lower, name);
+    upper(B, X);
+    check(X, B, upper, name);
+
+    MatrixX Y(n, nk);           // in place
+    Y= B;
+    upper(Y, Y);
+    for (std::size_t i= 0; i < n; i++)
+	for (std::size_t k= 0; k < nk; k++)
+	    MTL_THROW_IF(Y(i, k) != X(i, k), mtl::runtime_error("In-place solve differs!"));
+}
+
+template <typename Matrix, typename MatrixX>
+void test(Matrix& A, MatrixX& B, const char* name)
+{
+    mtl::io::tout << name << '\n';
+    A.change_dim(n, n);
+    fill(A);
+    B.change_dim(n, nk);
+    fill_rhs(B);
+
+    test_solver<Matrix, mtl::tag::regular_diagonal, false>(A, A, B, name);
+    test_solver<Matrix, mtl::tag::unit_diagonal, false>(A, A, B, name);
+    test_solver<Matrix, mtl::tag::inverse_diagonal, false>(A, A, B, name);
+
+    // Sparse triangles only, unit diagonal with strict triangles
+    if (mtl::traits::is_sparse<Matrix>::value) {
+	Matrix L(lower(A)), U(upper(A)), SL(strict_lower(A)), SU(strict_upper(A));
+	test_solver<Matrix, mtl::tag::regular_diagonal, true>(L, U, B, name);
+	test_solver<Matrix, mtl::tag::inverse_diagonal, true>(L, U, B, name);
+	test_solver<Matrix, mtl::tag::unit_diagonal, true>(SL, SU, B, name);
+    }
+
+    // Free functions
+    MatrixX X(n, nk), Y(n, nk);
+    lower_trisolve(A, B, X);
+    upper_trisolve(A, X, Y);
+    vector_type b(n), x(n);
+    for (std::size_t i= 0; i < n; i++)
+	b[i]= B(i, nk-1);
+    x= upper_trisolve(A, lower_trisolve(A, b));
+    for (std::size_t i= 0; i < n; i++)
+	MTL_THROW_IF(std::abs(Y(i, nk-1) - x[i]) > 1e-10 * (1.0 + std::abs(x[i])), mtl::runtime_error("Wrong result in free trisolve functions!"));
+}
+
+template <typename MatrixX>
+void test_lu(MatrixX& B, const char* name)
+{
+    mtl::io::tout << "lu_apply with " << name << '\n';
+    mtl::dense2D<double>      A(n, n);
+    fill(A);
+    for (std::size_t i= 0; i < n; i++)
+	A[i][(i + 17) % n]+= 10.0;                     // enforce pivoting
+    B.change_dim(n, nk);
+    fill_rhs(B);
+
+    mtl::dense2D<double>      LU(A);
+    mtl::dense_vector<std::size_t, mtl::vec::parameters<> > P;
+    lu(LU, P);
+    MatrixX X(lu_apply(LU, P, B)), Y(n, nk);
+    mtl::mat::lu_solver<mtl::dense2D<double> > solver(A);
+    solver.solve(B, Y);
+
+    for (std::size_t k= 0; k < nk; k++) {
+	vector_type b(n), x(n), y(n), r(n);
+	for (std::size_t i= 0; i < n; i++) {
+	    b[i]= B(i, k); x[i]= X(i, k); y[i]= Y(i, k);
+	}
+	r= A * x - b;
+	MTL_THROW_IF(two_norm(r) > 1e-10 * two_norm(b), mtl::runtime_error("Wrong result in lu_apply with multiple right-hand sides!"));
+	r= y - x;
+	MTL_THROW_IF(two_norm(r) > 1e-12 * two_norm(x), mtl::runtime_error("Wrong result in lu_solver with multiple right-hand sides!"));
+    }
+}
+
+template <typename MatrixX>
+void test_pc(MatrixX& B, const char* name)
+{
+    mtl::io::tout << "ic_0 and ilu_0 with " << name << '\n';
+    typedef mtl::compressed2D<double> matrix_type;
+    matrix_type                       A(n, n);
+    laplacian_setup(A, 15, 10);
+    B.change_dim(n, nk);
+    fill_rhs(B);
+
+    itl::pc::ic_0<matrix_type>        IC(A);
+    itl::pc::ilu_0<matrix_type>       ILU(A);
+    MatrixX X(n, nk), Y(n, nk);
+    IC.solve(B, X);
+    ILU.solve(B, Y);
+    ILU.adjoint_solve(B, Y);
+
+    for (std::size_t k= 0; k < nk; k++) {
+	vector_type b(n), x(n), y(n);
+	for (std::size_t i= 0; i < n; i++)
+	    b[i]= B(i, k);
+	x= solve(IC, b);
+	y= adjoint_solve(ILU, b);
+	for (std::size_t i= 0; i < n; i++) {
+	    MTL_THROW_IF(std::abs(X(i, k) - x[i]) > 1e-10 * (1.0 + std::abs(x[i])), mtl::runtime_error("Wrong result in ic_0 with multiple right-hand sides!"));
+	    MTL_THROW_IF(std::abs(Y(i, k) - y[i]) > 1e-10 * (1.0 + std::abs(y[i])), mtl::runtime_error("Wrong result in ilu_0 with multiple right-hand sides!"));
+	}
+    }
+}
+
+int main(int, char**)
+{
+    using namespace mtl;
+    dense2D<double>                                      dr;
+    dense2D<double, mat::parameters<col_major> >         dc;
+    compressed2D<double>                                 cr;
+    compressed2D<double, mat::parameters<col_major> >    cc;
+
+    dense2D<double>                                      Br;
+    dense2D<double, mat::parameters<col_major> >         Bc;
+    mat::multi_vector<vector_type>                       Bm;
+
+    test(dr, Br, "Dense row major with dense row-major RHS");
+    test(dr, Bc, "Dense row major with dense column-major RHS");
+    test(dc, Br, "Dense column major with dense row-major RHS");
+    test(dr, Bm, "Dense row major with multi_vector");
+    test(cr, Br, "Compressed row major with dense row-major RHS");
+    test(cr, Bm, "Compressed row major with multi_vector");
+    test(cc, Bc, "Compressed column major with dense column-major RHS");
+
+    test_lu(Br, "dense2D");
+    test_lu(Bm, "multi_vector");
+
+    test_pc(Br, "dense2D");
+    test_pc(Bm, "multi_vector");
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+// The built-in tracing needs C++11 and is not compiled in together with Vampir Trace
+#if !defined(MTL_HAS_VPT) && (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900))
+#  ifndef MTL_WITH_TRACE
+#    define MTL_WITH_TRACE
+#  endif
+#  undef MTL_VPT_LEVEL
+#  define MTL_VPT_LEVEL 0
+#  define MTL_TRACE_BUFFER_SIZE 4096
+#  ifdef __linux__
+#    define MTL_TRACE_COUNTERS
+#  endif
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+
+using namespace std;
+
+#ifdef MTL_WITH_TRACE
+
+const mtl::vpt::trace_statistics& find(const std::vector<mtl::vpt::trace_statistics>& v, int id)
+{
+    for (std::size_t i= 0; i < v.size(); i++)
+	if (v[i].id == id)
+	    return v[i];
+    MTL_THROW_IF(!false, mtl::runtime_error("event not found"));
+    return v[0];
+}
+
+std::size_t occurrences(const std::string& s, const std::string& pattern)
+{
+    std::size_t n= 0;
+    for (std::size_t p= s.find(pattern); p != std::string::npos; p= s.find(pattern, p + 1))
+	n++;
+    return n;
+}
+
+volatile double sink;
+
+void work(int n)
+{
+    double s= 0.0;
+    for (int i= 1; i <= n; i++)
+	s+= 1.0 / double(i);
+    sink= s;
+}
+
+void helper_function()
+{
+    mtl::vampir_trace<9990> tracer;
+    work(20000);
+}
+
+void function()
+{
+    mtl::vampir_trace<9991> tracer;
+    work(10000);
+    helper_function();
+    helper_function();
+}
+
+void recursion(int depth)
+{
+    mtl::vampir_trace<9901> tracer;
+    work(10000);
+    if (depth > 1)
+	recursion(depth - 1);
+}
+
+void own_event()
+{
+    mtl::vampir_trace<12800> tracer;
+}
+
+void test_nesting()
+{
+    mtl::vpt::clear_trace();
+    for (int i= 0; i < 10; i++)
+	::function();
+    recursion(3);
+    own_event();
+    MTL_THROW_IF(mtl::vpt::trace_event_name(12800) != "vpt_12800", mtl::runtime_error("default name"));
+    mtl::vpt::set_trace_event_name(12800, "own \"event\"");
+
+    std::vector<mtl::vpt::trace_statistics> v(mtl::vpt::trace_summary());
+    const mtl::vpt::trace_statistics &f= find(v, 9991), &h= find(v, 9990), &r= find(v, 9901);
+    mtl::io::tout << "function: " << f.count << " calls, total " << f.total << "s, self " << f.self << "s\n";
+    MTL_THROW_IF(!(f.name == "function" && h.name == "helper_function" && r.name == "tb1"), mtl::runtime_error("names"));
+    MTL_THROW_IF(!(f.count == 10 && h.count == 20 && r.count == 3), mtl::runtime_error("counts"));
+    MTL_THROW_IF(!(h.self == h.total && f.self < f.total), mtl::runtime_error("self time"));
+    MTL_THROW_IF(!(f.total >= h.total + f.self * 0.999 && f.total <= h.total + f.self * 1.001), mtl::runtime_error("total = nested + self"));
+    MTL_THROW_IF(r.total >= r.self * 1.001, mtl::runtime_error("recursive blocks counted once in total time"));
+
+    std::ostringstream os;
+    mtl::vpt::write_chrome_trace(os);
+    const std::string json= os.str();
+    MTL_THROW_IF(!(json.compare(0, 15, "{\"traceEvents\":") == 0 && json.find("]}") == std::string::npos
+		   && json.find("],\"displayTimeUnit\":\"ns\"}") != std::string::npos), mtl::runtime_error("JSON frame"));
+    MTL_THROW_IF(!(occurrences(json, "\"name\":\"helper_function\"") == 20 && occurrences(json, "\"ph\":\"X\"") == 34), mtl::runtime_error("JSON events"));
+    MTL_THROW_IF(json.find("\"name\":\"own \\\"event\\\"\"") == std::string::npos, mtl::runtime_error("escaped name"));
+}
+
+void test_solver()
+{
+    mtl::vpt::clear_trace();
+    const int size= 20, N= size * size;
+    mtl::compressed2D<double> A(N, N);
+    laplacian_setup(A, size, size);
+    mtl::dense_vector<double> x(N, 1.0), b(N);
+    b= A * x;
+    x= 0;
+    itl::basic_iteration<double> iter(b, N, 1.e-8);
+    cg(A, x, b, iter);
+
+    std::vector<mtl::vpt::trace_statistics> v(mtl::vpt::trace_summary());
+    MTL_THROW_IF(find(v, 7001).count != 1, mtl::runtime_error("one cg call"));
+    for (std::size_t i= 1; i < v.size(); i++)
+	MTL_THROW_IF(v[i-1].self < v[i].self, mtl::runtime_error("summary sorted by self time"));
+    std::ostringstream os;
+    mtl::vpt::print_trace_summary(os);
+    mtl::io::tout << os.str();
+    MTL_THROW_IF(os.str().find("cg_without_pc") == std::string::npos, mtl::runtime_error("cg in summary"));
+#ifdef MTL_TRACE_COUNTERS
+    MTL_THROW_IF(os.str().find("IPC") == std::string::npos, mtl::runtime_error("counters in summary"));
+    mtl::utility::perf_counter_t counter;
+    if (counter.is_event_supported("instructions"))
+	MTL_THROW_IF(find(v, 7001).instructions <= 0.0, mtl::runtime_error("instructions of cg"));
+#endif
+}
+
+void test_overflow()
+{
+    mtl::vpt::clear_trace();
+    for (int i= 0; i < 3000; i++)
+	::function();
+    MTL_THROW_IF(mtl::vpt::trace_dropped_events() <= 0, mtl::runtime_error("buffer overflow"));
+    std::vector<mtl::vpt::trace_statistics> v(mtl::vpt::trace_summary());
+    const mtl::vpt::trace_statistics &f= find(v, 9991), &h= find(v, 9990);
+    MTL_THROW_IF(!(f.count <= 4096 / 6 + 1 && h.count >= 2 * f.count && h.count <= 2 * f.count + 2), mtl::runtime_error("retained events"));
+    std::ostringstream os;
+    mtl::vpt::print_trace_summary(os);
+    MTL_THROW_IF(os.str().find("events were overwritten") == std::string::npos, mtl::runtime_error("overflow in summary"));
+}
+
+void test_threads()
+{
+    mtl::vpt::clear_trace();
+#ifdef MTL_WITH_OPENMP
+#   pragma omp parallel for
+#endif
+    for (int i= 0; i < 16; i++)
+	::function();
+    MTL_THROW_IF(find(mtl::vpt::trace_summary(), 9991).count != 16, mtl::runtime_error("calls in all threads"));
+}
+
+int main(int, char**)
+{
+    test_nesting();
+    test_solver();
+    test_overflow();
+    test_threads();
+
+    return 0;
+}
+
+#else
+
+int main(int, char**)
+{
+    std::cout << "Built-in tracing is not available.\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,72 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+// Structural analysis of a sparse matrix and recommendation of its storage format, e.g.:
+//   analyze_matrix matrix.mtx
+//   analyze_matrix --time --repetitions 20 matrix.mtx
+//   analyze_matrix --laplacian 1000
+// With --time the candidate formats are timed on the matrix and the fastest one is recommended.
+// The row unrollings of compressed2D are timed as well.
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/mtl/operation/structure_analysis.hpp>
+
+void usage(const char* prog)
+{
+    std::cerr << "usage: " << prog << " [--time] [--repetitions n] (file.mtx | --laplacian m)\n";
+    std::exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+    namespace storage_format= mtl::mat::storage_format;
+    mtl::compressed2D<double> A;
+    bool                      timing= false, have_matrix= false;
+    int                       repetitions= 10;
+
+    for (int i= 1; i < argc; i++) {
+	const std::string arg(argv[i]);
+	if (arg == "--time")
+	    timing= true;
+	else if (arg == "--repetitions" && i + 1 < argc)
+	    repetitions= std::atoi(argv[++i]);
+	else if (arg == "--laplacian" && i + 1 < argc) {
+	    const int m= std::atoi(argv[++i]);
+	    laplacian_setup(A, m, m);
+	    have_matrix= true;
+	} else if (arg[0] != '-') {
+	    mtl::io::matrix_market_istream(arg) >> A;
+	    have_matrix= true;
+	} else
+	    usage(argv[0]);
+    }
+    if (!have_matrix || repetitions < 1)
+	usage(argv[0]);
+
+    mtl::mat::structure_analysis a(mtl::mat::analyze_structure(A));
+    if (timing) {
+	std::vector<mtl::mat::format_timing> t(mtl::mat::time_formats(A, a, repetitions));
+	std::cout << "Measured times of the product:\n";
+	for (std::size_t i= 0; i < t.size(); i++) {
+	    std::cout << "  " << storage_format::name(t[i].format);
+	    if (t[i].block_size > 0)
+		std::cout << " with block size " << t[i].block_size;
+	    std::cout << ": " << t[i].seconds << "s, " << 2.0 * double(a.nnz) / t[i].seconds * 1e-9 << " GFLOP/s\n";
+	}
+    }
+    mtl::mat::print_structure(std::cout, a);
+
+    return 0;
+}
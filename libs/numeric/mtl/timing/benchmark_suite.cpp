@@ -0,0 +1,110 @@
+// Software License for MTL
+//
+// Copyright (c) 2007 The Trustees of Indiana University.
+//               2008 Dresden University of Technology and the Trustees of Indiana University.
+//               2010 SimuNova UG (haftungsbeschränkt), www.simunova.com.
+// All rights reserved.
+// Authors: Peter Gottschling and Andrew Lumsdaine
+//
+// This file is part of the Matrix Template Library
+//
+// See also license.mtl.txt in the distribution.
+
+// Benchmark suite of the main kernels with the harness in utility/benchmark.hpp, e.g.:
+//   benchmark_suite --json base.json
+//   benchmark_suite --baseline base.json --tolerance 0.05 --filter spmv
+// The exit code is the number of regressions against the baseline.
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <boost/numeric/mtl/mtl.hpp>
+#include <boost/numeric/itl/itl.hpp>
+#include <boost/numeric/mtl/utility/benchmark.hpp>
+
+using mtl::utility::benchmark;
+using mtl::utility::benchmark_keep;
+
+template <typename Value> const char* type_name();
+template <> const char* type_name<float>() { return "float"; }
+template <> const char* type_name<double>() { return "double"; }
+
+std::string case_name(const std::string& kernel, const char* type, std::size_t n)
+{
+    std::ostringstream os;
+    os << kernel << '/' << type << "/n=" << n;
+    return os.str();
+}
+
+template <typename Value>
+void vector_cases(benchmark& bench, std::size_t n)
+{
+    mtl::dense_vector<Value> u(n, Value(1)), v(n, Value(2)), w(n);
+    const double s= sizeof(Value), dn= double(n);
+    bench.run_parallel(case_name("vector/axpy", type_name<Value>(), n), [&]() { w= u + Value(3) * v; benchmark_keep(w); }, 2 * dn, 3 * s * dn);
+    bench.run_parallel(case_name("vector/dot", type_name<Value>(), n), [&]() { benchmark_keep(dot(u, v)); }, 2 * dn, 2 * s * dn);
+    bench.run_parallel(case_name("vector/two_norm", type_name<Value>(), n), [&]() { benchmark_keep(two_norm(u)); }, 2 * dn, s * dn);
+}
+
+template <typename Matrix>
+void spmv(benchmark& bench, const std::string& kernel, std::size_t m)
+{
+    typedef typename mtl::Collection<Matrix>::value_type value_type;
+    typedef typename mtl::Collection<Matrix>::size_type  size_type;
+    Matrix A;
+    laplacian_setup(A, m, m);
+    const std::size_t n= num_rows(A);
+    mtl::dense_vector<value_type> x(n, value_type(1)), y(n);
+    const double nnz= double(A.nnz()), s= sizeof(value_type), dn= double(n);
+    // Values and indices of A, row starts for compressed, and x and y once
+    const double bytes= nnz * (s + sizeof(size_type)) + dn * (sizeof(size_type) + 2 * s);
+    bench.run_parallel(case_name(kernel, type_name<value_type>(), n), [&]() { y= A * x; benchmark_keep(y); }, 2 * nnz, bytes);
+}
+
+template <typename Value>
+void dense_product(benchmark& bench, std::size_t n)
+{
+    mtl::dense2D<Value> A(n, n), B(n, n), C(n, n);
+    A= Value(1); B= Value(2);
+    const double dn= double(n);
+    bench.run(case_name("dense/gemm", type_name<Value>(), n), [&]() { C= A * B; benchmark_keep(C); },
+	      2 * dn * dn * dn, 3 * sizeof(Value) * dn * dn);
+}
+
+void solver_cases(benchmark& bench, std::size_t m)
+{
+    mtl::compressed2D<double> A;
+    laplacian_setup(A, m, m);
+    const std::size_t n= num_rows(A);
+    mtl::dense_vector<double> x(n), b(n, 1.0);
+    itl::pc::ilu_0<mtl::compressed2D<double> > P(A);
+    bench.run(case_name("solver/cg_ilu_0", "double", n), [&]() {
+	    x= 0;
+	    itl::basic_iteration<double> iter(b, 10000, 1.e-6);
+	    cg(A, x, b, P, iter);
+	    benchmark_keep(x);
+	});
+    bench.run(case_name("solver/ilu_0_setup", "double", n), [&]() { itl::pc::ilu_0<mtl::compressed2D<double> > Q(A); benchmark_keep(Q); });
+}
+
+int main(int argc, char* argv[])
+{
+    benchmark bench(argc, argv);
+    const bool quick= bench.quick();
+
+    for (std::size_t n= 1000; n <= (quick ? 100000u : 10000000u); n*= 100) {
+	vector_cases<double>(bench, n);
+	vector_cases<float>(bench, n);
+    }
+    for (std::size_t m= 100; m <= (quick ? 100u : 1000u); m*= 10) {
+	spmv<mtl::compressed2D<double> >(bench, "spmv/crs", m);
+	spmv<mtl::compressed2D<float> >(bench, "spmv/crs", m);
+	spmv<mtl::mat::ell_matrix<double> >(bench, "spmv/ell", m);
+	spmv<mtl::sparse_banded<double> >(bench, "spmv/banded", m);
+    }
+    for (std::size_t n= 64; n <= (quick ? 64u : 512u); n*= 2)
+	dense_product<double>(bench, n);
+    solver_cases(bench, quick ? 30 : 200);
+
+    return bench.finish();
+}
@@ -13,6 +13,9 @@ option(ENABLE_OPENMP "switch on to enable OpenMP flags for mtl" OFF)
 option(ENABLE_SHORT_ELE_PROD "enable short notation for element-wise product" OFF)
 option(ENABLE_CXX_ELEVEN "enable C++11 features as far as compiler permits" ON)
 option(USE_ASSERTS "Use assert instead of throwing exceptions" ON)
+option(ENABLE_ZLIB "switch on to write gzip-compressed Matrix Market files (*.gz) with zlib" OFF)
+option(ENABLE_TRACE "switch on the built-in tracing of the vampir_trace events (needs C++11)" OFF)
+option(ENABLE_ROOFLINE "switch on the roofline report of flops and bytes of the main kernels (needs C++11)" OFF)
 
 
 unset(MTL_LIBRARIES )
@@ -100,6 +103,22 @@ if(ENABLE_OPENMP )
 		message(FATAL_ERROR "OpenMP not found")
 	endif()
 endif()
+if(ENABLE_ZLIB)
+	find_package(ZLIB REQUIRED)
+	list(APPEND MTL_CXX_DEFINITIONS "-DMTL_WITH_ZLIB")
+	list(APPEND MTL_INCLUDE_DIRS ${ZLIB_INCLUDE_DIRS})
+	list(APPEND MTL_LIBRARIES ${ZLIB_LIBRARIES})
+endif()
+if(ENABLE_TRACE AND NOT HAVE_VAMPIR)
+	find_package(Threads REQUIRED)
+	list(APPEND MTL_CXX_DEFINITIONS "-DMTL_WITH_TRACE")
+	list(APPEND MTL_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+endif()
+if(ENABLE_ROOFLINE)
+	find_package(Threads REQUIRED)
+	list(APPEND MTL_CXX_DEFINITIONS "-DMTL_WITH_ROOFLINE")
+	list(APPEND MTL_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+endif()
 message(STATUS "MTL Find components: ${MTL_FIND_COMPONENTS}")
 #we found nothing..
 set(MTL_NOT_FOUND )